@@ -146,6 +146,7 @@ HEADERS  += \
     src/Cmd/CmdCopy.h \
     src/Cmd/CmdCut.h \
     src/Cmd/CmdDelete.h \
+    src/Cmd/CmdDirty.h \
     src/Cmd/CmdEditPointAxis.h \
     src/Cmd/CmdEditPointGraph.h \
     src/Cmd/CmdFactory.h \
@@ -286,8 +287,10 @@ HEADERS  += \
     src/Dlg/DlgValidatorNumber.h \
     src/Document/Document.h \
     src/Document/DocumentAxesPointsRequired.h \
+    src/Document/DocumentContainer.h \
     src/Document/DocumentHash.h \
     src/Document/DocumentHashGenerator.h \
+    src/Document/DocumentImageStorage.h \
     src/Document/DocumentModelAbstractBase.h \
     src/Document/DocumentModelAxesChecker.h \
     src/Document/DocumentModelColorFilter.h \
@@ -308,12 +311,14 @@ HEADERS  += \
     src/util/EnumsToQt.h \
     src/Export/ExportAlignLinear.h \
     src/Export/ExportAlignLog.h \
+    src/Export/ExportColumnsLoader.h \
     src/Export/ExportDelimiter.h \
     src/Export/ExportFileAbstractBase.h \    
     src/Export/ExportFileExtension.h \
     src/Export/ExportFileExtensionOverride.h \
     src/Export/ExportFileFunctions.h \
     src/Export/ExportFileRelations.h \
+    src/Export/ExportFunctionFit.h \
     src/Export/ExportHeader.h \
     src/Export/ExportImageForRegression.h \
     src/Export/ExportLayoutFunctions.h \
@@ -322,11 +327,16 @@ HEADERS  += \
     src/Export/ExportPointsIntervalUnits.h \
     src/Export/ExportPointsSelectionFunctions.h \
     src/Export/ExportPointsSelectionRelations.h \
+    src/Export/ExportRelationFit.h \
     src/Export/ExportToClipboard.h \
     src/Export/ExportToFile.h \
+    src/Export/ExportToFileBatch.h \
+    src/Export/ExportToFileNumpy.h \
+    src/Export/ExportValuesColumn.h \
     src/Export/ExportValuesOrdinal.h \
     src/Export/ExportValuesXOrY.h \
     src/Export/ExportXThetaValuesMergedFunctions.h \
+    src/Export/ExportZipStored.h \
     src/FileCmd/FileCmdAbstract.h \
     src/FileCmd/FileCmdClose.h \
     src/FileCmd/FileCmdExport.h \
@@ -347,9 +357,11 @@ HEADERS  += \
     src/Format/FormatCoordsUnitsStrategyNonPolarTheta.h \
     src/Format/FormatCoordsUnitsStrategyPolarTheta.h \
     src/Format/FormatDateTime.h \
+    src/Format/FormatDateTimeMatcher.h \
     src/Format/FormatDegreesMinutesSecondsBase.h \
     src/Format/FormatDegreesMinutesSecondsNonPolarTheta.h \
     src/Format/FormatDegreesMinutesSecondsPolarTheta.h \
+    src/Format/FormatPrecisionPlan.h \
     src/Callback/functor.h \
     src/Geometry/GeometryModel.h \
     src/Geometry/GeometryStrategyAbstractBase.h \
@@ -366,6 +378,7 @@ HEADERS  += \
     src/util/gnuplot.h \
     src/Graphics/GraphicsArcItem.h \
     src/Graphics/GraphicsArcItemRelay.h \
+    src/Graphics/GraphicsImageTiled.h \
     src/Graphics/GraphicsItemsExtractor.h \
     src/Graphics/GraphicsItemType.h \
     src/Graphics/GraphicsLineItemRelay.h \
@@ -376,6 +389,7 @@ HEADERS  += \
     src/Graphics/GraphicsPointEllipse.h \
     src/Graphics/GraphicsPointFactory.h \
     src/Graphics/GraphicsPointPolygon.h \
+    src/Graphics/GraphicsPointsBatch.h \
     src/Graphics/GraphicsScene.h \
     src/Graphics/GraphicsView.h \
     src/Grid/GridClassifier.h \
@@ -502,6 +516,8 @@ HEADERS  += \
     src/Settings/Settings.h \
     src/Settings/SettingsForGraph.h \
     src/Spline/Spline.h \
+    src/Spline/SplineArcLength.h \
+    src/Spline/SplineArcLengthCache.h \
     src/Spline/SplineCoeff.h \
     src/Spline/SplineDrawer.h \
     src/Spline/SplinePair.h \
@@ -612,6 +628,7 @@ SOURCES += \
     src/Cmd/CmdCopy.cpp \
     src/Cmd/CmdCut.cpp \
     src/Cmd/CmdDelete.cpp \
+    src/Cmd/CmdDirty.cpp \
     src/Cmd/CmdEditPointAxis.cpp \
     src/Cmd/CmdEditPointGraph.cpp \
     src/Cmd/CmdFactory.cpp \
@@ -746,6 +763,8 @@ SOURCES += \
     src/Dlg/DlgValidatorFactory.cpp \
     src/Dlg/DlgValidatorNumber.cpp \
     src/Document/Document.cpp \
+    src/Document/DocumentContainer.cpp \
+    src/Document/DocumentHash.cpp \
     src/Document/DocumentHashGenerator.cpp \
     src/Document/DocumentModelAbstractBase.cpp \
     src/Document/DocumentModelAxesChecker.cpp \
@@ -772,6 +791,7 @@ SOURCES += \
     src/Export/ExportFileExtensionOverride.cpp \
     src/Export/ExportFileFunctions.cpp \
     src/Export/ExportFileRelations.cpp \
+    src/Export/ExportFunctionFit.cpp \
     src/Export/ExportHeader.cpp \
     src/Export/ExportImageForRegression.cpp \
     src/Export/ExportLayoutFunctions.cpp \
@@ -780,9 +800,14 @@ SOURCES += \
     src/Export/ExportPointsIntervalUnits.cpp \
     src/Export/ExportPointsSelectionFunctions.cpp \
     src/Export/ExportPointsSelectionRelations.cpp \
+    src/Export/ExportRelationFit.cpp \
     src/Export/ExportToClipboard.cpp \
     src/Export/ExportToFile.cpp \
+    src/Export/ExportToFileBatch.cpp \
+    src/Export/ExportToFileNumpy.cpp \
+    src/Export/ExportValuesColumn.cpp \
     src/Export/ExportXThetaValuesMergedFunctions.cpp \
+    src/Export/ExportZipStored.cpp \
     src/FileCmd/FileCmdAbstract.cpp \
     src/FileCmd/FileCmdClose.cpp \
     src/FileCmd/FileCmdExport.cpp \
@@ -801,9 +826,11 @@ SOURCES += \
     src/Format/FormatCoordsUnitsStrategyNonPolarTheta.cpp \
     src/Format/FormatCoordsUnitsStrategyPolarTheta.cpp \
     src/Format/FormatDateTime.cpp \
+    src/Format/FormatDateTimeMatcher.cpp \
     src/Format/FormatDegreesMinutesSecondsBase.cpp \
     src/Format/FormatDegreesMinutesSecondsNonPolarTheta.cpp \
     src/Format/FormatDegreesMinutesSecondsPolarTheta.cpp \
+    src/Format/FormatPrecisionPlan.cpp \
     src/Geometry/GeometryModel.cpp \
     src/Geometry/GeometryStrategyAbstractBase.cpp \
     src/Geometry/GeometryStrategyContext.cpp \
@@ -819,6 +846,7 @@ SOURCES += \
     src/util/gnuplot.cpp \
     src/Graphics/GraphicsArcItem.cpp \
     src/Graphics/GraphicsArcItemRelay.cpp \
+    src/Graphics/GraphicsImageTiled.cpp \
     src/Graphics/GraphicsItemsExtractor.cpp \
     src/Graphics/GraphicsLineItemRelay.cpp \
     src/Graphics/GraphicsLinesForCurve.cpp \
@@ -828,6 +856,7 @@ SOURCES += \
     src/Graphics/GraphicsPointEllipse.cpp \
     src/Graphics/GraphicsPointFactory.cpp \
     src/Graphics/GraphicsPointPolygon.cpp \
+    src/Graphics/GraphicsPointsBatch.cpp \
     src/Graphics/GraphicsScene.cpp \
     src/Graphics/GraphicsView.cpp \
     src/Grid/GridClassifier.cpp \
@@ -946,6 +975,8 @@ SOURCES += \
     src/Settings/Settings.cpp \
     src/Settings/SettingsForGraph.cpp \
     src/Spline/Spline.cpp \
+    src/Spline/SplineArcLength.cpp \
+    src/Spline/SplineArcLengthCache.cpp \
     src/Spline/SplineCoeff.cpp \
     src/Spline/SplineDrawer.cpp \
     src/Spline/SplinePair.cpp \
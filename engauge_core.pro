@@ -0,0 +1,347 @@
+# engauge_core.pro : Builds make files for the engauge_core static library
+#
+# Comments:
+# 1) This library holds Document loading and saving, Transformation, Curve, FilterImage, PointMatchAlgorithm and the
+#    ExportFile* classes, without MainWindow or any other widget. Automation (batch export, for example) can link to
+#    it and run under QCoreApplication, on any thread, without the startup cost of the full gui
+# 2) Document, FilterImage and GridRemoval work with QImage, so the QtGui module is linked for QImage and QColor only.
+#    Conversion to QPixmap for display is left to the gui, which caches it in CmdMediator
+# 3) Errors while reading xml go to stderr unless the gui binds a message box with xmlBindToErrorDisplay
+# 4) SegmentFactory is not included since segments are QGraphicsItems that live in the QGraphicsScene
+# 5) The command line tests link this library rather than compiling these sources themselves. The separate make file
+#    keeps the Makefile of engauge.pro intact. Sample command line:
+#        qmake -o Makefile.engauge_core engauge_core.pro && make -f Makefile.engauge_core
+
+QT = core gui xml
+CONFIG += c++11 staticlib warn_on thread
+TEMPLATE = lib
+TARGET = engauge_core
+DESTDIR = lib
+
+CONFIG(debug,debug|release){
+  # Debug version:
+} else {
+  # Release version. See engauge.pro
+  DEFINES += QT_NO_DEBUG
+  *-g++* {
+    QMAKE_CXXFLAGS_WARN_ON += -Wreturn-type -O1 -Wuninitialized -Wunused-variable
+  }
+}
+
+OBJECTS_DIR = src/.objs_core
+MOC_DIR = src/.moc_core
+
+HEADERS  += \
+    src/Callback/CallbackAddPointsInCurvesGraphs.h \
+    src/Callback/CallbackAxisPointsAbstract.h \
+    src/Callback/CallbackBoundingRects.h \
+    src/Callback/CallbackCheckAddPointAxis.h \
+    src/Callback/CallbackCheckEditPointAxis.h \
+    src/Callback/CallbackGatherXThetasAbstractBase.h \
+    src/Callback/CallbackGatherXThetasInCurves.h \
+    src/Callback/CallbackGatherXThetasInGridLines.h \
+    src/Callback/CallbackNextOrdinal.h \
+    src/Callback/CallbackPointOrdinal.h \
+    src/Callback/CallbackRemovePointsInCurvesGraphs.h \
+    src/Callback/CallbackUpdateTransform.h \
+    src/Checker/CheckerMode.h \
+    src/Color/ColorFilter.h \
+    src/Color/ColorFilterMode.h \
+    src/Color/ColorFilterSettings.h \
+    src/Color/ColorFilterSettingsStrategyAbstractBase.h \
+    src/Color/ColorFilterSettingsStrategyForeground.h \
+    src/Color/ColorFilterSettingsStrategyHue.h \
+    src/Color/ColorFilterSettingsStrategyIntensity.h \
+    src/Color/ColorFilterSettingsStrategySaturation.h \
+    src/Color/ColorFilterSettingsStrategyValue.h \
+    src/Color/ColorFilterStrategyAbstractBase.h \
+    src/Color/ColorFilterStrategyForeground.h \
+    src/Color/ColorFilterStrategyHue.h \
+    src/Color/ColorFilterStrategyIntensity.h \
+    src/Color/ColorFilterStrategySaturation.h \
+    src/Color/ColorFilterStrategyValue.h \
+    src/Color/ColorPalette.h \
+    src/util/Compatibility.h \
+    src/Coord/CoordScale.h \
+    src/Coord/CoordsType.h \
+    src/Coord/CoordSymbol.h \
+    src/CoordSystem/CoordSystem.h \
+    src/CoordSystem/CoordSystemContext.h \
+    src/CoordSystem/CoordSystemInterface.h \
+    src/Coord/CoordUnitsDate.h \
+    src/Coord/CoordUnitsNonPolarTheta.h \
+    src/Coord/CoordUnitsPolarTheta.h \
+    src/Coord/CoordUnitsTime.h \
+    src/Cursor/CursorSize.h \
+    src/Curve/Curve.h \
+    src/Curve/CurveConnectAs.h \
+    src/Curve/CurvesGraphs.h \
+    src/Curve/CurveStyle.h \
+    src/Curve/CurveStyles.h \
+    src/Document/Document.h \
+    src/Document/DocumentContainer.h \
+    src/Document/DocumentHash.h \
+    src/Document/DocumentModelAbstractBase.h \
+    src/Document/DocumentModelAxesChecker.h \
+    src/Document/DocumentModelColorFilter.h \
+    src/Document/DocumentModelCoords.h \
+    src/Document/DocumentModelDigitizeCurve.h \
+    src/Document/DocumentModelExportFormat.h \
+    src/Document/DocumentModelGeneral.h \
+    src/Document/DocumentModelGridDisplay.h \
+    src/Document/DocumentModelGridRemoval.h \
+    src/Document/DocumentModelGuideline.h \
+    src/Document/DocumentModelLoadViews.h \
+    src/Document/DocumentModelPointMatch.h \
+    src/Document/DocumentModelSegments.h \
+    src/Document/DocumentSerialize.h \
+    src/util/EnumsToQt.h \
+    src/Export/ExportAlignLinear.h \
+    src/Export/ExportAlignLog.h \
+    src/Export/ExportDelimiter.h \
+    src/Export/ExportFileAbstractBase.h \
+    src/Export/ExportFileExtensionOverride.h \
+    src/Export/ExportFileFunctions.h \
+    src/Export/ExportFileRelations.h \
+    src/Export/ExportFunctionFit.h \
+    src/Export/ExportHeader.h \
+    src/Export/ExportLayoutFunctions.h \
+    src/Export/ExportOrdinalsSmooth.h \
+    src/Export/ExportOrdinalsStraight.h \
+    src/Export/ExportPointsIntervalUnits.h \
+    src/Export/ExportPointsSelectionFunctions.h \
+    src/Export/ExportPointsSelectionRelations.h \
+    src/Export/ExportRelationFit.h \
+    src/Export/ExportToFile.h \
+    src/Export/ExportToFileBatch.h \
+    src/Export/ExportToFileNumpy.h \
+    src/Export/ExportValuesColumn.h \
+    src/Export/ExportXThetaValuesMergedFunctions.h \
+    src/Export/ExportZipStored.h \
+    src/Filter/FilterImage.h \
+    src/Format/FormatCoordsUnits.h \
+    src/Format/FormatCoordsUnitsStrategyAbstractBase.h \
+    src/Format/FormatCoordsUnitsStrategyNonPolarTheta.h \
+    src/Format/FormatCoordsUnitsStrategyPolarTheta.h \
+    src/Format/FormatDateTime.h \
+    src/Format/FormatDateTimeMatcher.h \
+    src/Format/FormatDegreesMinutesSecondsBase.h \
+    src/Format/FormatDegreesMinutesSecondsNonPolarTheta.h \
+    src/Format/FormatDegreesMinutesSecondsPolarTheta.h \
+    src/Format/FormatPrecisionPlan.h \
+    src/util/gnuplot.h \
+    src/Grid/GridCoordDisable.h \
+    src/Grid/GridHealerAbstractBase.h \
+    src/Grid/GridHealerHorizontal.h \
+    src/Grid/GridHealerVertical.h \
+    src/Grid/GridInitializer.h \
+    src/Grid/GridLineLimiter.h \
+    src/Grid/GridLog.h \
+    src/Grid/GridRemoval.h \
+    src/Grid/GridTriangleFill.h \
+    src/Import/ImportCropping.h \
+    src/Import/ImportCroppingUtilBase.h \
+    src/util/InactiveOpacity.h \
+    src/util/LinearToLog.h \
+    src/Line/LineStyle.h \
+    src/Load/LoadViews.h \
+    src/Logger/Logger.h \
+    src/Logger/LoggerUpload.h \
+    src/main/MainWindowModel.h \
+    src/util/MigrateToVersion6.h \
+    src/util/mmsubs.h \
+    src/Ordinal/OrdinalGenerator.h \
+    src/Pdf/PdfResolution.h \
+    src/util/Pixels.h \
+    src/Point/Point.h \
+    src/Point/PointMatchAlgorithm.h \
+    src/Point/PointMatchPixel.h \
+    src/Point/PointMatchTriplet.h \
+    src/Point/PointShape.h \
+    src/Point/PointStyle.h \
+    src/util/QtToString.h \
+    src/Settings/Settings.h \
+    src/Settings/SettingsForGraph.h \
+    src/Spline/Spline.h \
+    src/Spline/SplineArcLength.h \
+    src/Spline/SplineArcLengthCache.h \
+    src/Spline/SplineCoeff.h \
+    src/Spline/SplinePair.h \
+    src/Transformation/Transformation.h \
+    src/util/UrlDirty.h \
+    src/util/Version.h \
+    src/util/Xml.h
+
+SOURCES  += \
+    src/Callback/CallbackAddPointsInCurvesGraphs.cpp \
+    src/Callback/CallbackAxisPointsAbstract.cpp \
+    src/Callback/CallbackBoundingRects.cpp \
+    src/Callback/CallbackCheckAddPointAxis.cpp \
+    src/Callback/CallbackCheckEditPointAxis.cpp \
+    src/Callback/CallbackGatherXThetasAbstractBase.cpp \
+    src/Callback/CallbackGatherXThetasInCurves.cpp \
+    src/Callback/CallbackGatherXThetasInGridLines.cpp \
+    src/Callback/CallbackNextOrdinal.cpp \
+    src/Callback/CallbackPointOrdinal.cpp \
+    src/Callback/CallbackRemovePointsInCurvesGraphs.cpp \
+    src/Callback/CallbackUpdateTransform.cpp \
+    src/Checker/CheckerMode.cpp \
+    src/Color/ColorFilter.cpp \
+    src/Color/ColorFilterMode.cpp \
+    src/Color/ColorFilterSettings.cpp \
+    src/Color/ColorFilterSettingsStrategyAbstractBase.cpp \
+    src/Color/ColorFilterSettingsStrategyForeground.cpp \
+    src/Color/ColorFilterSettingsStrategyHue.cpp \
+    src/Color/ColorFilterSettingsStrategyIntensity.cpp \
+    src/Color/ColorFilterSettingsStrategySaturation.cpp \
+    src/Color/ColorFilterSettingsStrategyValue.cpp \
+    src/Color/ColorFilterStrategyAbstractBase.cpp \
+    src/Color/ColorFilterStrategyForeground.cpp \
+    src/Color/ColorFilterStrategyHue.cpp \
+    src/Color/ColorFilterStrategyIntensity.cpp \
+    src/Color/ColorFilterStrategySaturation.cpp \
+    src/Color/ColorFilterStrategyValue.cpp \
+    src/Color/ColorPalette.cpp \
+    src/util/Compatibility.cpp \
+    src/Coord/CoordScale.cpp \
+    src/Coord/CoordsType.cpp \
+    src/Coord/CoordSymbol.cpp \
+    src/CoordSystem/CoordSystem.cpp \
+    src/CoordSystem/CoordSystemContext.cpp \
+    src/CoordSystem/CoordSystemInterface.cpp \
+    src/Coord/CoordUnitsDate.cpp \
+    src/Coord/CoordUnitsNonPolarTheta.cpp \
+    src/Coord/CoordUnitsPolarTheta.cpp \
+    src/Coord/CoordUnitsTime.cpp \
+    src/Cursor/CursorSize.cpp \
+    src/Curve/Curve.cpp \
+    src/Curve/CurveConnectAs.cpp \
+    src/Curve/CurvesGraphs.cpp \
+    src/Curve/CurveStyle.cpp \
+    src/Curve/CurveStyles.cpp \
+    src/Document/Document.cpp \
+    src/Document/DocumentContainer.cpp \
+    src/Document/DocumentHash.cpp \
+    src/Document/DocumentModelAbstractBase.cpp \
+    src/Document/DocumentModelAxesChecker.cpp \
+    src/Document/DocumentModelColorFilter.cpp \
+    src/Document/DocumentModelCoords.cpp \
+    src/Document/DocumentModelDigitizeCurve.cpp \
+    src/Document/DocumentModelExportFormat.cpp \
+    src/Document/DocumentModelGeneral.cpp \
+    src/Document/DocumentModelGridDisplay.cpp \
+    src/Document/DocumentModelGridRemoval.cpp \
+    src/Document/DocumentModelGuideline.cpp \
+    src/Document/DocumentModelLoadViews.cpp \
+    src/Document/DocumentModelPointMatch.cpp \
+    src/Document/DocumentModelSegments.cpp \
+    src/Document/DocumentSerialize.cpp \
+    src/util/EnumsToQt.cpp \
+    src/Export/ExportAlignLinear.cpp \
+    src/Export/ExportAlignLog.cpp \
+    src/Export/ExportDelimiter.cpp \
+    src/Export/ExportFileAbstractBase.cpp \
+    src/Export/ExportFileExtensionOverride.cpp \
+    src/Export/ExportFileFunctions.cpp \
+    src/Export/ExportFileRelations.cpp \
+    src/Export/ExportFunctionFit.cpp \
+    src/Export/ExportHeader.cpp \
+    src/Export/ExportLayoutFunctions.cpp \
+    src/Export/ExportOrdinalsSmooth.cpp \
+    src/Export/ExportOrdinalsStraight.cpp \
+    src/Export/ExportPointsIntervalUnits.cpp \
+    src/Export/ExportPointsSelectionFunctions.cpp \
+    src/Export/ExportPointsSelectionRelations.cpp \
+    src/Export/ExportRelationFit.cpp \
+    src/Export/ExportToFile.cpp \
+    src/Export/ExportToFileBatch.cpp \
+    src/Export/ExportToFileNumpy.cpp \
+    src/Export/ExportValuesColumn.cpp \
+    src/Export/ExportXThetaValuesMergedFunctions.cpp \
+    src/Export/ExportZipStored.cpp \
+    src/Filter/FilterImage.cpp \
+    src/Format/FormatCoordsUnits.cpp \
+    src/Format/FormatCoordsUnitsStrategyAbstractBase.cpp \
+    src/Format/FormatCoordsUnitsStrategyNonPolarTheta.cpp \
+    src/Format/FormatCoordsUnitsStrategyPolarTheta.cpp \
+    src/Format/FormatDateTime.cpp \
+    src/Format/FormatDateTimeMatcher.cpp \
+    src/Format/FormatDegreesMinutesSecondsBase.cpp \
+    src/Format/FormatDegreesMinutesSecondsNonPolarTheta.cpp \
+    src/Format/FormatDegreesMinutesSecondsPolarTheta.cpp \
+    src/Format/FormatPrecisionPlan.cpp \
+    src/util/gnuplot.cpp \
+    src/Grid/GridCoordDisable.cpp \
+    src/Grid/GridHealerAbstractBase.cpp \
+    src/Grid/GridHealerHorizontal.cpp \
+    src/Grid/GridHealerVertical.cpp \
+    src/Grid/GridInitializer.cpp \
+    src/Grid/GridLineLimiter.cpp \
+    src/Grid/GridLog.cpp \
+    src/Grid/GridRemoval.cpp \
+    src/Grid/GridTriangleFill.cpp \
+    src/Import/ImportCropping.cpp \
+    src/Import/ImportCroppingUtilBase.cpp \
+    src/util/InactiveOpacity.cpp \
+    src/util/LinearToLog.cpp \
+    src/Line/LineStyle.cpp \
+    src/Load/LoadViews.cpp \
+    src/Logger/Logger.cpp \
+    src/Logger/LoggerUpload.cpp \
+    src/main/MainWindowModel.cpp \
+    src/util/MigrateToVersion6.cpp \
+    src/util/mmsubs.cpp \
+    src/Ordinal/OrdinalGenerator.cpp \
+    src/Pdf/PdfResolution.cpp \
+    src/util/Pixels.cpp \
+    src/Point/Point.cpp \
+    src/Point/PointMatchAlgorithm.cpp \
+    src/Point/PointMatchPixel.cpp \
+    src/Point/PointMatchTriplet.cpp \
+    src/Point/PointShape.cpp \
+    src/Point/PointStyle.cpp \
+    src/util/QtToString.cpp \
+    src/Settings/Settings.cpp \
+    src/Settings/SettingsForGraph.cpp \
+    src/Spline/Spline.cpp \
+    src/Spline/SplineArcLength.cpp \
+    src/Spline/SplineArcLengthCache.cpp \
+    src/Spline/SplineCoeff.cpp \
+    src/Spline/SplinePair.cpp \
+    src/Transformation/Transformation.cpp \
+    src/util/UrlDirty.cpp \
+    src/util/Version.cpp \
+    src/util/Xml.cpp
+
+# PointMatchAlgorithm uses fftw, so applications linking this library also need -lfftw3
+INCLUDEPATH += $$(FFTW_HOME)/include
+
+INCLUDEPATH += src \
+               src/Callback \
+               src/Checker \
+               src/Color \
+               src/Coord \
+               src/CoordSystem \
+               src/Cursor \
+               src/Curve \
+               src/Document \
+               src/Export \
+               src/Filter \
+               src/Fitting \
+               src/Format \
+               src/Grid \
+               src/Guideline \
+               src/Import \
+               src/include \
+               src/Line \
+               src/Load \
+               src/Logger \
+               src/main \
+               src/Ordinal \
+               src/Pdf \
+               src/Point \
+               src/Settings \
+               src/Spline \
+               src/Transformation \
+               src/util \
+               src/Zoom
@@ -7,6 +7,7 @@
 #include "BackgroundStateAbstractBase.h"
 #include "DataKey.h"
 #include "EngaugeAssert.h"
+#include "GraphicsImageTiled.h"
 #include "GraphicsItemType.h"
 #include "GraphicsScene.h"
 #include "Logger.h"
@@ -19,8 +20,8 @@ BackgroundStateAbstractBase::BackgroundStateAbstractBase(BackgroundStateContext
   m_imageItem (nullptr)
 {
   // Create an image but do not show it until the appropriate state is reached
-  QPixmap dummy;
-  m_imageItem = m_scene.addPixmap (dummy);
+  QImage dummy;
+  m_imageItem = m_scene.addImage (dummy);
   m_imageItem->setVisible (false);
   m_imageItem->setZValue (Z_VALUE_BACKGROUND);
   m_imageItem->setData (DATA_KEY_IDENTIFIER, "view");
@@ -46,7 +47,7 @@ QImage BackgroundStateAbstractBase::image () const
   return m_image;
 }
 
-QGraphicsPixmapItem &BackgroundStateAbstractBase::imageItem () const
+GraphicsImageTiled &BackgroundStateAbstractBase::imageItem () const
 {
   return *m_imageItem;
 }
@@ -61,20 +62,26 @@ const GraphicsScene &BackgroundStateAbstractBase::scene() const
   return m_scene;
 }
 
+void BackgroundStateAbstractBase::setCacheMegabytes (int cacheMegabytes)
+{
+  m_imageItem->setCacheMegabytes (cacheMegabytes);
+}
+
 void BackgroundStateAbstractBase::setImageVisible (bool visible)
 {
   m_imageItem->setVisible (visible);
 }
 
-void BackgroundStateAbstractBase::setProcessedPixmap (const QPixmap &pixmap)
+void BackgroundStateAbstractBase::setProcessedImage (const QImage &image)
 {
 
   ENGAUGE_CHECK_PTR(m_imageItem);
 
-  m_imageItem->setPixmap (pixmap);
+  // Image item keeps the image, and converts just the visible tiles to pixmaps
+  m_image = image;
+
+  m_imageItem->setImage (m_image);
 
   // Reset scene rectangle or else small image after large image will be off-center
   m_scene.setSceneRect (m_imageItem->boundingRect ());
-
-  m_image = pixmap.toImage();
 }
@@ -7,7 +7,6 @@
 #ifndef BACKGROUND_STATE_ABSTRACT_BASE_H
 #define BACKGROUND_STATE_ABSTRACT_BASE_H
 
-#include <QGraphicsPixmapItem>
 #include <QImage>
 
 /// Set of possible states of background image.
@@ -22,6 +21,7 @@ enum BackgroundState {
 class BackgroundStateContext;
 class DocumentModelColorFilter;
 class DocumentModelGridRemoval;
+class GraphicsImageTiled;
 class GraphicsScene;
 class GraphicsView;
 class Transformation;
@@ -54,7 +54,7 @@ class BackgroundStateAbstractBase
   QImage image () const;
 
   /// Graphics image item for the current state
-  QGraphicsPixmapItem &imageItem () const;
+  GraphicsImageTiled &imageItem () const;
 
   /// Reference to the GraphicsScene, without const.
   GraphicsScene &scene();
@@ -62,6 +62,9 @@ class BackgroundStateAbstractBase
   /// Reference to the GraphicsScene, without const.
   const GraphicsScene &scene() const;
 
+  /// Update the maximum size of the tile cache of the image item
+  void setCacheMegabytes (int cacheMegabytes);
+
   /// Update the currently selected curve name
   virtual void setCurveSelected (bool isGnuplot,
                                  const Transformation &transformation,
@@ -70,12 +73,12 @@ class BackgroundStateAbstractBase
                                  const QString &curveSelected) = 0;
 
   /// Update the image for this state, after the leaf class processes it appropriately
-  virtual void setPixmap (bool isGnuplot,
-                          const Transformation &transformation,
-                          const DocumentModelGridRemoval &modelGridRemoval,
-                          const DocumentModelColorFilter &modelColorFilter,
-                          const QPixmap &pixmap,
-                          const QString &curveSelected) = 0;
+  virtual void setImage (bool isGnuplot,
+                         const Transformation &transformation,
+                         const DocumentModelGridRemoval &modelGridRemoval,
+                         const DocumentModelColorFilter &modelColorFilter,
+                         const QImage &image,
+                         const QString &curveSelected) = 0;
 
   /// State name for debugging
   virtual QString state() const = 0;
@@ -93,7 +96,7 @@ class BackgroundStateAbstractBase
   void setImageVisible (bool visible);
 
   /// Save the image for this state after it has been processed by the leaf class
-  void setProcessedPixmap (const QPixmap &pixmap);
+  void setProcessedImage (const QImage &image);
 
  private:
   BackgroundStateAbstractBase();
@@ -102,10 +105,10 @@ class BackgroundStateAbstractBase
   GraphicsScene &m_scene;
 
   // Each state has its own image, although only one is shown at a time. This is null if an image has not been defined yet,
-  // so we can eliminate a dependency on the ordering of the state transitions and the update of the image by setPixmap
-  QGraphicsPixmapItem *m_imageItem;
+  // so we can eliminate a dependency on the ordering of the state transitions and the update of the image by setImage
+  GraphicsImageTiled *m_imageItem;
 
-  QImage m_image; // Original image. This is stored in addition to m_imageItem since m_imageItem cannot be used when invisible
+  QImage m_image; // Processed image. This shares its pixels with m_imageItem, so the image is not stored twice
 };
 
 #endif // BACKGROUND_STATE_ABSTRACT_BASE_H
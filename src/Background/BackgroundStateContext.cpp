@@ -12,10 +12,10 @@
 #include "DocumentModelColorFilter.h"
 #include "DocumentModelGridRemoval.h"
 #include "EngaugeAssert.h"
+#include "GraphicsImageTiled.h"
 #include "GraphicsView.h"
 #include "Logger.h"
 #include "MainWindow.h"
-#include <QGraphicsPixmapItem>
 #include "Transformation.h"
 
 BackgroundStateContext::BackgroundStateContext(MainWindow &mainWindow) :
@@ -72,7 +72,7 @@ void BackgroundStateContext::fitInView (GraphicsView &view)
   // After initialization, we should be in unloaded state or some other equally valid state
   ENGAUGE_ASSERT (m_currentState != NUM_BACKGROUND_STATES);
 
-  const QGraphicsPixmapItem *imageItem = &m_states [BACKGROUND_STATE_CURVE]->imageItem ();
+  const GraphicsImageTiled *imageItem = &m_states [BACKGROUND_STATE_CURVE]->imageItem ();
 
   double width = imageItem->boundingRect().width();
   double height = imageItem->boundingRect().height();
@@ -134,22 +134,30 @@ void BackgroundStateContext::setCurveSelected (bool isGnuplot,
   }
 }
 
-void BackgroundStateContext::setPixmap (bool isGnuplot,
-                                        const Transformation &transformation,
-                                        const DocumentModelGridRemoval &modelGridRemoval,
-                                        const DocumentModelColorFilter &modelColorFilter,
-                                        const QPixmap &pixmapOriginal,
-                                        const QString &curveSelected)
+void BackgroundStateContext::setImage (bool isGnuplot,
+                                       const Transformation &transformation,
+                                       const DocumentModelGridRemoval &modelGridRemoval,
+                                       const DocumentModelColorFilter &modelColorFilter,
+                                       const QImage &imageOriginal,
+                                       const QString &curveSelected)
 {
 
   for (int backgroundState = 0; backgroundState < NUM_BACKGROUND_STATES; backgroundState++) {
 
-    m_states [backgroundState]->setPixmap (isGnuplot,
-                                           transformation,
-                                           modelGridRemoval,
-                                           modelColorFilter,
-                                           pixmapOriginal,
-                                           curveSelected);
+    m_states [backgroundState]->setImage (isGnuplot,
+                                          transformation,
+                                          modelGridRemoval,
+                                          modelColorFilter,
+                                          imageOriginal,
+                                          curveSelected);
+  }
+}
+
+void BackgroundStateContext::setTileCacheMegabytes (int tileCacheMegabytes)
+{
+  for (int backgroundState = 0; backgroundState < NUM_BACKGROUND_STATES; backgroundState++) {
+
+    m_states [backgroundState]->setCacheMegabytes (tileCacheMegabytes);
   }
 }
 
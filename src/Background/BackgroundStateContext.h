@@ -15,7 +15,6 @@ class DocumentModelColorFilter;
 class DocumentModelGridRemoval;
 class GraphicsView;
 class MainWindow;
-class QGraphicsPixmapItem;
 class Transformation;
 
 /// Context class that manages the background image state machine.
@@ -54,7 +53,7 @@ class BackgroundStateContext
   void setBackgroundImage (BackgroundImage backgroundImage);
 
   /// Update the selected curve. Although this probably affects only the BACKGROUND_STATE_CURVE state, we will forward it
-  /// to all states (consistent with setPixmap)
+  /// to all states (consistent with setImage)
   void setCurveSelected (bool isGnuplot,
                          const Transformation &transformation,
                          const DocumentModelGridRemoval &modelGridRemoval,
@@ -62,12 +61,15 @@ class BackgroundStateContext
                          const QString &curveSelected);
 
   /// Update the images of all states, rather than just the current state
-  void setPixmap (bool isGnuplot,
-                  const Transformation &transformation,
-                  const DocumentModelGridRemoval &modelGridRemoval,
-                  const DocumentModelColorFilter &modelColorFilter,
-                  const QPixmap &pixmapOriginal,
-                  const QString &curveSelected);
+  void setImage (bool isGnuplot,
+                 const Transformation &transformation,
+                 const DocumentModelGridRemoval &modelGridRemoval,
+                 const DocumentModelColorFilter &modelColorFilter,
+                 const QImage &imageOriginal,
+                 const QString &curveSelected);
+
+  /// Update the maximum size of the tile cache of each state's image
+  void setTileCacheMegabytes (int tileCacheMegabytes);
 
   /// Apply color filter settings
   void updateColorFilter (bool isGnuplot,
@@ -9,10 +9,11 @@
 #include "DocumentModelColorFilter.h"
 #include "DocumentModelGridRemoval.h"
 #include "FilterImage.h"
+#include "GraphicsImageTiled.h"
 #include "GraphicsScene.h"
 #include "GraphicsView.h"
 #include "Logger.h"
-#include <QPixmap>
+#include <QImage>
 #include "Transformation.h"
 
 BackgroundStateCurve::BackgroundStateCurve(BackgroundStateContext &context,
@@ -52,19 +53,19 @@ void BackgroundStateCurve::processImageFromSavedInputs (bool isGnuplot,
 
     // Generate filtered image
     FilterImage filterImage;
-    QPixmap pixmapFiltered = filterImage.filter (isGnuplot,
-                                                 m_pixmapOriginal.toImage(),
-                                                 transformation,
-                                                 curveSelected,
-                                                 modelColorFilter,
-                                                 modelGridRemoval);
+    QImage imageFiltered = filterImage.filter (isGnuplot,
+                                               m_imageOriginal,
+                                               transformation,
+                                               curveSelected,
+                                               modelColorFilter,
+                                               modelGridRemoval);
 
-    setProcessedPixmap (pixmapFiltered);
+    setProcessedImage (imageFiltered);
 
   } else {
 
     // Set the image in case BackgroundStateContext::fitInView is called, so the bounding rect is available
-    setProcessedPixmap (m_pixmapOriginal);
+    setProcessedImage (m_imageOriginal);
 
   }
 }
@@ -85,15 +86,15 @@ void BackgroundStateCurve::setCurveSelected (bool isGnuplot,
                                curveSelected);
 }
 
-void BackgroundStateCurve::setPixmap (bool isGnuplot,
-                                      const Transformation &transformation,
-                                      const DocumentModelGridRemoval &modelGridRemoval,
-                                      const DocumentModelColorFilter &modelColorFilter,
-                                      const QPixmap &pixmapOriginal,
-                                      const QString &curveSelected)
+void BackgroundStateCurve::setImage (bool isGnuplot,
+                                     const Transformation &transformation,
+                                     const DocumentModelGridRemoval &modelGridRemoval,
+                                     const DocumentModelColorFilter &modelColorFilter,
+                                     const QImage &imageOriginal,
+                                     const QString &curveSelected)
 {
 
-  m_pixmapOriginal = pixmapOriginal;
+  m_imageOriginal = imageOriginal; // Shares its pixels with the Document image
   processImageFromSavedInputs (isGnuplot,
                                transformation,
                                modelGridRemoval,
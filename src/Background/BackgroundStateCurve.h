@@ -25,12 +25,12 @@ class BackgroundStateCurve : public BackgroundStateAbstractBase
                                  const DocumentModelGridRemoval &modelGridRemoval,
                                  const DocumentModelColorFilter &colorFilter,
                                  const QString &curveSelected);
-  virtual void setPixmap (bool isGnuplot,
-                          const Transformation &transformation,
-                          const DocumentModelGridRemoval &modelGridRemoval,
-                          const DocumentModelColorFilter &modelColorFilter,
-                          const QPixmap &pixmapOriginal,
-                          const QString &curveSelected);
+  virtual void setImage (bool isGnuplot,
+                         const Transformation &transformation,
+                         const DocumentModelGridRemoval &modelGridRemoval,
+                         const DocumentModelColorFilter &modelColorFilter,
+                         const QImage &imageOriginal,
+                         const QString &curveSelected);
   virtual QString state () const;
   virtual void updateColorFilter (bool isGnuplot,
                                   const Transformation &transformation,
@@ -48,7 +48,7 @@ class BackgroundStateCurve : public BackgroundStateAbstractBase
                                    const QString &curveSelected);
 
   // Data saved for use by processImageFromSavedInputs
-  QPixmap m_pixmapOriginal;
+  QImage m_imageOriginal;
 };
 
 #endif // BACKGROUND_STATE_CURVE_H
@@ -8,10 +8,11 @@
 #include "BackgroundStateNone.h"
 #include "DocumentModelColorFilter.h"
 #include "DocumentModelGridRemoval.h"
+#include "GraphicsImageTiled.h"
 #include "GraphicsScene.h"
 #include "GraphicsView.h"
 #include "Logger.h"
-#include <QPixmap>
+#include <QImage>
 
 BackgroundStateNone::BackgroundStateNone(BackgroundStateContext &context,
                                          GraphicsScene &scene) :
@@ -46,18 +47,22 @@ void BackgroundStateNone::setCurveSelected (bool /* isGnuplot */,
 {
 }
 
-void BackgroundStateNone::setPixmap (bool /* isGnuplot */,
-                                     const Transformation & /* transformation */,
-                                     const DocumentModelGridRemoval & /* modelGridRemoval */,
-                                     const DocumentModelColorFilter & /* modelColorFilter */,
-                                     const QPixmap &pixmapOriginal,
-                                     const QString & /* curveSelected */)
+void BackgroundStateNone::setImage (bool /* isGnuplot */,
+                                    const Transformation & /* transformation */,
+                                    const DocumentModelGridRemoval & /* modelGridRemoval */,
+                                    const DocumentModelColorFilter & /* modelColorFilter */,
+                                    const QImage &imageOriginal,
+                                    const QString & /* curveSelected */)
 {
 
-  // Empty background
-  QPixmap pixmapNone (pixmapOriginal);
-  pixmapNone.fill (Qt::white);
-  setProcessedPixmap (pixmapNone);
+  // Empty background. One bit per pixel is enough for a single color, so this takes little memory even for a huge image
+  QImage imageNone (imageOriginal.size (),
+                    QImage::Format_Mono);
+  if (!imageNone.isNull ()) {
+    imageNone.setColor (0, qRgb (255, 255, 255));
+    imageNone.fill (0);
+  }
+  setProcessedImage (imageNone);
 
 }
 
@@ -8,10 +8,11 @@
 #include "BackgroundStateOriginal.h"
 #include "DocumentModelColorFilter.h"
 #include "DocumentModelGridRemoval.h"
+#include "GraphicsImageTiled.h"
 #include "GraphicsScene.h"
 #include "GraphicsView.h"
 #include "Logger.h"
-#include <QPixmap>
+#include <QImage>
 #include "Transformation.h"
 
 BackgroundStateOriginal::BackgroundStateOriginal(BackgroundStateContext &context,
@@ -47,16 +48,16 @@ void BackgroundStateOriginal::setCurveSelected (bool /* isGnuplot */,
 {
 }
 
-void BackgroundStateOriginal::setPixmap (bool /* isGnuplot */,
-                                         const Transformation & /* transformation */,
-                                         const DocumentModelGridRemoval & /* modelGridRemoval */,
-                                         const DocumentModelColorFilter & /* modelColorFilter */,
-                                         const QPixmap &pixmapOriginal,
-                                         const QString & /* curveSelected */)
+void BackgroundStateOriginal::setImage (bool /* isGnuplot */,
+                                        const Transformation & /* transformation */,
+                                        const DocumentModelGridRemoval & /* modelGridRemoval */,
+                                        const DocumentModelColorFilter & /* modelColorFilter */,
+                                        const QImage &imageOriginal,
+                                        const QString & /* curveSelected */)
 {
 
   // Unfiltered original image
-  setProcessedPixmap (pixmapOriginal);
+  setProcessedImage (imageOriginal);
 }
 
 QString BackgroundStateOriginal::state () const
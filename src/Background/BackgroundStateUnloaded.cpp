@@ -11,7 +11,7 @@
 #include "GraphicsScene.h"
 #include "GraphicsView.h"
 #include "Logger.h"
-#include <QPixmap>
+#include <QImage>
 
 BackgroundStateUnloaded::BackgroundStateUnloaded(BackgroundStateContext &context,
                                                  GraphicsScene &scene) :
@@ -40,12 +40,12 @@ void BackgroundStateUnloaded::setCurveSelected (bool /* isGnuplot */,
 {
 }
 
-void BackgroundStateUnloaded::setPixmap (bool /* isGnuplot */,
-                                         const Transformation & /* transformation */,
-                                         const DocumentModelGridRemoval & /* modelGridRemoval */,
-                                         const DocumentModelColorFilter & /* modelColorFilter */,
-                                         const QPixmap & /* pixmap */,
-                                         const QString & /* curveSelected */)
+void BackgroundStateUnloaded::setImage (bool /* isGnuplot */,
+                                        const Transformation & /* transformation */,
+                                        const DocumentModelGridRemoval & /* modelGridRemoval */,
+                                        const DocumentModelColorFilter & /* modelColorFilter */,
+                                        const QImage & /* image */,
+                                        const QString & /* curveSelected */)
 {
 
   // This state has no displayed image
@@ -25,12 +25,12 @@ class BackgroundStateUnloaded : public BackgroundStateAbstractBase
                                  const DocumentModelGridRemoval &modelGridRemoval,
                                  const DocumentModelColorFilter &colorFilter,
                                  const QString &curveSelected);
-  virtual void setPixmap (bool isGnuplot,
-                          const Transformation &transformation,
-                          const DocumentModelGridRemoval &modelGridRemoval,
-                          const DocumentModelColorFilter &modelColorFilter,
-                          const QPixmap &pixmap,
-                          const QString &curveSelected);
+  virtual void setImage (bool isGnuplot,
+                         const Transformation &transformation,
+                         const DocumentModelGridRemoval &modelGridRemoval,
+                         const DocumentModelColorFilter &modelColorFilter,
+                         const QImage &image,
+                         const QString &curveSelected);
   virtual QString state () const;
   virtual void updateColorFilter (bool isGnuplot,
                                   const Transformation &transformation,
@@ -17,7 +17,7 @@ CallbackAddPointsInCurvesGraphs::CallbackAddPointsInCurvesGraphs(CoordSystem &co
 CallbackSearchReturn CallbackAddPointsInCurvesGraphs::callback (const QString &curveName,
                                                                 const Point &point)
 {
-  const QString identifier = point.identifier ();
+  const QString identifier = point.identifier (curveName);
 
   if (curveName == AXIS_CURVE_NAME) {
     m_coordSystem.addPointAxisWithSpecifiedIdentifier (point.posScreen (),
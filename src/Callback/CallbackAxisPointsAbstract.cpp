@@ -80,13 +80,13 @@ bool CallbackAxisPointsAbstract::anyPointsRepeatSingle (const CoordSingleVector
   return false;
 }
 
-CallbackSearchReturn CallbackAxisPointsAbstract::callback (const QString & /* curveName */,
+CallbackSearchReturn CallbackAxisPointsAbstract::callback (const QString &curveName,
                                                            const Point &point)
 {
   QPointF posScreen = point.posScreen ();
   QPointF posGraph = point.posGraph ();
 
-  if (m_pointIdentifierOverride == point.identifier ()) {
+  if (m_pointIdentifierOverride == point.identifier (curveName)) {
 
     // Override the old point coordinates with its new (if all tests are passed) coordinates
     posScreen = m_posScreenOverride;
@@ -8,13 +8,11 @@
 #include "EngaugeAssert.h"
 #include "Logger.h"
 #include "Point.h"
-#include <QCryptographicHash>
-#include "QtToString.h"
-#include "Transformation.h"
 
-CallbackDocumentHash::CallbackDocumentHash(DocumentAxesPointsRequired documentAxesPointsRequired) :
+CallbackDocumentHash::CallbackDocumentHash(DocumentAxesPointsRequired documentAxesPointsRequired,
+                                           DocumentHash documentHash) :
   m_documentAxesPointsRequired (documentAxesPointsRequired),
-  m_documentHash (QCryptographicHash::Md5)
+  m_documentHash (documentHash)
 {
 }
 
@@ -22,57 +20,45 @@ CallbackDocumentHash::~CallbackDocumentHash()
 {
 }
 
-CallbackSearchReturn CallbackDocumentHash::callback (const QString &curveName,
+CallbackSearchReturn CallbackDocumentHash::callback (const QString & /* curveName */,
                                                      const Point &point)
 {
-  // Capture all important information about the point into the hash. A single string representing all of the point's details is
-  // created, which can be logged, and then that string is added to the hash
-
-  QString details;
-
-  details += curveName.toLatin1();
-  details += " " + point.identifier ();
-  details += " " + QPointFToString (point.posScreen());
-
-  if (point.hasOrdinal ()) {
-    details += " " + QString::number (point.ordinal ());
-  }
+  // Identifier, screen position and ordinal are already in the curve digests, so only the graph coordinates that
+  // are meaningful for this axis point are added here
 
   if (point.isAxisPoint()) {
 
     switch (m_documentAxesPointsRequired) {
     case DOCUMENT_AXES_POINTS_REQUIRED_2:
       // Axis point has same value for both coordinates so we chose one coordinate
-      details += " " + QString::number (point.posGraph().x());
+      m_documentHash = documentHashMix (m_documentHash, point.posGraph().x());
       break;
 
     case DOCUMENT_AXES_POINTS_REQUIRED_3:
       // Axis point has two coordinates
-      details += " " + QPointFToString (point.posGraph());
+      m_documentHash = documentHashMix (m_documentHash, point.posGraph().x());
+      m_documentHash = documentHashMix (m_documentHash, point.posGraph().y());
       break;
 
     case DOCUMENT_AXES_POINTS_REQUIRED_4:
       // Axis point has one coordinate
       if (point.isXOnly()) {
 
-        details += " " + QString::number (point.posGraph().x());
+        m_documentHash = documentHashMix (m_documentHash, point.posGraph().x());
 
       } else {
 
-        details += " " + QString::number (point.posGraph().y());
+        m_documentHash = documentHashMix (m_documentHash, point.posGraph().y());
 
       }
       break;
     }
   }
 
-  // Add details to hash
-  m_documentHash.addData (details.toLatin1());
-
   return CALLBACK_SEARCH_RETURN_CONTINUE;
 }
 
 DocumentHash CallbackDocumentHash::hash () const
 {
-  return m_documentHash.result ();
+  return m_documentHash;
 }
@@ -10,17 +10,18 @@
 #include "CallbackSearchReturn.h"
 #include "DocumentAxesPointsRequired.h"
 #include "DocumentHash.h"
-#include <QCryptographicHash>
 #include <QString>
 
 class Point;
 
-/// Callback for DocumentHash value for a Document
+/// Callback that adds the graph coordinates of the axis points to a DocumentHash. Everything else about the points is
+/// already in the digests that the Curves keep up to date, and there are only a few axis points
 class CallbackDocumentHash
 {
 public:
-  /// Single constructor
-  CallbackDocumentHash(DocumentAxesPointsRequired documentAxesPointsRequired);
+  /// Single constructor, starting from the digest of the curves
+  CallbackDocumentHash(DocumentAxesPointsRequired documentAxesPointsRequired,
+                       DocumentHash documentHash);
   virtual ~CallbackDocumentHash ();
 
   /// Callback method.
@@ -34,7 +35,7 @@ private:
   CallbackDocumentHash();
 
   const DocumentAxesPointsRequired m_documentAxesPointsRequired;
-  QCryptographicHash m_documentHash;
+  DocumentHash m_documentHash;
 };
 
 #endif // CALLBACK_BOUNDING_HASH_H
@@ -21,16 +21,16 @@ QString CallbackDocumentScrub::badPointName () const
   return m_badPointName;
 }
 
-CallbackSearchReturn CallbackDocumentScrub::callback (const QString & /* curveName */,
+CallbackSearchReturn CallbackDocumentScrub::callback (const QString &curveName,
                                                       const Point &point)
 {
-  QString identifier = point.identifier ();
+  QString identifier = point.identifier (curveName);
 
   QStringList fields = identifier.split (POINT_IDENTIFIER_DELIMITER_SAFE);
 
   bool successBefore = m_success;
 
-  // Required format is defined by Point::temporaryPointIdentifier and Point::uniqueIdentifierGenerator
+  // Required format is defined by Point::temporaryPointIdentifier and Point::identifier
   if (fields.size () == 2) {
 
     // Temporary point
@@ -62,7 +62,7 @@ CallbackSearchReturn CallbackDocumentScrub::callback (const QString & /* curveNa
   }
 
   if (!m_success && successBefore) {
-    m_badPointName = point.identifier ();
+    m_badPointName = identifier;
   }
 
   return (m_success ? CALLBACK_SEARCH_RETURN_CONTINUE :
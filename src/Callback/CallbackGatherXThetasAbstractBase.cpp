@@ -11,8 +11,13 @@
 #include "ExportAlignLog.h"
 #include "ExportLayoutFunctions.h"
 #include "ExportPointsSelectionFunctions.h"
+#include <functional>
 #include "Logger.h"
 #include "Point.h"
+#include <queue>
+#include <QVector>
+#include <utility>
+#include <vector>
 
 CallbackGatherXThetasAbstractBase::CallbackGatherXThetasAbstractBase(bool firstCurveOnly,
                                                                      bool extrapolateOutsideEndpoints,
@@ -44,7 +49,14 @@ CallbackGatherXThetasAbstractBase::~CallbackGatherXThetasAbstractBase()
 
 void CallbackGatherXThetasAbstractBase::addGraphX (double xGraph)
 {
-  m_xThetaValues [xGraph] = true;
+  // Start a new run when the value would break the increasing order, like at the start of the next curve
+  if (m_xThetaRuns.isEmpty () ||
+      xGraph < m_xThetaRuns.last ().last ()) {
+
+    m_xThetaRuns.append (ExportValuesXOrY ());
+  }
+
+  m_xThetaRuns.last ().append (xGraph);
 }
 
 CurveLimits CallbackGatherXThetasAbstractBase::curveLimitsMax () const
@@ -99,8 +111,43 @@ void CallbackGatherXThetasAbstractBase::updateMinMax (const QString &curveName,
   }
 }
 
-ValuesVectorXOrY CallbackGatherXThetasAbstractBase::xThetaValuesRaw () const
+ExportValuesXOrY CallbackGatherXThetasAbstractBase::xThetaValuesRaw () const
 {
+  // Merge the runs with a heap holding the next value of each run, so the total work is linear in the number of
+  // values for the usual handful of runs. Each heap entry is the value and the run it came from
+  typedef std::pair<double, int> HeapEntry;
+  std::priority_queue<HeapEntry, std::vector<HeapEntry>, std::greater<HeapEntry> > heap;
+
+  QVector<int> nextIndexes (m_xThetaRuns.count (), 0);
+  int totalCount = 0;
+  for (int run = 0; run < m_xThetaRuns.count (); run++) {
+    heap.push (HeapEntry (m_xThetaRuns.at (run).first (),
+                          run));
+    totalCount += m_xThetaRuns.at (run).count ();
+  }
+
+  ExportValuesXOrY xThetaValues;
+  xThetaValues.reserve (totalCount);
+  while (!heap.empty ()) {
+
+    HeapEntry entry = heap.top ();
+    heap.pop ();
+
+    // Values arrive in nondecreasing order, so a value is new only if it is greater than the value appended last.
+    // Duplicates are exact matches, as they were when the values were QMap keys
+    if (xThetaValues.isEmpty () ||
+        entry.first > xThetaValues.last ()) {
+
+      xThetaValues.append (entry.first);
+    }
+
+    int run = entry.second;
+    int index = ++nextIndexes [run];
+    if (index < m_xThetaRuns.at (run).count ()) {
+      heap.push (HeapEntry (m_xThetaRuns.at (run).at (index),
+                            run));
+    }
+  }
 
-  return m_xThetaValues;
+  return xThetaValues;
 }
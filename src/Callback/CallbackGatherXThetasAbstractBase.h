@@ -11,14 +11,17 @@
 #include "CurveLimits.h"
 #include "CurvesIncludedHash.h"
 #include "ExportValuesXOrY.h"
+#include <QList>
 #include "Transformation.h"
-#include "ValuesVectorXOrY.h"
 
 class Point;
 
 /// Base callback for collecting X/Theta independent variables, for functions, in preparation for exporting
 class CallbackGatherXThetasAbstractBase
 {
+  // For unit testing
+  friend class TestExport;
+
 public:
   /// Single constructor.
   CallbackGatherXThetasAbstractBase(bool firstCurveOnly,
@@ -37,12 +40,14 @@ public:
   /// Endpoint minima for each curve, if extrapolation has been disabled
   CurveLimits curveLimitsMin () const;
 
-  /// Resulting x/theta values for all included functions
-  ValuesVectorXOrY xThetaValuesRaw () const;
+  /// Resulting x/theta values for all included functions, sorted and without duplicates. The gathered values are
+  /// merged here rather than as each one arrives
+  ExportValuesXOrY xThetaValuesRaw () const;
 
 protected:
 
-  /// Save one graph x value
+  /// Save one graph x value. Values arrive in increasing order within each curve, since function points are kept
+  /// sorted by ordinal, so each value usually just extends the current run
   void addGraphX (double xGraph);
   
   /// Get method for included names
@@ -65,7 +70,7 @@ private:
   QStringList m_curvesIncluded;
   const Transformation m_transformation;
   CurvesIncludedHash m_curvesIncludedHash;
-  ValuesVectorXOrY m_xThetaValues;
+  QList<ExportValuesXOrY> m_xThetaRuns; // Increasing runs of x/theta values, in the order they were gathered
 
   // Curve limits that may or may not be merged into m_xThetaValues
   CurveLimits m_curveLimitsMin;
@@ -18,9 +18,9 @@ CallbackSearchReturn CallbackRemovePointsInCurvesGraphs::callback (const QString
                                                                    const Point &point)
 {
   if (curveName == AXIS_CURVE_NAME) {
-    m_coordSystem.removePointAxis (point.identifier());
+    m_coordSystem.removePointAxis (point.identifier (curveName));
   } else {
-    m_coordSystem.removePointGraph (point.identifier());
+    m_coordSystem.removePointGraph (point.identifier (curveName));
   }
 
   return CALLBACK_SEARCH_RETURN_CONTINUE;
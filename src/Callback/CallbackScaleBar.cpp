@@ -34,13 +34,13 @@ CallbackSearchReturn CallbackScaleBar::callback (const QString &curveName,
     
     if (isNonzeroX || isNonzeroY) {
 
-      m_scaleBarPointIdentifier = point.identifier ();
+      m_scaleBarPointIdentifier = point.identifier (curveName);
       m_scaleBarLength = (isNonzeroX ?
                           point.posGraph ().x () :
                           point.posGraph ().y ());
     }
 
-    m_axisCurvePointIdentifiers << point.identifier ();
+    m_axisCurvePointIdentifiers << point.identifier (curveName);
   }
 
   return CALLBACK_SEARCH_RETURN_CONTINUE;
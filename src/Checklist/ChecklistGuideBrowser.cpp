@@ -258,8 +258,13 @@ void ChecklistGuideBrowser::update (const CmdMediator &cmdMediator,
                                     bool documentIsExported)
 {
 
+  QHash<QString, bool> checkedTagsBefore = m_checkedTags;
+
   repopulateCheckedTags(cmdMediator,
                         documentIsExported);
 
-  refresh();
+  // Rebuilding the html is slow, and most commands do not change which steps are checked
+  if (m_checkedTags != checkedTagsBefore) {
+    refresh();
+  }
 }
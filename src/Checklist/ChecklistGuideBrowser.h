@@ -24,7 +24,7 @@ class ChecklistGuideBrowser : public QTextBrowser
   virtual void setTemplateHtml (const QString &html,
                                 const QStringList &curveNames);
 
-  /// Update using current CmdMediator/Document state
+  /// Update using current CmdMediator/Document state. The display is only refreshed if a checkbox changed
   void update (const CmdMediator &cmdMediator,
                bool documentIsExported);
 
@@ -12,12 +12,14 @@
 #include "DocumentSerialize.h"
 #include "EngaugeAssert.h"
 #include "GraphicsItemType.h"
+#include "GraphicsPoint.h"
 #include "GraphicsScene.h"
 #include "GraphicsView.h"
 #include "GuidelineState.h"
 #include "Logger.h"
 #include "MainWindow.h"
 #include "Point.h"
+#include <QDateTime>
 #include <QGraphicsItem>
 #include <QXmlStreamReader>
 #include <QXmlStreamWriter>
@@ -30,6 +32,12 @@ CmdAbstract::CmdAbstract(MainWindow &mainWindow,
   m_mainWindow (mainWindow),
   m_document (document),
   m_isFirstRedo (true),
+  m_documentHashPost (0),
+  m_documentHashPre (0),
+  m_isDocumentHashPostSaved (false),
+  m_isDocumentHashPreSaved (false),
+  m_timeLastChange (QDateTime::currentMSecsSinceEpoch ()),
+  m_isMergeable (true),
   m_digitizeState (mainWindow.digitizeState ())
 {
 }
@@ -90,6 +98,22 @@ void CmdAbstract::leafAndBaseAttributes (const QXmlStreamAttributes &attributes,
 
   // Extract parent class attributes
   m_digitizeState = static_cast<DigitizeState> (attributes.value (DOCUMENT_SERIALIZE_DIGITIZE_STATE).toInt());
+
+  // Commands loaded from xml are replayed back to back, so their creation times would merge them all. Each one
+  // must stay a separate step, as when it was recorded
+  m_isMergeable = false;
+}
+
+bool CmdAbstract::isWithinMergeInterval (const CmdAbstract &cmdLater) const
+{
+  const qint64 MERGE_INTERVAL_MS = 1000; // Longer than keyboard autorepeat delay, shorter than a deliberate pause
+
+  if (!m_isMergeable ||
+      !cmdLater.m_isMergeable) {
+    return false;
+  }
+
+  return (cmdLater.m_timeLastChange - m_timeLastChange <= MERGE_INTERVAL_MS);
 }
 
 MainWindow &CmdAbstract::mainWindow ()
@@ -97,6 +121,13 @@ MainWindow &CmdAbstract::mainWindow ()
   return m_mainWindow;
 }
 
+void CmdAbstract::mergeBase (const CmdAbstract &cmdLater)
+{
+  m_documentHashPost = cmdLater.m_documentHashPost;
+  m_identifierIndexAfterRedo = cmdLater.m_identifierIndexAfterRedo;
+  m_timeLastChange = cmdLater.m_timeLastChange;
+}
+
 void CmdAbstract::redo ()
 {
   // Note that m_identifierIndexBeforeRedo and m_identifierIndexAfterRedo are not set until below (at which point they are logged)
@@ -128,7 +159,8 @@ void CmdAbstract::redo ()
 void CmdAbstract::resetSelection(const PointIdentifiers &pointIdentifiersToSelect)
 {
 
-  QList<QGraphicsItem *> items = mainWindow().view().items();
+  // Deselect the currently selected items that are not wanted, without visiting every unselected item
+  QList<QGraphicsItem *> items = mainWindow().scene().selectedItems();
   QList<QGraphicsItem *>::iterator itrS;
   for (itrS = items.begin (); itrS != items.end (); itrS++) {
 
@@ -143,6 +175,17 @@ void CmdAbstract::resetSelection(const PointIdentifiers &pointIdentifiersToSelec
 
     item->setSelected (selected);
   }
+
+  // Select the wanted points, which are looked up by identifier
+  QStringList pointIdentifiers = pointIdentifiersToSelect.keys ();
+  QStringList::const_iterator itrP;
+  for (itrP = pointIdentifiers.begin (); itrP != pointIdentifiers.end (); itrP++) {
+
+    GraphicsPoint *graphicsPoint = mainWindow().scene().graphicsPointForIdentifier (*itrP);
+    if (graphicsPoint != nullptr) {
+      graphicsPoint->setSelected (true);
+    }
+  }
 }
 
 void CmdAbstract::restoreState ()
@@ -157,10 +200,11 @@ void CmdAbstract::saveOrCheckPostCommandDocumentStateHash (const Document &docum
   DocumentHashGenerator documentHashGenerator;
   DocumentHash documentHash = documentHashGenerator.generate (document);
 
-  if (m_documentHashPost.count() == 0) {
+  if (!m_isDocumentHashPostSaved) {
 
     // This is the first time through here so save the initial value
     m_documentHashPost = documentHash;
+    m_isDocumentHashPostSaved = true;
 
   } else {
 
@@ -178,10 +222,11 @@ void CmdAbstract::saveOrCheckPreCommandDocumentStateHash (const Document &docume
   DocumentHashGenerator documentHashGenerator;
   DocumentHash documentHash = documentHashGenerator.generate (document);
 
-  if (m_documentHashPre.count() == 0) {
+  if (!m_isDocumentHashPreSaved) {
 
     // This is the first time through here so save the initial value
     m_documentHashPre = documentHash;
+    m_isDocumentHashPreSaved = true;
 
   } else {
 
@@ -193,6 +238,13 @@ void CmdAbstract::saveOrCheckPreCommandDocumentStateHash (const Document &docume
 
 }
 
+void CmdAbstract::savePostCommandDocumentStateHash (const Document &document)
+{
+  DocumentHashGenerator documentHashGenerator;
+  m_documentHashPost = documentHashGenerator.generate (document);
+  m_isDocumentHashPostSaved = true;
+}
+
 void CmdAbstract::selectAddedPointForMoving (const QString &pointAdded)
 {
   // Select added points so they can be moved
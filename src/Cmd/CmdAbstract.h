@@ -63,9 +63,17 @@ protected:
                               const QStringList &requiredAttributesLeaf,
                               QXmlStreamReader &reader);
 
+  /// True if the later command arrived soon enough after this one, or after the last command merged into this one,
+  /// that the two should appear as a single step on the undo stack. Always false for commands loaded from xml
+  bool isWithinMergeInterval (const CmdAbstract &cmdLater) const;
+
   /// Return the MainWindow so it can be updated by this command as a last step.
   MainWindow &mainWindow ();
 
+  /// Called by mergeWith of the leaf class after merging a later command into this one. This command takes over the
+  /// Document state that the later command produced, so the consistency checks in later redos still pass
+  void mergeBase (const CmdAbstract &cmdLater);
+
   /// Call this (for consistency) after writing leaf class attributes, to write the base class attributes
 
   /// Since the set of selected points has probably changed, changed that set back to the specified set. This
@@ -86,6 +94,10 @@ protected:
   /// immediately after the redo method of the subclass has done its processing. See also saveOrCheckPostCommandDocumentState
   void saveOrCheckPreCommandDocumentStateHash (const Document &document);
 
+  /// Replace the saved post command hash by the hash of the current Document state. Called by mergeWith of a leaf class
+  /// that recomputes the merged Document state, so the consistency checks in later redos compare against that state
+  void savePostCommandDocumentStateHash (const Document &document);
+
   /// Select point that was just added so it can be moved by the user next for convenience
   void selectAddedPointForMoving (const QString &pointAdded);
 
@@ -109,6 +121,12 @@ private:
   // Hash value that represents Document state before and after CmdAbstract::redo
   DocumentHash m_documentHashPost;
   DocumentHash m_documentHashPre;
+  bool m_isDocumentHashPostSaved;
+  bool m_isDocumentHashPreSaved;
+
+  // Time of creation, or of the last merge, in milliseconds since the epoch
+  qint64 m_timeLastChange;
+  bool m_isMergeable; // False for commands loaded from xml, which must replay as the separate steps they were recorded as
 
   // States that apply throughout the lifetime of the command. In either forward (=redo)
   // or backward (=undo) direction they will be applied before the command is executed
@@ -85,7 +85,7 @@ void CmdAddPointAxis::cmdRedo ()
                                                   m_ordinal,
                                                   m_isXOnly);
   document().updatePointOrdinals (mainWindow().transformation());
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommand(CmdDirty (QStringList (m_identifierAdded)));
   selectAddedPointForMoving (m_identifierAdded);
   saveOrCheckPostCommandDocumentStateHash (document ());
 }
@@ -96,7 +96,7 @@ void CmdAddPointAxis::cmdUndo ()
   restoreState ();
   saveOrCheckPostCommandDocumentStateHash (document ());
   restoreDocumentState (document ());
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommand(CmdDirty (QStringList (m_identifierAdded)));
   saveOrCheckPreCommandDocumentStateHash (document ());
 }
 
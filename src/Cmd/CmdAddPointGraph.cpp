@@ -75,7 +75,7 @@ void CmdAddPointGraph::cmdRedo ()
                                                    m_identifierAdded,
                                                    m_ordinal);
   document().updatePointOrdinals (mainWindow().transformation());
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommand(CmdDirty (QStringList (m_identifierAdded)));
   selectAddedPointForMoving(m_identifierAdded);
   saveOrCheckPostCommandDocumentStateHash (document ());
 }
@@ -86,7 +86,7 @@ void CmdAddPointGraph::cmdUndo ()
   restoreState ();
   saveOrCheckPostCommandDocumentStateHash (document ());
   restoreDocumentState (document ());
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommand(CmdDirty (QStringList (m_identifierAdded)));
   saveOrCheckPreCommandDocumentStateHash (document ());
 }
 
@@ -106,19 +106,14 @@ void CmdAddPointsGraph::cmdRedo ()
   saveOrCheckPreCommandDocumentStateHash (document ());
   saveDocumentState (document ());
 
-  int index;
-  for (index = 0; index < m_points.count(); index++) {
-
-    QString identifierAdded;
-    document().addPointGraphWithGeneratedIdentifier (m_curveName,
-                                                     m_points.at (index),
-                                                     identifierAdded,
-                                                     m_ordinals.at (index));
-    m_identifiersAdded.push_back (identifierAdded);
-  }
+  // All points go in as one batch. Undo remains atomic since it restores the saved Document state
+  document().addPointsGraphWithGeneratedIdentifiers (m_curveName,
+                                                     m_points,
+                                                     m_ordinals,
+                                                     m_identifiersAdded);
 
   document().updatePointOrdinals (mainWindow().transformation());
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommand(CmdDirty (m_identifiersAdded));
   selectAddedPointsForMoving(m_identifiersAdded);
   saveOrCheckPostCommandDocumentStateHash (document ());
 }
@@ -129,7 +124,7 @@ void CmdAddPointsGraph::cmdUndo ()
   restoreState ();
   saveOrCheckPostCommandDocumentStateHash (document ());
   restoreDocumentState (document ());
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommand(CmdDirty (m_identifiersAdded));
   saveOrCheckPreCommandDocumentStateHash (document ());
 }
 
@@ -88,7 +88,7 @@ void CmdAddScale::cmdRedo ()
                                               m_ordinal0,
                                               m_ordinal1);
   document().updatePointOrdinals (mainWindow().transformation());
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommand(CmdDirty (QStringList () << m_identifierAdded0 << m_identifierAdded1));
   saveOrCheckPostCommandDocumentStateHash (document ());
 }
 
@@ -98,7 +98,7 @@ void CmdAddScale::cmdUndo ()
   restoreState ();
   saveOrCheckPostCommandDocumentStateHash (document ());
   restoreDocumentState (document ());
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommand(CmdDirty (QStringList () << m_identifierAdded0 << m_identifierAdded1));
   saveOrCheckPreCommandDocumentStateHash (document ());
 }
 
@@ -93,7 +93,7 @@ void CmdCopy::cmdRedo ()
 
   saveOrCheckPreCommandDocumentStateHash (document ());
   document().updatePointOrdinals (mainWindow().transformation());
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommand(CmdDirty (QStringList ()));
   saveOrCheckPostCommandDocumentStateHash (document ());
 }
 
@@ -103,7 +103,7 @@ void CmdCopy::cmdUndo ()
   restoreState ();
   saveOrCheckPostCommandDocumentStateHash (document ());
   document().updatePointOrdinals (mainWindow().transformation());
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommand(CmdDirty (QStringList ()));
   saveOrCheckPreCommandDocumentStateHash (document ());
 }
 
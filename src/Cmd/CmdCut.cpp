@@ -77,6 +77,19 @@ CmdCut::~CmdCut ()
 {
 }
 
+CmdDirty CmdCut::cmdDirty () const
+{
+  CmdDirty cmdDirty ((QStringList ()));
+
+  QStringList curveNames = m_curvesGraphsRemoved.curvesGraphsNames ();
+  QStringList::const_iterator itr;
+  for (itr = curveNames.begin(); itr != curveNames.end(); itr++) {
+    cmdDirty.addCurve (*itr);
+  }
+
+  return cmdDirty;
+}
+
 void CmdCut::cmdRedo ()
 {
 
@@ -97,7 +110,7 @@ void CmdCut::cmdRedo ()
   document().removePointsInCurvesGraphs (m_curvesGraphsRemoved);
 
   document().updatePointOrdinals (mainWindow().transformation());
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommand(cmdDirty ());
   saveOrCheckPostCommandDocumentStateHash (document ());
 }
 
@@ -107,7 +120,7 @@ void CmdCut::cmdUndo ()
   restoreState ();
   saveOrCheckPostCommandDocumentStateHash (document ());
   restoreDocumentState (document ());
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommand(cmdDirty ());
   saveOrCheckPreCommandDocumentStateHash (document ());
 }
 
@@ -7,6 +7,7 @@
 #ifndef CMD_CUT_H
 #define CMD_CUT_H
 
+#include "CmdDirty.h"
 #include "CmdPointChangeBase.h"
 #include "CurvesGraphs.h"
 #include <QHash>
@@ -38,6 +39,8 @@ public:
 private:
   CmdCut();
 
+  CmdDirty cmdDirty () const; // Curves that lost points
+
   bool m_transformIsDefined;
   QString m_csv;
   QString m_html;
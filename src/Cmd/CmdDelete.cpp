@@ -86,7 +86,7 @@ void CmdDelete::cmdRedo ()
   document().removePointsInCurvesGraphs (m_curvesGraphsRemoved);
 
   document().updatePointOrdinals (mainWindow().transformation());
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommand(CmdDirty (m_deletedPointIdentifiers));
   saveOrCheckPostCommandDocumentStateHash (document ());
 }
 
@@ -96,7 +96,7 @@ void CmdDelete::cmdUndo ()
   restoreState ();
   saveOrCheckPostCommandDocumentStateHash (document ());
   restoreDocumentState (document ());
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommand(CmdDirty (m_deletedPointIdentifiers));
   selectAddedPointsForMoving(m_deletedPointIdentifiers);
   saveOrCheckPreCommandDocumentStateHash (document ());
 }
@@ -0,0 +1,76 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#include "CmdDirty.h"
+#include "Curve.h"
+#include "Point.h"
+
+CmdDirty::CmdDirty() :
+  m_isAll (true),
+  m_isAxes (true)
+{
+}
+
+CmdDirty::CmdDirty(const QStringList &pointIdentifiers) :
+  m_isAll (false),
+  m_isAxes (false)
+{
+  QStringList::const_iterator itr;
+  for (itr = pointIdentifiers.begin(); itr != pointIdentifiers.end(); itr++) {
+
+    QString curveName = Point::curveNameFromPointIdentifier (*itr);
+    if (curveName == AXIS_CURVE_NAME) {
+      m_isAxes = true;
+    } else {
+      m_curveNames.insert (curveName);
+    }
+  }
+}
+
+void CmdDirty::addCurve (const QString &curveName)
+{
+  if (curveName == AXIS_CURVE_NAME) {
+    m_isAxes = true;
+  } else {
+    m_curveNames.insert (curveName);
+  }
+}
+
+bool CmdDirty::isAll () const
+{
+  return m_isAll;
+}
+
+bool CmdDirty::isAnything () const
+{
+  return m_isAll || m_isAxes || !m_curveNames.isEmpty ();
+}
+
+bool CmdDirty::isAxes () const
+{
+  return m_isAll || m_isAxes;
+}
+
+bool CmdDirty::isCurve (const QString &curveName) const
+{
+  return m_isAll || m_curveNames.contains (curveName);
+}
+
+bool CmdDirty::isCurveOrAxes (const QString &curveName) const
+{
+  if (curveName == AXIS_CURVE_NAME) {
+    return isAxes ();
+  }
+
+  return isAxes () || isCurve (curveName);
+}
+
+void CmdDirty::merge (const CmdDirty &cmdDirty)
+{
+  m_isAll = m_isAll || cmdDirty.m_isAll;
+  m_isAxes = m_isAxes || cmdDirty.m_isAxes;
+  m_curveNames.unite (cmdDirty.m_curveNames);
+}
@@ -0,0 +1,57 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef CMD_DIRTY_H
+#define CMD_DIRTY_H
+
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+/// Parts of the Document that were changed by a command. MainWindow::updateAfterCommand uses this to skip the refresh
+/// steps that depend on none of those parts. Axis points are tracked as a whole, since any axis point affects the
+/// transformation, while graph points are tracked per curve
+class CmdDirty
+{
+public:
+  /// Default constructor marks everything as changed. This is for settings commands that affect the points, lines or
+  /// transformation, and for loading or replacing a Document, since those can affect every refresh step
+  CmdDirty();
+
+  /// Constructor for commands that added, removed or moved the specified points. An empty list means no points were
+  /// changed, which also suits settings commands that affect neither the points nor the transformation
+  CmdDirty(const QStringList &pointIdentifiers);
+
+  /// Mark all points of the specified curve as changed, for commands that only know which curves they touched
+  void addCurve (const QString &curveName);
+
+  /// True if everything was changed
+  bool isAll () const;
+
+  /// True if anything at all was changed
+  bool isAnything () const;
+
+  /// True if the axis points, and therefore possibly the transformation, were changed
+  bool isAxes () const;
+
+  /// True if the points of the specified graph curve were changed
+  bool isCurve (const QString &curveName) const;
+
+  /// True if the points or lines of the specified curve, which may be the axis curve, need refreshing. Smooth lines of
+  /// every graph curve depend on the axis points through the transformation
+  bool isCurveOrAxes (const QString &curveName) const;
+
+  /// Add the changes in another CmdDirty to this one
+  void merge (const CmdDirty &cmdDirty);
+
+private:
+
+  bool m_isAll;
+  bool m_isAxes;
+  QSet<QString> m_curveNames; // Graph curves with changed points
+};
+
+#endif // CMD_DIRTY_H
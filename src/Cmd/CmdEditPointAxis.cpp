@@ -79,7 +79,7 @@ void CmdEditPointAxis::cmdRedo ()
   document().editPointAxis (m_posGraphAfter,
                             m_pointIdentifier);
   document().updatePointOrdinals (mainWindow().transformation());
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommand(CmdDirty (QStringList (m_pointIdentifier)));
   saveOrCheckPostCommandDocumentStateHash (document ());
 }
 
@@ -89,7 +89,7 @@ void CmdEditPointAxis::cmdUndo ()
   restoreState ();
   saveOrCheckPostCommandDocumentStateHash (document ());
   restoreDocumentState (document ());
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommand(CmdDirty (QStringList (m_pointIdentifier)));
   saveOrCheckPreCommandDocumentStateHash (document ());
 }
 
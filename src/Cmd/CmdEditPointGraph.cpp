@@ -113,7 +113,7 @@ void CmdEditPointGraph::cmdRedo ()
                              m_pointIdentifiers,
                              mainWindow().transformation());
   document().updatePointOrdinals (mainWindow().transformation());
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommand(CmdDirty (m_pointIdentifiers));
   saveOrCheckPostCommandDocumentStateHash (document ());
 }
 
@@ -123,7 +123,7 @@ void CmdEditPointGraph::cmdUndo ()
   restoreState ();
   saveOrCheckPostCommandDocumentStateHash (document ());
   restoreDocumentState (document ());
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommand(CmdDirty (m_pointIdentifiers));
   saveOrCheckPreCommandDocumentStateHash (document ());
 }
 
@@ -97,12 +97,6 @@ void CmdMediator::iterateThroughCurvesPointsGraphs (const Functor2wRet<const QSt
   return m_document.iterateThroughCurvesPointsGraphs (ftorWithCallback);
 }
 
-QPixmap CmdMediator::pixmap () const
-{
-  ENGAUGE_ASSERT (m_document.successfulRead ());
-
-  return m_document.pixmap ();
-}
 
 QString CmdMediator::reasonForUnsuccessfulRead () const
 {
@@ -11,6 +11,7 @@
 #include "Document.h"
 #include "DocumentAxesPointsRequired.h"
 #include "PointStyle.h"
+#include <QPixmap>
 #include <QUndoStack>
 
 class MainWindow;
@@ -65,9 +66,6 @@ public:
   /// See Curve::iterateThroughCurvePoints, for all the graphs curves.
   void iterateThroughCurvesPointsGraphs (const Functor2wRet<const QString &, const Point &, CallbackSearchReturn> &ftorWithCallback);
 
-  /// See Document::pixmap.
-  QPixmap pixmap () const;
-
   /// See Document::reasonForUnsuccessfulRead.
   QString reasonForUnsuccessfulRead () const;
 
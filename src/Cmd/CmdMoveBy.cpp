@@ -10,6 +10,8 @@
 #include "DocumentSerialize.h"
 #include "EngaugeAssert.h"
 #include "GraphicsItemType.h"
+#include "GraphicsPoint.h"
+#include "GraphicsScene.h"
 #include "GraphicsView.h"
 #include "Logger.h"
 #include "MainWindow.h"
@@ -18,6 +20,8 @@
 #include <QXmlStreamReader>
 #include "Xml.h"
 
+const int CMD_MOVE_BY_ID = 1; // QUndoCommand::id for merging. Any other mergeable command must use a different value
+
 CmdMoveBy::CmdMoveBy(MainWindow &mainWindow,
                      Document &document,
                      const QPointF &deltaScreen,
@@ -74,7 +78,7 @@ void CmdMoveBy::cmdRedo ()
   saveOrCheckPreCommandDocumentStateHash (document ());
   saveDocumentState (document ());
   moveBy (m_deltaScreen);
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommandThrottled(CmdDirty (m_movedPoints.keys ()));
   resetSelection(m_movedPoints);
   saveOrCheckPostCommandDocumentStateHash (document ());
 }
@@ -85,42 +89,82 @@ void CmdMoveBy::cmdUndo ()
   restoreState ();
   saveOrCheckPostCommandDocumentStateHash (document ());
   restoreDocumentState (document ());
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommand(CmdDirty (m_movedPoints.keys ()));
   resetSelection(m_movedPoints);
   saveOrCheckPreCommandDocumentStateHash (document ());
 }
 
-void CmdMoveBy::moveBy (const QPointF &deltaScreen)
+int CmdMoveBy::id () const
 {
+  return CMD_MOVE_BY_ID;
+}
 
-  // Move Points in the Document
-  for (int i = 0; i < m_movedPoints.count(); i++) {
+bool CmdMoveBy::isSameMovedPoints (const PointIdentifiers &movedPoints) const
+{
+  if (movedPoints.count () != m_movedPoints.count ()) {
+    return false;
+  }
 
-    QString pointIdentifier = m_movedPoints.getKey (i);
-    document().movePoint (pointIdentifier, deltaScreen);
+  QStringList keys = movedPoints.keys ();
+  QStringList::const_iterator itr;
+  for (itr = keys.begin (); itr != keys.end (); itr++) {
+    if (!m_movedPoints.contains (*itr)) {
+      return false;
+    }
+  }
 
+  return true;
+}
+
+bool CmdMoveBy::mergeWith (const QUndoCommand *command)
+{
+  // Only a quick succession of moves of the same points, like from holding down an arrow key, is merged
+  const CmdMoveBy *cmdMoveBy = dynamic_cast<const CmdMoveBy*> (command);
+  if (cmdMoveBy == nullptr ||
+      !isWithinMergeInterval (*cmdMoveBy) ||
+      !isSameMovedPoints (cmdMoveBy->m_movedPoints)) {
+    return false;
   }
 
-  // Move Points in GraphicsScene, using the new positions in Document
-  QList<QGraphicsItem *> items = mainWindow().view().items();
-  QList<QGraphicsItem *>::iterator itrS;
-  for (itrS = items.begin (); itrS != items.end (); itrS++) {
+  m_deltaScreen += cmdMoveBy->m_deltaScreen;
+  mergeBase (*cmdMoveBy);
 
-    QGraphicsItem *item = *itrS;
-    if (item->data (DATA_KEY_GRAPHICS_ITEM_TYPE).toInt () == GRAPHICS_ITEM_TYPE_POINT) {
+  // Points are moved again from where they were before this command, by the summed delta. That is what later redos
+  // do, and it can differ in the last bits from the separate moves. Later commands then see the same Document state
+  // whether or not this command was undone and redone in between, and their consistency checks still pass
+  restoreDocumentState (document ());
+  moveBy (m_deltaScreen);
+  savePostCommandDocumentStateHash (document ());
+
+  return true;
+}
+
+void CmdMoveBy::moveBy (const QPointF &deltaScreen)
+{
+
+  // Move Points in the Document
+  QStringList pointIdentifiers = m_movedPoints.keys ();
+  QStringList::const_iterator itrP;
+  for (itrP = pointIdentifiers.begin (); itrP != pointIdentifiers.end (); itrP++) {
+
+    document().movePoint (*itrP, deltaScreen);
+
+  }
 
-      QString pointIdentifier = item->data (DATA_KEY_IDENTIFIER).toString ();
+  // Move Points in GraphicsScene, using the new positions in Document. Only the moved points are looked up
+  QStringList::const_iterator itrS;
+  for (itrS = pointIdentifiers.begin (); itrS != pointIdentifiers.end (); itrS++) {
 
-      if (m_movedPoints.contains (pointIdentifier)) {
+    GraphicsPoint *graphicsPoint = mainWindow().scene().graphicsPointForIdentifier (*itrS);
+    if (graphicsPoint != nullptr) {
 
-        // Get the new position
-        QPointF posScreen = document().positionScreen (pointIdentifier);
+      // Get the new position
+      QPointF posScreen = document().positionScreen (*itrS);
 
-        if (item->pos () != posScreen) {
+      if (graphicsPoint->pos () != posScreen) {
 
-          // Save the new position
-          item->setPos (posScreen);
-        }
+        // Save the new position
+        graphicsPoint->setPos (posScreen);
       }
     }
   }
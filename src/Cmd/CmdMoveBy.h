@@ -35,14 +35,17 @@ public:
 
   virtual void cmdRedo ();
   virtual void cmdUndo ();
+  virtual int id () const;
+  virtual bool mergeWith (const QUndoCommand *command);
   virtual void saveXml (QXmlStreamWriter &writer) const;
 
 private:
   CmdMoveBy();
 
+  bool isSameMovedPoints (const PointIdentifiers &movedPoints) const;
   void moveBy (const QPointF &deltaScreen);
 
-  QPointF m_deltaScreen;
+  QPointF m_deltaScreen; // Total over all merged commands
   PointIdentifiers m_movedPoints;
 };
 
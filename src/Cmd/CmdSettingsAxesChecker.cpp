@@ -4,6 +4,7 @@
  * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
  ******************************************************************************************************/
 
+#include "CmdDirty.h"
 #include "CmdSettingsAxesChecker.h"
 #include "Document.h"
 #include "DocumentSerialize.h"
@@ -82,7 +83,7 @@ void CmdSettingsAxesChecker::cmdRedo ()
   restoreState ();
   saveOrCheckPreCommandDocumentStateHash (document ());
   mainWindow().updateSettingsAxesChecker(m_modelAxesCheckerAfter);
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommand(CmdDirty (QStringList ()));
   saveOrCheckPostCommandDocumentStateHash (document ());
 }
 
@@ -92,7 +93,7 @@ void CmdSettingsAxesChecker::cmdUndo ()
   restoreState ();
   saveOrCheckPostCommandDocumentStateHash (document ());
   mainWindow().updateSettingsAxesChecker(m_modelAxesCheckerBefore);
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommand(CmdDirty (QStringList ()));
   saveOrCheckPreCommandDocumentStateHash (document ());
 }
 
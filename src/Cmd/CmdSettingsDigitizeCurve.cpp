@@ -4,6 +4,7 @@
  * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
  ******************************************************************************************************/
 
+#include "CmdDirty.h"
 #include "CmdSettingsDigitizeCurve.h"
 #include "Document.h"
 #include "DocumentSerialize.h"
@@ -82,7 +83,7 @@ void CmdSettingsDigitizeCurve::cmdRedo ()
   restoreState ();
   saveOrCheckPreCommandDocumentStateHash (document ());
   mainWindow().updateSettingsDigitizeCurve(m_modelDigitizeCurveAfter);
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommand(CmdDirty (QStringList ()));
   saveOrCheckPostCommandDocumentStateHash (document ());
 }
 
@@ -92,7 +93,7 @@ void CmdSettingsDigitizeCurve::cmdUndo ()
   restoreState ();
   saveOrCheckPostCommandDocumentStateHash (document ());
   mainWindow().updateSettingsDigitizeCurve(m_modelDigitizeCurveBefore);
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommand(CmdDirty (QStringList ()));
   saveOrCheckPreCommandDocumentStateHash (document ());
 }
 
@@ -4,6 +4,7 @@
  * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
  ******************************************************************************************************/
 
+#include "CmdDirty.h"
 #include "CmdSettingsExportFormat.h"
 #include "Document.h"
 #include "DocumentModelExportFormat.h"
@@ -83,7 +84,7 @@ void CmdSettingsExportFormat::cmdRedo ()
   restoreState ();
   saveOrCheckPreCommandDocumentStateHash (document ());
   mainWindow().updateSettingsExportFormat(m_modelExportAfter);
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommand(CmdDirty (QStringList ()));
   saveOrCheckPostCommandDocumentStateHash (document ());
 }
 
@@ -93,7 +94,7 @@ void CmdSettingsExportFormat::cmdUndo ()
   restoreState ();
   saveOrCheckPostCommandDocumentStateHash (document ());
   mainWindow().updateSettingsExportFormat(m_modelExportBefore);
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommand(CmdDirty (QStringList ()));
   saveOrCheckPreCommandDocumentStateHash (document ());
 }
 
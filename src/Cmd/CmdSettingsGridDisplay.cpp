@@ -4,6 +4,7 @@
  * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
  ******************************************************************************************************/
 
+#include "CmdDirty.h"
 #include "CmdSettingsGridDisplay.h"
 #include "Document.h"
 #include "DocumentSerialize.h"
@@ -82,7 +83,7 @@ void CmdSettingsGridDisplay::cmdRedo ()
   restoreState ();
   saveOrCheckPreCommandDocumentStateHash (document ());
   mainWindow().updateSettingsGridDisplay(m_modelGridDisplayAfter);
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommand(CmdDirty (QStringList ()));
   saveOrCheckPostCommandDocumentStateHash (document ());
 }
 
@@ -92,7 +93,7 @@ void CmdSettingsGridDisplay::cmdUndo ()
   restoreState ();
   saveOrCheckPostCommandDocumentStateHash (document ());
   mainWindow().updateSettingsGridDisplay(m_modelGridDisplayBefore);
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommand(CmdDirty (QStringList ()));
   saveOrCheckPreCommandDocumentStateHash (document ());
 }
 
@@ -87,7 +87,7 @@ void CoordSystem::addPointAxisWithGeneratedIdentifier (const QPointF &posScreen,
                isXOnly);
   m_curveAxes->addPoint (point);
 
-  identifier = point.identifier();
+  identifier = point.identifier (AXIS_CURVE_NAME);
 
 }
 
@@ -115,9 +115,10 @@ void CoordSystem::addPointGraphWithGeneratedIdentifier (const QString &curveName
   Point point (curveName,
                posScreen,
                ordinal);
-  m_curvesGraphs.addPoint (point);
+  m_curvesGraphs.addPoint (curveName,
+                           point);
 
-  identifier = point.identifier();
+  identifier = point.identifier (curveName);
 
 }
 
@@ -130,10 +131,37 @@ void CoordSystem::addPointGraphWithSpecifiedIdentifier (const QString &curveName
                identifier,
                posScreen,
                ordinal);
-  m_curvesGraphs.addPoint (point);
+  m_curvesGraphs.addPoint (curveName,
+                           point);
 
 }
 
+void CoordSystem::addPointsGraphWithGeneratedIdentifiers (const QString &curveName,
+                                                          const QList<QPoint> &positionsScreen,
+                                                          const QList<double> &ordinals,
+                                                          QStringList &generatedIdentifiers)
+{
+  ENGAUGE_ASSERT (positionsScreen.count () == ordinals.count ());
+
+  // Build all the points, and their identifiers, before touching the curve
+  Points points;
+  points.reserve (positionsScreen.count ());
+  generatedIdentifiers.clear ();
+  generatedIdentifiers.reserve (positionsScreen.count ());
+  for (int index = 0; index < positionsScreen.count (); index++) {
+    Point point (curveName,
+                 positionsScreen.at (index),
+                 ordinals.at (index));
+    points.append (point);
+    generatedIdentifiers.append (point.identifier (curveName));
+  }
+
+  // One curve lookup for the whole batch
+  Curve *curve = m_curvesGraphs.curveForCurveName (curveName);
+  ENGAUGE_CHECK_PTR (curve);
+  curve->addPoints (points);
+}
+
 void CoordSystem::addPointsInCurvesGraphs (CurvesGraphs &curvesGraphs)
 {
   CallbackAddPointsInCurvesGraphs ftor (*this);
@@ -24,7 +24,6 @@
 #include "DocumentModelSegments.h"
 #include "PointStyle.h"
 #include <QList>
-#include <QPixmap>
 #include <QString>
 #include <QStringList>
 #include <QXmlStreamReader>
@@ -69,6 +68,10 @@ public:
                                                      const QPointF &posScreen,
                                                      const QString &identifier,
                                                      double ordinal);
+  virtual void addPointsGraphWithGeneratedIdentifiers (const QString &curveName,
+                                                     const QList<QPoint> &positionsScreen,
+                                                     const QList<double> &ordinals,
+                                                     QStringList &generatedIdentifiers);
   virtual void addPointsInCurvesGraphs (CurvesGraphs &curvesGraphs);
   virtual void checkAddPointAxis (const QPointF &posScreen,
                                   const QPointF &posGraph,
@@ -88,6 +88,18 @@ void CoordSystemContext::addPointGraphWithSpecifiedIdentifier (const QString &cu
                                                                                      ordinal);
 }
 
+void CoordSystemContext::addPointsGraphWithGeneratedIdentifiers (const QString &curveName,
+                                                                 const QList<QPoint> &positionsScreen,
+                                                                 const QList<double> &ordinals,
+                                                                 QStringList &generatedIdentifiers)
+{
+
+  m_coordSystems [signed (m_coordSystemIndex)]->addPointsGraphWithGeneratedIdentifiers(curveName,
+                                                                                       positionsScreen,
+                                                                                       ordinals,
+                                                                                       generatedIdentifiers);
+}
+
 void CoordSystemContext::addPointsInCurvesGraphs (CurvesGraphs &curvesGraphs)
 {
 
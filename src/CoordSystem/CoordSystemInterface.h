@@ -23,9 +23,12 @@
 #include "DocumentModelSegments.h"
 #include "functor.h"
 #include "Point.h"
+#include <QList>
+#include <QStringList>
 
 class Curve;
 class CurvesGraphs;
+class QPoint;
 class QPointF;
 class QString;
 class Transformation;
@@ -77,6 +80,13 @@ public:
                                                      const QString &identifier,
                                                      double ordinal) = 0;
 
+  /// Add many graph points to one curve with generated point identifiers, in a single pass. This is much faster than
+  /// calling addPointGraphWithGeneratedIdentifier for each point when segment fill produces thousands of points
+  virtual void addPointsGraphWithGeneratedIdentifiers (const QString &curveName,
+                                                     const QList<QPoint> &positionsScreen,
+                                                     const QList<double> &ordinals,
+                                                     QStringList &generatedIdentifiers) = 0;
+
   /// Add all points identified in the specified CurvesGraphs. See also removePointsInCurvesGraphs
   virtual void addPointsInCurvesGraphs (CurvesGraphs &curvesGraphs) = 0;
 
@@ -24,5 +24,10 @@ void CreateScene::create(MainWindow &mw)
   mw.m_scene = new GraphicsScene (&mw);
   mw.m_view = new GraphicsView (mw.m_scene, mw);
   mw.m_layout->addWidget (mw.m_view);
+
+  // Queue for later by including Qt::QueuedConnection, since the view reports while it is painting the scene
+  connect (mw.m_view, SIGNAL (signalVisibleSceneRectChanged (QRectF)),
+           mw.m_scene, SLOT (slotVisibleSceneRectChanged (QRectF)),
+           Qt::QueuedConnection);
 }
 
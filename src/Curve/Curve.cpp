@@ -4,20 +4,21 @@
  * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
  ******************************************************************************************************/
 
+#include <algorithm>
 #include "Curve.h"
 #include "CurvesGraphs.h"
 #include "CurveStyle.h"
 #include "DocumentSerialize.h"
 #include "EngaugeAssert.h"
+#include <iterator>
 #include "Logger.h"
 #include "MigrateToVersion6.h"
 #include "Point.h"
 #include "PointComparator.h"
 #include <QDataStream>
 #include <QDebug>
-#include <qmath.h>
-#include <QMultiMap>
 #include <QTextStream>
+#include <QVector>
 #include <QXmlStreamReader>
 #include <QXmlStreamWriter>
 #include "Transformation.h"
@@ -29,14 +30,15 @@ const QString DUMMY_CURVE_NAME ("dummy");
 const QString SCALE_CURVE_NAME ("Scale"); // Used for pre-version 6 input files
 const QString TAB_DELIMITER ("\t");
 
-// This has to be a multimap instead of a map since some users may mistakenly allow multiple points with the
-// same x coordinate in their functions even though that should not happen
-typedef QMultiMap<double, QString> XOrThetaToPointIdentifier;
+// Insertion sort of the ordinals gives up after this many moves per point on average, as when an axis is reversed,
+// since a full sort is faster at that point
+const int MAX_INSERTION_SORT_MOVES_PER_POINT = 8;
 
 Curve::Curve(const QString &curveName,
              const ColorFilterSettings &colorFilterSettings,
              const CurveStyle &curveStyle) :
   m_curveName (curveName),
+  m_documentHash (0),
   m_colorFilterSettings (colorFilterSettings),
   m_curveStyle (curveStyle)
 {
@@ -45,12 +47,15 @@ Curve::Curve(const QString &curveName,
 Curve::Curve (const Curve &curve) :
   m_curveName (curve.curveName ()),
   m_points (curve.points ()),
+  m_pointIndexes (curve.m_pointIndexes),
+  m_documentHash (curve.m_documentHash),
   m_colorFilterSettings (curve.colorFilterSettings ()),
   m_curveStyle (curve.curveStyle ())
 {
 }
 
-Curve::Curve (QDataStream &str)
+Curve::Curve (QDataStream &str) :
+  m_documentHash (0)
 {
   const int CONVERT_ENUM_TO_RADIUS = 6;
   MigrateToVersion6 migrate;
@@ -116,7 +121,8 @@ Curve::Curve (QDataStream &str)
   }
 }
 
-Curve::Curve (QXmlStreamReader &reader)
+Curve::Curve (QXmlStreamReader &reader) :
+  m_documentHash (0)
 {
   loadXml(reader);
 }
@@ -125,6 +131,8 @@ Curve &Curve::operator=(const Curve &curve)
 {
   m_curveName = curve.curveName ();
   m_points = curve.points ();
+  m_pointIndexes = curve.m_pointIndexes;
+  m_documentHash = curve.m_documentHash;
   m_colorFilterSettings = curve.colorFilterSettings ();
   m_curveStyle = curve.curveStyle ();
 
@@ -133,7 +141,54 @@ Curve &Curve::operator=(const Curve &curve)
 
 void Curve::addPoint (const Point &point)
 {
+  m_pointIndexes [point.identifierNumber ()] = m_points.count ();
   m_points.push_back (point);
+  m_documentHash += point.documentHash ();
+}
+
+void Curve::addPoints (const Points &points)
+{
+  m_pointIndexes.reserve (m_pointIndexes.count () + points.count ());
+
+  CurveConnectAs curveConnectAs = m_curveStyle.lineStyle().curveConnectAs();
+  if (curveConnectAs == CONNECT_AS_FUNCTION_SMOOTH ||
+      curveConnectAs == CONNECT_AS_FUNCTION_STRAIGHT) {
+
+    // The list is kept in ordinal order, so merging the new points by their ordinals puts each one next to its
+    // neighbors. The next ordinal update then has very little reordering left to do. Relations are not merged since
+    // their ordinals come from list order, which must stay as it was for appended points. Existing points go ahead of
+    // new points with equal ordinals, as they would if the new points had been appended
+    Points pointsNew = points;
+    std::stable_sort (pointsNew.begin (),
+                      pointsNew.end (),
+                      PointComparator ());
+
+    Points pointsMerged;
+    pointsMerged.reserve (m_points.count () + pointsNew.count ());
+    std::merge (m_points.begin (),
+                m_points.end (),
+                pointsNew.begin (),
+                pointsNew.end (),
+                std::back_inserter (pointsMerged),
+                PointComparator ());
+    m_points = pointsMerged;
+
+    Points::const_iterator itr;
+    for (itr = pointsNew.begin (); itr != pointsNew.end (); itr++) {
+      m_documentHash += itr->documentHash ();
+    }
+
+    updatePointIndexes ();
+
+  } else {
+
+    m_points.reserve (m_points.count () + points.count ());
+
+    Points::const_iterator itr;
+    for (itr = points.begin (); itr != points.end (); itr++) {
+      addPoint (*itr);
+    }
+  }
 }
 
 ColorFilterSettings Curve::colorFilterSettings () const
@@ -151,20 +206,19 @@ CurveStyle Curve::curveStyle() const
   return m_curveStyle;
 }
 
+DocumentHash Curve::documentHash () const
+{
+  // Curve name is mixed in here rather than into each Point digest, so a rename does not visit the points
+  return documentHashMix (m_documentHash,
+                          quint64 (qHash (m_curveName)));
+}
+
 void Curve::editPointAxis (const QPointF &posGraph,
                            const QString &identifier)
 {
-  // Search for the point with matching identifier
-  QList<Point>::iterator itr;
-  for (itr = m_points.begin (); itr != m_points.end (); itr++) {
-
-    Point &point = *itr;
-    if (point.identifier () == identifier) {
-
-      point.setPosGraph (posGraph);
-      break;
-
-    }
+  int index = indexForPointIdentifier (identifier);
+  if (index >= 0) {
+    m_points [index].setPosGraph (posGraph);
   }
 }
 
@@ -178,13 +232,14 @@ void Curve::editPointGraph (bool isX,
 
   if (transformation.transformIsDefined()) {
 
-    // Search for the point with matching identifier
-    QList<Point>::iterator itr;
-    for (itr = m_points.begin(); itr != m_points.end(); itr++) {
+    // Look up each point with matching identifier. Identifiers belonging to other curves are skipped
+    QStringList::const_iterator itr;
+    for (itr = identifiers.begin(); itr != identifiers.end(); itr++) {
 
-      Point &point = *itr;
+      int index = indexForPointIdentifier (*itr);
+      if (index >= 0) {
 
-      if (identifiers.contains (point.identifier ())) {
+        Point &point = m_points [index];
 
         // Although one or more graph coordinates are specified, it is the screen coordinates that must be
         // moved. This is because only the screen coordinates of the graph points are tracked (not the graph coordinates).
@@ -209,7 +264,9 @@ void Curve::editPointGraph (bool isX,
         transformation.transformRawGraphToScreen(posGraph,
                                                  posScreen);
 
+        m_documentHash -= point.documentHash ();
         point.setPosScreen (posScreen);
+        m_documentHash += point.documentHash ();
       }
     }
   }
@@ -229,7 +286,7 @@ void Curve::exportToClipboard (const QHash<QString, bool> &selectedHash,
   for (itr = m_points.begin (); itr != m_points.end (); itr++) {
 
     const Point &point = *itr;
-    if (selectedHash.contains (point.identifier ())) {
+    if (selectedHash.contains (point.identifier (m_curveName))) {
 
       if (isFirst) {
 
@@ -278,17 +335,32 @@ void Curve::exportToClipboard (const QHash<QString, bool> &selectedHash,
   }
 }
 
-bool Curve::isXOnly(const QString &pointIdentifier) const
+int Curve::indexForPointIdentifier (const QString &pointIdentifier) const
 {
-  // Search for point with matching identifier
-  Points::const_iterator itr;
-  for (itr = m_points.begin (); itr != m_points.end (); itr++) {
-    const Point &point = *itr;
-    if (pointIdentifier == point.identifier ()) {
-      return point.isXOnly();
+  int index = m_pointIndexes.value (Point::identifierNumberFromPointIdentifier (pointIdentifier),
+                                    -1);
+
+  // Identifiers of other curves are rejected by their leading curve name, which the number alone would not show
+  if (index >= 0) {
+    QStringRef delimiter = pointIdentifier.midRef (m_curveName.length (),
+                                                   1);
+    if (!pointIdentifier.startsWith (m_curveName) ||
+        (delimiter != POINT_IDENTIFIER_DELIMITER_SAFE &&
+         delimiter != POINT_IDENTIFIER_DELIMITER_XML)) {
+      index = -1;
     }
   }
 
+  return index;
+}
+
+bool Curve::isXOnly(const QString &pointIdentifier) const
+{
+  int index = indexForPointIdentifier (pointIdentifier);
+  if (index >= 0) {
+    return m_points.at (index).isXOnly();
+  }
+
   ENGAUGE_ASSERT (false);
 
   return false;
@@ -353,7 +425,7 @@ void Curve::loadCurvePoints(QXmlStreamReader &reader)
       if (reader.name () == DOCUMENT_SERIALIZE_POINT) {
 
         Point point (reader);
-        m_points.push_back (point);
+        addPoint (point);
       }
     }
   }
@@ -420,7 +492,9 @@ void Curve::movePoint (const QString &pointIdentifier,
   Point *point = pointForPointIdentifier (pointIdentifier);
 
   QPointF posScreen = deltaScreen + point->posScreen ();
+  m_documentHash -= point->documentHash ();
   point->setPosScreen (posScreen);
+  m_documentHash += point->documentHash ();
 }
 
 int Curve::numPoints () const
@@ -430,12 +504,9 @@ int Curve::numPoints () const
 
 Point *Curve::pointForPointIdentifier (const QString pointIdentifier)
 {
-  Points::iterator itr;
-  for (itr = m_points.begin (); itr != m_points.end (); itr++) {
-    Point &point = *itr;
-    if (pointIdentifier == point.identifier ()) {
-      return &point;
-    }
+  int index = indexForPointIdentifier (pointIdentifier);
+  if (index >= 0) {
+    return &m_points [index];
   }
 
   ENGAUGE_ASSERT (false);
@@ -451,14 +522,9 @@ QPointF Curve::positionGraph (const QString &pointIdentifier) const
 {
   QPointF posGraph;
 
-  // Search for point with matching identifier
-  Points::const_iterator itr;
-  for (itr = m_points.begin (); itr != m_points.end (); itr++) {
-    const Point &point = *itr;
-    if (pointIdentifier == point.identifier ()) {
-      posGraph = point.posGraph ();
-      break;
-    }
+  int index = indexForPointIdentifier (pointIdentifier);
+  if (index >= 0) {
+    posGraph = m_points.at (index).posGraph ();
   }
 
   return posGraph;
@@ -468,14 +534,9 @@ QPointF Curve::positionScreen (const QString &pointIdentifier) const
 {
   QPointF posScreen;
 
-  // Search for point with matching identifier
-  Points::const_iterator itr;
-  for (itr = m_points.begin (); itr != m_points.end (); itr++) {
-    const Point &point = *itr;
-    if (pointIdentifier == point.identifier ()) {
-      posScreen = point.posScreen ();
-      break;
-    }
+  int index = indexForPointIdentifier (pointIdentifier);
+  if (index >= 0) {
+    posScreen = m_points.at (index).posScreen ();
   }
 
   return posScreen;
@@ -503,14 +564,14 @@ void Curve::printStream (QString indentation,
 
 void Curve::removePoint (const QString &identifier)
 {
-  // Search for point with matching identifier
-  Points::iterator itr;
-  for (itr = m_points.begin (); itr != m_points.end (); itr++) {
-    Point point = *itr;
-    if (point.identifier () == identifier) {
-      m_points.erase (itr);
-      break;
-    }
+  int index = indexForPointIdentifier (identifier);
+  if (index >= 0) {
+    m_documentHash -= m_points.at (index).documentHash ();
+    m_pointIndexes.remove (m_points.at (index).identifierNumber ());
+    m_points.removeAt (index);
+
+    // Points after the removed point have shifted down by one
+    updatePointIndexes (index);
   }
 }
 
@@ -529,7 +590,8 @@ void Curve::saveXml(QXmlStreamWriter &writer) const
   Points::const_iterator itr;
   for (itr = m_points.begin (); itr != m_points.end (); itr++) {
     const Point &point = *itr;
-    point.saveXml (writer);
+    point.saveXml (writer,
+                   m_curveName);
   }
   writer.writeEndElement();
 
@@ -544,13 +606,6 @@ void Curve::setColorFilterSettings (const ColorFilterSettings &colorFilterSettin
 void Curve::setCurveName (const QString &curveName)
 {
   m_curveName = curveName;
-
-  // Pass to member objects
-  QList<Point>::iterator itr;
-  for (itr = m_points.begin(); itr != m_points.end(); itr++) {
-    Point &point = *itr;
-    point.setCurveName (curveName);
-  }
 }
 
 void Curve::setCurveStyle (const CurveStyle &curveStyle)
@@ -558,11 +613,19 @@ void Curve::setCurveStyle (const CurveStyle &curveStyle)
   m_curveStyle = curveStyle;
 }
 
+void Curve::updatePointIndexes (int indexStart)
+{
+  for (int index = indexStart; index < m_points.count (); index++) {
+    m_pointIndexes [m_points.at (index).identifierNumber ()] = index;
+  }
+}
+
 void Curve::updatePointOrdinals (const Transformation &transformation)
 {
   CurveConnectAs curveConnectAs = m_curveStyle.lineStyle().curveConnectAs();
 
-  // Make sure ordinals are properly ordered. Sorting is done afterward
+  // Make sure ordinals are properly ordered. Both algorithms leave the points already sorted by ordinal, so
+  // no separate sort is needed
 
   if (curveConnectAs == CONNECT_AS_FUNCTION_SMOOTH ||
       curveConnectAs == CONNECT_AS_FUNCTION_STRAIGHT) {
@@ -579,80 +642,104 @@ void Curve::updatePointOrdinals (const Transformation &transformation)
     ENGAUGE_ASSERT (false);
 
   }
-
-  std::sort (m_points.begin(),
-             m_points.end(),
-             PointComparator());
 }
 
 void Curve::updatePointOrdinalsFunctions (const Transformation &transformation)
 {
-  CurveConnectAs curveConnectAs = m_curveStyle.lineStyle().curveConnectAs();
-
-  // Get a map of x/theta values as keys with point identifiers as the values. This has to be a multimap since
-  // some users will have two (or maybe more) points with the same x coordinate, even though true functions should
-  // never have that happen
-  XOrThetaToPointIdentifier xOrThetaToPointIdentifier;
-  Points::iterator itr;
-  for (itr = m_points.begin (); itr != m_points.end (); itr++) {
-    Point &point = *itr;
+  int count = m_points.count ();
 
-    QPointF posGraph;
-    if (transformation.transformIsDefined()) {
-
-      // Transformation is available so use it
-      transformation.transformScreenToRawGraph (point.posScreen (),
-                                                posGraph);
-    } else {
+  // Gather the screen coordinates into separate x and y arrays so the transformation is applied in one pass
+  m_xBatch.resize (count);
+  m_yBatch.resize (count);
+  for (int index = 0; index < count; index++) {
+    QPointF posScreen = m_points.at (index).posScreen ();
+    m_xBatch [index] = posScreen.x ();
+    m_yBatch [index] = posScreen.y ();
+  }
 
-      // Transformation is not available so we just use the screen coordinates. Effectively, the
-      // transformation is the identity matrix
-      posGraph= point.posScreen();
-    }
+  if (transformation.transformIsDefined()) {
 
-    xOrThetaToPointIdentifier.insert (posGraph.x(),
-                                      point.identifier());
+    // Transformation is available so use it
+    transformation.transformScreenToRawGraph (m_xBatch,
+                                              m_yBatch);
   }
 
-  // Every point in m_points must be in the map. Failure to perform this check will probably result in the assert
-  // below getting triggered
-  ENGAUGE_ASSERT (xOrThetaToPointIdentifier.count () == m_points.count ());
+  // Otherwise the transformation is not available so we just use the screen coordinates. Effectively, the
+  // transformation is the identity matrix
+
+  // Sort the point indexes by x/theta. Some users will have two (or maybe more) points with the same x coordinate,
+  // even though true functions should never have that happen. Those are ordered the way the QMultiMap that this
+  // replaced ordered them, which returned equal keys most recently inserted first. Since the points were inserted in
+  // list order, the point later in the list comes first, and exported output does not change
+  const QVector<double> &xGraph = m_xBatch;
+  auto isBefore = [&xGraph] (int a, int b) {
+    return (xGraph.at (a) < xGraph.at (b)) ||
+           (xGraph.at (a) == xGraph.at (b) && a > b);
+  };
+
+  m_indexesSorted.resize (count);
+  for (int index = 0; index < count; index++) {
+    m_indexesSorted [index] = index;
+  }
 
-  // Since m_points is a list (and therefore does not provide direct access to elements), we build a temporary map of
-  // point identifier to ordinal, by looping through the sorted x/theta values. Since QMap is used, the x/theta keys are sorted
-  QMap<QString, double> pointIdentifierToOrdinal;
-  int ordinal = 0;
-  XOrThetaToPointIdentifier::const_iterator itrX;
-  for (itrX = xOrThetaToPointIdentifier.begin(); itrX != xOrThetaToPointIdentifier.end(); itrX++) {
+  // The list is already in the order of the previous ordinals, so after an axis change the x/theta values are
+  // usually sorted or nearly so. Insertion sort handles that in close to one pass, and a full sort takes over if
+  // too many points move
+  int moves = 0;
+  int movesMax = MAX_INSERTION_SORT_MOVES_PER_POINT * count;
+  for (int ordinal = 1; (ordinal < count) && (moves <= movesMax); ordinal++) {
+    int index = m_indexesSorted.at (ordinal);
+    int ordinalNew = ordinal;
+    while ((ordinalNew > 0) &&
+           isBefore (index, m_indexesSorted.at (ordinalNew - 1))) {
+      m_indexesSorted [ordinalNew] = m_indexesSorted.at (ordinalNew - 1);
+      --ordinalNew;
+      ++moves;
+    }
+    m_indexesSorted [ordinalNew] = index;
+  }
 
-    QString pointIdentifier = itrX.value();
-    pointIdentifierToOrdinal [pointIdentifier] = ordinal++;
+  if (moves > movesMax) {
+    std::sort (m_indexesSorted.begin (),
+               m_indexesSorted.end (),
+               isBefore);
   }
 
   // Override the old ordinal values
-  for (itr = m_points.begin(); itr != m_points.end(); itr++) {
-    Point &point = *itr;
+  bool isReordered = false;
+  for (int ordinal = 0; ordinal < count; ordinal++) {
+    int index = m_indexesSorted.at (ordinal);
+    m_documentHash -= m_points.at (index).documentHash ();
+    m_points [index].setOrdinal (ordinal);
+    m_documentHash += m_points.at (index).documentHash ();
+    if (index != ordinal) {
+      isReordered = true;
+    }
+  }
 
-    // Make sure point is in the map list. If this test is skipped then the square bracket operator
-    // will insert an entry with a zero ordinal, and the presence of multiple points with the same zero ordinal will
-    // cause problems downstream
-    ENGAUGE_ASSERT (pointIdentifierToOrdinal.contains (point.identifier()));
+  // Rebuild the list in ordinal order, which is skipped in the common case that nothing moved past a neighbor
+  if (isReordered) {
+    Points pointsSorted;
+    pointsSorted.reserve (count);
+    for (int ordinal = 0; ordinal < count; ordinal++) {
+      pointsSorted.append (m_points.at (m_indexesSorted.at (ordinal)));
+    }
+    m_points = pointsSorted;
 
-    // Point is to be included since it is in the map list.
-    int ordinalNew = qFloor (pointIdentifierToOrdinal [point.identifier()]);
-    point.setOrdinal (ordinalNew);
+    updatePointIndexes ();
   }
 }
 
 void Curve::updatePointOrdinalsRelations ()
 {
-  CurveConnectAs curveConnectAs = m_curveStyle.lineStyle().curveConnectAs();
-
-    // Keep the ordinal numbering, but make sure the ordinals are evenly spaced
+    // Keep the ordinal numbering, but make sure the ordinals are evenly spaced. Points are numbered in list
+    // order, so the list stays sorted by ordinal
     Points::iterator itr;
     int ordinal = 0;
     for (itr = m_points.begin(); itr != m_points.end(); itr++) {
       Point &point = *itr;
+      m_documentHash -= point.documentHash ();
       point.setOrdinal (ordinal++);
+      m_documentHash += point.documentHash ();
     }
 }
@@ -10,12 +10,14 @@
 #include "CallbackSearchReturn.h"
 #include "ColorFilterSettings.h"
 #include "CurveStyle.h"
+#include "DocumentHash.h"
 #include "functor.h"
 #include "Point.h"
 #include "Points.h"
 #include <QHash>
 #include <QList>
 #include <QString>
+#include <QVector>
 
 extern const QString AXIS_CURVE_NAME;
 extern const QString DEFAULT_GRAPH_CURVE_NAME;
@@ -53,6 +55,10 @@ public:
   /// Add Point to this Curve.
   void addPoint (const Point &point);
 
+  /// Add many Points to this Curve, with storage reserved up front. Points of a function are merged into place by
+  /// ordinal, while points of a relation are appended in their current order.
+  void addPoints (const Points &points);
+
   /// Return the color filter.
   ColorFilterSettings colorFilterSettings () const;
 
@@ -62,6 +68,9 @@ public:
   /// Return the curve style
   CurveStyle curveStyle() const;
 
+  /// Sum of the Point digests, which is kept up to date as Points change so it costs nothing to read
+  DocumentHash documentHash () const;
+
   /// Edit the graph coordinates of an axis point. This method does not apply to a graph point
   void editPointAxis (const QPointF &posGraph,
                       const QString &identifier);
@@ -119,7 +128,7 @@ public:
   /// Set color filter.
   void setColorFilterSettings (const ColorFilterSettings &colorFilterSettings);
 
-  /// Change the curve name
+  /// Change the curve name. The Points are untouched since their identifier text is built from this name on request
   void setCurveName (const QString &curveName);
 
   /// Set curve style.
@@ -132,14 +141,25 @@ public:
 private:
   Curve();
 
+  int indexForPointIdentifier (const QString &pointIdentifier) const; // Index into m_points, or -1 if not in this curve
   void loadCurvePoints(QXmlStreamReader &reader);
   void loadXml(QXmlStreamReader &reader);
   Point *pointForPointIdentifier (const QString pointIdentifier);
+  void updatePointIndexes (int indexStart = 0);
   void updatePointOrdinalsFunctions (const Transformation &transformation);
   void updatePointOrdinalsRelations ();
 
   QString m_curveName;
   Points m_points;
+  QHash<unsigned int, int> m_pointIndexes; // Index into m_points for each point identifier number, kept in step with m_points
+  DocumentHash m_documentHash; // Sum of Point::documentHash over m_points, kept in step with m_points. Curve name is mixed in on request
+
+  // Transform batch for updatePointOrdinalsFunctions. The points themselves stay in m_points, and these only hold
+  // their coordinates in list order, transformed in place, plus the sorted order. They are kept between updates so
+  // the buffers are reused rather than reallocated, and are not copied with the Curve
+  QVector<double> m_xBatch; // Screen x, replaced by graph x/theta which gives the ordinals
+  QVector<double> m_yBatch; // Screen y, which the transformation needs along with x
+  QVector<int> m_indexesSorted;
 
   ColorFilterSettings m_colorFilterSettings;
   CurveStyle m_curveStyle;
@@ -22,27 +22,22 @@ CurvesGraphs::CurvesGraphs()
 
 void CurvesGraphs::addGraphCurveAtEnd (const Curve &curve)
 {
+  m_curveIndexes [curve.curveName ()] = m_curvesGraphs.count ();
   m_curvesGraphs.push_back (curve);
 }
 
-void CurvesGraphs::addPoint (const Point &point)
+void CurvesGraphs::addPoint (const QString &curveName,
+                             const Point &point)
 {
-  QString curveName = Point::curveNameFromPointIdentifier (point.identifier());
-
   Curve *curve = curveForCurveName (curveName);
   curve->addPoint (point);
 }
 
 Curve *CurvesGraphs::curveForCurveName (const QString &curveName)
 {
-  // Search for curve with matching name
-  CurveList::iterator itr;
-  for (itr = m_curvesGraphs.begin (); itr != m_curvesGraphs.end (); itr++) {
-
-    Curve &curve = *itr;
-    if (curveName == curve.curveName ()) {
-      return &curve;
-    }
+  int index = curveIndexForCurveName (curveName);
+  if (index >= 0) {
+    return &m_curvesGraphs [index];
   }
 
   return nullptr;
@@ -50,17 +45,40 @@ Curve *CurvesGraphs::curveForCurveName (const QString &curveName)
 
 const Curve *CurvesGraphs::curveForCurveName (const QString &curveName) const
 {
-  // Search for curve with matching name
-  CurveList::const_iterator itr;
-  for (itr = m_curvesGraphs.begin (); itr != m_curvesGraphs.end (); itr++) {
+  int index = curveIndexForCurveName (curveName);
+  if (index >= 0) {
+    return &m_curvesGraphs.at (index);
+  }
 
-    const Curve &curve = *itr;
-    if (curveName == curve.curveName ()) {
-      return &curve;
+  return nullptr;
+}
+
+int CurvesGraphs::curveIndexForCurveName (const QString &curveName) const
+{
+  // Curves can be renamed through the pointers returned by curveForCurveName, so the indexed entry is verified
+  int index = m_curveIndexes.value (curveName, -1);
+  if (index >= 0 &&
+      index < m_curvesGraphs.count () &&
+      m_curvesGraphs.at (index).curveName () == curveName) {
+    return index;
+  }
+
+  // Linear search is the fallback. The index is repaired as soon as a renamed curve is found, so only its first
+  // lookup is slow. Entries are only ever changed here after a rename, which never happens during the parallel
+  // lookups of exports
+  for (index = 0; index < m_curvesGraphs.count (); index++) {
+    if (m_curvesGraphs.at (index).curveName () == curveName) {
+      m_curveIndexes [curveName] = index;
+      return index;
     }
   }
 
-  return nullptr;
+  // Entry, if there is one, belongs to a curve that has since been renamed
+  if (m_curveIndexes.contains (curveName)) {
+    m_curveIndexes.remove (curveName);
+  }
+
+  return -1;
 }
 
 QStringList CurvesGraphs::curvesGraphsNames () const
@@ -79,17 +97,26 @@ QStringList CurvesGraphs::curvesGraphsNames () const
 
 int CurvesGraphs::curvesGraphsNumPoints (const QString &curveName) const
 {
-  // Search for curve with matching name
+  const Curve *curve = curveForCurveName (curveName);
+  if (curve != nullptr) {
+    return curve->numPoints ();
+  }
+
+  return 0;
+}
+
+DocumentHash CurvesGraphs::documentHash () const
+{
+  DocumentHash documentHash = 0;
+
+  // Curve order matters, as it did when every point was visited
   CurveList::const_iterator itr;
   for (itr = m_curvesGraphs.begin (); itr != m_curvesGraphs.end (); itr++) {
-
-    const Curve &curve = *itr;
-    if (curve.curveName () == curveName) {
-      return curve.numPoints ();
-    }
+    documentHash = documentHashMix (documentHash,
+                                    itr->documentHash ());
   }
 
-  return 0;
+  return documentHash;
 }
 
 void CurvesGraphs::editPointGraph (bool isX,
@@ -115,16 +142,11 @@ void CurvesGraphs::editPointGraph (bool isX,
 void CurvesGraphs::iterateThroughCurvePoints (const QString &curveNameWanted,
                                               const Functor2wRet<const QString &, const Point &, CallbackSearchReturn> &ftorWithCallback)
 {
-  // Search for curve with matching name
-  CurveList::const_iterator itr;
-  for (itr = m_curvesGraphs.begin (); itr != m_curvesGraphs.end (); itr++) {
+  const Curve *curve = curveForCurveName (curveNameWanted);
+  if (curve != nullptr) {
 
-    const Curve &curve = *itr;
-    if (curve.curveName () == curveNameWanted) {
-
-      curve.iterateThroughCurvePoints (ftorWithCallback);
-      return;
-    }
+    curve->iterateThroughCurvePoints (ftorWithCallback);
+    return;
   }
 
   ENGAUGE_ASSERT (false);
@@ -133,16 +155,11 @@ void CurvesGraphs::iterateThroughCurvePoints (const QString &curveNameWanted,
 void CurvesGraphs::iterateThroughCurveSegments (const QString &curveNameWanted,
                                                 const Functor2wRet<const Point &, const Point &, CallbackSearchReturn> &ftorWithCallback) const
 {
-  // Search for curve with matching name
-  CurveList::const_iterator itr;
-  for (itr = m_curvesGraphs.begin (); itr != m_curvesGraphs.end (); itr++) {
+  const Curve *curve = curveForCurveName (curveNameWanted);
+  if (curve != nullptr) {
 
-    const Curve &curve = *itr;
-    if (curve.curveName () == curveNameWanted) {
-
-      curve.iterateThroughCurveSegments (ftorWithCallback);
-      return;
-    }
+    curve->iterateThroughCurveSegments (ftorWithCallback);
+    return;
   }
 
   ENGAUGE_ASSERT (false);
@@ -175,12 +192,13 @@ void CurvesGraphs::loadPreVersion6(QDataStream &str)
 
   // Remove previous Curves. There is a DEFAULT_GRAPH_CURVE_NAME by default
   m_curvesGraphs.clear();
+  m_curveIndexes.clear();
 
   qint32 numberCurvesGraphs;
   str >> numberCurvesGraphs;
   for (i = 0; i < numberCurvesGraphs; i++) {
     Curve curve (str);
-    m_curvesGraphs.append (curve);
+    addGraphCurveAtEnd (curve);
   }
 
   qint32 numberCurvesMeasures;
@@ -199,6 +217,7 @@ void CurvesGraphs::loadXml(QXmlStreamReader &reader)
 
   // Remove previous Curves. There is a DEFAULT_GRAPH_CURVE_NAME by default
   m_curvesGraphs.clear();
+  m_curveIndexes.clear();
 
   // Read until end of this subtree
   while ((reader.tokenType() != QXmlStreamReader::EndElement) ||
@@ -219,13 +238,13 @@ void CurvesGraphs::loadXml(QXmlStreamReader &reader)
       // curve names can result in crashes and/or corruption, so we deconflict duplicate curve names here
       QString DUPLICATE = QString ("-%1").arg (QObject::tr ("DUPLICATE"));
       QString curveName = curve.curveName();
-      while (curvesGraphsNames().contains (curveName)) {
+      while (m_curveIndexes.contains (curveName)) {
         curveName += DUPLICATE;
       }
       curve.setCurveName (curveName); // No effect if curve name was not a duplicate
 
       // Add the curve
-      m_curvesGraphs.push_back (curve);
+      addGraphCurveAtEnd (curve);
 
     }
   }
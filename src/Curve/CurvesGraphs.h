@@ -9,6 +9,7 @@
 
 #include "CallbackSearchReturn.h"
 #include "Curve.h"
+#include <QHash>
 #include <QList>
 #include <QStringList>
 
@@ -30,7 +31,8 @@ public:
   void addGraphCurveAtEnd (const Curve &curve);
 
   /// Append new Point to the specified Curve.
-  void addPoint (const Point &point);
+  void addPoint (const QString &curveName,
+                 const Point &point);
 
   /// Return the axis or graph curve for the specified curve name.
   Curve *curveForCurveName (const QString &curveName);
@@ -44,6 +46,9 @@ public:
   /// Point count.
   int curvesGraphsNumPoints (const QString &curveName) const;
 
+  /// Digest of all graph curves, from the digests that each Curve keeps up to date. Cost is per curve rather than per point
+  DocumentHash documentHash () const;
+
   /// Set the x and/or y coordinate values of the specified points
   void editPointGraph (bool isX,
                        bool isY,
@@ -90,7 +95,10 @@ public:
 
 private:
 
+  int curveIndexForCurveName (const QString &curveName) const;
+
   CurveList m_curvesGraphs;
+  mutable QHash<QString, int> m_curveIndexes; // Index into m_curvesGraphs for each curve name. Repaired after renames
 };
 
 #endif // CURVES_GRAPHS_H
@@ -66,7 +66,7 @@ bool DigitizeStateColorPicker::computeFilterFromPixel (CmdMediator *cmdMediator,
 
   // Filter for background color now, and then later, once filter mode is set, processing of image
   ColorFilter filter;
-  QImage image = cmdMediator->document().pixmap().toImage();
+  QImage image = cmdMediator->document().image();
   QRgb rgbBackground = filter.marginColor(&image);
 
   // Adjust screen position so truncation gives round-up behavior
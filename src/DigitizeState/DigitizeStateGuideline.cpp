@@ -210,6 +210,9 @@ void DigitizeStateGuideline::lockNonGuidelinesAndUnlockGuidelines (bool lockdown
 
     }
   }
+
+  // Points outside of the view may be detached from their graphics items, so they are not in the loop above
+  context().mainWindow().scene().setPointsEditable (!lockdown);
 }
 
 QString DigitizeStateGuideline::state() const
@@ -57,6 +57,9 @@ void DigitizeStateSelect::addHoverHighlighting()
        item->setAcceptHoverEvents(true);
     }
   }
+
+  // Points outside of the view may be detached from their graphics items, so they are not in the loop above
+  context().mainWindow().scene().setPointsAcceptHoverEvents (true);
 }
 
 void DigitizeStateSelect::begin (CmdMediator *cmdMediator,
@@ -388,6 +391,9 @@ void DigitizeStateSelect::removeHoverHighlighting()
        item->setAcceptHoverEvents(false);
     }
   }
+
+  // Points outside of the view may be detached from their graphics items, so they are not in the loop above
+  context().mainWindow().scene().setPointsAcceptHoverEvents (false);
 }
 
 double DigitizeStateSelect::scaleBarLength (CmdMediator *cmdMediator) const
@@ -425,6 +431,9 @@ void DigitizeStateSelect::setHoverHighlighting(const MainWindowModel &modelMainW
        item->setOpacity (modelMainWindow.highlightOpacity());
     }
   }
+
+  // Points outside of the view may be detached from their graphics items, so they are not in the loop above
+  context().mainWindow().scene().setPointsOpacity (modelMainWindow.highlightOpacity());
 }
 
 void DigitizeStateSelect::showCoordinatesIfSinglePointIsSelected ()
@@ -7,10 +7,10 @@
 #include "DlgFilterThread.h"
 #include "DlgSettingsColorFilter.h"
 
-DlgFilterThread::DlgFilterThread(const QPixmap &pixmapOriginal,
+DlgFilterThread::DlgFilterThread(const QImage &imageOriginal,
                                  QRgb rgbBackground,
                                  DlgSettingsColorFilter &dlgSettingsColorFilter) :
-  m_pixmapOriginal (pixmapOriginal),
+  m_imageOriginal (imageOriginal),
   m_rgbBackground (rgbBackground),
   m_dlgSettingsColorFilter (dlgSettingsColorFilter),
   m_dlgFilterWorker (nullptr)
@@ -22,7 +22,7 @@ void DlgFilterThread::run ()
   // Create worker only once
   if (m_dlgFilterWorker == nullptr) {
 
-    m_dlgFilterWorker = new DlgFilterWorker (m_pixmapOriginal,
+    m_dlgFilterWorker = new DlgFilterWorker (m_imageOriginal,
                                              m_rgbBackground);
 
     // Connect signal to start process
@@ -8,8 +8,8 @@
 #define DLG_FILTER_THREAD_H
 
 #include "DlgFilterWorker.h"
+#include <QImage>
 #include <QObject>
-#include <QPixmap>
 #include <QThread>
 
 class DlgSettingsColorFilter;
@@ -21,7 +21,7 @@ class DlgFilterThread : public QThread
 
 public:
   /// Single constructor.
-  DlgFilterThread(const QPixmap &pixmapOriginal,
+  DlgFilterThread(const QImage &imageOriginal,
                   QRgb rgbBackground,
                   DlgSettingsColorFilter &dlgSettingsColorFilter);
 
@@ -36,7 +36,7 @@ signals:
 private:
   DlgFilterThread();
 
-  QPixmap m_pixmapOriginal;
+  QImage m_imageOriginal;
   QRgb m_rgbBackground;
 
   DlgSettingsColorFilter &m_dlgSettingsColorFilter;
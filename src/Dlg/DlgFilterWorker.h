@@ -12,7 +12,6 @@
 #include <QImage>
 #include <QList>
 #include <QObject>
-#include <QPixmap>
 #include <QRgb>
 #include <QTimer>
 
@@ -25,7 +24,7 @@ class DlgFilterWorker : public QObject
 
 public:
   /// Single constructor.
-  DlgFilterWorker(const QPixmap &pixmapOriginal,
+  DlgFilterWorker(const QImage &imageOriginal,
                   QRgb m_rgbBackground);
 
 public slots:
@@ -199,14 +199,14 @@ QRgb DlgSettingsColorFilter::createThread ()
 {
 
   // Get background color
-  QImage image = cmdMediator().document().pixmap().toImage();
+  QImage image = cmdMediator().document().image();
   ColorFilter filter;
   QRgb rgbBackground = filter.marginColor(&image);
 
   // Only create thread once
   if (m_filterThread == nullptr) {
 
-    m_filterThread = new DlgFilterThread (cmdMediator().document().pixmap(),
+    m_filterThread = new DlgFilterThread (image,
                                           rgbBackground,
                                           *this);
     m_filterThread->start(); // Now that thread is started, we can use signalApplyFilter
@@ -276,7 +276,7 @@ void DlgSettingsColorFilter::loadForCurveName()
     m_btnValue->setChecked (colorFilterMode == COLOR_FILTER_MODE_VALUE);
 
     m_scenePreview->clear();
-    m_imagePreview = cmdMediator().document().pixmap().toImage();
+    m_imagePreview = cmdMediator().document().image();
     addPixmap (*m_scenePreview,
                QPixmap::fromImage (m_imagePreview));
 
@@ -405,7 +405,7 @@ void DlgSettingsColorFilter::updateHistogram()
   m_scale->setColorFilterMode (m_modelColorFilterAfter->colorFilterMode(curveName));
 
   // Start with original image
-  QImage image = cmdMediator().document().pixmap().toImage();
+  QImage image = cmdMediator().document().image();
 
   double *histogramBins = new double [unsigned (ColorFilterHistogram::HISTOGRAM_BINS ())];
 
@@ -56,6 +56,8 @@ const QString EMPTY_PREVIEW;
 const int MINIMUM_DIALOG_WIDTH_EXPORT_FORMAT = 600;
 const int MINIMUM_HEIGHT = 780;
 
+const int PREVIEW_ROW_LIMIT = 1000; // Rows shown for each table, since the preview only shows the formatting
+
 DlgSettingsExportFormat::DlgSettingsExportFormat(MainWindow &mainWindow) :
   DlgSettingsAbstractBase (tr ("Export Format"),
                            "DlgSettingsExportFormat",
@@ -1185,6 +1187,7 @@ void DlgSettingsExportFormat::updatePreview()
                                                                                                   filename);
 
     ExportFileFunctions exportStrategyFunctions;
+    exportStrategyFunctions.setRowLimit (PREVIEW_ROW_LIMIT);
     exportStrategyFunctions.exportToFile (modelAfterWithFileExtension,
                                           cmdMediator().document(),
                                           mainWindow().modelMainWindow(),
@@ -1194,6 +1197,7 @@ void DlgSettingsExportFormat::updatePreview()
                                           isOverrunFunctions);
 
     ExportFileRelations exportStrategyRelations;
+    exportStrategyRelations.setRowLimit (PREVIEW_ROW_LIMIT);
     exportStrategyRelations.exportToFile (modelAfterWithFileExtension,
                                           cmdMediator().document(),
                                           mainWindow().modelMainWindow(),
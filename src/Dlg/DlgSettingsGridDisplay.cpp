@@ -368,7 +368,7 @@ void DlgSettingsGridDisplay::load (CmdMediator &cmdMediator)
   m_spinLineWidth->setValue (m_modelGridDisplayAfter->lineWidth ());
 
   addPixmap (*m_scenePreview,
-             cmdMediator.document().pixmap());
+             QPixmap::fromImage (cmdMediator.document().image ()));
 
   updateControls ();
   enableOk (false); // Disable Ok button since there not yet any changes
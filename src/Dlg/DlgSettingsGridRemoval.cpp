@@ -20,6 +20,7 @@
 #include <QGridLayout>
 #include <QGroupBox>
 #include <QHBoxLayout>
+#include <QImage>
 #include <QLabel>
 #include <QLineEdit>
 #include <QPixmap>
@@ -597,11 +598,11 @@ void DlgSettingsGridRemoval::updatePreview ()
 {
   GridRemoval gridRemoval (mainWindow().isGnuplot());
 
-  QPixmap pixmap = gridRemoval.remove (mainWindow ().transformation(),
-                                       *m_modelGridRemovalAfter,
-                                       cmdMediator ().document().pixmap().toImage());
+  QImage image = gridRemoval.remove (mainWindow ().transformation(),
+                                     *m_modelGridRemovalAfter,
+                                     cmdMediator ().document().image());
 
   m_scenePreview->clear();
   addPixmap (*m_scenePreview,
-             pixmap);
+             QPixmap::fromImage (image));
 }
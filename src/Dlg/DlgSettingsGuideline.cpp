@@ -306,11 +306,11 @@ void DlgSettingsGuideline::loadImages (CmdMediator &cmdMediator)
   m_scenePreviewActive->clear();
   m_scenePreviewInactive->clear();
 
-  QImage imagePreviewActive = cmdMediator.document().pixmap().toImage();
+  QImage imagePreviewActive = cmdMediator.document().image();
   addPixmap (*m_scenePreviewActive,
              QPixmap::fromImage (imagePreviewActive));
 
-  QImage imagePreviewInactive = cmdMediator.document().pixmap().toImage();
+  QImage imagePreviewInactive = cmdMediator.document().image();
   addPixmap (*m_scenePreviewInactive,
              QPixmap::fromImage (imagePreviewInactive));
 }
@@ -43,11 +43,17 @@ const int MAX_GRID_LINES_MIN = 2;
 const int MAX_GRID_LINES_MAX = 1000;
 const int MINIMUM_DIALOG_WIDTH_MAIN_WINDOW = 550;
 
-// The limits for exported points must include DEFAULT_MAXIMUM_EXPORTED_POINTS_PER_CURVE. The max
-// is not very large since that would correspond to more points than pixels in the picture
+// The limits for exported points must include DEFAULT_MAXIMUM_EXPORTED_POINTS_PER_CURVE. Exported rows are written
+// as they are generated, so the max only has to keep the export interval from being unreasonably small
 const int STEP_MAX_EXPORTED_POINTS_PER_CURVE = 100; // Min and max should probably both be a multiple of this step size
 const int MIN_MAX_EXPORTED_POINTS_PER_CURVE = STEP_MAX_EXPORTED_POINTS_PER_CURVE * 1;
-const int MAX_MAX_EXPORTED_POINTS_PER_CURVE = STEP_MAX_EXPORTED_POINTS_PER_CURVE * 50;
+const int MAX_MAX_EXPORTED_POINTS_PER_CURVE = STEP_MAX_EXPORTED_POINTS_PER_CURVE * 100000;
+
+// The limits for the tile cache must include DEFAULT_TILE_CACHE_MEGABYTES. The min may not hold the tiles for one screen,
+// in which case GraphicsImageTiled raises its cache to fit the view
+const int STEP_TILE_CACHE_MEGABYTES = 32;
+const int MIN_TILE_CACHE_MEGABYTES = STEP_TILE_CACHE_MEGABYTES * 1;
+const int MAX_TILE_CACHE_MEGABYTES = STEP_TILE_CACHE_MEGABYTES * 128;
 
 DlgSettingsMainWindow::DlgSettingsMainWindow(MainWindow &mainWindow) :
   DlgSettingsAbstractBase (tr ("Main Window"),
@@ -198,12 +204,26 @@ void DlgSettingsMainWindow::createControls (QGridLayout *layout,
   m_spinMaximumExportedPointsPerCurve->setRange (MIN_MAX_EXPORTED_POINTS_PER_CURVE, MAX_MAX_EXPORTED_POINTS_PER_CURVE);
   m_spinMaximumExportedPointsPerCurve->setSingleStep (STEP_MAX_EXPORTED_POINTS_PER_CURVE);
   m_spinMaximumExportedPointsPerCurve->setWhatsThis (tr ("Maximum Exported Points per Curve\n\n"
-                                                         "This is the maximum number of points allowed in each exported curve. No points are "
-                                                         "exported when this is exceeded. This limit prevents delays and overly large file sizes due "
+                                                         "This is the maximum number of points expected in each exported curve. The interval "
+                                                         "between exported points cannot be set so small that this is exceeded, and the export "
+                                                         "preview warns when it is. This limit prevents delays and overly large file sizes due "
                                                          "to curves that have too many points."));
   connect (m_spinMaximumExportedPointsPerCurve, SIGNAL (valueChanged (int)), this, SLOT (slotMaximumExportedPointsPerCurve (int)));
   layout->addWidget (m_spinMaximumExportedPointsPerCurve, row++, 2);
 
+  QLabel *labelTileCache = new QLabel (QString ("%1:").arg (tr ("Image tile cache (MB)")));
+  layout->addWidget (labelTileCache, row, 1);
+
+  m_spinTileCacheMegabytes = new QSpinBox;
+  m_spinTileCacheMegabytes->setRange (MIN_TILE_CACHE_MEGABYTES, MAX_TILE_CACHE_MEGABYTES);
+  m_spinTileCacheMegabytes->setSingleStep (STEP_TILE_CACHE_MEGABYTES);
+  m_spinTileCacheMegabytes->setWhatsThis (tr ("Image Tile Cache\n\n"
+                                              "Maximum memory, in megabytes, used for the visible pieces of the background image. "
+                                              "A larger value makes scrolling and zooming of very large images smoother, at the "
+                                              "cost of more memory."));
+  connect (m_spinTileCacheMegabytes, SIGNAL (valueChanged (int)), this, SLOT (slotTileCacheMegabytes (int)));
+  layout->addWidget (m_spinTileCacheMegabytes, row++, 2);
+
   QLabel *labelHighlightOpacity = new QLabel (QString ("%1:").arg (tr ("Highlight opacity")));
   layout->addWidget (labelHighlightOpacity, row, 1);
 
@@ -379,6 +399,7 @@ void DlgSettingsMainWindow::loadMainWindowModel (CmdMediator &cmdMediator,
   m_spinSignificantDigits->setValue (m_modelMainWindowAfter->significantDigits ());
   m_chkImageReplaceRenamesDocument->setChecked (m_modelMainWindowAfter->imageReplaceRenamesDocument());
   m_spinMaximumExportedPointsPerCurve->setValue (m_modelMainWindowAfter->maximumExportedPointsPerCurve());
+  m_spinTileCacheMegabytes->setValue (m_modelMainWindowAfter->tileCacheMegabytes());
   
   updateControls ();
   enableOk (false); // Disable Ok button since there not yet any changes
@@ -475,6 +496,13 @@ void DlgSettingsMainWindow::slotSmallDialogs (bool)
   updateControls ();
 }
 
+void DlgSettingsMainWindow::slotTileCacheMegabytes (int megabytes)
+{
+
+  m_modelMainWindowAfter->setTileCacheMegabytes (megabytes);
+  updateControls ();
+}
+
 void DlgSettingsMainWindow::slotTitleBarFormat(bool)
 {
 
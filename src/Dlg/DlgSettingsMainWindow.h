@@ -53,6 +53,7 @@ private slots:
   void slotRecentFileClear ();
   void slotSignificantDigits (int);
   void slotSmallDialogs(bool);
+  void slotTileCacheMegabytes (int megabytes);
   void slotTitleBarFormat(bool);
   void slotWhatsThis();
   void slotZoomControl (const QString);
@@ -80,6 +81,7 @@ private:
   QComboBox *m_cmbPdfResolution;
   QSpinBox *m_spinMaximumGridLines;
   QSpinBox *m_spinMaximumExportedPointsPerCurve;
+  QSpinBox *m_spinTileCacheMegabytes;
   QDoubleSpinBox *m_spinHighlightOpacity;
   QCheckBox *m_chkSmallDialogs;
   QCheckBox *m_chkDragDropExport;
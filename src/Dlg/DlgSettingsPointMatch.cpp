@@ -199,8 +199,8 @@ void DlgSettingsPointMatch::handleOk ()
 void DlgSettingsPointMatch::initializeBox ()
 {
 
-  m_circle->setPos (cmdMediator().document().pixmap().width () / 2.0,
-                    cmdMediator().document().pixmap().height () / 2.0); // Initially box is in center of preview
+  m_circle->setPos (cmdMediator().document().image().width () / 2.0,
+                    cmdMediator().document().image().height () / 2.0); // Initially box is in center of preview
 }
 
 void DlgSettingsPointMatch::load (CmdMediator &cmdMediator)
@@ -240,12 +240,12 @@ void DlgSettingsPointMatch::load (CmdMediator &cmdMediator)
   // Fix the preview size using an invisible boundary
   QGraphicsRectItem *boundary = m_scenePreview->addRect (QRect (0,
                                                                 0,
-                                                                cmdMediator.document().pixmap().width (),
-                                                                cmdMediator.document().pixmap().height ()));
+                                                                cmdMediator.document().image().width (),
+                                                                cmdMediator.document().image().height ()));
   boundary->setVisible (false);
 
   addPixmap (*m_scenePreview,
-             cmdMediator.document().pixmap());
+             QPixmap::fromImage (cmdMediator.document().image ()));
 
   updateControls();
   enableOk (false); // Disable Ok button since there not yet any changes
@@ -15,6 +15,7 @@
 #include "CurveStyle.h"
 #include "CurveStyles.h"
 #include "Document.h"
+#include "DocumentContainer.h"
 #include "DocumentSerialize.h"
 #include "EngaugeAssert.h"
 #include "EnumsToQt.h"
@@ -24,11 +25,13 @@
 #include "OrdinalGenerator.h"
 #include "Point.h"
 #include "PointStyle.h"
+#include <QBuffer>
 #include <QByteArray>
 #include <QDataStream>
 #include <QDebug>
 #include <QDomDocument>
 #include <QFile>
+#include <QFileInfo>
 #include <QImage>
 #include <qmath.h>
 #include <QObject>
@@ -53,6 +56,7 @@ const int VERSION_13 = 13;
 
 Document::Document (const QImage &image) :
   m_name ("untitled"),
+  m_imagePendingFileSize (0),
   m_documentAxesPointsRequired (DOCUMENT_AXES_POINTS_REQUIRED_3)
 {
 
@@ -60,11 +64,12 @@ Document::Document (const QImage &image) :
 
   m_successfulRead = true; // Reading from QImage always succeeds, resulting in empty Document
 
-  m_pixmap.convertFromImage (image);
+  m_image = image;
 }
 
 Document::Document (const QString &fileName) :
   m_name (fileName),
+  m_imagePendingFileSize (0),
   m_documentAxesPointsRequired (DOCUMENT_AXES_POINTS_REQUIRED_3)
 {
 
@@ -77,7 +82,11 @@ Document::Document (const QString &fileName) :
     QByteArray bytesStart = fileVersion.read (FOUR_BYTES);
     fileVersion.close ();
 
-    if (bytesIndicatePreVersion6 (bytesStart)) {
+    if (DocumentContainer::bytesIndicateContainer (bytesStart)) {
+
+      loadContainer (fileName);
+
+    } else if (bytesIndicatePreVersion6 (bytesStart)) {
 
       QFile *file = new QFile (fileName);
       if (file->open (QIODevice::ReadOnly)) {
@@ -97,32 +106,7 @@ Document::Document (const QString &fileName) :
       QFile *file = new QFile (fileName);
       if (file->open (QIODevice::ReadOnly | QIODevice::Text)) {
 
-        int version = versionFromFile (file);
-        switch (version)
-        {
-          case VERSION_6:
-            loadVersion6 (file);
-            break;
-
-          case VERSION_7:
-          case VERSION_8:
-          case VERSION_9:
-          case VERSION_10:
-          case VERSION_11:
-          case VERSION_12:
-          case VERSION_13:
-            loadVersions7AndUp (file);
-            break;
-
-          default:
-            m_successfulRead = false;
-            m_reasonForUnsuccessfulRead = QString ("Engauge %1 %2 %3 %4 Engauge")
-                                          .arg (VERSION_NUMBER)
-                                          .arg (QObject::tr ("cannot read newer files from version"))
-                                          .arg (version)
-                                          .arg (QObject::tr ("of"));\
-            break;
-        }
+        loadXml (file);
 
         // Close and deactivate
         file->close ();
@@ -209,6 +193,18 @@ void Document::addPointGraphWithSpecifiedIdentifier (const QString &curveName,
                                                             ordinal);
 }
 
+void Document::addPointsGraphWithGeneratedIdentifiers (const QString &curveName,
+                                                       const QList<QPoint> &positionsScreen,
+                                                       const QList<double> &ordinals,
+                                                       QStringList &generatedIdentifiers)
+{
+
+  m_coordSystemContext.addPointsGraphWithGeneratedIdentifiers(curveName,
+                                                              positionsScreen,
+                                                              ordinals,
+                                                              generatedIdentifiers);
+}
+
 void Document::addPointsInCurvesGraphs (CurvesGraphs &curvesGraphs)
 {
 
@@ -337,6 +333,62 @@ int Document::curvesGraphsNumPoints(const QString &curveName) const
   return m_coordSystemContext.curvesGraphsNumPoints(curveName);
 }
 
+bool Document::decodePendingImage (QString &reasonForUnsuccessfulRead) const
+{
+  if (!m_imagePendingFileName.isEmpty ()) {
+
+    // Pending location is kept after any failure, so the image is not silently replaced by an empty one and
+    // saving fails instead
+
+    // Member offsets recorded during loading are meaningless if the file was changed since then
+    QFileInfo info (m_imagePendingFileName);
+    if (!info.exists () ||
+        (info.size () != m_imagePendingFileSize) ||
+        (info.lastModified () != m_imagePendingFileModified)) {
+
+      reasonForUnsuccessfulRead = QObject::tr ("File was changed after it was loaded, so its image cannot be read");
+      return false;
+    }
+
+    QImage image;
+    QFile file (m_imagePendingFileName);
+    if (file.open (QIODevice::ReadOnly)) {
+      image = m_imagePendingContainer.readImage (file);
+    }
+
+    if (image.isNull ()) {
+
+      reasonForUnsuccessfulRead = QObject::tr ("Cannot read image data");
+      return false;
+    }
+
+    m_image = image;
+    m_imagePendingFileName = "";
+
+  } else if (!m_imagePendingBase64.isEmpty ()) {
+
+    // Decoded array
+    QByteArray array;
+    array = QByteArray::fromBase64(m_imagePendingBase64);
+
+    // Read decoded array into image
+    QImage image;
+    QDataStream str (&array, QIODevice::ReadOnly);
+    str >> image;
+
+    if (image.isNull ()) {
+
+      reasonForUnsuccessfulRead = QObject::tr ("Cannot read image data");
+      return false;
+    }
+
+    m_image = image;
+    m_imagePendingBase64.clear ();
+  }
+
+  return true;
+}
+
 DocumentAxesPointsRequired Document::documentAxesPointsRequired () const
 {
   return m_documentAxesPointsRequired;
@@ -369,6 +421,11 @@ void Document::editPointGraph (bool isX,
 void Document::generateEmptyPixmap(const QXmlStreamAttributes &attributes)
 {
 
+  if (attributes.hasAttribute (DOCUMENT_SERIALIZE_IMAGE_IN_CONTAINER)) {
+    // Image will come from the container member when it is first needed, so there is no point allocating a placeholder
+    return;
+  }
+
   int width = 800, height = 500; // Defaults
 
   if (attributes.hasAttribute (DOCUMENT_SERIALIZE_IMAGE_WIDTH) &&
@@ -379,7 +436,17 @@ void Document::generateEmptyPixmap(const QXmlStreamAttributes &attributes)
 
   }
 
-  m_pixmap = QPixmap (width, height);
+  m_image = QImage (width,
+                    height,
+                    QImage::Format_RGB32);
+}
+
+QImage Document::image () const
+{
+  QString reasonForUnsuccessfulRead; // Failure leaves the previous image, and is reported when saving
+  decodePendingImage (reasonForUnsuccessfulRead);
+
+  return m_image;
 }
 
 void Document::initializeGridDisplay (const Transformation &transformation)
@@ -408,7 +475,7 @@ void Document::initializeGridDisplay (const Transformation &transformation)
                                                                                                  boundingRectGraphMax,
                                                                                                  modelCoords(),
                                                                                                  transformation,
-                                                                                                 m_pixmap.size ());
+                                                                                                 image ().size ());
 
     m_coordSystemContext.setModelGridDisplay (modelGridDisplay);
   }
@@ -451,24 +518,75 @@ void Document::iterateThroughCurvesPointsGraphs (const Functor2wRet<const QStrin
   m_coordSystemContext.iterateThroughCurvesPointsGraphs(ftorWithCallback);
 }
 
+void Document::loadContainer (const QString &fileName)
+{
+  QFile file (fileName);
+  if (!file.open (QIODevice::ReadOnly)) {
+
+    m_successfulRead = false;
+    m_reasonForUnsuccessfulRead = QObject::tr ("Operating system says file is not readable");
+    return;
+  }
+
+  DocumentContainer container;
+  if (!container.readLayout (file)) {
+
+    m_successfulRead = false;
+    m_reasonForUnsuccessfulRead = QObject::tr ("File is incomplete or was written by a newer version of Engauge");
+    return;
+  }
+
+  // The xml member is small. The much larger image member is decoded straight from the file later
+  QByteArray xml = container.readXml (file);
+  QBuffer buffer (&xml);
+  buffer.open (QIODevice::ReadOnly | QIODevice::Text);
+
+  loadXml (&buffer);
+
+  if (m_successfulRead) {
+
+    // Only the image header is checked here. Decoding is deferred until image is called, which never happens
+    // in export-only runs
+    if (container.canReadImage (file)) {
+
+      QFileInfo info (fileName);
+      m_imagePendingFileName = fileName;
+      m_imagePendingFileSize = info.size ();
+      m_imagePendingFileModified = info.lastModified ();
+      m_imagePendingContainer = container;
+
+    } else {
+
+      m_successfulRead = false;
+      m_reasonForUnsuccessfulRead = QObject::tr ("Cannot read image data");
+    }
+  }
+}
+
 void Document::loadImage(QXmlStreamReader &reader)
 {
 
-  loadNextFromReader(reader); // Read to CDATA
-  if (reader.isCDATA ()) {
+  QXmlStreamAttributes attributes = reader.attributes();
+  if (attributes.hasAttribute (DOCUMENT_SERIALIZE_IMAGE_IN_CONTAINER) &&
+      (attributes.value (DOCUMENT_SERIALIZE_IMAGE_IN_CONTAINER).toString() == DOCUMENT_SERIALIZE_BOOL_TRUE)) {
 
-    // Get base64 array
-    QByteArray array64 = reader.text().toString().toUtf8();
+    // Image is in its own container member, which loadContainer reads after the xml. Until then, the
+    // empty pixmap from generateEmptyPixmap is used
 
-    // Decoded array
-    QByteArray array;
-    array = QByteArray::fromBase64(array64);
+    // Read until end of this subtree
+    while ((reader.tokenType() != QXmlStreamReader::EndElement) ||
+           (reader.name() != DOCUMENT_SERIALIZE_IMAGE)){
+      loadNextFromReader(reader);
+    }
 
-    // Read decoded array into image
-    QDataStream str (&array, QIODevice::ReadOnly);
-    QImage img = m_pixmap.toImage ();
-    str >> img;
-    m_pixmap = QPixmap::fromImage (img);
+    return;
+  }
+
+  loadNextFromReader(reader); // Read to CDATA
+  if (reader.isCDATA ()) {
+
+    // Get base64 array. Decoding is deferred until image is called, which never happens in export-only runs
+    m_imagePendingBase64 = reader.text().toString().toUtf8();
 
     // Read until end of this subtree
     while ((reader.tokenType() != QXmlStreamReader::EndElement) ||
@@ -496,7 +614,7 @@ void Document::loadPreVersion6 (QDataStream &str)
   str >> version;
   str >> st; // Version string
   str >> int32; // Background
-  str >> m_pixmap;
+  str >> m_image; // Streamed QPixmap and QImage share the same format
   str >> m_name;
 
   m_coordSystemContext.loadPreVersion6 (str,
@@ -504,10 +622,10 @@ void Document::loadPreVersion6 (QDataStream &str)
                                         m_documentAxesPointsRequired); // Returns axes points required
 }
 
-void Document::loadVersion6 (QFile *file)
+void Document::loadVersion6 (QIODevice *device)
 {
 
-  QXmlStreamReader reader (file);
+  QXmlStreamReader reader (device);
 
   m_documentAxesPointsRequired = DOCUMENT_AXES_POINTS_REQUIRED_3;
 
@@ -574,12 +692,12 @@ void Document::loadVersion6 (QFile *file)
   // There are already one axes curve and at least one graph curve so we do not need to add any more graph curves
 }
 
-void Document::loadVersions7AndUp (QFile *file)
+void Document::loadVersions7AndUp (QIODevice *device)
 {
 
   const int ONE_COORDINATE_SYSTEM = 1;
 
-  QXmlStreamReader reader (file);
+  QXmlStreamReader reader (device);
 
   // If this is purely a serialized Document then we process every node under the root. However, if this is an error report file
   // then we need to skip the non-Document stuff. The common solution is to skip nodes outside the Document subtree using this flag
@@ -646,6 +764,36 @@ void Document::loadVersions7AndUp (QFile *file)
   // There are already one axes curve and at least one graph curve so we do not need to add any more graph curves
 }
 
+void Document::loadXml (QIODevice *device)
+{
+  int version = versionFromFile (device);
+  switch (version)
+  {
+    case VERSION_6:
+      loadVersion6 (device);
+      break;
+
+    case VERSION_7:
+    case VERSION_8:
+    case VERSION_9:
+    case VERSION_10:
+    case VERSION_11:
+    case VERSION_12:
+    case VERSION_13:
+      loadVersions7AndUp (device);
+      break;
+
+    default:
+      m_successfulRead = false;
+      m_reasonForUnsuccessfulRead = QString ("Engauge %1 %2 %3 %4 Engauge")
+                                    .arg (VERSION_NUMBER)
+                                    .arg (QObject::tr ("cannot read newer files from version"))
+                                    .arg (version)
+                                    .arg (QObject::tr ("of"));
+      break;
+  }
+}
+
 DocumentModelAxesChecker Document::modelAxesChecker() const
 {
   return m_coordSystemContext.modelAxesChecker();
@@ -770,11 +918,6 @@ void Document::overrideGraphDefaultsWithMapDefaults ()
   setModelCurveStyles (curveStyles);
 }
 
-QPixmap Document::pixmap () const
-{                               
-  return m_pixmap;
-}
-
 QPointF Document::positionGraph (const QString &pointIdentifier) const
 {
   return m_coordSystemContext.positionGraph(pointIdentifier);
@@ -803,7 +946,7 @@ void Document::printStream (QString indentation,
   indentation += INDENTATION_DELTA;
 
   str << indentation << "name=" << m_name << "\n";
-  str << indentation << "pixmap=" << m_pixmap.width() << "x" <<  m_pixmap.height() << "\n";
+  str << indentation << "image=" << image().width() << "x" <<  image().height() << "\n";
 
   m_coordSystemContext.printStream(indentation,
                       str);
@@ -834,7 +977,8 @@ void Document::removePointsInCurvesGraphs (CurvesGraphs &curvesGraphs)
   m_coordSystemContext.removePointsInCurvesGraphs(curvesGraphs);
 }
 
-void Document::saveXml (QXmlStreamWriter &writer) const
+void Document::saveXml (QXmlStreamWriter &writer,
+                        DocumentImageStorage imageStorage) const
 {
   writer.writeStartElement(DOCUMENT_SERIALIZE_DOCUMENT);
 
@@ -845,19 +989,30 @@ void Document::saveXml (QXmlStreamWriter &writer) const
   // Number of axes points required
   writer.writeAttribute(DOCUMENT_SERIALIZE_AXES_POINTS_REQUIRED, QString::number (m_documentAxesPointsRequired));
 
-  // Serialize the Document image. That binary data is encoded as base64
-  QByteArray array;
-  QDataStream str (&array, QIODevice::WriteOnly);
-  QImage img = m_pixmap.toImage ();
-  str << img;
   writer.writeStartElement(DOCUMENT_SERIALIZE_IMAGE);
 
   // Image width and height are explicitly inserted for error reports, since the CDATA is removed
   // but we still want the image size for reconstructing the error(s)
-  writer.writeAttribute(DOCUMENT_SERIALIZE_IMAGE_WIDTH, QString::number (img.width()));
-  writer.writeAttribute(DOCUMENT_SERIALIZE_IMAGE_HEIGHT, QString::number (img.height()));
+  QString reasonForUnsuccessfulRead; // Callers that save have already decoded, and reported any failure
+  decodePendingImage (reasonForUnsuccessfulRead);
+  writer.writeAttribute(DOCUMENT_SERIALIZE_IMAGE_WIDTH, QString::number (m_image.width()));
+  writer.writeAttribute(DOCUMENT_SERIALIZE_IMAGE_HEIGHT, QString::number (m_image.height()));
+
+  if (imageStorage == DOCUMENT_IMAGE_STORAGE_CONTAINER) {
+
+    // DocumentContainer writes the image binary data into its own member after this xml
+    writer.writeAttribute(DOCUMENT_SERIALIZE_IMAGE_IN_CONTAINER, DOCUMENT_SERIALIZE_BOOL_TRUE);
+
+  } else {
+
+    // Serialize the Document image. That binary data is encoded as base64
+    QByteArray array;
+    QDataStream str (&array, QIODevice::WriteOnly);
+    str << m_image;
+
+    writer.writeCDATA (array.toBase64 ());
+  }
 
-  writer.writeCDATA (array.toBase64 ());
   writer.writeEndElement();
 
   m_coordSystemContext.saveXml (writer);
@@ -1000,7 +1155,11 @@ void Document::setModelSegments(const DocumentModelSegments &modelSegments)
 void Document::setPixmap(const QImage &image)
 {
 
-  m_pixmap = QPixmap::fromImage (image);
+  // Any image still waiting to be decoded is obsolete
+  m_imagePendingFileName = "";
+  m_imagePendingBase64.clear ();
+
+  m_image = image;
 }
 
 void Document::setSelectedCurveName(const QString &selectedCurveName)
@@ -1019,13 +1178,13 @@ void Document::updatePointOrdinals (const Transformation &transformation)
   m_coordSystemContext.updatePointOrdinals(transformation);
 }
 
-int Document::versionFromFile (QFile *file) const
+int Document::versionFromFile (QIODevice *device) const
 {
 
   int version = VERSION_6; // Use default if tag is missing
 
   QDomDocument doc;
-  if (doc.setContent (file)) {
+  if (doc.setContent (device)) {
 
     QDomNodeList nodes = doc.elementsByTagName (DOCUMENT_SERIALIZE_DOCUMENT);
     if (nodes.count() > 0) {
@@ -1041,7 +1200,7 @@ int Document::versionFromFile (QFile *file) const
     }
   }
 
-  file->seek (0); // Go back to beginning
+  device->seek (0); // Go back to beginning
 
   return version;
 }
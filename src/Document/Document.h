@@ -12,6 +12,8 @@
 #include "CurvesGraphs.h"
 #include "CurveStyles.h"
 #include "DocumentAxesPointsRequired.h"
+#include "DocumentContainer.h"
+#include "DocumentImageStorage.h"
 #include "DocumentModelAxesChecker.h"
 #include "DocumentModelColorFilter.h"
 #include "DocumentModelCoords.h"
@@ -25,8 +27,9 @@
 #include "DocumentModelPointMatch.h"
 #include "DocumentModelSegments.h"
 #include "PointStyle.h"
+#include <QDateTime>
+#include <QImage>
 #include <QList>
-#include <QPixmap>
 #include <QString>
 #include <QXmlStreamReader>
 
@@ -34,7 +37,7 @@ class CoordSystem;
 class Curve;
 class QByteArray;
 class QFile;
-class QImage;
+class QIODevice;
 class QTransform;
 class QXmlStreamWriter;
 class Transformation;
@@ -92,6 +95,12 @@ public:
                                              const QString &identifier,
                                              double ordinal);
 
+  /// Add many graph points to one curve with generated point identifiers, in a single pass
+  void addPointsGraphWithGeneratedIdentifiers (const QString &curveName,
+                                             const QList<QPoint> &positionsScreen,
+                                             const QList<double> &ordinals,
+                                             QStringList &generatedIdentifiers);
+
   /// Add all points identified in the specified CurvesGraphs. See also removePointsInCurvesGraphs
   void addPointsInCurvesGraphs (CurvesGraphs &curvesGraphs);
 
@@ -149,6 +158,10 @@ public:
   /// See CurvesGraphs::curvesGraphsNumPoints.
   int curvesGraphsNumPoints (const QString &curveName) const;
 
+  /// Decode the image now if loading deferred it, returning false with the reason if it could not be decoded. Saving
+  /// calls this before the output file is opened, since the deferred image may be read from that same file
+  bool decodePendingImage (QString &reasonForUnsuccessfulRead) const;
+
   /// Get method for DocumentAxesPointsRequired
   DocumentAxesPointsRequired documentAxesPointsRequired () const;
 
@@ -167,6 +180,10 @@ public:
   /// Sync all Guideline instances from screen to Document
   void guidelinesSyncScreenToDocument (const DocumentModelGuideline &modelGuideline);
 
+  /// Return the image that is being digitized. For loaded files, the image is decoded on the first call. Unlike pixmap,
+  /// this is safe to call without a QGuiApplication and from threads other than the gui thread
+  QImage image () const;
+
   /// Initialize grid display. This is called immediately after the transformation has been defined for the first time
   void initializeGridDisplay (const Transformation &transformation);
   
@@ -238,9 +255,6 @@ public:
   /// Default next ordinal value for specified curve
   int nextOrdinalForCurve (const QString &curveName) const;
 
-  /// Return the image that is being digitized.
-  QPixmap pixmap () const;
-
   /// See Curve::positionGraph.
   QPointF positionGraph (const QString &pointIdentifier) const;
 
@@ -266,8 +280,9 @@ public:
   /// Remove all points identified in the specified CurvesGraphs. See also addPointsInCurvesGraphs
   void removePointsInCurvesGraphs (CurvesGraphs &curvesGraphs);
 
-  /// Save document to xml
-  void saveXml (QXmlStreamWriter &writer) const;
+  /// Save document to xml. The image is embedded as base64 unless DocumentContainer is writing it as a separate member
+  void saveXml (QXmlStreamWriter &writer,
+                DocumentImageStorage imageStorage = DOCUMENT_IMAGE_STORAGE_BASE64) const;
 
   /// Currently selected curve name. This is used to set the selected curve combobox in MainWindow
   QString selectedCurveName () const;
@@ -343,16 +358,25 @@ private:
   bool bytesIndicatePreVersion6 (const QByteArray &bytes) const;
   Curve *curveForCurveName (const QString &curveName); // For use by Document only. External classes should use functors
   void generateEmptyPixmap(const QXmlStreamAttributes &attributes);
+  void loadContainer (const QString &fileName);
   void loadImage(QXmlStreamReader &reader);
   void loadPreVersion6 (QDataStream &str);
-  void loadVersion6 (QFile *file);
-  void loadVersions7AndUp (QFile *file);
+  void loadVersion6 (QIODevice *device);
+  void loadVersions7AndUp (QIODevice *device);
+  void loadXml (QIODevice *device);
   void overrideGraphDefaultsWithMapDefaults ();
-  int versionFromFile (QFile *file) const;
+  int versionFromFile (QIODevice *device) const;
 
   // Metadata
   QString m_name;
-  QPixmap m_pixmap;
+  mutable QImage m_image; // QImage rather than QPixmap so loading and export work without a gui
+
+  // Image location recorded during loading, so decoding can wait until image is called. At most one of these is set
+  mutable QString m_imagePendingFileName; // DocumentContainer file, with image member located by m_imagePendingContainer
+  qint64 m_imagePendingFileSize; // Size and modification time of m_imagePendingFileName when it was loaded
+  QDateTime m_imagePendingFileModified;
+  DocumentContainer m_imagePendingContainer;
+  mutable QByteArray m_imagePendingBase64; // Xml file with base64 CDATA
 
   // Number of axes points used is set during creation/import
   DocumentAxesPointsRequired m_documentAxesPointsRequired;
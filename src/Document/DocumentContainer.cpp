@@ -0,0 +1,200 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#include "Document.h"
+#include "DocumentContainer.h"
+#include "DocumentImageStorage.h"
+#include <QDataStream>
+#include <QImageReader>
+#include <QImageWriter>
+#include <QIODevice>
+#include <QXmlStreamWriter>
+
+const int FOUR_BYTES = 4;
+
+// Container versions. Bump this when the layout changes, and keep reading the older layouts
+const quint32 CONTAINER_VERSION_1 = 1;
+const quint32 CONTAINER_VERSION_LATEST = CONTAINER_VERSION_1;
+
+// Png is lossless. Qt maps quality 0 to 100 onto zlib levels 9 to 0, so this favors fast saves over the last few
+// percent of file size
+const char IMAGE_FORMAT [] = "PNG";
+const int IMAGE_QUALITY = 70;
+
+const int MEMBER_SIZE_BYTES = sizeof (quint64);
+
+DocumentContainer::DocumentContainer() :
+  m_xmlOffset (0),
+  m_xmlSize (0),
+  m_imageOffset (0),
+  m_imageSize (0)
+{
+}
+
+bool DocumentContainer::bytesIndicateContainer (const QByteArray &bytes)
+{
+  return (bytes.left (FOUR_BYTES) == magicNumber ());
+}
+
+bool DocumentContainer::canReadImage (QIODevice &device) const
+{
+  if (!device.seek (m_imageOffset)) {
+    return false;
+  }
+
+  QImageReader reader (&device,
+                       IMAGE_FORMAT);
+  reader.setDecideFormatFromContent (false);
+
+  return reader.canRead () &&
+      reader.size ().isValid ();
+}
+
+QByteArray DocumentContainer::magicNumber ()
+{
+  QByteArray containerMagicNumber;
+  containerMagicNumber.resize (FOUR_BYTES);
+
+  // Leading zeros keep this from being mistaken for xml. Last two bytes differ from the pre-version 6 magic number.
+  // Windows compiler gives warning if 0x## is used instead of '\x##' below
+  containerMagicNumber[0] = '\x00';
+  containerMagicNumber[1] = '\x00';
+  containerMagicNumber[2] = '\xE6';
+  containerMagicNumber[3] = '\xDC';
+
+  return containerMagicNumber;
+}
+
+bool DocumentContainer::patchMemberSize (QIODevice &device,
+                                         qint64 posMemberSize) const
+{
+  // Go back and fill in the byte count placeholder now that the member has been streamed, then return to the end
+  qint64 posEnd = device.pos ();
+  quint64 memberSize = static_cast<quint64> (posEnd - posMemberSize - MEMBER_SIZE_BYTES);
+
+  if (!device.seek (posMemberSize)) {
+    return false;
+  }
+
+  QDataStream str (&device);
+  str << memberSize;
+
+  return (str.status () == QDataStream::Ok) &&
+      device.seek (posEnd);
+}
+
+QImage DocumentContainer::readImage (QIODevice &device) const
+{
+  QImage image;
+
+  if (device.seek (m_imageOffset)) {
+
+    // Decoder pulls the compressed bytes straight from the device
+    QImageReader reader (&device,
+                         IMAGE_FORMAT);
+    reader.setDecideFormatFromContent (false);
+    reader.read (&image); // Null image on failure
+  }
+
+  return image;
+}
+
+bool DocumentContainer::readLayout (QIODevice &device)
+{
+  if (!device.seek (0)) {
+    return false;
+  }
+
+  QByteArray magic = device.read (FOUR_BYTES);
+  if (!bytesIndicateContainer (magic)) {
+    return false;
+  }
+
+  QDataStream str (&device);
+
+  quint32 version;
+  str >> version;
+  if ((str.status () != QDataStream::Ok) ||
+      (version > CONTAINER_VERSION_LATEST)) {
+    return false;
+  }
+
+  quint64 xmlSize, imageSize;
+
+  str >> xmlSize;
+  m_xmlOffset = device.pos ();
+  m_xmlSize = static_cast<qint64> (xmlSize);
+  if ((str.status () != QDataStream::Ok) ||
+      (m_xmlOffset + m_xmlSize + MEMBER_SIZE_BYTES > device.size ()) ||
+      !device.seek (m_xmlOffset + m_xmlSize)) {
+    return false;
+  }
+
+  str >> imageSize;
+  m_imageOffset = device.pos ();
+  m_imageSize = static_cast<qint64> (imageSize);
+
+  return (str.status () == QDataStream::Ok) &&
+      (m_imageOffset + m_imageSize <= device.size ());
+}
+
+QByteArray DocumentContainer::readXml (QIODevice &device) const
+{
+  if (device.seek (m_xmlOffset)) {
+    return device.read (m_xmlSize);
+  }
+
+  return QByteArray ();
+}
+
+bool DocumentContainer::write (QIODevice &device,
+                               const Document &document) const
+{
+  // Nothing is written if the image cannot be decoded, since an empty image member would lose the image
+  QString reasonForUnsuccessfulRead;
+  if (!document.decodePendingImage (reasonForUnsuccessfulRead)) {
+    return false;
+  }
+
+  QDataStream str (&device);
+
+  QByteArray magic = magicNumber ();
+  str.writeRawData (magic.constData (),
+                    FOUR_BYTES);
+  str << CONTAINER_VERSION_LATEST;
+
+  // Xml member, streamed directly into the device after a placeholder for its byte count
+  qint64 posXmlSize = device.pos ();
+  str << static_cast<quint64> (0);
+
+  QXmlStreamWriter writer (&device);
+  writer.setAutoFormatting (true);
+  writer.writeStartDocument ();
+  writer.writeDTD ("<!DOCTYPE engauge>");
+  document.saveXml (writer,
+                    DOCUMENT_IMAGE_STORAGE_CONTAINER);
+  writer.writeEndDocument ();
+
+  if (writer.hasError () ||
+      !patchMemberSize (device,
+                        posXmlSize)) {
+    return false;
+  }
+
+  // Image member, encoded directly into the device after a placeholder for its byte count
+  qint64 posImageSize = device.pos ();
+  str << static_cast<quint64> (0);
+
+  QImageWriter imageWriter (&device,
+                            IMAGE_FORMAT);
+  imageWriter.setQuality (IMAGE_QUALITY);
+  if (!imageWriter.write (document.image ())) {
+    return false;
+  }
+
+  return patchMemberSize (device,
+                          posImageSize);
+}
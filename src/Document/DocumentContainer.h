@@ -0,0 +1,63 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef DOCUMENT_CONTAINER_H
+#define DOCUMENT_CONTAINER_H
+
+#include <QByteArray>
+#include <QImage>
+#include <QtGlobal>
+
+class Document;
+class QIODevice;
+
+/// Binary file container for a Document. Storing the image as its own member, rather than as base64 text in the xml,
+/// keeps files smaller and lets both members be streamed directly to and from the file. Integers are big endian. Layout:
+/// -# Magic bytes followed by container version number
+/// -# Xml member byte count followed by the Document xml, in which the image element has only the image size
+/// -# Image member byte count followed by the losslessly compressed image
+///
+/// Files written before the container was introduced (xml with base64 image, and pre-version 6 binary) are still
+/// read by Document, which checks bytesIndicateContainer first
+class DocumentContainer
+{
+public:
+  /// Single constructor
+  DocumentContainer();
+
+  /// True if the first bytes of a file identify it as a DocumentContainer
+  static bool bytesIndicateContainer (const QByteArray &bytes);
+
+  /// True if the image member header can be decoded, without decoding the image itself. Requires successful readLayout
+  bool canReadImage (QIODevice &device) const;
+
+  /// Decode the image member directly from the device, without copying the encoded bytes. Requires successful readLayout
+  QImage readImage (QIODevice &device) const;
+
+  /// Read the header and member byte counts, and check that the members fit inside the device. Returns false
+  /// if the container is truncated, or was written by a newer version that this version cannot read
+  bool readLayout (QIODevice &device);
+
+  /// Read the xml member. Requires successful readLayout
+  QByteArray readXml (QIODevice &device) const;
+
+  /// Stream the Document into the device. Returns false if there was a write error
+  bool write (QIODevice &device,
+              const Document &document) const;
+
+private:
+
+  static QByteArray magicNumber ();
+  bool patchMemberSize (QIODevice &device,
+                        qint64 posMemberSize) const;
+
+  qint64 m_xmlOffset;
+  qint64 m_xmlSize;
+  qint64 m_imageOffset;
+  qint64 m_imageSize;
+};
+
+#endif // DOCUMENT_CONTAINER_H
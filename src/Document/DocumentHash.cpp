@@ -0,0 +1,30 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#include "DocumentHash.h"
+#include <string.h>
+
+DocumentHash documentHashMix (DocumentHash documentHash,
+                              quint64 value)
+{
+  // Finalizer of the splitmix64 generator, which spreads every input bit across the whole output
+  quint64 z = documentHash ^ value;
+  z += Q_UINT64_C (0x9e3779b97f4a7c15);
+  z = (z ^ (z >> 30)) * Q_UINT64_C (0xbf58476d1ce4e5b9);
+  z = (z ^ (z >> 27)) * Q_UINT64_C (0x94d049bb133111eb);
+
+  return z ^ (z >> 31);
+}
+
+DocumentHash documentHashMix (DocumentHash documentHash,
+                              double value)
+{
+  quint64 bits;
+  memcpy (&bits, &value, sizeof (bits));
+
+  return documentHashMix (documentHash,
+                          bits);
+}
@@ -7,8 +7,18 @@
 #ifndef DOCUMENT_HASH_H
 #define DOCUMENT_HASH_H
 
-#include <QByteArray>
+#include <QtGlobal>
 
-typedef QByteArray DocumentHash;
+/// 64-bit digest of the Document state. Each Curve keeps the sum of the digests of its Points up to date as the
+/// Points change, so a DocumentHash is available without visiting every Point
+typedef quint64 DocumentHash;
+
+/// Mix a value into a digest. The result depends on the order in which values are mixed in
+DocumentHash documentHashMix (DocumentHash documentHash,
+                              quint64 value);
+
+/// Mix the bit pattern of a double into a digest. The result depends on the order in which values are mixed in
+DocumentHash documentHashMix (DocumentHash documentHash,
+                              double value);
 
 #endif // DOCUMENT_HASH_H
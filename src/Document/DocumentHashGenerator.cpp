@@ -5,6 +5,8 @@
  ******************************************************************************************************/
 
 #include "CallbackDocumentHash.h"
+#include "Curve.h"
+#include "CurvesGraphs.h"
 #include "Document.h"
 #include "DocumentHashGenerator.h"
 #include "Logger.h"
@@ -15,16 +17,20 @@ DocumentHashGenerator::DocumentHashGenerator()
 
 DocumentHash DocumentHashGenerator::generate (const Document &document) const
 {
+  // Start from the digests that the curves keep up to date, so no point has to be visited here except the few
+  // axis points, whose graph coordinates are not part of those digests
+  DocumentHash documentHash = documentHashMix (DocumentHash (0),
+                                               document.curveAxes().documentHash());
+  documentHash = documentHashMix (documentHash,
+                                  document.curvesGraphs().documentHash());
 
-  // Get hash by letting functor iterate through Document
-  CallbackDocumentHash ftor (document.documentAxesPointsRequired());
+  CallbackDocumentHash ftor (document.documentAxesPointsRequired(),
+                             documentHash);
 
   Functor2wRet<const QString &, const Point &, CallbackSearchReturn> ftorWithCallback = functor_ret (ftor,
                                                                                                      &CallbackDocumentHash::callback);
 
   document.iterateThroughCurvePointsAxes (ftorWithCallback);
-  document.iterateThroughCurvesPointsGraphs (ftorWithCallback);
-
 
   return ftor.hash ();
 }
@@ -0,0 +1,16 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef DOCUMENT_IMAGE_STORAGE_H
+#define DOCUMENT_IMAGE_STORAGE_H
+
+/// Where the Document image goes when the Document is serialized
+enum DocumentImageStorage {
+  DOCUMENT_IMAGE_STORAGE_BASE64, // Image is base64 CDATA inside the xml. Used by xml-only files and in-memory snapshots
+  DOCUMENT_IMAGE_STORAGE_CONTAINER // Image is a separate binary member of a DocumentContainer, outside the xml
+};
+
+#endif // DOCUMENT_IMAGE_STORAGE_H
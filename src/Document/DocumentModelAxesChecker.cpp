@@ -4,7 +4,7 @@
  * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
  ******************************************************************************************************/
 
-#include "CmdMediator.h"
+#include "Document.h"
 #include "DocumentModelAxesChecker.h"
 #include "DocumentSerialize.h"
 #include "Logger.h"
@@ -4,7 +4,6 @@
  * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
  ******************************************************************************************************/
 
-#include "CmdMediator.h"
 #include "CoordSystem.h"
 #include "DocumentModelColorFilter.h"
 #include "DocumentSerialize.h"
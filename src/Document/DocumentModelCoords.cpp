@@ -4,9 +4,9 @@
  * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
  ******************************************************************************************************/
 
-#include "CmdMediator.h"
 #include "CoordUnitsDate.h"
 #include "CoordUnitsTime.h"
+#include "Document.h"
 #include "DocumentModelCoords.h"
 #include "DocumentSerialize.h"
 #include "EngaugeAssert.h"
@@ -6,6 +6,8 @@
 
 #include "CallbackDocumentScrub.h"
 #include "CallbackSearchReturn.h"
+#include "CmdDirty.h"
+#include "Curve.h"
 #include "Document.h"
 #include "DocumentScrub.h"
 #include "Logger.h"
@@ -19,7 +21,8 @@ DocumentScrub::DocumentScrub ()
 }
 
 void DocumentScrub::check (MainWindow &mainWindow,
-                           const Document &document) const
+                           const Document &document,
+                           const CmdDirty &cmdDirty) const
 {
 
   CallbackDocumentScrub ftor;
@@ -27,8 +30,28 @@ void DocumentScrub::check (MainWindow &mainWindow,
   Functor2wRet<const QString &, const Point &, CallbackSearchReturn> ftorWithCallback = functor_ret (ftor,
                                                                                                      &CallbackDocumentScrub::callback);
   
-  document.iterateThroughCurvePointsAxes (ftorWithCallback);
-  document.iterateThroughCurvesPointsGraphs (ftorWithCallback);
+  // Identifiers only change when points are added, so unchanged curves need no check
+  if (cmdDirty.isAll ()) {
+
+    document.iterateThroughCurvePointsAxes (ftorWithCallback);
+    document.iterateThroughCurvesPointsGraphs (ftorWithCallback);
+
+  } else {
+
+    if (cmdDirty.isAxes ()) {
+      document.iterateThroughCurvePointsAxes (ftorWithCallback);
+    }
+
+    QStringList curveNames = document.curvesGraphsNames ();
+    QStringList::const_iterator itr;
+    for (itr = curveNames.begin(); itr != curveNames.end(); itr++) {
+
+      const QString &curveName = *itr;
+      if (cmdDirty.isCurve (curveName)) {
+        document.curveForCurveName (curveName)->iterateThroughCurvePoints (ftorWithCallback);
+      }
+    }
+  }
 
   if (!ftor.success ()) {
 
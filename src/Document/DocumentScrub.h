@@ -7,6 +7,7 @@
 #ifndef DOCUMENT_SCRUB_H
 #define DOCUMENT_SCRUB_H
 
+class CmdDirty;
 class Document;
 class MainWindow;
 
@@ -18,9 +19,10 @@ public:
   /// Single constructor
   DocumentScrub ();
 
-  /// Check document state
+  /// Check document state, for the curves in the dirty set
   void check (MainWindow &mainWindow,
-              const Document &document) const;
+              const Document &document,
+              const CmdDirty &cmdDirty) const;
 
 private:
 
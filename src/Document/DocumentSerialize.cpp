@@ -206,6 +206,7 @@ const QString DOCUMENT_SERIALIZE_IDENTIFIER_NAME ("IdentifierName");
 const QString DOCUMENT_SERIALIZE_IDENTIFIERS ("Identifiers");
 const QString DOCUMENT_SERIALIZE_IMAGE ("Image");
 const QString DOCUMENT_SERIALIZE_IMAGE_HEIGHT ("Height");
+const QString DOCUMENT_SERIALIZE_IMAGE_IN_CONTAINER ("InContainer");
 const QString DOCUMENT_SERIALIZE_IMAGE_WIDTH ("Width");
 const QString DOCUMENT_SERIALIZE_LINE_STYLE ("LineStyle");
 const QString DOCUMENT_SERIALIZE_LINE_STYLE_COLOR ("Color");
@@ -211,6 +211,7 @@ extern const QString DOCUMENT_SERIALIZE_IDENTIFIER_NAME;
 extern const QString DOCUMENT_SERIALIZE_IDENTIFIERS;
 extern const QString DOCUMENT_SERIALIZE_IMAGE;
 extern const QString DOCUMENT_SERIALIZE_IMAGE_HEIGHT;
+extern const QString DOCUMENT_SERIALIZE_IMAGE_IN_CONTAINER;
 extern const QString DOCUMENT_SERIALIZE_IMAGE_WIDTH;
 extern const QString DOCUMENT_SERIALIZE_LINE_STYLE;
 extern const QString DOCUMENT_SERIALIZE_LINE_STYLE_COLOR;
@@ -0,0 +1,18 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef EXPORT_COLUMNS_LOADER_H
+#define EXPORT_COLUMNS_LOADER_H
+
+#include "ExportValuesColumn.h"
+#include <functional>
+#include <QVector>
+
+/// Loads the next block of at most blockCount rows into the columns, one column per curve, and returns the number of
+/// rows loaded. Zero is returned once every row has been loaded
+typedef std::function<int (int blockCount, QVector<ExportValuesColumn> &columns)> ExportColumnsLoader;
+
+#endif // EXPORT_COLUMNS_LOADER_H
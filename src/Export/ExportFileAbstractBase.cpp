@@ -12,12 +12,16 @@
 #include "ExportFileAbstractBase.h"
 #include "Logger.h"
 #include <qmath.h>
+#include <QAtomicInt>
+#include <QSemaphore>
 #include <QTextStream>
+#include <QThreadPool>
 #include "Transformation.h"
 
 using namespace std;
 
-ExportFileAbstractBase::ExportFileAbstractBase()
+ExportFileAbstractBase::ExportFileAbstractBase() :
+  m_rowLimit (0)
 {
 }
 
@@ -58,18 +62,6 @@ QStringList ExportFileAbstractBase::curvesToInclude (const DocumentModelExportFo
   return curvesToInclude;
 }
 
-void ExportFileAbstractBase::destroy2DArray (QVector<QVector<QString*> > &array) const
-{
-
-  int colCount = array.count();
-  int rowCount = array [0].count();
-  for (int row = 0; row < rowCount; row++) {
-    for (int col = 0; col < colCount; col++) {
-      delete array [col] [row];
-    }
-  }
-}
-
 QString ExportFileAbstractBase::gnuplotComment() const
 {
   return QString ("# ");
@@ -103,6 +95,53 @@ double ExportFileAbstractBase::linearlyInterpolateYRadiusFromTwoPoints (double x
   return yRadiusLinearized;
 }
 
+int ExportFileAbstractBase::rowCountWithinLimit (int rowCount) const
+{
+  if (m_rowLimit > 0) {
+    return qMin (rowCount,
+                 m_rowLimit);
+  }
+
+  return rowCount;
+}
+
+void ExportFileAbstractBase::runForEachCurve (int curveCount,
+                                              const std::function<void (int)> &work) const
+{
+  QAtomicInt nextCurve (0);
+  QSemaphore helpersDone;
+
+  std::function<void ()> takeCurves = [&nextCurve, curveCount, &work] () {
+    int curve;
+    while ((curve = nextCurve.fetchAndAddOrdered (1)) < curveCount) {
+      work (curve);
+    }
+  };
+
+  // Helpers are never queued behind other work, since tryStart fails when no thread is idle. Concurrent exports, like
+  // batch export which runs one file per thread, share the threads of the global pool rather than each adding their own
+  int helperCount = 0;
+  for (int helper = 1; helper < curveCount; helper++) {
+    bool started = QThreadPool::globalInstance ()->tryStart ([&takeCurves, &helpersDone] () {
+      takeCurves ();
+      helpersDone.release ();
+    });
+    if (!started) {
+      break;
+    }
+    ++helperCount;
+  }
+
+  takeCurves ();
+
+  helpersDone.acquire (helperCount);
+}
+
+void ExportFileAbstractBase::setRowLimit (int rowLimit)
+{
+  m_rowLimit = rowLimit;
+}
+
 QString ExportFileAbstractBase::wrapInDoubleQuotesIfNeeded (const DocumentModelExportFormat &modelExportOverride,
                                                             const QString &valueString) const
 {
@@ -9,6 +9,7 @@
 
 #include "CurveConnectAs.h"
 #include "ExportHeader.h"
+#include <functional>
 #include <QPointF>
 #include <QStringList>
 #include <QVector>
@@ -21,6 +22,8 @@ class QTextStream;
 class SplinePair;
 class Transformation;
 
+const int EXPORT_ROWS_PER_BLOCK = 4096; // Rows loaded and written at a time, which bounds the memory used by a table
+
 /// Strategy base class for exporting to a file. This class provides common methods
 class ExportFileAbstractBase
 {
@@ -28,6 +31,9 @@ public:
   /// Single constructor.
   ExportFileAbstractBase();
   virtual ~ExportFileAbstractBase ();
+
+  /// Limit each exported table to its first rows, as when only a preview is needed. Zero, the default, means no limit
+  void setRowLimit (int rowLimit);
   
 protected:
 
@@ -38,9 +44,6 @@ protected:
                                CurveConnectAs curveConnectAs1,
                                CurveConnectAs curveConnectAs2) const;
 
-  /// Deallocate memory for array
-  void destroy2DArray (QVector<QVector<QString*> > &array) const;
-
   /// Gnuplot comment delimiter
   QString gnuplotComment() const;
 
@@ -56,11 +59,25 @@ protected:
                                                   const QPointF &posGraphBefore,
                                                   const QPointF &posGraph) const;
 
+  /// Number of table rows to export, from the number that are available and the row limit
+  int rowCountWithinLimit (int rowCount) const;
+
+  /// Call work once for each curve index from 0 to curveCount-1, spreading the curves across the global thread pool,
+  /// and return after every curve is done. The calling thread takes curves too, and helper threads are only used
+  /// while the pool has idle threads. Each curve must write only to its own output so the results do not depend on
+  /// the order in which the curves are processed
+  void runForEachCurve (int curveCount,
+                        const std::function<void (int)> &work) const;
+
   /// RFC 4180 says if values are delimited by a comma AND a value has commas in it (for locale like
   /// English/Switzerland when dealing with numbers) then double quotes are required for the value.
   /// In other cases this method is a noop
   QString wrapInDoubleQuotesIfNeeded (const DocumentModelExportFormat &modelExportOverride,
                                       const QString &valueString) const;
+
+private:
+
+  int m_rowLimit;
 };
 
 #endif // EXPORT_FILE_ABSTRACT_BASE_H
@@ -4,6 +4,7 @@
  * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
  ******************************************************************************************************/
 
+#include <algorithm>
 #include "CallbackGatherXThetasInCurves.h"
 #include "CallbackGatherXThetasInGridLines.h"
 #include "CurveConnectAs.h"
@@ -15,10 +16,14 @@
 #include "ExportOrdinalsSmooth.h"
 #include "ExportXThetaValuesMergedFunctions.h"
 #include "FormatCoordsUnits.h"
+#include "FormatPrecisionPlan.h"
 #include "GridLineLimiter.h"
+#include <limits>
 #include "LinearToLog.h"
 #include "Logger.h"
+#include "MainWindowModel.h"
 #include <qmath.h>
+#include <QLocale>
 #include <QTextStream>
 #include <QVector>
 #include "Spline.h"
@@ -28,6 +33,18 @@
 
 using namespace std;
 
+static bool lessThanXTheta (const QPointF &position,
+                            double xTheta)
+{
+  return position.x() < xTheta;
+}
+
+static bool lessThanXThetaOfPosition (const QPointF &position,
+                                      const QPointF &positionOther)
+{
+  return position.x() < positionOther.x();
+}
+
 ExportFileFunctions::ExportFileFunctions()
 {
 }
@@ -36,7 +53,7 @@ void ExportFileFunctions::exportAllPerLineXThetaValuesMerged (const DocumentMode
                                                               const Document &document,
                                                               const MainWindowModel &modelMainWindow,
                                                               const QStringList &curvesIncluded,
-                                                              const ExportValuesXOrY &xThetaValues,
+                                                              ExportXThetaValuesMergedFunctions &xThetaValues,
                                                               const QString &delimiter,
                                                               const Transformation &transformation,
                                                               bool isLogXTheta,
@@ -48,42 +65,76 @@ void ExportFileFunctions::exportAllPerLineXThetaValuesMerged (const DocumentMode
 {
 
   int curveCount = curvesIncluded.count();
-  int xThetaCount = xThetaValues.count();
-  QVector<QVector<QString*> > yRadiusValues (curveCount, QVector<QString*> (xThetaCount));
-  initializeYRadiusValues (curvesIncluded,
-                           xThetaValues,
-                           yRadiusValues);
-  loadYRadiusValues (modelExportOverride,
-                     document,
-                     modelMainWindow,
-                     curvesIncluded,
-                     transformation,
-                     isLogXTheta,
-                     isLogYRadius,
-                     xThetaValues,
-                     curveLimitsMin,
-                     curveLimitsMax,
-                     yRadiusValues);
-
-  outputXThetaYRadiusValues (modelExportOverride,
-                             document.modelCoords(),
-                             document.modelGeneral(),
-                             modelMainWindow,
-                             curvesIncluded,
-                             xThetaValues,
-                             transformation,
-                             yRadiusValues,
-                             delimiter,
-                             str,
-                             numWritesSoFar);
-  destroy2DArray (yRadiusValues);
+
+  // Rows are generated, loaded and written one block at a time, so memory use does not grow with the number of rows.
+  // Raw points are each matched to the closest of all the x/theta values, so in that case every row is one block
+  bool isRaw = (modelExportOverride.pointsSelectionFunctions() == EXPORT_POINTS_SELECTION_FUNCTIONS_RAW);
+  ExportValuesXOrY xThetaValuesAll;
+  xThetaValues.restart ();
+  if (isRaw) {
+    xThetaValuesAll = xThetaValues.xThetaValuesBlock (std::numeric_limits<int>::max ());
+    xThetaValues.restart ();
+  }
+  int rowsPerBlock = (isRaw ? xThetaValuesAll.count () : EXPORT_ROWS_PER_BLOCK);
+
+  outputHeader (modelExportOverride,
+                curvesIncluded,
+                delimiter,
+                str,
+                numWritesSoFar);
+
+  // Points are transformed, and splines are fitted, just once rather than for every block
+  QVector<ExportFunctionFit> functionFits;
+  loadFunctionFits (modelExportOverride,
+                    document,
+                    curvesIncluded,
+                    transformation,
+                    isLogXTheta,
+                    isLogYRadius,
+                    functionFits);
+
+  int rowStart = 0;
+  while (true) {
+
+    int blockCount = rowCountWithinLimit (rowStart + rowsPerBlock) - rowStart;
+    ExportValuesXOrY xThetaValuesBlock = xThetaValues.xThetaValuesBlock (blockCount);
+    if (xThetaValuesBlock.isEmpty ()) {
+      break;
+    }
+    rowStart += xThetaValuesBlock.count ();
+
+    ExportValuesXOrY xThetaValuesLoaded = (isRaw ? xThetaValuesAll : xThetaValuesBlock);
+
+    QVector<ExportValuesColumn> yRadiusValues (curveCount, ExportValuesColumn (xThetaValuesLoaded.count()));
+    loadYRadiusValues (modelExportOverride,
+                       functionFits,
+                       transformation,
+                       isLogXTheta,
+                       isLogYRadius,
+                       xThetaValuesLoaded,
+                       curveLimitsMin,
+                       curveLimitsMax,
+                       yRadiusValues);
+
+    outputXThetaYRadiusValues (modelExportOverride,
+                               document.modelCoords(),
+                               document.modelGeneral(),
+                               modelMainWindow,
+                               xThetaValuesBlock,
+                               transformation,
+                               yRadiusValues,
+                               delimiter,
+                               str);
+  }
+
+  ++numWritesSoFar;
 }
 
 void ExportFileFunctions::exportOnePerLineXThetaValuesMerged (const DocumentModelExportFormat &modelExportOverride,
                                                               const Document &document,
                                                               const MainWindowModel &modelMainWindow,
                                                               const QStringList &curvesIncluded,
-                                                              const ExportValuesXOrY &xThetaValues,
+                                                              ExportXThetaValuesMergedFunctions &xThetaValues,
                                                               const QString &delimiter,
                                                               const Transformation &transformation,
                                                               bool isLogXTheta,
@@ -97,42 +148,89 @@ void ExportFileFunctions::exportOnePerLineXThetaValuesMerged (const DocumentMode
   QStringList::const_iterator itr;
   for (itr = curvesIncluded.begin(); itr != curvesIncluded.end(); itr++) {
 
-    // This curve
-    const int CURVE_COUNT = 1;
     QString curveIncluded = *itr;
-    QStringList curvesIncludedIter (curveIncluded);
 
-    int xThetaCount = xThetaValues.count();
-    QVector<QVector<QString*> > yRadiusValues (CURVE_COUNT, QVector<QString*> (xThetaCount));
-    initializeYRadiusValues (curvesIncludedIter,
-                             xThetaValues,
-                             yRadiusValues);
-    loadYRadiusValues (modelExportOverride,
-                       document,
-                       modelMainWindow,
-                       curvesIncludedIter,
-                       transformation,
-                       isLogXTheta,
-                       isLogYRadius,
-                       xThetaValues,
-                       curveLimitsMin,
-                       curveLimitsMax,
-                       yRadiusValues);
-    outputXThetaYRadiusValues (modelExportOverride,
-                               document.modelCoords(),
-                               document.modelGeneral(),
-                               modelMainWindow,
-                               curvesIncludedIter,
-                               xThetaValues,
-                               transformation,
-                               yRadiusValues,
-                               delimiter,
-                               str,
-                               numWritesSoFar);
-    destroy2DArray (yRadiusValues);
+    exportAllPerLineXThetaValuesMerged (modelExportOverride,
+                                        document,
+                                        modelMainWindow,
+                                        QStringList (curveIncluded),
+                                        xThetaValues,
+                                        delimiter,
+                                        transformation,
+                                        isLogXTheta,
+                                        isLogYRadius,
+                                        curveLimitsMin,
+                                        curveLimitsMax,
+                                        str,
+                                        numWritesSoFar);
   }
 }
 
+ExportColumnsLoader ExportFileFunctions::exportToColumns (const DocumentModelExportFormat &modelExportOverride,
+                                                          const Document &document,
+                                                          const MainWindowModel &modelMainWindow,
+                                                          const Transformation &transformation,
+                                                          QStringList &curvesIncluded,
+                                                          int &rowCount) const
+{
+
+  // Log coordinates must be temporarily transformed to linear coordinates
+  bool isLogXTheta = (document.modelCoords().coordScaleXTheta() == COORD_SCALE_LOG);
+  bool isLogYRadius = (document.modelCoords().coordScaleYRadius() == COORD_SCALE_LOG);
+
+  curvesIncluded = curvesToInclude (modelExportOverride,
+                                    document,
+                                    document.curvesGraphsNames(),
+                                    CONNECT_AS_FUNCTION_SMOOTH,
+                                    CONNECT_AS_FUNCTION_STRAIGHT);
+
+  CurveLimits curveLimitsMin, curveLimitsMax;
+  ExportXThetaValuesMergedFunctions xThetaValuesMerged = xThetaValuesMergedForCurves (modelExportOverride,
+                                                                                      document,
+                                                                                      modelMainWindow,
+                                                                                      transformation,
+                                                                                      curvesIncluded,
+                                                                                      curveLimitsMin,
+                                                                                      curveLimitsMax);
+
+  // Skip if every curve was a relation
+  rowCount = (curvesIncluded.isEmpty () ? 0 : xThetaValuesMerged.count ());
+
+  QVector<ExportFunctionFit> functionFits;
+  loadFunctionFits (modelExportOverride,
+                    document,
+                    curvesIncluded,
+                    transformation,
+                    isLogXTheta,
+                    isLogYRadius,
+                    functionFits);
+
+  // The loader captures copies, including the generator which keeps its position from one block to the next
+  ExportFileFunctions exporter (*this);
+  return [=] (int blockCount,
+              QVector<ExportValuesColumn> &yRadiusValues) mutable -> int {
+
+    ExportValuesXOrY xThetaValues;
+    if (!functionFits.isEmpty ()) {
+      xThetaValues = xThetaValuesMerged.xThetaValuesBlock (blockCount);
+    }
+
+    yRadiusValues = QVector<ExportValuesColumn> (functionFits.count(),
+                                                 ExportValuesColumn (xThetaValues.count()));
+    exporter.loadYRadiusValues (modelExportOverride,
+                                functionFits,
+                                transformation,
+                                isLogXTheta,
+                                isLogYRadius,
+                                xThetaValues,
+                                curveLimitsMin,
+                                curveLimitsMax,
+                                yRadiusValues);
+
+    return xThetaValues.count();
+  };
+}
+
 void ExportFileFunctions::exportToFile (const DocumentModelExportFormat &modelExportOverride,
                                         const Document &document,
                                         const MainWindowModel &modelMainWindow,
@@ -159,274 +257,298 @@ void ExportFileFunctions::exportToFile (const DocumentModelExportFormat &modelEx
   const QString delimiter = exportDelimiterToText (modelExportOverride.delimiter(),
                                                    modelExportOverride.header() == EXPORT_HEADER_GNUPLOT);
 
-  // Get x/theta values to be used. Also get the endpoint limits, if any
+  // Get the generator of the x/theta values to be used. Also get the endpoint limits, if any
   CurveLimits curveLimitsMin, curveLimitsMax;
-  ValuesVectorXOrY valuesVector;
-  if (modelExportOverride.pointsSelectionFunctions() == EXPORT_POINTS_SELECTION_FUNCTIONS_INTERPOLATE_GRID_LINES) {
-    CallbackGatherXThetasInGridLines ftor (modelMainWindow,
-                                           modelExportOverride,
-                                           curvesIncluded,
-                                           transformation,
-                                           document);
-    Functor2wRet<const QString &, const Point &, CallbackSearchReturn> ftorWithCallback = functor_ret (ftor,
-                                                                                                       &CallbackGatherXThetasInGridLines::callback);
-    document.iterateThroughCurvesPointsGraphs(ftorWithCallback);
-    valuesVector = ftor.xThetaValuesRaw();
-    curveLimitsMin = ftor.curveLimitsMin();
-    curveLimitsMax = ftor.curveLimitsMax();
-  } else {
-    CallbackGatherXThetasInCurves ftor (modelExportOverride,
-                                        curvesIncluded,
-                                        transformation);
-    Functor2wRet<const QString &, const Point &, CallbackSearchReturn> ftorWithCallback = functor_ret (ftor,
-                                                                                                       &CallbackGatherXThetasInCurves::callback);
-    document.iterateThroughCurvesPointsGraphs(ftorWithCallback);
-    valuesVector = ftor.xThetaValuesRaw();
-    curveLimitsMin = ftor.curveLimitsMin();
-    curveLimitsMax = ftor.curveLimitsMax();
+  ExportXThetaValuesMergedFunctions xThetaValuesMerged = xThetaValuesMergedForCurves (modelExportOverride,
+                                                                                      document,
+                                                                                      modelMainWindow,
+                                                                                      transformation,
+                                                                                      curvesIncluded,
+                                                                                      curveLimitsMin,
+                                                                                      curveLimitsMax);
+
+  // Every row is exported even when there are too many, so the flag only warns the user
+  isOverrun = xThetaValuesMerged.isOverrun ();
+
+  // Skip if every curve was a relation
+  if (xThetaValuesMerged.xThetaValuesBlock (1).count() > 0) {
+
+    // Export in one of two layouts
+    if (modelExportOverride.layoutFunctions() == EXPORT_LAYOUT_ALL_PER_LINE) {
+      exportAllPerLineXThetaValuesMerged (modelExportOverride,
+                                          document,
+                                          modelMainWindow,
+                                          curvesIncluded,
+                                          xThetaValuesMerged,
+                                          delimiter,
+                                          transformation,
+                                          isLogXTheta,
+                                          isLogYRadius,
+                                          curveLimitsMin,
+                                          curveLimitsMax,
+                                          str,
+                                          numWritesSoFar);
+    } else {
+      exportOnePerLineXThetaValuesMerged (modelExportOverride,
+                                          document,
+                                          modelMainWindow,
+                                          curvesIncluded,
+                                          xThetaValuesMerged,
+                                          delimiter,
+                                          transformation,
+                                          isLogXTheta,
+                                          isLogYRadius,
+                                          curveLimitsMin,
+                                          curveLimitsMax,
+                                          str,
+                                          numWritesSoFar);
+    }
   }
+}
 
-  ExportXThetaValuesMergedFunctions exportXTheta (modelExportOverride,
-                                                  modelMainWindow,
-                                                  valuesVector,
-                                                  transformation);
+int ExportFileFunctions::indexOfPointAtOrAfterXTheta (const FittingPointsConvenient &positionsLinearized,
+                                                     bool isSortedByXTheta,
+                                                     double xThetaLinearized,
+                                                     int &ipCursor) const
+{
+  // Result is the first index ip>0 with xThetaLinearized <= positionsLinearized[ip].x, or the point count if there is
+  // none. The first point is skipped so there are always two points for interpolating or extrapolating
+  int count = positionsLinearized.count();
 
-  ExportValuesXOrY xThetaValuesMerged = exportXTheta.xThetaValues (isOverrun);
+  if (!isSortedByXTheta) {
 
-  if (isOverrun) {
+    // Search from the start every time, since a later point may have a smaller x/theta than an earlier point
+    int ip = 1;
+    while ((ip < count) && (positionsLinearized.at (ip).x() < xThetaLinearized)) {
+      ++ip;
+    }
 
-    // Put note in output to explain why there are no points
-    str << QObject::tr ("Too many points");
+    return ip;
+  }
 
-  } else {
+  if ((ipCursor > 1) &&
+      (xThetaLinearized <= positionsLinearized.at (ipCursor - 1).x())) {
 
-    // Skip if every curve was a relation
-    if (xThetaValuesMerged.count() > 0) {
+    // This x/theta value is before the previous one, so binary search for it
+    FittingPointsConvenient::const_iterator itr = std::lower_bound (positionsLinearized.begin() + 1,
+                                                                     positionsLinearized.end(),
+                                                                     xThetaLinearized,
+                                                                     lessThanXTheta);
+    ipCursor = int (itr - positionsLinearized.begin());
 
-      // Export in one of two layouts
-      if (modelExportOverride.layoutFunctions() == EXPORT_LAYOUT_ALL_PER_LINE) {
-        exportAllPerLineXThetaValuesMerged (modelExportOverride,
-                                            document,
-                                            modelMainWindow,
-                                            curvesIncluded,
-                                            xThetaValuesMerged,
-                                            delimiter,
-                                            transformation,
-                                            isLogXTheta,
-                                            isLogYRadius,
-                                            curveLimitsMin,
-                                            curveLimitsMax,
-                                            str,
-                                            numWritesSoFar);
-      } else {
-        exportOnePerLineXThetaValuesMerged (modelExportOverride,
-                                            document,
-                                            modelMainWindow,
-                                            curvesIncluded,
-                                            xThetaValuesMerged,
-                                            delimiter,
-                                            transformation,
-                                            isLogXTheta,
-                                            isLogYRadius,
-                                            curveLimitsMin,
-                                            curveLimitsMax,
-                                            str,
-                                            numWritesSoFar);
-      }
-    }
-  }
-}
-
-void ExportFileFunctions::initializeYRadiusValues (const QStringList &curvesIncluded,
-                                                   const ExportValuesXOrY &xThetaValuesMerged,
-                                                   QVector<QVector<QString*> > &yRadiusValues) const
-{
+  } else {
 
-  // Initialize every entry with empty string
-  int curveCount = curvesIncluded.count();
-  int xThetaCount = xThetaValuesMerged.count();
-  for (int row = 0; row < xThetaCount; row++) {
-    for (int col = 0; col < curveCount; col++) {
-      yRadiusValues [col] [row] = new QString;
+    // Every point before the cursor is before this x/theta value, so walk forward from the cursor. When the x/theta
+    // values are sorted, which is the usual case, the whole walk visits each point only once
+    ipCursor = qMax (ipCursor, 1);
+    while ((ipCursor < count) && (positionsLinearized.at (ipCursor).x() < xThetaLinearized)) {
+      ++ipCursor;
     }
   }
+
+  return ipCursor;
 }
 
 double ExportFileFunctions::linearlyInterpolate (const FittingPointsConvenient &positionsLinearized,
-                                                 double xThetaLinearized) const
+                                                 bool isSortedByXTheta,
+                                                 double xThetaLinearized,
+                                                 int &ipCursor) const
 {
 
   // If point is within the range of the function points then interpolation will be used, otherwise
   // extrapolation will be used
   double yRadiusLinearized = 0;
-  QPointF posGraphBefore; // Not set until ip=1
-  bool foundIt = false;
-  FittingPointsConvenient::const_iterator itr;
-  for (itr = positionsLinearized.begin(); itr != positionsLinearized.end(); itr++) {
-    const QPointF posGraph = *itr;
-
-    // Cases where we have found it at this point in the code
-    // (1) interpolation case where (xBefore < xThetaValue < xAfter)
-    // (2) extrapolation case where (xThetaValue < xBefore < xAfter and ip=0) for which we delay finding it until ip=1 so we have
-    //     two points for extrapolating. This case is why we have the subtle test for ip>0 in the next line
-    if (xThetaLinearized <= posGraph.x() && (itr != positionsLinearized.begin())) {
-
-      foundIt = true;
-
-      // Case 1 comments: xThetaValue is between posGraphBefore and posGraph. Note that if posGraph.x()=posGraphBefore.x() then
-      // previous iteration of loop would have been used for interpolation, and then the loop was exited. Range of s is 0<s<1
-      // Case 2 comments: Range of s is s<0
-      yRadiusLinearized = linearlyInterpolateYRadiusFromTwoPoints (xThetaLinearized,
-                                                                   posGraphBefore,
-                                                                   posGraph);
 
-      break;
-    }
+  // Cases where we have found it
+  // (1) interpolation case where (xBefore < xThetaValue < xAfter)
+  // (2) extrapolation case where (xThetaValue < xBefore < xAfter and ip=0) for which we delay finding it until ip=1 so we have
+  //     two points for extrapolating. This case is why the search starts at ip=1
+  int ip = indexOfPointAtOrAfterXTheta (positionsLinearized,
+                                        isSortedByXTheta,
+                                        xThetaLinearized,
+                                        ipCursor);
+  int N = positionsLinearized.count();
 
-    posGraphBefore = posGraph;
-  }
+  if (ip < N) {
 
-  if (!foundIt) {
+    // Case 1 comments: xThetaValue is between posGraphBefore and posGraph. Note that if posGraph.x()=posGraphBefore.x() then
+    // the earlier point would have been found instead. Range of s is 0<s<1
+    // Case 2 comments: Range of s is s<0
+    yRadiusLinearized = linearlyInterpolateYRadiusFromTwoPoints (xThetaLinearized,
+                                                                 positionsLinearized.at (ip - 1),
+                                                                 positionsLinearized.at (ip));
 
-    if (positionsLinearized.count() > 1) {
+  } else if (N > 1) {
 
-      // Extrapolation will be used since point is out of the range of the function points. Specifically, it is greater than the
-      // last x value in the function. Range of s is 1<s
-      int N = positionsLinearized.count();
-      const QPointF &pointBefore = positionsLinearized.at (N - 2);
-      const QPointF &pointLast = positionsLinearized.at (N - 1);
-      yRadiusLinearized = linearlyInterpolateYRadiusFromTwoPoints (xThetaLinearized,
-                                                                   pointBefore,
-                                                                   pointLast);
+    // Extrapolation will be used since point is out of the range of the function points. Specifically, it is greater than the
+    // last x value in the function. Range of s is 1<s
+    const QPointF &pointBefore = positionsLinearized.at (N - 2);
+    const QPointF &pointLast = positionsLinearized.at (N - 1);
+    yRadiusLinearized = linearlyInterpolateYRadiusFromTwoPoints (xThetaLinearized,
+                                                                 pointBefore,
+                                                                 pointLast);
 
-    } else if (positionsLinearized.count() == 1) {
+  } else if (N == 1) {
 
-      // Just use the single point
-      yRadiusLinearized = posGraphBefore.y();
+    // Just use the single point
+    yRadiusLinearized = positionsLinearized.at (0).y();
 
-    } else {
+  } else {
 
-      ENGAUGE_ASSERT (false);
+    ENGAUGE_ASSERT (false);
 
-    }
   }
 
   return yRadiusLinearized;
 }
 
+void ExportFileFunctions::loadFunctionFits (const DocumentModelExportFormat &modelExportOverride,
+                                            const Document &document,
+                                            const QStringList &curvesIncluded,
+                                            const Transformation &transformation,
+                                            bool isLogXTheta,
+                                            bool isLogYRadius,
+                                            QVector<ExportFunctionFit> &functionFits) const
+{
+
+  functionFits = QVector<ExportFunctionFit> (curvesIncluded.count());
+
+  // Spline fitting is the costly part, so the curves are fitted in parallel. The fits are accessed through a pointer
+  // taken here, since the non-const QVector::operator[] must not be called from several threads
+  ExportFunctionFit *fits = functionFits.data ();
+
+  runForEachCurve (curvesIncluded.count(),
+                   [&, fits] (int col) {
+
+    const QString curveName = curvesIncluded.at (col);
+
+    const Curve *curve = document.curveForCurveName (curveName);
+    Points points = curve->points (); // These points will be linearized below if either coordinate is log
+
+    if (modelExportOverride.pointsSelectionFunctions() == EXPORT_POINTS_SELECTION_FUNCTIONS_RAW) {
+
+      // No interpolation. Just raw points. No transformation to/from linear space is required for log coordinates
+      fits [col] = ExportFunctionFit (curveName,
+                                      points);
+
+    } else if (curve->curveStyle().lineStyle().curveConnectAs() == CONNECT_AS_FUNCTION_SMOOTH) {
+
+      // Create spline pairs with x/y coordinates in linearized coordinates and t as the independent variable
+      vector<double> t;
+      vector<SplinePair> xyLinearized;
+      ExportOrdinalsSmooth ordinalsSmooth;
+      ordinalsSmooth.loadSplinePairsWithTransformation (points,
+                                                        transformation,
+                                                        isLogXTheta,
+                                                        isLogYRadius,
+                                                        t,
+                                                        xyLinearized);
+
+      fits [col] = ExportFunctionFit (curveName,
+                                      points,
+                                      t,
+                                      xyLinearized);
+
+    } else {
+
+      FittingPointsConvenient positionsLinearized = populateLinearizedFittingPositions (points,
+                                                                                        transformation,
+                                                                                        isLogXTheta,
+                                                                                        isLogYRadius);
+
+      // The x/theta values are sorted, so with sorted points a cursor walks through the points once for all rows
+      bool isSortedByXTheta = std::is_sorted (positionsLinearized.begin(),
+                                              positionsLinearized.end(),
+                                              lessThanXThetaOfPosition);
+
+      fits [col] = ExportFunctionFit (curveName,
+                                      points,
+                                      positionsLinearized,
+                                      isSortedByXTheta);
+    }
+  });
+}
+
 void ExportFileFunctions::loadYRadiusValues (const DocumentModelExportFormat &modelExportOverride,
-                                             const Document &document,
-                                             const MainWindowModel &modelMainWindow,
-                                             const QStringList &curvesIncluded,
+                                             const QVector<ExportFunctionFit> &functionFits,
                                              const Transformation &transformation,
                                              bool isLogXTheta,
                                              bool isLogYRadius,
                                              const ExportValuesXOrY &xThetaValues,
                                              const CurveLimits &curveLimitsMin,
                                              const CurveLimits &curveLimitsMax,
-                                             QVector<QVector<QString*> > &yRadiusValues) const
+                                             QVector<ExportValuesColumn> &yRadiusValues) const
 {
 
-  // Loop through curves
-  int curveCount = curvesIncluded.count();
-  for (int col = 0; col < curveCount; col++) {
+  // Each curve is loaded into its own column so the curves are loaded in parallel. The columns are accessed through
+  // a pointer taken here, since the non-const QVector::operator[] must not be called from several threads
+  ExportValuesColumn *columns = yRadiusValues.data ();
 
-    const QString curveName = curvesIncluded.at (col);
+  runForEachCurve (functionFits.count(),
+                   [&, columns] (int col) {
 
-    const Curve *curve = document.curveForCurveName (curveName);
-    Points points = curve->points (); // These points will be linearized below if either coordinate is log
+    const ExportFunctionFit &functionFit = functionFits.at (col);
 
     if (modelExportOverride.pointsSelectionFunctions() == EXPORT_POINTS_SELECTION_FUNCTIONS_RAW) {
 
       // No interpolation. Just raw points. No transformation to/from linear space is required for log coordinates
-      loadYRadiusValuesForCurveRaw (document.modelCoords(),
-                                    document.modelGeneral(),
-                                    modelMainWindow,
-                                    points,
+      loadYRadiusValuesForCurveRaw (functionFit.points (),
                                     xThetaValues,
                                     transformation,
-                                    curveName,
+                                    functionFit.curveName (),
                                     curveLimitsMin,
                                     curveLimitsMax,
-                                    yRadiusValues [col]);
+                                    columns [col]);
     } else {
 
       // Interpolation
-      if (curve->curveStyle().lineStyle().curveConnectAs() == CONNECT_AS_FUNCTION_SMOOTH) {
+      if (functionFit.isSmooth ()) {
 
         // Transformation to/from linear space is required for log coordinates
-        loadYRadiusValuesForCurveInterpolatedSmooth (document.modelCoords(),
-                                                     document.modelGeneral(),
-                                                     modelMainWindow,
-                                                     points,
+        loadYRadiusValuesForCurveInterpolatedSmooth (functionFit,
                                                      xThetaValues,
-                                                     transformation,
                                                      isLogXTheta,
                                                      isLogYRadius,
-                                                     curveName,
                                                      curveLimitsMin,
                                                      curveLimitsMax,
-                                                     yRadiusValues [col]);
+                                                     columns [col]);
 
       } else {
 
         // Transformation to/from linear space is required for log coordinates
-        loadYRadiusValuesForCurveInterpolatedStraight (document.modelCoords(),
-                                                       document.modelGeneral(),
-                                                       modelMainWindow,
-                                                       points,
+        loadYRadiusValuesForCurveInterpolatedStraight (functionFit,
                                                        xThetaValues,
-                                                       transformation,
                                                        isLogXTheta,
                                                        isLogYRadius,
-                                                       curveName,
                                                        curveLimitsMin,
                                                        curveLimitsMax,
-                                                       yRadiusValues [col]);
+                                                       columns [col]);
       }
     }
-  }
+  });
 }
 
-void ExportFileFunctions::loadYRadiusValuesForCurveInterpolatedSmooth (const DocumentModelCoords &modelCoords,
-                                                                       const DocumentModelGeneral &modelGeneral,
-                                                                       const MainWindowModel &modelMainWindow,
-                                                                       const Points &points,
+void ExportFileFunctions::loadYRadiusValuesForCurveInterpolatedSmooth (const ExportFunctionFit &functionFit,
                                                                        const ExportValuesXOrY &xThetaValues,
-                                                                       const Transformation &transformation,
                                                                        bool isLogXTheta,
                                                                        bool isLogYRadius,
-                                                                       const QString &curveName,
                                                                        const CurveLimits &curveLimitsMin,
                                                                        const CurveLimits &curveLimitsMax,
-                                                                       QVector<QString*> &yRadiusValues) const
+                                                                       ExportValuesColumn &yRadiusValues) const
 {
 
-  // Convert screen coordinates to graph coordinates, in vectors suitable for spline fitting
-  vector<double> t;
-  vector<SplinePair> xyLinearized;
-  ExportOrdinalsSmooth ordinalsSmooth;
-
-  // Create spline pairs with x/y coordinates in linearized coordinates and t as the independent variable
-  ordinalsSmooth.loadSplinePairsWithTransformation (points,
-                                                    transformation,
-                                                    isLogXTheta,
-                                                    isLogYRadius,
-                                                    t,
-                                                    xyLinearized);
+  const Points &points = functionFit.points ();
+  const vector<SplinePair> &xyLinearized = functionFit.xyLinearized ();
+  const QString curveName = functionFit.curveName ();
 
   // Linearize/delinearize utility
   LinearToLog linearToLog;
 
-  // Formatting
-  FormatCoordsUnits format;
-  QString dummyXThetaOut;
-
   if (points.count() == 0) {
 
     // Since there are no values, leave the field empty
     for (int row = 0; row < xThetaValues.count(); row++) {
-      *(yRadiusValues [row]) = "";
+      yRadiusValues.clearValue (row);
     }
 
   } else if (points.count() == 1 ||
@@ -467,16 +589,11 @@ void ExportFileFunctions::loadYRadiusValuesForCurveInterpolatedSmooth (const Doc
                                   curveName,
                                   curveLimitsMin,
                                   curveLimitsMax)) {
-        format.unformattedToFormatted (xTheta,
-                                       yRadius,
-                                       modelCoords,
-                                       modelGeneral,
-                                       modelMainWindow,
-                                       dummyXThetaOut,
-                                       *(yRadiusValues [row]),
-                                       transformation);
+        yRadiusValues.setValue (row,
+                                xTheta,
+                                yRadius);
       } else {
-        *(yRadiusValues [row]) = "";
+        yRadiusValues.clearValue (row);
       }
     }
 
@@ -488,76 +605,68 @@ void ExportFileFunctions::loadYRadiusValuesForCurveInterpolatedSmooth (const Doc
     // the regression tests. Toggling between 30 and 32 made no difference in the regression tests.
     const int MAX_ITERATIONS = 32;
 
-    // Spline class requires at least one point
-    if (xyLinearized.size() > 0) {
+    // Spline was fitted once for all blocks of rows
+    const Spline *spline = functionFit.spline ();
+    if (spline != nullptr) {
+
+      // Linearized x/theta values, which are increasing so the spline intervals are found with one walk
+      vector<double> xThetasLinearized;
+      xThetasLinearized.reserve (unsigned (xThetaValues.count()));
+      for (int row = 0; row < xThetaValues.count(); row++) {
+        xThetasLinearized.push_back (linearToLog.linearize (xThetaValues.at (row),
+                                                            isLogXTheta));
+      }
 
-      // Fit a spline
-      Spline spline (t,
-                     xyLinearized);
+      vector<SplinePair> splinePairsFound;
+      spline->findSplinePairsForFunctionX (xThetasLinearized,
+                                           MAX_ITERATIONS,
+                                           splinePairsFound);
 
       // Get value at desired points
       for (int row = 0; row < xThetaValues.count(); row++) {
 
-        // Compute unlinearized and linearized x/theta
         double xTheta = xThetaValues.at (row);
-        double xThetaLinearized = linearToLog.linearize (xTheta,
-                                                         isLogXTheta);
-
-        SplinePair splinePairFound = spline.findSplinePairForFunctionX (xThetaLinearized,
-                                                                        MAX_ITERATIONS);
-        double yRadiusLinearized = splinePairFound.y ();
+        double yRadiusLinearized = splinePairsFound [unsigned (row)].y ();
 
         // Delinearize, which is a noop for linear coordinates
         double yRadius = linearToLog.delinearize (yRadiusLinearized,
                                                   isLogYRadius);
 
-        // Save y/radius value for this row into yRadiusValues, after appropriate formatting
+        // Save y/radius value for this row into yRadiusValues. Formatting is deferred until output
         if (xThetaIsNotOutOfBounds (xTheta,
                                     curveName,
                                     curveLimitsMin,
                                     curveLimitsMax)) {
-          format.unformattedToFormatted (xTheta,
-                                         yRadius,
-                                         modelCoords,
-                                         modelGeneral,
-                                         modelMainWindow,
-                                         dummyXThetaOut,
-                                         *(yRadiusValues [row]),
-                                         transformation);
+          yRadiusValues.setValue (row,
+                                  xTheta,
+                                  yRadius);
         } else {
-          *(yRadiusValues [row]) = "";
+          yRadiusValues.clearValue (row);
         }
       }
     }
   }
 }
 
-void ExportFileFunctions::loadYRadiusValuesForCurveInterpolatedStraight (const DocumentModelCoords &modelCoords,
-                                                                         const DocumentModelGeneral &modelGeneral,
-                                                                         const MainWindowModel &modelMainWindow,
-                                                                         const Points &points,
+void ExportFileFunctions::loadYRadiusValuesForCurveInterpolatedStraight (const ExportFunctionFit &functionFit,
                                                                          const ExportValuesXOrY &xThetaValues,
-                                                                         const Transformation &transformation,
                                                                          bool isLogXTheta,
                                                                          bool isLogYRadius,
-                                                                         const QString &curveName,
                                                                          const CurveLimits &curveLimitsMin,
                                                                          const CurveLimits &curveLimitsMax,
-                                                                         QVector<QString*> &yRadiusValues) const
+                                                                         ExportValuesColumn &yRadiusValues) const
 {
 
-  FormatCoordsUnits format;
-
   // Linearize/delinearize utility
   LinearToLog linearToLog;
 
-  FittingPointsConvenient positionsLinearized = populateLinearizedFittingPositions (points,
-                                                                                    transformation,
-                                                                                    isLogXTheta,
-                                                                                    isLogYRadius);
+  const FittingPointsConvenient &positionsLinearized = functionFit.positionsLinearized ();
+  bool isSortedByXTheta = functionFit.isSortedByXTheta ();
+  const QString curveName = functionFit.curveName ();
+
+  int ipCursor = 1;
 
   // Get value at desired points
-  QString dummyXThetaOut;
   for (int row = 0; row < xThetaValues.count(); row++) {
 
     // Compute unlinearized and linearized x/theta
@@ -566,46 +675,38 @@ void ExportFileFunctions::loadYRadiusValuesForCurveInterpolatedStraight (const D
                                                      isLogXTheta);
 
     // Interpolation on curve with no points will trigger an assert so check the point count
-    *(yRadiusValues [row]) = "";
+    yRadiusValues.clearValue (row);
     if (positionsLinearized.count () > 0) {
 
       double yRadiusLinearized = linearlyInterpolate (positionsLinearized,
-                                                      xThetaLinearized);
+                                                      isSortedByXTheta,
+                                                      xThetaLinearized,
+                                                      ipCursor);
       double yRadius = linearToLog.delinearize (yRadiusLinearized,
                                                 isLogYRadius);
 
-      // Save y/radius value for this row into yRadiusValues, after appropriate formatting
+      // Save y/radius value for this row into yRadiusValues. Formatting is deferred until output
       if (xThetaIsNotOutOfBounds (xTheta,
                                   curveName,
                                   curveLimitsMin,
                                   curveLimitsMax)) {
-        format.unformattedToFormatted (xTheta,
-                                       yRadius,
-                                       modelCoords,
-                                       modelGeneral,
-                                       modelMainWindow,
-                                       dummyXThetaOut,
-                                       *(yRadiusValues [row]),
-                                       transformation);
+        yRadiusValues.setValue (row,
+                                xTheta,
+                                yRadius);
       }
     }
   }
 }
 
-void ExportFileFunctions::loadYRadiusValuesForCurveRaw (const DocumentModelCoords &modelCoords,
-                                                        const DocumentModelGeneral &modelGeneral,
-                                                        const MainWindowModel &modelMainWindow,
-                                                        const Points &points,
+void ExportFileFunctions::loadYRadiusValuesForCurveRaw (const Points &points,
                                                         const ExportValuesXOrY &xThetaValues,
                                                         const Transformation &transformation,
                                                         const QString &curveName,
                                                         const CurveLimits &curveLimitsMin,
                                                         const CurveLimits &curveLimitsMax,
-                                                        QVector<QString*> &yRadiusValues) const
+                                                        ExportValuesColumn &yRadiusValues) const
 {
 
-  FormatCoordsUnits format;
-
   // Since the curve points may be a subset of xThetaValues (in which case the non-applicable xThetaValues will have
   // blanks for the yRadiusValues), we iterate over the smaller set
   for (int pt = 0; pt < points.count(); pt++) {
@@ -635,40 +736,27 @@ void ExportFileFunctions::loadYRadiusValuesForCurveRaw (const DocumentModelCoord
       }
     }
 
-    // Save y/radius value for this row into yRadiusValues, after appropriate formatting
+    // Save y/radius value for this row into yRadiusValues. The raw x/theta value is kept rather than the x/theta
+    // value of the row, since the formatting precision depends on it
     if (xThetaIsNotOutOfBounds (posGraph.x(),
                                 curveName,
                                 curveLimitsMin,
                                 curveLimitsMax)) {
-      QString dummyXThetaOut;
-      format.unformattedToFormatted (posGraph.x(),
-                                     posGraph.y(),
-                                     modelCoords,
-                                     modelGeneral,
-                                     modelMainWindow,
-                                     dummyXThetaOut,
-                                     *(yRadiusValues [rowClosest]),
-                                     transformation);
+      yRadiusValues.setValue (rowClosest,
+                              posGraph.x(),
+                              posGraph.y());
     } else {
-      *(yRadiusValues [rowClosest]) = "";
+      yRadiusValues.clearValue (rowClosest);
     }
   }
 }
 
-void ExportFileFunctions::outputXThetaYRadiusValues (const DocumentModelExportFormat &modelExportOverride,
-                                                     const DocumentModelCoords &modelCoords,
-                                                     const DocumentModelGeneral &modelGeneral,
-                                                     const MainWindowModel &modelMainWindow,
-                                                     const QStringList &curvesIncluded,
-                                                     const ExportValuesXOrY &xThetaValuesMerged,
-                                                     const Transformation &transformation,
-                                                     QVector<QVector<QString*> > &yRadiusValues,
-                                                     const QString &delimiter,
-                                                     QTextStream &str,
-                                                     unsigned int &numWritesSoFar) const
+void ExportFileFunctions::outputHeader (const DocumentModelExportFormat &modelExportOverride,
+                                        const QStringList &curvesIncluded,
+                                        const QString &delimiter,
+                                        QTextStream &str,
+                                        unsigned int numWritesSoFar) const
 {
-
-  // Header
   if (modelExportOverride.header() != EXPORT_HEADER_NONE) {
     insertLineSeparator (numWritesSoFar == 0,
                          modelExportOverride.header (),
@@ -684,10 +772,27 @@ void ExportFileFunctions::outputXThetaYRadiusValues (const DocumentModelExportFo
     }
     str << "\n";
   }
+}
 
-  // Table body
+void ExportFileFunctions::outputXThetaYRadiusValues (const DocumentModelExportFormat &modelExportOverride,
+                                                     const DocumentModelCoords &modelCoords,
+                                                     const DocumentModelGeneral &modelGeneral,
+                                                     const MainWindowModel &modelMainWindow,
+                                                     const ExportValuesXOrY &xThetaValuesMerged,
+                                                     const Transformation &transformation,
+                                                     const QVector<ExportValuesColumn> &yRadiusValues,
+                                                     const QString &delimiter,
+                                                     QTextStream &str) const
+{
+
+  // Each value is formatted just before it is written, so the table never exists as strings. The locale and
+  // precision plan are set up once for the whole block
   FormatCoordsUnits format;
+  FormatPrecisionPlan precisionPlan (modelGeneral,
+                                     transformation);
+  const QLocale locale = modelMainWindow.locale();
   const double DUMMY_Y_RADIUS = 1.0;
+  QString dummyXThetaOut;
 
   for (int row = 0; row < xThetaValuesMerged.count(); row++) {
 
@@ -701,17 +806,26 @@ void ExportFileFunctions::outputXThetaYRadiusValues (const DocumentModelExportFo
       format.unformattedToFormatted (xTheta,
                                      DUMMY_Y_RADIUS,
                                      modelCoords,
-                                     modelGeneral,
-                                     modelMainWindow,
+                                     locale,
+                                     precisionPlan,
                                      xThetaString,
-                                     yRadiusString,
-                                     transformation);
+                                     yRadiusString);
       str << wrapInDoubleQuotesIfNeeded (modelExportOverride,
                                          xThetaString);
 
       for (int col = 0; col < yRadiusValues.count(); col++) {
 
-        QString yRadiusString = *(yRadiusValues [col] [row]);
+        const ExportValuesColumn &column = yRadiusValues.at (col);
+        yRadiusString = "";
+        if (column.isValid (row)) {
+          format.unformattedToFormatted (column.xTheta (row),
+                                         column.yRadius (row),
+                                         modelCoords,
+                                         locale,
+                                         precisionPlan,
+                                         dummyXThetaOut,
+                                         yRadiusString);
+        }
         str << delimiter << wrapInDoubleQuotesIfNeeded (modelExportOverride,
                                                         yRadiusString);
       }
@@ -719,8 +833,6 @@ void ExportFileFunctions::outputXThetaYRadiusValues (const DocumentModelExportFo
       str << "\n";
     }
   }
-
-  ++numWritesSoFar;
 }
 
 FittingPointsConvenient ExportFileFunctions::populateLinearizedFittingPositions (const Points &points,
@@ -749,15 +861,14 @@ FittingPointsConvenient ExportFileFunctions::populateLinearizedFittingPositions
   return positionsLinearized;
 }
 
-bool ExportFileFunctions::rowHasAtLeastOneYRadiusEntry (const QVector<QVector<QString*> > &yRadiusValues,
+bool ExportFileFunctions::rowHasAtLeastOneYRadiusEntry (const QVector<ExportValuesColumn> &yRadiusValues,
                                                         int row) const
 {
   bool hasEntry = false;
 
   for (int col = 0; col < yRadiusValues.count(); col++) {
 
-    QString entry = *(yRadiusValues [col] [row]);
-    if (!entry.isEmpty()) {
+    if (yRadiusValues.at (col).isValid (row)) {
 
       hasEntry = true;
       break;
@@ -785,3 +896,42 @@ bool ExportFileFunctions::xThetaIsNotOutOfBounds (double xTheta,
 
   return ok;
 }
+
+ExportXThetaValuesMergedFunctions ExportFileFunctions::xThetaValuesMergedForCurves (const DocumentModelExportFormat &modelExportOverride,
+                                                                                    const Document &document,
+                                                                                    const MainWindowModel &modelMainWindow,
+                                                                                    const Transformation &transformation,
+                                                                                    const QStringList &curvesIncluded,
+                                                                                    CurveLimits &curveLimitsMin,
+                                                                                    CurveLimits &curveLimitsMax) const
+{
+  ExportValuesXOrY xThetaValuesRaw;
+  if (modelExportOverride.pointsSelectionFunctions() == EXPORT_POINTS_SELECTION_FUNCTIONS_INTERPOLATE_GRID_LINES) {
+    CallbackGatherXThetasInGridLines ftor (modelMainWindow,
+                                           modelExportOverride,
+                                           curvesIncluded,
+                                           transformation,
+                                           document);
+    Functor2wRet<const QString &, const Point &, CallbackSearchReturn> ftorWithCallback = functor_ret (ftor,
+                                                                                                       &CallbackGatherXThetasInGridLines::callback);
+    document.iterateThroughCurvesPointsGraphs(ftorWithCallback);
+    xThetaValuesRaw = ftor.xThetaValuesRaw();
+    curveLimitsMin = ftor.curveLimitsMin();
+    curveLimitsMax = ftor.curveLimitsMax();
+  } else {
+    CallbackGatherXThetasInCurves ftor (modelExportOverride,
+                                        curvesIncluded,
+                                        transformation);
+    Functor2wRet<const QString &, const Point &, CallbackSearchReturn> ftorWithCallback = functor_ret (ftor,
+                                                                                                       &CallbackGatherXThetasInCurves::callback);
+    document.iterateThroughCurvesPointsGraphs(ftorWithCallback);
+    xThetaValuesRaw = ftor.xThetaValuesRaw();
+    curveLimitsMin = ftor.curveLimitsMin();
+    curveLimitsMax = ftor.curveLimitsMax();
+  }
+
+  return ExportXThetaValuesMergedFunctions (modelExportOverride,
+                                            modelMainWindow,
+                                            xThetaValuesRaw,
+                                            transformation);
+}
@@ -8,8 +8,12 @@
 #define EXPORT_FILE_FUNCTIONS_H
 
 #include "CurveLimits.h"
+#include "ExportColumnsLoader.h"
 #include "ExportFileAbstractBase.h"
+#include "ExportFunctionFit.h"
+#include "ExportValuesColumn.h"
 #include "ExportValuesXOrY.h"
+#include "ExportXThetaValuesMergedFunctions.h"
 #include "FittingPointsConvenient.h"
 #include "Points.h"
 #include <QStringList>
@@ -34,8 +38,21 @@ public:
   /// Single constructor.
   ExportFileFunctions();
 
+  /// Prepare the included function curves for loading their unformatted values in blocks, one column per curve, for
+  /// the binary export formats. Every column has one row per merged x/theta value, and rows that are not applicable
+  /// to a curve have no value. The row count is for all blocks, and is not limited by the maximum number of exported
+  /// points per curve. The returned loader keeps its own copy of everything it needs
+  ExportColumnsLoader exportToColumns (const DocumentModelExportFormat &modelExportOverride,
+                                       const Document &document,
+                                       const MainWindowModel &modelMainWindow,
+                                       const Transformation &transformation,
+                                       QStringList &curvesIncluded,
+                                       int &rowCount) const;
+
   /// Export Document points according to the settings. The DocumentModelExportFormat inside the Document is ignored so
-  /// DlgSettingsExport can supply its own DocumentModelExportFormat when previewing what would be exported.
+  /// DlgSettingsExport can supply its own DocumentModelExportFormat when previewing what would be exported. Rows are
+  /// generated and written one block at a time so there is no limit on their number. The isOverrun flag is set, as a
+  /// warning for the preview, when there are more rows than the maximum number of exported points per curve
   void exportToFile (const DocumentModelExportFormat &modelExportOverride,
                      const Document &document,
                      const MainWindowModel &modelMainWindow,
@@ -50,7 +67,7 @@ private:
                                            const Document &document,
                                            const MainWindowModel &modelMainWindow,
                                            const QStringList &curvesIncluded,
-                                           const ExportValuesXOrY &xThetaValues,
+                                           ExportXThetaValuesMergedFunctions &xThetaValues,
                                            const QString &delimiter,
                                            const Transformation &transformation,
                                            bool isLogXTheta,
@@ -63,7 +80,7 @@ private:
                                            const Document &document,
                                            const MainWindowModel &modelMainWindow,
                                            const QStringList &curvesIncluded,
-                                           const ExportValuesXOrY &xThetaValues,
+                                           ExportXThetaValuesMergedFunctions &xThetaValues,
                                            const QString &delimiter,
                                            const Transformation &transformation,
                                            bool isLogXTheta,
@@ -73,73 +90,81 @@ private:
                                            QTextStream &str,
                                            unsigned int &numWritesSoFar) const;
 
-  /// Allocate a 2D y/radius array indexed by (included) curve and x/theta.
-  /// Array rows and columns are set up so yRadiusValues[N] gives vector for Nth curve. Values are strings
-  /// so non-applicable entries can be blank
-  void initializeYRadiusValues (const QStringList &curvesIncluded,
-                                const ExportValuesXOrY &xThetaValuesMerged,
-                                QVector<QVector<QString*> > &yRadiusValues) const;
+  // Find the point that ends the pair used for interpolating at the specified x/theta value. When the points are sorted
+  // by x/theta, ipCursor carries the position from the previous call so increasing x/theta values take one walk through
+  // the points, and decreasing x/theta values are found by binary search
+  int indexOfPointAtOrAfterXTheta (const FittingPointsConvenient &positionsLinearized,
+                                   bool isSortedByXTheta,
+                                   double xThetaLinearized,
+                                   int &ipCursor) const;
 
   double linearlyInterpolate (const FittingPointsConvenient &positionsLinearized,
-                              double xThetaLinearized) const;
+                              bool isSortedByXTheta,
+                              double xThetaLinearized,
+                              int &ipCursor) const;
+
+  /// Transform the points of each included curve, and fit the splines of smooth curves, once for all blocks of rows
+  void loadFunctionFits (const DocumentModelExportFormat &modelExportOverride,
+                         const Document &document,
+                         const QStringList &curvesIncluded,
+                         const Transformation &transformation,
+                         bool isLogXTheta,
+                         bool isLogYRadius,
+                         QVector<ExportFunctionFit> &functionFits) const;
+
+  /// Load the y/radius values, which are indexed by (included) curve and x/theta so yRadiusValues[N] gives the
+  /// column for Nth curve. Each column keeps the x/theta value used for formatting alongside each y/radius value,
+  /// since raw points need not fall exactly on the merged x/theta values. Non-applicable entries are left without
+  /// a value so they are output as blanks
   void loadYRadiusValues (const DocumentModelExportFormat &modelExportOverride,
-                          const Document &document,
-                          const MainWindowModel &modelMainWindow,
-                          const QStringList &curvesIncluded,
+                          const QVector<ExportFunctionFit> &functionFits,
                           const Transformation &transformation,
                           bool isLogXTheta,
                           bool isLogYRadius,
                           const ExportValuesXOrY &xThetaValues,
                           const CurveLimits &curveLimitsMin,
                           const CurveLimits &curveLimitsMax,
-                          QVector<QVector<QString*> > &yRadiusValues) const;
-  void loadYRadiusValuesForCurveInterpolatedSmooth (const DocumentModelCoords &modelCoords,
-                                                    const DocumentModelGeneral &modelGeneral,
-                                                    const MainWindowModel &modelMainWindow,
-                                                    const Points &points,
+                          QVector<ExportValuesColumn> &yRadiusValues) const;
+  void loadYRadiusValuesForCurveInterpolatedSmooth (const ExportFunctionFit &functionFit,
                                                     const ExportValuesXOrY &xThetaValues,
-                                                    const Transformation &transformation,
                                                     bool isLogXTheta,
                                                     bool isLogYRadius,
-                                                    const QString &curveName,
                                                     const CurveLimits &curveLimitsMin,
                                                     const CurveLimits &curveLimitsMax,
-                                                    QVector<QString*> &yRadiusValues) const;
-  void loadYRadiusValuesForCurveInterpolatedStraight (const DocumentModelCoords &modelCoords,
-                                                      const DocumentModelGeneral &modelGeneral,
-                                                      const MainWindowModel &modelMainWindow,
-                                                      const Points &points,
+                                                    ExportValuesColumn &yRadiusValues) const;
+  void loadYRadiusValuesForCurveInterpolatedStraight (const ExportFunctionFit &functionFit,
                                                       const ExportValuesXOrY &xThetaValues,
-                                                      const Transformation &transformation,
                                                       bool isLogXTheta,
                                                       bool isLogYRadius,
-                                                      const QString &curveName,
                                                       const CurveLimits &curveLimitsMin,
                                                       const CurveLimits &curveLimitsMax,
-                                                      QVector<QString*> &yRadiusValues) const;
-  void loadYRadiusValuesForCurveRaw (const DocumentModelCoords &modelCoords,
-                                     const DocumentModelGeneral &modelGeneral,
-                                     const MainWindowModel &modelMainWindow,
-                                     const Points &points,
+                                                      ExportValuesColumn &yRadiusValues) const;
+  void loadYRadiusValuesForCurveRaw (const Points &points,
                                      const ExportValuesXOrY &xThetaValues,
                                      const Transformation &transformation,
                                      const QString &curveName,
                                      const CurveLimits &curveLimitsMin,
                                      const CurveLimits &curveLimitsMax,
-                                     QVector<QString*> &yRadiusValues) const;
+                                     ExportValuesColumn &yRadiusValues) const;
 
-  /// Output 2D y/radius array along with x/theta vector in first column
+  /// Output header line, if any, with x/theta label and curve names
+  void outputHeader (const DocumentModelExportFormat &modelExportOverride,
+                     const QStringList &curvesIncluded,
+                     const QString &delimiter,
+                     QTextStream &str,
+                     unsigned int numWritesSoFar) const;
+
+  /// Output block of 2D y/radius array along with x/theta vector in first column. Values are formatted as each row
+  /// is written
   void outputXThetaYRadiusValues (const DocumentModelExportFormat &modelExportOverride,
                                   const DocumentModelCoords &modelCoords,
                                   const DocumentModelGeneral &modelGeneral,
                                   const MainWindowModel &modelMainWindow,
-                                  const QStringList &curvesIncluded,
                                   const ExportValuesXOrY &xThetaValuesMerged,
                                   const Transformation &transformation,
-                                  QVector<QVector<QString*> > &yRadiusValues,
+                                  const QVector<ExportValuesColumn> &yRadiusValues,
                                   const QString &delimiter,
-                                  QTextStream &str,
-                                  unsigned int &numWritesSoFar) const;
+                                  QTextStream &str) const;
   // Transform screen points into linearized graph points
   FittingPointsConvenient populateLinearizedFittingPositions (const Points &points,
                                                               const Transformation &transformation,
@@ -147,7 +172,7 @@ private:
                                                               bool isLogYRadius) const;
   // Only include rows that have at least one y/radius entry. This check is required when outputing one curve per row
   // since the union of all x/theta values is applied to each curve
-  bool rowHasAtLeastOneYRadiusEntry (const QVector<QVector<QString*> > &yRadiusValues,
+  bool rowHasAtLeastOneYRadiusEntry (const QVector<ExportValuesColumn> &yRadiusValues,
                                      int row) const;
 
   // If there are bounds for the curve, make sure xTheta is within those bounds
@@ -155,6 +180,16 @@ private:
                                const QString &curveName,
                                const CurveLimits &curveLimitsMin,
                                const CurveLimits &curveLimitsMax) const;
+
+  // Gather the x/theta values of the included curves, or the grid lines, and merge them into the generator of the
+  // exported x/theta values. Also get the endpoint limits, if any
+  ExportXThetaValuesMergedFunctions xThetaValuesMergedForCurves (const DocumentModelExportFormat &modelExportOverride,
+                                                                 const Document &document,
+                                                                 const MainWindowModel &modelMainWindow,
+                                                                 const Transformation &transformation,
+                                                                 const QStringList &curvesIncluded,
+                                                                 CurveLimits &curveLimitsMin,
+                                                                 CurveLimits &curveLimitsMax) const;
 };
 
 #endif // EXPORT_FILE_FUNCTIONS_H
@@ -4,6 +4,7 @@
  * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
  ******************************************************************************************************/
 
+#include <algorithm>
 #include "CurveConnectAs.h"
 #include "Document.h"
 #include "DocumentModelGeneral.h"
@@ -12,9 +13,14 @@
 #include "ExportLayoutFunctions.h"
 #include "ExportOrdinalsSmooth.h"
 #include "ExportOrdinalsStraight.h"
+#include "ExportRelationFit.h"
+#include "ExportValuesColumn.h"
 #include "FormatCoordsUnits.h"
+#include "FormatPrecisionPlan.h"
 #include "Logger.h"
+#include "MainWindowModel.h"
 #include <qmath.h>
+#include <QLocale>
 #include <QTextStream>
 #include <QVector>
 #include "Spline.h"
@@ -24,7 +30,17 @@
 
 using namespace std;
 
-const int COLUMNS_PER_CURVE = 2;
+static bool lessThanOrdinal (const Point &point,
+                             double ordinal)
+{
+  return point.ordinal() < ordinal;
+}
+
+static bool lessThanOrdinalOfPoint (const Point &point,
+                                    const Point &pointOther)
+{
+  return point.ordinal() < pointOther.ordinal();
+}
 
 ExportFileRelations::ExportFileRelations()
 {
@@ -41,150 +57,59 @@ void ExportFileRelations::exportAllPerLineXThetaValuesMerged (const DocumentMode
                                                               QTextStream &str,
                                                               unsigned int &numWritesSoFar) const
 {
-
-  int maxColumnSize = maxColumnSizeAllocation (modelExportOverride,
-                                               document,
-                                               transformation,
-                                               isLogXTheta,
-                                               isLogYRadius,
-                                               curvesIncluded);
-
-  // Skip if every curve was a function
-  if (maxColumnSize > 0) {
-
-    if (modelExportOverride.pointsSelectionRelations() == EXPORT_POINTS_SELECTION_RELATIONS_INTERPOLATE) {
-
-      exportAllPerLineXThetaValuesMergedMultiplePass (maxColumnSize,
-                                                      modelExportOverride,
-                                                      document,
-                                                      modelMainWindow,
-                                                      curvesIncluded,
-                                                      delimiter,
-                                                      transformation,
-                                                      isLogXTheta,
-                                                      isLogYRadius,
-                                                      str,
-                                                      numWritesSoFar);
-
-    } else {
-
-      exportAllPerLineXThetaValuesMergedOnePass (maxColumnSize,
-                                                 modelExportOverride,
-                                                 document,
-                                                 modelMainWindow,
-                                                 curvesIncluded,
-                                                 delimiter,
-                                                 transformation,
-                                                 isLogXTheta,
-                                                 isLogYRadius,
-                                                 str,
-                                                 numWritesSoFar);
-    }
-  }
-}
-
-void ExportFileRelations::exportAllPerLineXThetaValuesMergedMultiplePass (int maxColumnSize,
-                                                                          const DocumentModelExportFormat &modelExportOverride,
-                                                                          const Document &document,
-                                                                          const MainWindowModel &modelMainWindow,
-                                                                          const QStringList &curvesIncluded,
-                                                                          const QString &delimiter,
-                                                                          const Transformation &transformation,
-                                                                          bool isLogXTheta,
-                                                                          bool isLogYRadius,
-                                                                          QTextStream &str,
-                                                                          unsigned int &numWritesSoFar) const
-{
   // For interpolation of relations in general a single set of x/theta values cannot be created that work for every
   // relation curve, since one curve may have M y/radius values for a specific x/radius while another curve has
-  // N y/radius values for that same x/radius value. So we export each curve into memory separately and then merge
-  // the results. Why? Since the methods called from this method all assume a single set of x/theta values can be
-  // used for all curves
-
-  const int CURVE_COUNT_PER_PASS = 1;
-
-  int curveCount = curvesIncluded.count ();
-
-  QVector<QVector<QString*> > xThetaYRadiusValuesAll (COLUMNS_PER_CURVE * curveCount, QVector<QString*> (maxColumnSize));
-
-  initializeXThetaYRadiusValues (curvesIncluded,
-                                 xThetaYRadiusValuesAll);
-
-  // One pass per curve
-  int colX = 0, colY = colX + 1;
-  for (int c = 0; c < curvesIncluded.count (); c++) {
-    QString curve = curvesIncluded [c];
-
-    QStringList curvesIncludedInPass;
-    curvesIncludedInPass << curve;
-    ENGAUGE_ASSERT (curvesIncludedInPass.count () == CURVE_COUNT_PER_PASS);
+  // N y/radius values for that same x/radius value. So each curve has its own rows, in its own column of the table
 
-    QVector<QVector<QString*> > xThetaYRadiusValuesOne (COLUMNS_PER_CURVE * CURVE_COUNT_PER_PASS, QVector<QString*> (maxColumnSize));
+  // Ordinals are found, points are transformed, and splines are fitted, just once rather than for every block
+  QVector<ExportRelationFit> relationFits;
+  loadRelationFits (modelExportOverride,
+                    document,
+                    curvesIncluded,
+                    transformation,
+                    isLogXTheta,
+                    isLogYRadius,
+                    relationFits);
 
-    initializeXThetaYRadiusValues (curvesIncludedInPass,
-                                   xThetaYRadiusValuesOne);
-    loadXThetaYRadiusValues (modelExportOverride,
-                             document,
-                             modelMainWindow,
-                             curvesIncludedInPass,
-                             transformation,
-                             isLogXTheta,
-                             isLogYRadius,
-                             xThetaYRadiusValuesOne);
+  int rowCount = maxRowCount (relationFits);
 
-    // Merge one curve array into all curves array
-    for (int row = 0; row < maxColumnSize; row++) {
-      *(xThetaYRadiusValuesAll [colX] [row]) = *(xThetaYRadiusValuesOne [0] [row]);
-      *(xThetaYRadiusValuesAll [colY] [row]) = *(xThetaYRadiusValuesOne [1] [row]);
+  // Skip if every curve was a function
+  if (rowCount > 0) {
+
+    outputHeader (modelExportOverride,
+                  curvesIncluded,
+                  delimiter,
+                  str,
+                  numWritesSoFar);
+
+    // Rows are loaded and written one block at a time, so memory use does not grow with the number of rows. Rows
+    // past the row limit are not loaded at all, so a preview of a dense relation stays quick
+    rowCount = rowCountWithinLimit (rowCount);
+    QVector<int> ipCursors (relationFits.count(), 0);
+    for (int rowStart = 0; rowStart < rowCount; rowStart += EXPORT_ROWS_PER_BLOCK) {
+
+      int blockCount = qMin (EXPORT_ROWS_PER_BLOCK,
+                             rowCount - rowStart);
+
+      QVector<ExportValuesColumn> xThetaYRadiusValues (relationFits.count(), ExportValuesColumn (blockCount));
+      loadXThetaYRadiusValues (relationFits,
+                               transformation,
+                               rowStart,
+                               ipCursors,
+                               xThetaYRadiusValues);
+
+      outputXThetaYRadiusValues (modelExportOverride,
+                                 document.modelCoords(),
+                                 document.modelGeneral(),
+                                 modelMainWindow,
+                                 transformation,
+                                 xThetaYRadiusValues,
+                                 delimiter,
+                                 str);
     }
 
-    destroy2DArray (xThetaYRadiusValuesOne);
-
-    colX += 2;
-    colY += 2;
+    ++numWritesSoFar;
   }
-
-  outputXThetaYRadiusValues (modelExportOverride,
-                             curvesIncluded,
-                             xThetaYRadiusValuesAll,
-                             delimiter,
-                             str,
-                             numWritesSoFar);
-  destroy2DArray (xThetaYRadiusValuesAll);
-}
-
-void ExportFileRelations::exportAllPerLineXThetaValuesMergedOnePass (int maxColumnSize,
-                                                                     const DocumentModelExportFormat &modelExportOverride,
-                                                                     const Document &document,
-                                                                     const MainWindowModel &modelMainWindow,
-                                                                     const QStringList &curvesIncluded,
-                                                                     const QString &delimiter,
-                                                                     const Transformation &transformation,
-                                                                     bool isLogXTheta,
-                                                                     bool isLogYRadius,
-                                                                     QTextStream &str,
-                                                                     unsigned int &numWritesSoFar) const
-{
-  int curveCount = curvesIncluded.count ();
-
-  QVector<QVector<QString*> > xThetaYRadiusValues (COLUMNS_PER_CURVE * curveCount, QVector<QString*> (maxColumnSize));
-  initializeXThetaYRadiusValues (curvesIncluded,
-                                 xThetaYRadiusValues);
-  loadXThetaYRadiusValues (modelExportOverride,
-                           document,
-                           modelMainWindow,
-                           curvesIncluded,
-                           transformation,
-                           isLogXTheta,
-                           isLogYRadius,
-                           xThetaYRadiusValues);
-  outputXThetaYRadiusValues (modelExportOverride,
-                             curvesIncluded,
-                             xThetaYRadiusValues,
-                             delimiter,
-                             str,
-                             numWritesSoFar);
-  destroy2DArray (xThetaYRadiusValues);
 }
 
 void ExportFileRelations::exportOnePerLineXThetaValuesMerged (const DocumentModelExportFormat &modelExportOverride,
@@ -217,6 +142,60 @@ void ExportFileRelations::exportOnePerLineXThetaValuesMerged (const DocumentMode
   }
 }
 
+ExportColumnsLoader ExportFileRelations::exportToColumns (const DocumentModelExportFormat &modelExportOverride,
+                                                          const Document &document,
+                                                          const Transformation &transformation,
+                                                          QStringList &curvesIncluded,
+                                                          int &rowCount) const
+{
+
+  // Log coordinates must be temporarily transformed to linear coordinates
+  bool isLogXTheta = (document.modelCoords().coordScaleXTheta() == COORD_SCALE_LOG);
+  bool isLogYRadius = (document.modelCoords().coordScaleYRadius() == COORD_SCALE_LOG);
+
+  curvesIncluded = curvesToInclude (modelExportOverride,
+                                    document,
+                                    document.curvesGraphsNames(),
+                                    CONNECT_AS_RELATION_SMOOTH,
+                                    CONNECT_AS_RELATION_STRAIGHT);
+
+  QVector<ExportRelationFit> relationFits;
+  loadRelationFits (modelExportOverride,
+                    document,
+                    curvesIncluded,
+                    transformation,
+                    isLogXTheta,
+                    isLogYRadius,
+                    relationFits);
+
+  int rowCountAll = maxRowCount (relationFits);
+  rowCount = rowCountAll;
+
+  // The loader captures copies, including the cursors and the next row which carry over from one block to the next
+  ExportFileRelations exporter (*this);
+  QVector<int> ipCursors (relationFits.count(), 0);
+  int rowStart = 0;
+  return [=] (int blockCount,
+              QVector<ExportValuesColumn> &xThetaYRadiusValues) mutable -> int {
+
+    int blockCountLoaded = qMin (blockCount,
+                                 rowCountAll - rowStart);
+
+    xThetaYRadiusValues = QVector<ExportValuesColumn> (relationFits.count(),
+                                                       ExportValuesColumn (blockCountLoaded));
+    if (blockCountLoaded > 0) {
+      exporter.loadXThetaYRadiusValues (relationFits,
+                                        transformation,
+                                        rowStart,
+                                        ipCursors,
+                                        xThetaYRadiusValues);
+      rowStart += blockCountLoaded;
+    }
+
+    return blockCountLoaded;
+  };
+}
+
 void ExportFileRelations::exportToFile (const DocumentModelExportFormat &modelExportOverride,
                                         const Document &document,
                                         const MainWindowModel &modelMainWindow,
@@ -271,66 +250,85 @@ void ExportFileRelations::exportToFile (const DocumentModelExportFormat &modelEx
   }
 }
 
-void ExportFileRelations::initializeXThetaYRadiusValues (const QStringList &curvesIncluded,
-                                                         QVector<QVector<QString*> > &xThetaYRadiusValues) const
+int ExportFileRelations::indexOfPointAtOrAfterOrdinal (const Points &points,
+                                                      bool isSortedByOrdinal,
+                                                      double ordinal,
+                                                      int &ipCursor) const
 {
+  // Result is the first index ip with ordinal <= points[ip].ordinal, or the point count if there is none
+  int count = points.count();
 
-  // Initialize every entry with empty string
-  int curveCount = curvesIncluded.count();
-  int xThetaCount = xThetaYRadiusValues [0].count();
-  for (int row = 0; row < xThetaCount; row++) {
-    for (int col = 0; col < COLUMNS_PER_CURVE * curveCount; col++) {
-      xThetaYRadiusValues [col] [row] = new QString;
+  if (!isSortedByOrdinal) {
+
+    // Search from the start every time, since a later point may have a smaller ordinal than an earlier point
+    int ip = 0;
+    while ((ip < count) && (points.at (ip).ordinal() < ordinal)) {
+      ++ip;
     }
+
+    return ip;
   }
+
+  if ((ipCursor > 0) &&
+      (ordinal <= points.at (ipCursor - 1).ordinal())) {
+
+    // This ordinal is before the previous one, so binary search for it
+    Points::const_iterator itr = std::lower_bound (points.begin(),
+                                                   points.end(),
+                                                   ordinal,
+                                                   lessThanOrdinal);
+    ipCursor = int (itr - points.begin());
+
+  } else {
+
+    // Every point before the cursor is before this ordinal, so walk forward from the cursor. The ordinals are
+    // increasing, so the whole walk visits each point only once
+    while ((ipCursor < count) && (points.at (ipCursor).ordinal() < ordinal)) {
+      ++ipCursor;
+    }
+  }
+
+  return ipCursor;
 }
 
 QPointF ExportFileRelations::linearlyInterpolate (const Points &points,
+                                                  const FittingPointsConvenient &positionsGraph,
+                                                  bool isSortedByOrdinal,
                                                   double ordinal,
-                                                  const Transformation &transformation) const
+                                                  int &ipCursor) const
 {
 
   double xTheta = 0, yRadius = 0;
-  double ordinalBefore = 0; // Not set until ip=1
-  QPointF posGraphBefore; // Not set until ip=1
-  bool foundIt = false;
-  for (int ip = 0; ip < points.count(); ip++) {
 
-    const Point &point = points.at (ip);
-    QPointF posGraph;
-    transformation.transformScreenToRawGraph (point.posScreen(),
-                                              posGraph);
-
-    if (ordinal <= point.ordinal()) {
-
-      foundIt = true;
-      if (ip == 0) {
+  int ip = indexOfPointAtOrAfterOrdinal (points,
+                                         isSortedByOrdinal,
+                                         ordinal,
+                                         ipCursor);
 
-        // Use first point
-        xTheta = posGraph.x();
-        yRadius = posGraph.y();
+  if (ip == points.count()) {
 
-      } else {
-
-        // Between posGraphBefore and posGraph. Note that if posGraph.x()=posGraphBefore.x() then
-        // previous iteration of loop would have been used for interpolation, and then the loop was exited
-        double s = (ordinal - ordinalBefore) / (point.ordinal() - ordinalBefore);
-        xTheta =  (1.0 - s) * posGraphBefore.x() + s * posGraph.x();
-        yRadius = (1.0 - s) * posGraphBefore.y() + s * posGraph.y();
-      }
-
-      break;
+    // Use last point, if there is one
+    if (ip > 0) {
+      xTheta = positionsGraph.at (ip - 1).x();
+      yRadius = positionsGraph.at (ip - 1).y();
     }
 
-    ordinalBefore = point.ordinal();
-    posGraphBefore = posGraph;
-  }
+  } else if (ip == 0) {
 
-  if (!foundIt) {
+    // Use first point
+    xTheta = positionsGraph.at (0).x();
+    yRadius = positionsGraph.at (0).y();
 
-    // Use last point
-    xTheta = posGraphBefore.x();
-    yRadius = posGraphBefore.y();
+  } else {
+
+    // Between posGraphBefore and posGraph. Note that if posGraph.x()=posGraphBefore.x() then
+    // the earlier point would have been found instead
+    double ordinalBefore = points.at (ip - 1).ordinal();
+    const QPointF &posGraphBefore = positionsGraph.at (ip - 1);
+    const QPointF &posGraph = positionsGraph.at (ip);
+    double s = (ordinal - ordinalBefore) / (points.at (ip).ordinal() - ordinalBefore);
+    xTheta =  (1.0 - s) * posGraphBefore.x() + s * posGraph.x();
+    yRadius = (1.0 - s) * posGraphBefore.y() + s * posGraph.y();
 
   }
 
@@ -338,176 +336,140 @@ QPointF ExportFileRelations::linearlyInterpolate (const Points &points,
                   yRadius);
 }
 
-void ExportFileRelations::loadXThetaYRadiusValues (const DocumentModelExportFormat &modelExportOverride,
-                                                   const Document &document,
-                                                   const MainWindowModel &modelMainWindow,
-                                                   const QStringList &curvesIncluded,
-                                                   const Transformation &transformation,
-                                                   bool isLogXTheta,
-                                                   bool isLogYRadius,
-                                                   QVector<QVector<QString*> > &xThetaYRadiusValues) const
+void ExportFileRelations::loadRelationFits (const DocumentModelExportFormat &modelExportOverride,
+                                            const Document &document,
+                                            const QStringList &curvesIncluded,
+                                            const Transformation &transformation,
+                                            bool isLogXTheta,
+                                            bool isLogYRadius,
+                                            QVector<ExportRelationFit> &relationFits) const
 {
+  relationFits = QVector<ExportRelationFit> (curvesIncluded.count());
+
+  // Finding the ordinals and fitting the splines are the costly parts, so the curves are done in parallel. The row
+  // count of the table comes from these results, so no curve is walked twice. The fits are accessed through a pointer
+  // taken here, since the non-const QVector::operator[] must not be called from several threads
+  ExportRelationFit *fits = relationFits.data ();
+
+  runForEachCurve (curvesIncluded.count(),
+                   [&, fits] (int ic) {
+
+    fits [ic] = relationFitForCurve (modelExportOverride,
+                                     document,
+                                     curvesIncluded.at (ic),
+                                     transformation,
+                                     isLogXTheta,
+                                     isLogYRadius);
+  });
+}
 
-  // The curve processing logic here is mirrored in maxColumnSizeAllocation so the array allocations are in sync
-  for (int ic = 0; ic < curvesIncluded.count(); ic++) {
+void ExportFileRelations::loadXThetaYRadiusValues (const QVector<ExportRelationFit> &relationFits,
+                                                   const Transformation &transformation,
+                                                   int rowStart,
+                                                   QVector<int> &ipCursors,
+                                                   QVector<ExportValuesColumn> &xThetaYRadiusValues) const
+{
 
-    int colXTheta = 2 * ic;
-    int colYRadius = 2 * ic + 1;
+  // Each curve is loaded into its own column so the curves are loaded in parallel. The columns and cursors are
+  // accessed through pointers taken here, since the non-const QVector::operator[] must not be called from several
+  // threads
+  ExportValuesColumn *columns = xThetaYRadiusValues.data ();
+  int *cursors = ipCursors.data ();
 
-    const QString curveName = curvesIncluded.at (ic);
+  runForEachCurve (relationFits.count(),
+                   [&, columns, cursors] (int ic) {
 
-    const Curve *curve = document.curveForCurveName (curveName);
-    const Points points = curve->points ();
+    const ExportRelationFit &relationFit = relationFits.at (ic);
 
-    if (modelExportOverride.pointsSelectionRelations() == EXPORT_POINTS_SELECTION_RELATIONS_RAW) {
+    if (relationFit.isRaw ()) {
 
       // No interpolation. Raw points
-      loadXThetaYRadiusValuesForCurveRaw (document.modelCoords(),
-                                          document.modelGeneral(),
-                                          modelMainWindow,
-                                          points,
-                                          xThetaYRadiusValues [colXTheta],
-                                          xThetaYRadiusValues [colYRadius],
-                                          transformation);
+      loadXThetaYRadiusValuesForCurveRaw (relationFit,
+                                          transformation,
+                                          rowStart,
+                                          columns [ic]);
+
+    } else if (relationFit.isSmooth ()) {
+
+      loadXThetaYRadiusValuesForCurveInterpolatedSmooth (relationFit,
+                                                         rowStart,
+                                                         columns [ic]);
+
     } else {
 
-      const LineStyle &lineStyle = document.modelCurveStyles().lineStyle(curveName);
-
-      // Interpolation. Points are taken approximately every every modelExport.pointsIntervalRelations
-      ExportValuesOrdinal ordinals = ordinalsAtIntervals (modelExportOverride.pointsIntervalRelations(),
-                                                          modelExportOverride.pointsIntervalUnitsRelations(),
-                                                          lineStyle.curveConnectAs(),
-                                                          transformation,
-                                                          isLogXTheta,
-                                                          isLogYRadius,
-                                                          points);
-
-      if (curve->curveStyle().lineStyle().curveConnectAs() == CONNECT_AS_RELATION_SMOOTH) {
-
-        loadXThetaYRadiusValuesForCurveInterpolatedSmooth (document.modelCoords(),
-                                                           document.modelGeneral(),
-                                                           modelMainWindow,
-                                                           points,
-                                                           ordinals,
-                                                           xThetaYRadiusValues [colXTheta],
-                                                           xThetaYRadiusValues [colYRadius],
-                                                           transformation,
-                                                           isLogXTheta,
-                                                           isLogYRadius);
-
-      } else {
-
-        loadXThetaYRadiusValuesForCurveInterpolatedStraight (document.modelCoords(),
-                                                             document.modelGeneral(),
-                                                             modelMainWindow,
-                                                             points,
-                                                             ordinals,
-                                                             xThetaYRadiusValues [colXTheta],
-                                                             xThetaYRadiusValues [colYRadius],
-                                                             transformation);
-      }
+      loadXThetaYRadiusValuesForCurveInterpolatedStraight (relationFit,
+                                                           rowStart,
+                                                           cursors [ic],
+                                                           columns [ic]);
     }
-  }
+  });
 }
 
-void ExportFileRelations::loadXThetaYRadiusValuesForCurveInterpolatedSmooth (const DocumentModelCoords &modelCoords,
-                                                                             const DocumentModelGeneral &modelGeneral,
-                                                                             const MainWindowModel &modelMainWindow,
-                                                                             const Points &points,
-                                                                             const ExportValuesOrdinal &ordinals,
-                                                                             QVector<QString*> &xThetaValues,
-                                                                             QVector<QString*> &yRadiusValues,
-                                                                             const Transformation &transformation,
-                                                                             bool isLogXTheta,
-                                                                             bool isLogYRadius) const
+void ExportFileRelations::loadXThetaYRadiusValuesForCurveInterpolatedSmooth (const ExportRelationFit &relationFit,
+                                                                             int rowStart,
+                                                                             ExportValuesColumn &xThetaYRadiusValues) const
 {
 
-  vector<double> t;
-  vector<SplinePair> xy;
-  ExportOrdinalsSmooth ordinalsSmooth;
-
-  ordinalsSmooth.loadSplinePairsWithTransformation (points,
-                                                    transformation,
-                                                    isLogXTheta,
-                                                    isLogYRadius,
-                                                    t,
-                                                    xy);
-
-  // Spline class requires at least one point
-  if (xy.size() > 0) {
-
-    // Fit a spline
-    Spline spline (t,
-                   xy);
+  // Spline was fitted once for all blocks of rows. There is none if the curve has no points
+  const Spline *spline = relationFit.spline ();
+  if (spline != nullptr) {
 
-    FormatCoordsUnits format;
-
-    // Extract the points
-    for (int row = 0; row < ordinals.count(); row++) {
+    // Extract the points. Rows past the end of this curve are left without a value
+    const ExportValuesOrdinal &ordinals = relationFit.ordinals ();
+    int rowEnd = qMin (rowStart + xThetaYRadiusValues.rowCount (),
+                       ordinals.count());
+    for (int row = rowStart; row < rowEnd; row++) {
 
       double ordinal = ordinals.at (row);
-      SplinePair splinePairFound = spline.interpolateCoeff(ordinal);
+      SplinePair splinePairFound = spline->interpolateCoeff(ordinal);
       double xTheta = splinePairFound.x ();
       double yRadius = splinePairFound.y ();
 
-      // Save values for this row into xThetaValues and yRadiusValues, after appropriate formatting
-      format.unformattedToFormatted (xTheta,
-                                     yRadius,
-                                     modelCoords,
-                                     modelGeneral,
-                                     modelMainWindow,
-                                     *(xThetaValues [row]),
-                                     *(yRadiusValues [row]),
-                                     transformation);
+      // Save values for this row. Formatting is deferred until output
+      xThetaYRadiusValues.setValue (row - rowStart,
+                                    xTheta,
+                                    yRadius);
     }
   }
 }
 
-void ExportFileRelations::loadXThetaYRadiusValuesForCurveInterpolatedStraight (const DocumentModelCoords &modelCoords,
-                                                                               const DocumentModelGeneral &modelGeneral,
-                                                                               const MainWindowModel &modelMainWindow,
-                                                                               const Points &points,
-                                                                               const ExportValuesOrdinal &ordinals,
-                                                                               QVector<QString*> &xThetaValues,
-                                                                               QVector<QString*> &yRadiusValues,
-                                                                               const Transformation &transformation) const
+void ExportFileRelations::loadXThetaYRadiusValuesForCurveInterpolatedStraight (const ExportRelationFit &relationFit,
+                                                                               int rowStart,
+                                                                               int &ipCursor,
+                                                                               ExportValuesColumn &xThetaYRadiusValues) const
 {
 
-  FormatCoordsUnits format;
-
-  // Get value at desired points
-  for (int row = 0; row < ordinals.count(); row++) {
+  // The ordinals are increasing, so with sorted points the cursor walks through the points once for all blocks
+  const ExportValuesOrdinal &ordinals = relationFit.ordinals ();
+  int rowEnd = qMin (rowStart + xThetaYRadiusValues.rowCount (),
+                     ordinals.count());
+  for (int row = rowStart; row < rowEnd; row++) {
 
     double ordinal = ordinals.at (row);
 
-    QPointF pointInterpolated = linearlyInterpolate (points,
+    QPointF pointInterpolated = linearlyInterpolate (relationFit.points (),
+                                                     relationFit.positionsGraph (),
+                                                     relationFit.isSortedByOrdinal (),
                                                      ordinal,
-                                                     transformation);
-
-    // Save values for this row into xThetaValues and yRadiusValues, after appropriate formatting
-    format.unformattedToFormatted (pointInterpolated.x(),
-                                   pointInterpolated.y(),
-                                   modelCoords,
-                                   modelGeneral,
-                                   modelMainWindow,
-                                   *(xThetaValues [row]),
-                                   *(yRadiusValues [row]),
-                                   transformation);
+                                                     ipCursor);
+
+    // Save values for this row. Formatting is deferred until output
+    xThetaYRadiusValues.setValue (row - rowStart,
+                                  pointInterpolated.x(),
+                                  pointInterpolated.y());
   }
 }
 
-void ExportFileRelations::loadXThetaYRadiusValuesForCurveRaw (const DocumentModelCoords &modelCoords,
-                                                              const DocumentModelGeneral &modelGeneral,
-                                                              const MainWindowModel &modelMainWindow,
-                                                              const Points &points,
-                                                              QVector<QString*> &xThetaValues,
-                                                              QVector<QString*> &yRadiusValues,
-                                                              const Transformation &transformation) const
+void ExportFileRelations::loadXThetaYRadiusValuesForCurveRaw (const ExportRelationFit &relationFit,
+                                                              const Transformation &transformation,
+                                                              int rowStart,
+                                                              ExportValuesColumn &xThetaYRadiusValues) const
 {
 
-  FormatCoordsUnits format;
-
-  for (int pt = 0; pt < points.count(); pt++) {
+  const Points &points = relationFit.points ();
+  int rowEnd = qMin (rowStart + xThetaYRadiusValues.rowCount (),
+                     points.count());
+  for (int pt = rowStart; pt < rowEnd; pt++) {
 
     const Point &point = points.at (pt);
 
@@ -515,65 +477,27 @@ void ExportFileRelations::loadXThetaYRadiusValuesForCurveRaw (const DocumentMode
     transformation.transformScreenToRawGraph (point.posScreen(),
                                               posGraph);
 
-    // Save values for this row into xThetaValues and yRadiusValues, after appropriate formatting
-    format.unformattedToFormatted (posGraph.x(),
-                                   posGraph.y(),
-                                   modelCoords,
-                                   modelGeneral,
-                                   modelMainWindow,
-                                   *(xThetaValues [pt]),
-                                   *(yRadiusValues [pt]),
-                                   transformation);
+    // Save values for this row. Formatting is deferred until output
+    xThetaYRadiusValues.setValue (pt - rowStart,
+                                  posGraph.x(),
+                                  posGraph.y());
   }
 }
 
-int ExportFileRelations::maxColumnSizeAllocation (const DocumentModelExportFormat &modelExport,
-                                                  const Document &document,
-                                                  const Transformation &transformation,
-                                                  bool isLogXTheta,
-                                                  bool isLogYRadius,
-                                                  const QStringList &curvesIncluded) const
+int ExportFileRelations::maxRowCount (const QVector<ExportRelationFit> &relationFits) const
 {
+  int rowCount = 0;
 
-  int maxColumnSize = 0;
-
-  // The curve processing logic here is mirrored in loadXThetaYRadiusValues so the array allocations are in sync
-  for (int ic = 0; ic < curvesIncluded.count(); ic++) {
-
-    const QString curveName = curvesIncluded.at (ic);
-
-    const Curve *curve = document.curveForCurveName (curveName);
-    const Points points = curve->points ();
-
-    if (modelExport.pointsSelectionRelations() == EXPORT_POINTS_SELECTION_RELATIONS_RAW) {
-
-      // No interpolation. Raw points
-      maxColumnSize = qMax (maxColumnSize,
-                            points.count());
-
-    } else {
-
-      const LineStyle &lineStyle = document.modelCurveStyles().lineStyle(curveName);
-
-
-      // Interpolation. Points are taken approximately every every modelExport.pointsIntervalRelations
-      ExportValuesOrdinal ordinals = ordinalsAtIntervals (modelExport.pointsIntervalRelations(),
-                                                          modelExport.pointsIntervalUnitsRelations(),
-                                                          lineStyle.curveConnectAs(),
-                                                          transformation,
-                                                          isLogXTheta,
-                                                          isLogYRadius,
-                                                          points);
-
-      maxColumnSize = qMax (maxColumnSize,
-                            ordinals.count());
-    }
+  for (int ic = 0; ic < relationFits.count(); ic++) {
+    rowCount = qMax (rowCount,
+                     relationFits.at (ic).rowCount ());
   }
 
-  return maxColumnSize;
+  return rowCount;
 }
 
-ExportValuesOrdinal ExportFileRelations::ordinalsAtIntervals (double pointsIntervalRelations,
+ExportValuesOrdinal ExportFileRelations::ordinalsAtIntervals (const QString &curveName,
+                                                              double pointsIntervalRelations,
                                                               ExportPointsIntervalUnits pointsIntervalUnits,
                                                               CurveConnectAs curveConnectAs,
                                                               const Transformation &transformation,
@@ -585,7 +509,8 @@ ExportValuesOrdinal ExportFileRelations::ordinalsAtIntervals (double pointsInter
   if (pointsIntervalUnits == EXPORT_POINTS_INTERVAL_UNITS_GRAPH) {
     if (curveConnectAs == CONNECT_AS_RELATION_SMOOTH) {
 
-      return ordinalsAtIntervalsSmoothGraph (pointsIntervalRelations,
+      return ordinalsAtIntervalsSmoothGraph (curveName,
+                                             pointsIntervalRelations,
                                              transformation,
                                              isLogXTheta,
                                              isLogYRadius,
@@ -602,7 +527,8 @@ ExportValuesOrdinal ExportFileRelations::ordinalsAtIntervals (double pointsInter
 
     if (curveConnectAs == CONNECT_AS_RELATION_SMOOTH) {
 
-      return ordinalsAtIntervalsSmoothScreen (pointsIntervalRelations,
+      return ordinalsAtIntervalsSmoothScreen (curveName,
+                                              pointsIntervalRelations,
                                               points);
 
     } else {
@@ -614,7 +540,8 @@ ExportValuesOrdinal ExportFileRelations::ordinalsAtIntervals (double pointsInter
   }
 }
 
-ExportValuesOrdinal ExportFileRelations::ordinalsAtIntervalsSmoothGraph (double pointsIntervalRelations,
+ExportValuesOrdinal ExportFileRelations::ordinalsAtIntervalsSmoothGraph (const QString &curveName,
+                                                                         double pointsIntervalRelations,
                                                                          const Transformation &transformation,
                                                                          bool isLogXTheta,
                                                                          bool isLogYRadius,
@@ -638,7 +565,8 @@ ExportValuesOrdinal ExportFileRelations::ordinalsAtIntervalsSmoothGraph (double
                                                       t,
                                                       xy);
 
-    ordinals = ordinalsSmooth.ordinalsAtIntervalsGraph (t,
+    ordinals = ordinalsSmooth.ordinalsAtIntervalsGraph (curveName,
+                                                        t,
                                                         xy,
                                                         pointsIntervalRelations);
   }
@@ -646,7 +574,8 @@ ExportValuesOrdinal ExportFileRelations::ordinalsAtIntervalsSmoothGraph (double
   return ordinals;
 }
 
-ExportValuesOrdinal ExportFileRelations::ordinalsAtIntervalsSmoothScreen (double pointsIntervalRelations,
+ExportValuesOrdinal ExportFileRelations::ordinalsAtIntervalsSmoothScreen (const QString &curveName,
+                                                                          double pointsIntervalRelations,
                                                                           const Points &points) const
 {
 
@@ -665,7 +594,8 @@ ExportValuesOrdinal ExportFileRelations::ordinalsAtIntervalsSmoothScreen (double
                                                          t,
                                                          xy);
 
-    ordinals = ordinalsSmooth.ordinalsAtIntervalsGraph (t,
+    ordinals = ordinalsSmooth.ordinalsAtIntervalsGraph (curveName,
+                                                        t,
                                                         xy,
                                                         pointsIntervalRelations);
   }
@@ -714,15 +644,12 @@ ExportValuesOrdinal ExportFileRelations::ordinalsAtIntervalsStraightScreen (doub
   return ordinals;
 }
 
-void ExportFileRelations::outputXThetaYRadiusValues (const DocumentModelExportFormat &modelExportOverride,
-                                                     const QStringList &curvesIncluded,
-                                                     QVector<QVector<QString*> > &xThetaYRadiusValues,
-                                                     const QString &delimiter,
-                                                     QTextStream &str,
-                                                     unsigned int &numWritesSoFar) const
+void ExportFileRelations::outputHeader (const DocumentModelExportFormat &modelExportOverride,
+                                        const QStringList &curvesIncluded,
+                                        const QString &delimiter,
+                                        QTextStream &str,
+                                        unsigned int numWritesSoFar) const
 {
-
-  // Header
   if (modelExportOverride.header() != EXPORT_HEADER_NONE) {
     insertLineSeparator (numWritesSoFar == 0,
                          modelExportOverride.header (),
@@ -740,21 +667,115 @@ void ExportFileRelations::outputXThetaYRadiusValues (const DocumentModelExportFo
     }
     str << "\n";
   }
+}
 
-  // Table body
-  for (int row = 0; row < xThetaYRadiusValues [0].count(); row++) {
+void ExportFileRelations::outputXThetaYRadiusValues (const DocumentModelExportFormat &modelExportOverride,
+                                                     const DocumentModelCoords &modelCoords,
+                                                     const DocumentModelGeneral &modelGeneral,
+                                                     const MainWindowModel &modelMainWindow,
+                                                     const Transformation &transformation,
+                                                     const QVector<ExportValuesColumn> &xThetaYRadiusValues,
+                                                     const QString &delimiter,
+                                                     QTextStream &str) const
+{
+
+  // Each value is formatted just before it is written, so the table never exists as strings. Rows past the end of a
+  // shorter curve are left blank. The locale and precision plan are set up once for the whole block
+  FormatCoordsUnits format;
+  FormatPrecisionPlan precisionPlan (modelGeneral,
+                                     transformation);
+  const QLocale locale = modelMainWindow.locale();
+  int rowCount = xThetaYRadiusValues [0].rowCount();
+  for (int row = 0; row < rowCount; row++) {
 
     QString delimiterForRow;
     for (int col = 0; col < xThetaYRadiusValues.count(); col++) {
 
-      QString xThetaString = *(xThetaYRadiusValues [col] [row]);
+      const ExportValuesColumn &column = xThetaYRadiusValues.at (col);
+      QString xThetaString, yRadiusString;
+      if (column.isValid (row)) {
+        format.unformattedToFormatted (column.xTheta (row),
+                                       column.yRadius (row),
+                                       modelCoords,
+                                       locale,
+                                       precisionPlan,
+                                       xThetaString,
+                                       yRadiusString);
+      }
       str << delimiterForRow << wrapInDoubleQuotesIfNeeded (modelExportOverride,
                                                             xThetaString);
       delimiterForRow = delimiter;
+      str << delimiterForRow << wrapInDoubleQuotesIfNeeded (modelExportOverride,
+                                                            yRadiusString);
     }
 
     str << "\n";
   }
+}
+
+ExportRelationFit ExportFileRelations::relationFitForCurve (const DocumentModelExportFormat &modelExportOverride,
+                                                            const Document &document,
+                                                            const QString &curveName,
+                                                            const Transformation &transformation,
+                                                            bool isLogXTheta,
+                                                            bool isLogYRadius) const
+{
+
+  const Curve *curve = document.curveForCurveName (curveName);
+  const Points points = curve->points ();
+
+  if (modelExportOverride.pointsSelectionRelations() == EXPORT_POINTS_SELECTION_RELATIONS_RAW) {
+
+    // No interpolation. Raw points
+    return ExportRelationFit (points);
+
+  }
+
+  const LineStyle &lineStyle = document.modelCurveStyles().lineStyle(curveName);
+
+  // Interpolation. Points are taken approximately every every modelExport.pointsIntervalRelations
+  ExportValuesOrdinal ordinals = ordinalsAtIntervals (curveName,
+                                                      modelExportOverride.pointsIntervalRelations(),
+                                                      modelExportOverride.pointsIntervalUnitsRelations(),
+                                                      lineStyle.curveConnectAs(),
+                                                      transformation,
+                                                      isLogXTheta,
+                                                      isLogYRadius,
+                                                      points);
+
+  if (curve->curveStyle().lineStyle().curveConnectAs() == CONNECT_AS_RELATION_SMOOTH) {
+
+    vector<double> t;
+    vector<SplinePair> xy;
+    ExportOrdinalsSmooth ordinalsSmooth;
+
+    ordinalsSmooth.loadSplinePairsWithTransformation (points,
+                                                      transformation,
+                                                      isLogXTheta,
+                                                      isLogYRadius,
+                                                      t,
+                                                      xy);
+
+    return ExportRelationFit (t,
+                              xy,
+                              ordinals);
+  }
+
+  // Transform each point once, rather than once per interpolated value
+  FittingPointsConvenient positionsGraph;
+  for (int ip = 0; ip < points.count(); ip++) {
+    QPointF posGraph;
+    transformation.transformScreenToRawGraph (points.at (ip).posScreen(),
+                                              posGraph);
+    positionsGraph.push_back (posGraph);
+  }
+
+  bool isSortedByOrdinal = std::is_sorted (points.begin(),
+                                           points.end(),
+                                           lessThanOrdinalOfPoint);
 
-  ++numWritesSoFar;
+  return ExportRelationFit (points,
+                            positionsGraph,
+                            isSortedByOrdinal,
+                            ordinals);
 }
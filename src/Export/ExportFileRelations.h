@@ -7,9 +7,13 @@
 #ifndef EXPORT_FILE_RELATIONS_H
 #define EXPORT_FILE_RELATIONS_H
 
+#include "ExportColumnsLoader.h"
 #include "ExportFileAbstractBase.h"
 #include "ExportPointsIntervalUnits.h"
+#include "ExportRelationFit.h"
+#include "ExportValuesColumn.h"
 #include "ExportValuesOrdinal.h"
+#include "FittingPointsConvenient.h"
 #include "Points.h"
 #include <QStringList>
 #include <QVector>
@@ -32,6 +36,15 @@ public:
   /// Single constructor.
   ExportFileRelations();
 
+  /// Prepare the included relation curves for loading their unformatted values in blocks, one column per curve, for
+  /// the binary export formats. The row count is that of the longest curve, and rows past the end of a shorter curve
+  /// have no value. The returned loader keeps its own copy of everything it needs
+  ExportColumnsLoader exportToColumns (const DocumentModelExportFormat &modelExportOverride,
+                                       const Document &document,
+                                       const Transformation &transformation,
+                                       QStringList &curvesIncluded,
+                                       int &rowCount) const;
+
   /// Export Document points according to the settings. The DocumentModelExportFormat inside the Document is ignored so
   /// DlgSettingsExport can supply its own DocumentModelExportFormat when previewing what would be exported.
   void exportToFile (const DocumentModelExportFormat &modelExportOverride,
@@ -53,28 +66,6 @@ private:
                                            bool isLogYRadius,
                                            QTextStream &str,
                                            unsigned int &numWritesSoFar) const;
-  void exportAllPerLineXThetaValuesMergedMultiplePass (int maxColumnSize,
-                                                       const DocumentModelExportFormat &modelExportOverride,
-                                                       const Document &document,
-                                                       const MainWindowModel &modelMainWindow,
-                                                       const QStringList &curvesIncluded,
-                                                       const QString &delimiter,
-                                                       const Transformation &transformation,
-                                                       bool isLogXTheta,
-                                                       bool isLogYRadius,
-                                                       QTextStream &str,
-                                                       unsigned int &numWritesSoFar) const;
-  void exportAllPerLineXThetaValuesMergedOnePass (int maxColumnSize,
-                                                  const DocumentModelExportFormat &modelExportOverride,
-                                                  const Document &document,
-                                                  const MainWindowModel &modelMainWindow,
-                                                  const QStringList &curvesIncluded,
-                                                  const QString &delimiter,
-                                                  const Transformation &transformation,
-                                                  bool isLogXTheta,
-                                                  bool isLogYRadius,
-                                                  QTextStream &str,
-                                                  unsigned int &numWritesSoFar) const;
   void exportOnePerLineXThetaValuesMerged (const DocumentModelExportFormat &modelExportOverride,
                                            const Document &document,
                                            const MainWindowModel &modelMainWindow,
@@ -85,63 +76,70 @@ private:
                                            bool isLogYRadius,
                                            QTextStream &str,
                                            unsigned int &numWritesSoFar) const;
-  void initializeXThetaYRadiusValues (const QStringList &curvesIncluded,
-                                      QVector<QVector<QString*> > &xThetaYRadiusValues) const;
+
+  // Find the first point at or after the specified ordinal. When the points are sorted by ordinal, ipCursor carries the
+  // position from the previous call so increasing ordinals take one walk through the points, and decreasing ordinals
+  // are found by binary search
+  int indexOfPointAtOrAfterOrdinal (const Points &points,
+                                    bool isSortedByOrdinal,
+                                    double ordinal,
+                                    int &ipCursor) const;
+
+  // Interpolate between the points, whose graph coordinates have been computed once in positionsGraph
   QPointF linearlyInterpolate (const Points &points,
+                               const FittingPointsConvenient &positionsGraph,
+                               bool isSortedByOrdinal,
                                double ordinal,
-                               const Transformation &transformation) const;
-  void loadXThetaYRadiusValues (const DocumentModelExportFormat &modelExportOverride,
-                                const Document &document,
-                                const MainWindowModel &modelMainWindow,
-                                const QStringList &curvesIncluded,
+                               int &ipCursor) const;
+
+  // Load the export inputs of each curve into the fit with the same index. Curves are processed in parallel
+  void loadRelationFits (const DocumentModelExportFormat &modelExportOverride,
+                         const Document &document,
+                         const QStringList &curvesIncluded,
+                         const Transformation &transformation,
+                         bool isLogXTheta,
+                         bool isLogYRadius,
+                         QVector<ExportRelationFit> &relationFits) const;
+
+  /// Load the unformatted x/theta and y/radius values of each curve into the column with the same index, for the
+  /// block of rows starting at rowStart. Each column has the block size, and rows past the end of a curve are left
+  /// without a value. Each cursor carries the point position of its straight curve from one block to the next
+  void loadXThetaYRadiusValues (const QVector<ExportRelationFit> &relationFits,
                                 const Transformation &transformation,
-                                bool isLogXTheta,
-                                bool isLogYRadius,
-                                QVector<QVector<QString*> > &xThetaYRadiusValues) const;
-  void loadXThetaYRadiusValuesForCurveInterpolatedSmooth (const DocumentModelCoords &modelCoords,
-                                                          const DocumentModelGeneral  &modelGeneral,
-                                                          const MainWindowModel &modelMainWindow,
-                                                          const Points &points,
-                                                          const ExportValuesOrdinal &ordinals,
-                                                          QVector<QString*> &xThetaValues,
-                                                          QVector<QString*> &yRadiusValues,
-                                                          const Transformation &transformation,
-                                                          bool isLogXTheta,
-                                                          bool isLogYRadius) const;
-  void loadXThetaYRadiusValuesForCurveInterpolatedStraight (const DocumentModelCoords &modelCoords,
-                                                            const DocumentModelGeneral &modelGeneral,
-                                                            const MainWindowModel &modelMainWindow,
-                                                            const Points &points,
-                                                            const ExportValuesOrdinal &ordinals,
-                                                            QVector<QString*> &xThetaValues,
-                                                            QVector<QString*> &yRadiusValues,
-                                                            const Transformation &transformation) const;
-  void loadXThetaYRadiusValuesForCurveRaw (const DocumentModelCoords &modelCoords,
-                                           const DocumentModelGeneral &modelGeneral,
-                                           const MainWindowModel &modelMainWindow,
-                                           const Points &points,
-                                           QVector<QString*> &xThetaValues,
-                                           QVector<QString*> &yRadiusValues,
-                                           const Transformation &transformation) const;
-  int maxColumnSizeAllocation (const DocumentModelExportFormat &modelExportOverride,
-                               const Document &document,
-                               const Transformation &transformation,
-                               bool isLogXTheta,
-                               bool isLogYRadius,
-                               const QStringList &curvesIncluded) const;
-  ExportValuesOrdinal ordinalsAtIntervals (double pointsIntervalRelations,
+                                int rowStart,
+                                QVector<int> &ipCursors,
+                                QVector<ExportValuesColumn> &xThetaYRadiusValues) const;
+  void loadXThetaYRadiusValuesForCurveInterpolatedSmooth (const ExportRelationFit &relationFit,
+                                                          int rowStart,
+                                                          ExportValuesColumn &xThetaYRadiusValues) const;
+  void loadXThetaYRadiusValuesForCurveInterpolatedStraight (const ExportRelationFit &relationFit,
+                                                            int rowStart,
+                                                            int &ipCursor,
+                                                            ExportValuesColumn &xThetaYRadiusValues) const;
+  void loadXThetaYRadiusValuesForCurveRaw (const ExportRelationFit &relationFit,
+                                           const Transformation &transformation,
+                                           int rowStart,
+                                           ExportValuesColumn &xThetaYRadiusValues) const;
+
+  // Number of rows in the longest curve
+  int maxRowCount (const QVector<ExportRelationFit> &relationFits) const;
+
+  ExportValuesOrdinal ordinalsAtIntervals (const QString &curveName,
+                                           double pointsIntervalRelations,
                                            ExportPointsIntervalUnits pointsIntervalUnits,
                                            CurveConnectAs curveConnectAs,
                                            const Transformation &transformation,
                                            bool isLogXTheta,
                                            bool isLogYRadius,
                                            const Points &points) const;
-  ExportValuesOrdinal ordinalsAtIntervalsSmoothGraph (double pointsIntervalRelations,
+  ExportValuesOrdinal ordinalsAtIntervalsSmoothGraph (const QString &curveName,
+                                                      double pointsIntervalRelations,
                                                       const Transformation &transformation,
                                                       bool isLogXTheta,
                                                       bool isLogYRadius,
                                                       const Points &points) const;
-  ExportValuesOrdinal ordinalsAtIntervalsSmoothScreen (double pointsIntervalRelations,
+  ExportValuesOrdinal ordinalsAtIntervalsSmoothScreen (const QString &curveName,
+                                                       double pointsIntervalRelations,
                                                        const Points &points) const;
   ExportValuesOrdinal ordinalsAtIntervalsStraightGraph (double pointsIntervalRelations,
                                                         const Transformation &transformation,
@@ -149,13 +147,30 @@ private:
   ExportValuesOrdinal ordinalsAtIntervalsStraightScreen (double pointsIntervalRelations,
                                                          const Points &points) const;
 
-  /// Output 2D array with alternating x/theta and y/radius columns
-  void outputXThetaYRadiusValues (const DocumentModelExportFormat &modelExport,
-                                  const QStringList &curvesIncluded,
-                                  QVector<QVector<QString*> > &xThetaYRadiusValues,
+  /// Output header line, if there is one
+  void outputHeader (const DocumentModelExportFormat &modelExportOverride,
+                     const QStringList &curvesIncluded,
+                     const QString &delimiter,
+                     QTextStream &str,
+                     unsigned int numWritesSoFar) const;
+
+  /// Output block of 2D array with alternating x/theta and y/radius columns. Values are formatted as each row is written
+  void outputXThetaYRadiusValues (const DocumentModelExportFormat &modelExportOverride,
+                                  const DocumentModelCoords &modelCoords,
+                                  const DocumentModelGeneral &modelGeneral,
+                                  const MainWindowModel &modelMainWindow,
+                                  const Transformation &transformation,
+                                  const QVector<ExportValuesColumn> &xThetaYRadiusValues,
                                   const QString &delimiter,
-                                  QTextStream &str,
-                                  unsigned int &numWritesSoFar) const;
+                                  QTextStream &str) const;
+
+  // Find the ordinals of the rows of one curve, and transform its points or fit its spline
+  ExportRelationFit relationFitForCurve (const DocumentModelExportFormat &modelExportOverride,
+                                         const Document &document,
+                                         const QString &curveName,
+                                         const Transformation &transformation,
+                                         bool isLogXTheta,
+                                         bool isLogYRadius) const;
 };
 
 #endif // EXPORT_FILE_RELATIONS_H
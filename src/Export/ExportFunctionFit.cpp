@@ -0,0 +1,86 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#include "ExportFunctionFit.h"
+#include "Spline.h"
+
+ExportFunctionFit::ExportFunctionFit() :
+  m_isSmooth (false),
+  m_isSortedByXTheta (true)
+{
+}
+
+ExportFunctionFit::ExportFunctionFit(const QString &curveName,
+                                     const Points &points) :
+  m_curveName (curveName),
+  m_points (points),
+  m_isSmooth (false),
+  m_isSortedByXTheta (true)
+{
+}
+
+ExportFunctionFit::ExportFunctionFit(const QString &curveName,
+                                     const Points &points,
+                                     const FittingPointsConvenient &positionsLinearized,
+                                     bool isSortedByXTheta) :
+  m_curveName (curveName),
+  m_points (points),
+  m_isSmooth (false),
+  m_positionsLinearized (positionsLinearized),
+  m_isSortedByXTheta (isSortedByXTheta)
+{
+}
+
+ExportFunctionFit::ExportFunctionFit(const QString &curveName,
+                                     const Points &points,
+                                     const std::vector<double> &t,
+                                     const std::vector<SplinePair> &xyLinearized) :
+  m_curveName (curveName),
+  m_points (points),
+  m_isSmooth (true),
+  m_isSortedByXTheta (true),
+  m_xyLinearized (xyLinearized)
+{
+  if (xyLinearized.size() > 2) {
+    m_spline = QSharedPointer<Spline> (new Spline (t,
+                                                   xyLinearized));
+  }
+}
+
+QString ExportFunctionFit::curveName () const
+{
+  return m_curveName;
+}
+
+bool ExportFunctionFit::isSmooth () const
+{
+  return m_isSmooth;
+}
+
+bool ExportFunctionFit::isSortedByXTheta () const
+{
+  return m_isSortedByXTheta;
+}
+
+const Points &ExportFunctionFit::points () const
+{
+  return m_points;
+}
+
+const FittingPointsConvenient &ExportFunctionFit::positionsLinearized () const
+{
+  return m_positionsLinearized;
+}
+
+const Spline *ExportFunctionFit::spline () const
+{
+  return m_spline.data ();
+}
+
+const std::vector<SplinePair> &ExportFunctionFit::xyLinearized () const
+{
+  return m_xyLinearized;
+}
@@ -0,0 +1,77 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef EXPORT_FUNCTION_FIT_H
+#define EXPORT_FUNCTION_FIT_H
+
+#include "FittingPointsConvenient.h"
+#include "Points.h"
+#include <QSharedPointer>
+#include <QString>
+#include "SplinePair.h"
+#include <vector>
+
+class Spline;
+
+/// Inputs for exporting one function curve, which are the curve points and whatever is derived from them for
+/// interpolation: the linearized graph positions for straight curves, or the linearized spline pairs and fitted
+/// spline for smooth curves. These are computed once per curve, and then used for every block of exported rows
+class ExportFunctionFit
+{
+public:
+  /// Default constructor for use in QVector, giving a curve with no points
+  ExportFunctionFit();
+
+  /// Constructor for curve whose points are used as they are, without interpolation
+  ExportFunctionFit(const QString &curveName,
+                    const Points &points);
+
+  /// Constructor for straight curve, with the linearized graph positions of the points
+  ExportFunctionFit(const QString &curveName,
+                    const Points &points,
+                    const FittingPointsConvenient &positionsLinearized,
+                    bool isSortedByXTheta);
+
+  /// Constructor for smooth curve, with the linearized spline pairs of the points. A spline is fitted if there are
+  /// more than two points, since fewer points are interpolated directly
+  ExportFunctionFit(const QString &curveName,
+                    const Points &points,
+                    const std::vector<double> &t,
+                    const std::vector<SplinePair> &xyLinearized);
+
+  /// Name of the curve
+  QString curveName () const;
+
+  /// True if the curve is smooth, in which case xyLinearized and spline apply
+  bool isSmooth () const;
+
+  /// True if the linearized positions increase in x/theta
+  bool isSortedByXTheta () const;
+
+  /// Points of the curve
+  const Points &points () const;
+
+  /// Linearized graph positions of the points, for straight curves
+  const FittingPointsConvenient &positionsLinearized () const;
+
+  /// Fitted spline, for smooth curves with more than two points. Null otherwise
+  const Spline *spline () const;
+
+  /// Linearized spline pairs of the points, for smooth curves
+  const std::vector<SplinePair> &xyLinearized () const;
+
+private:
+
+  QString m_curveName;
+  Points m_points;
+  bool m_isSmooth;
+  FittingPointsConvenient m_positionsLinearized;
+  bool m_isSortedByXTheta;
+  std::vector<SplinePair> m_xyLinearized;
+  QSharedPointer<Spline> m_spline; // Shared so copies in QVector do not refit
+};
+
+#endif // EXPORT_FUNCTION_FIT_H
@@ -6,15 +6,15 @@
 
 #include "ExportImageForRegression.h"
 #include <QFile>
+#include <QImage>
 #include <QMessageBox>
 #include <QObject>
-#include <QPixmap>
 #include <QString>
 #include <QTextStream>
 
-ExportImageForRegression::ExportImageForRegression (const QPixmap &pixmap) :
-  m_width (pixmap.width ()),
-  m_height (pixmap.height ())
+ExportImageForRegression::ExportImageForRegression (const QImage &image) :
+  m_width (image.width ()),
+  m_height (image.height ())
 {
 }
 
@@ -7,7 +7,7 @@
 #ifndef EXPORT_IMAGE_FOR_REGRESSION_H
 #define EXPORT_IMAGE_FOR_REGRESSION_H
 
-class QPixmap;
+class QImage;
 class QString;
 
 /// Class for exporting during regression, when the Transformation has not yet been defined. This class just
@@ -16,7 +16,7 @@ class ExportImageForRegression
 {
  public:
   /// Single constructor
-  ExportImageForRegression(const QPixmap &pixmap);
+  ExportImageForRegression(const QImage &image);
 
   /// Export to the specified file. This is called when the Transformation has not been defined
   void fileExport (const QString &filename) const;
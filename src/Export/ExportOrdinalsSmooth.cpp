@@ -7,13 +7,16 @@
 #include "ExportOrdinalsSmooth.h"
 #include "LinearToLog.h"
 #include "Logger.h"
-#include <qmath.h>
 #include <QPointF>
-#include "Spline.h"
+#include "SplineArcLength.h"
 #include "Transformation.h"
 
 using namespace std;
 
+const int NUM_SMALLER_INTERVALS = 1000;
+
+SplineArcLengthCache ExportOrdinalsSmooth::m_arcLengthCache;
+
 ExportOrdinalsSmooth::ExportOrdinalsSmooth ()
 {
 }
@@ -58,77 +61,29 @@ void ExportOrdinalsSmooth::loadSplinePairsWithTransformation (const Points &poin
   }
 }
 
-ExportValuesOrdinal ExportOrdinalsSmooth::ordinalsAtIntervalsGraph (const vector<double> &t,
+ExportValuesOrdinal ExportOrdinalsSmooth::ordinalsAtIntervalsGraph (const QString &curveName,
+                                                                    const vector<double> &t,
                                                                     const vector<SplinePair> &xy,
                                                                     double pointsInterval) const
 {
-
-  const double NUM_SMALLER_INTERVALS = 1000;
-
   // Results. Initially empty, but at the end it will have tMin, ..., tMax
   ExportValuesOrdinal ordinals;
 
   // Spline class requires at least one point
   if (xy.size() > 0) {
 
-    // Fit a spline
-    Spline spline (t,
-                   xy);
-
-    // Integrate the distances for the subintervals
-    double integratedSeparation = 0;
-    QPointF posLast (xy [0].x(),
-                     xy [0].y());
-
     // Simplest method to find the intervals is to break up the curve into many smaller intervals, and then aggregate them
     // into intervals that, as much as possible, have the desired length. Simplicity wins out over accuracy in this
     // approach - accuracy is sacrificed to achieve simplicity
-    double tMin = t.front();
-    double tMax = t.back();
-
-    double tLast = 0.0;
-    int iTLastInterval = 0;
-    for (int iT = 0; iT < NUM_SMALLER_INTERVALS; iT++) {
-
-      double tIter = tMin + ((tMax - tMin) * iT) / (NUM_SMALLER_INTERVALS - 1.0);
-
-      SplinePair pairNew = spline.interpolateCoeff(tIter);
-
-      QPointF posNew = QPointF (pairNew.x(),
-                                pairNew.y());
-
-      QPointF posDelta = posNew - posLast;
-      double integratedSeparationDelta = qSqrt (posDelta.x() * posDelta.x() + posDelta.y() * posDelta.y());
-      integratedSeparation += integratedSeparationDelta;
-
-      while (integratedSeparation >= pointsInterval) {
-
-        // End of current interval, and start of next interval. For better accuracy without having to crank up
-        // the number of points by orders of magnitude, we use linear interpolation
-        double sInterp;
-        if (iT == 0) {
-          sInterp = 0.0;
-        } else {
-          sInterp = double (pointsInterval) / double (integratedSeparation);
-        }
-        double tInterp = (1.0 - sInterp) * tLast + sInterp * tIter;
-
-        integratedSeparation -= pointsInterval; // Part of delta that was not used gets applied to next interval
-
-        tLast = tInterp;
-        ordinals.push_back (tInterp);
-        iTLastInterval = iT;
-      }
-
-      tLast = tIter;
-      posLast = posNew;
-    }
-
-    if (iTLastInterval < NUM_SMALLER_INTERVALS - 1) {
-
-      // Add last point so we end up at tMax
-      ordinals.push_back (tMax);
-
+    QSharedPointer<const SplineArcLength> arcLength = m_arcLengthCache.arcLength (curveName,
+                                                                                  t,
+                                                                                  xy,
+                                                                                  NUM_SMALLER_INTERVALS);
+
+    vector<double> ordinalsAtIntervals = arcLength->tAtIntervalsWithRemainder (pointsInterval);
+    vector<double>::const_iterator itr;
+    for (itr = ordinalsAtIntervals.begin(); itr != ordinalsAtIntervals.end(); itr++) {
+      ordinals.push_back (*itr);
     }
   }
 
@@ -10,8 +10,10 @@
 #include "ExportValuesOrdinal.h"
 #include "Point.h"
 #include "Points.h"
+#include "SplineArcLengthCache.h"
 #include "SplinePair.h"
 #include <QList>
+#include <QString>
 #include <vector>
 
 class Transformation;
@@ -36,10 +38,17 @@ class ExportOrdinalsSmooth
                                           std::vector<double> &t,
                                           std::vector<SplinePair> &xy) const;
 
-  /// Perform the interpolation on the arrays loaded by the other methods
-  ExportValuesOrdinal ordinalsAtIntervalsGraph (const std::vector<double> &t,
+  /// Perform the interpolation on the arrays loaded by the other methods. The arc length table of the curve is reused
+  /// from earlier exports until the arrays change
+  ExportValuesOrdinal ordinalsAtIntervalsGraph (const QString &curveName,
+                                                const std::vector<double> &t,
                                                 const std::vector<SplinePair> &xy,
                                                 double pointsInterval) const;
+
+private:
+
+  // Shared by every export, since each export creates its own ExportOrdinalsSmooth
+  static SplineArcLengthCache m_arcLengthCache;
 };
 
 #endif // EXPORT_ORDINALS_SMOOTH_H
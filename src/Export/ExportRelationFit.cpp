@@ -0,0 +1,94 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#include "ExportRelationFit.h"
+#include "Spline.h"
+
+ExportRelationFit::ExportRelationFit() :
+  m_isRaw (true),
+  m_isSmooth (false),
+  m_isSortedByOrdinal (true)
+{
+}
+
+ExportRelationFit::ExportRelationFit(const Points &points) :
+  m_isRaw (true),
+  m_isSmooth (false),
+  m_points (points),
+  m_isSortedByOrdinal (true)
+{
+}
+
+ExportRelationFit::ExportRelationFit(const Points &points,
+                                     const FittingPointsConvenient &positionsGraph,
+                                     bool isSortedByOrdinal,
+                                     const ExportValuesOrdinal &ordinals) :
+  m_isRaw (false),
+  m_isSmooth (false),
+  m_points (points),
+  m_positionsGraph (positionsGraph),
+  m_isSortedByOrdinal (isSortedByOrdinal),
+  m_ordinals (ordinals)
+{
+}
+
+ExportRelationFit::ExportRelationFit(const std::vector<double> &t,
+                                     const std::vector<SplinePair> &xyLinearized,
+                                     const ExportValuesOrdinal &ordinals) :
+  m_isRaw (false),
+  m_isSmooth (true),
+  m_isSortedByOrdinal (true),
+  m_ordinals (ordinals)
+{
+  if (xyLinearized.size() > 0) {
+    m_spline = QSharedPointer<Spline> (new Spline (t,
+                                                   xyLinearized));
+  }
+}
+
+bool ExportRelationFit::isRaw () const
+{
+  return m_isRaw;
+}
+
+bool ExportRelationFit::isSmooth () const
+{
+  return m_isSmooth;
+}
+
+bool ExportRelationFit::isSortedByOrdinal () const
+{
+  return m_isSortedByOrdinal;
+}
+
+const ExportValuesOrdinal &ExportRelationFit::ordinals () const
+{
+  return m_ordinals;
+}
+
+const Points &ExportRelationFit::points () const
+{
+  return m_points;
+}
+
+const FittingPointsConvenient &ExportRelationFit::positionsGraph () const
+{
+  return m_positionsGraph;
+}
+
+int ExportRelationFit::rowCount () const
+{
+  if (m_isRaw) {
+    return m_points.count ();
+  }
+
+  return m_ordinals.count ();
+}
+
+const Spline *ExportRelationFit::spline () const
+{
+  return m_spline.data ();
+}
@@ -0,0 +1,78 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef EXPORT_RELATION_FIT_H
+#define EXPORT_RELATION_FIT_H
+
+#include "ExportValuesOrdinal.h"
+#include "FittingPointsConvenient.h"
+#include "Points.h"
+#include <QSharedPointer>
+#include "SplinePair.h"
+#include <vector>
+
+class Spline;
+
+/// Inputs for exporting one relation curve, which are the curve points and whatever is derived from them for
+/// interpolation: the ordinals of the exported rows, plus the graph positions for straight curves or the fitted spline
+/// for smooth curves. These are computed once per curve, and then used for every block of exported rows
+class ExportRelationFit
+{
+public:
+  /// Default constructor for use in QVector, giving a curve with no rows
+  ExportRelationFit();
+
+  /// Constructor for curve whose points are exported as they are, one row per point
+  ExportRelationFit(const Points &points);
+
+  /// Constructor for straight curve, with the graph positions of the points and the ordinals of the rows
+  ExportRelationFit(const Points &points,
+                    const FittingPointsConvenient &positionsGraph,
+                    bool isSortedByOrdinal,
+                    const ExportValuesOrdinal &ordinals);
+
+  /// Constructor for smooth curve, with the linearized spline pairs of the points and the ordinals of the rows. A
+  /// spline is fitted if there is at least one point
+  ExportRelationFit(const std::vector<double> &t,
+                    const std::vector<SplinePair> &xyLinearized,
+                    const ExportValuesOrdinal &ordinals);
+
+  /// True if the points are exported without interpolation, in which case ordinals and spline do not apply
+  bool isRaw () const;
+
+  /// True if the curve is smooth, in which case spline applies
+  bool isSmooth () const;
+
+  /// True if the points increase in ordinal
+  bool isSortedByOrdinal () const;
+
+  /// Ordinals of the rows, for interpolated curves
+  const ExportValuesOrdinal &ordinals () const;
+
+  /// Points of the curve, for raw and straight curves
+  const Points &points () const;
+
+  /// Graph positions of the points, for straight curves
+  const FittingPointsConvenient &positionsGraph () const;
+
+  /// Number of exported rows for this curve
+  int rowCount () const;
+
+  /// Fitted spline, for smooth curves with at least one point. Null otherwise
+  const Spline *spline () const;
+
+private:
+
+  bool m_isRaw;
+  bool m_isSmooth;
+  Points m_points;
+  FittingPointsConvenient m_positionsGraph;
+  bool m_isSortedByOrdinal;
+  ExportValuesOrdinal m_ordinals;
+  QSharedPointer<Spline> m_spline; // Shared so copies in QVector do not refit
+};
+
+#endif // EXPORT_RELATION_FIT_H
@@ -20,7 +20,7 @@ ExportToFile::ExportToFile()
 {
 }
 
-void ExportToFile::exportToFile (const DocumentModelExportFormat &modelExport,
+bool ExportToFile::exportToFile (const DocumentModelExportFormat &modelExport,
                                  const Document &document,
                                  const MainWindowModel &modelMainWindow,
                                  const Transformation &transformation,
@@ -47,6 +47,11 @@ void ExportToFile::exportToFile (const DocumentModelExportFormat &modelExport,
                                 str,
                                 numWritesSoFar,
                                 isOverrunRelations);
+
+  // Buffered text is pushed to the device so any write failure shows up in the stream status
+  str.flush ();
+
+  return (str.status () == QTextStream::Ok);
 }
 
 QString ExportToFile::fileExtensionCsv () const
@@ -29,8 +29,9 @@ public:
   ExportToFile();
 
   /// Export Document points according to the settings. The DocumentModelExportFormat inside the Document is ignored so
-  /// DlgSettingsExport can supply its own DocumentModelExportFormat when previewing what would be exported.
-  void exportToFile (const DocumentModelExportFormat &modelExport,
+  /// DlgSettingsExport can supply its own DocumentModelExportFormat when previewing what would be exported. Returns
+  /// false if writing to the stream failed
+  bool exportToFile (const DocumentModelExportFormat &modelExport,
                      const Document &document,
                      const MainWindowModel &modelMainWindow,
                      const Transformation &transformation,
@@ -0,0 +1,204 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#include "Document.h"
+#include "EngaugeAssert.h"
+#include "ExportFileExtensionOverride.h"
+#include "ExportToFile.h"
+#include "ExportToFileBatch.h"
+#include "ExportToFileNumpy.h"
+#include <iostream>
+#include <QAtomicInt>
+#include <QFile>
+#include <QImage>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QObject>
+#include <QTextStream>
+#include <QThreadPool>
+#include "Transformation.h"
+#include "UrlDirty.h"
+
+ExportToFileBatch::ExportToFileBatch(const MainWindowModel &modelMainWindow,
+                                     int threadCount) :
+  m_modelMainWindow (modelMainWindow),
+  m_threadCount (threadCount)
+{
+}
+
+bool ExportToFileBatch::exportDocument (const Document &document,
+                                        const Transformation &transformation,
+                                        const QString &outputFileName,
+                                        QString &reasonForFailure) const
+{
+  QFile file (outputFileName);
+  if (!file.open (QIODevice::WriteOnly)) {
+    reasonForFailure = QString ("%1 %2: %3")
+                       .arg (QObject::tr ("Unable to export to file"))
+                       .arg (outputFileName)
+                       .arg (file.errorString ());
+    return false;
+  }
+
+  ExportToFileNumpy exportNumpy;
+  if (exportNumpy.isNumpyFileName (outputFileName)) {
+
+    // Binary formats have no delimiter so there is nothing to override
+    if (!exportNumpy.exportToFile (document.modelExport(),
+                                   document,
+                                   m_modelMainWindow,
+                                   transformation,
+                                   outputFileName,
+                                   file) ||
+        !file.flush ()) {
+      reasonForFailure = QString ("%1 %2: %3")
+                         .arg (QObject::tr ("Unable to export to file"))
+                         .arg (outputFileName)
+                         .arg (file.errorString ());
+      return false;
+    }
+
+    return true;
+  }
+
+  QTextStream str (&file);
+
+  ExportToFile exportStrategy;
+  ExportFileExtensionOverride extensionOverride;
+  DocumentModelExportFormat modelExportFormat = extensionOverride.modelExportOverride (document.modelExport(),
+                                                                                       exportStrategy,
+                                                                                       outputFileName);
+  if (!exportStrategy.exportToFile (modelExportFormat,
+                                    document,
+                                    m_modelMainWindow,
+                                    transformation,
+                                    str)) {
+    reasonForFailure = QString ("%1 %2: %3")
+                       .arg (QObject::tr ("Unable to export to file"))
+                       .arg (outputFileName)
+                       .arg (file.errorString ());
+    return false;
+  }
+
+  return true;
+}
+
+int ExportToFileBatch::exportFiles (const QStringList &inputFileNames,
+                                    const QStringList &outputFileNames) const
+{
+  ENGAUGE_ASSERT (inputFileNames.count () == outputFileNames.count ());
+
+  QAtomicInt failureCount (0);
+  QMutex mutexStatus; // Keeps status lines from different threads from interleaving
+
+  QThreadPool threadPool;
+  if (m_threadCount > 0) {
+    threadPool.setMaxThreadCount (m_threadCount);
+  }
+
+  for (int i = 0; i < inputFileNames.count (); i++) {
+
+    QString inputFileName = inputFileNames.at (i);
+    QString outputFileName = outputFileNames.at (i);
+
+    // Each file is loaded here while earlier files are still being exported by the thread pool
+    Transformation transformation;
+    QString reasonForFailure;
+    Document *document = loadDocument (inputFileName,
+                                       transformation,
+                                       reasonForFailure);
+    if (document == nullptr) {
+
+      failureCount.fetchAndAddOrdered (1);
+      reportStatus (mutexStatus,
+                    false,
+                    inputFileName,
+                    outputFileName,
+                    reasonForFailure);
+      continue;
+    }
+
+    threadPool.start ([this, document, transformation, inputFileName, outputFileName, &failureCount, &mutexStatus] () {
+
+      QString reasonForFailure;
+      bool success = exportDocument (*document,
+                                     transformation,
+                                     outputFileName,
+                                     reasonForFailure);
+      delete document;
+
+      if (!success) {
+        failureCount.fetchAndAddOrdered (1);
+      }
+
+      reportStatus (mutexStatus,
+                    success,
+                    inputFileName,
+                    outputFileName,
+                    reasonForFailure);
+    });
+  }
+
+  threadPool.waitForDone ();
+
+  return failureCount.loadAcquire ();
+}
+
+Document *ExportToFileBatch::loadDocument (const QString &inputFileName,
+                                           Transformation &transformation,
+                                           QString &reasonForFailure) const
+{
+  QString fileName = inputFileName;
+  UrlDirty url (inputFileName);
+  if (url.isLocalFile ()) {
+    fileName = url.toLocalFile();
+  }
+
+  // Image decoding is deferred by Document, and never happens here since only the points are needed
+  Document *document = new Document (fileName);
+  if (!document->successfulRead ()) {
+
+    // Startup files that are not Document files are imported as images, as in MainWindow::slotLoadStartupFiles
+    QImage image;
+    if (!image.load (fileName)) {
+      reasonForFailure = document->reasonForUnsuccessfulRead ();
+      delete document;
+      return nullptr;
+    }
+
+    delete document;
+    document = new Document (image);
+  }
+
+  transformation.update (*document,
+                         m_modelMainWindow);
+  if (!transformation.transformIsDefined ()) {
+    reasonForFailure = QObject::tr ("Axis points do not define a transformation");
+    delete document;
+    return nullptr;
+  }
+
+  // Same ordering of function points by x value that the gui applies after loading
+  document->updatePointOrdinals (transformation);
+
+  return document;
+}
+
+void ExportToFileBatch::reportStatus (QMutex &mutexStatus,
+                                      bool success,
+                                      const QString &inputFileName,
+                                      const QString &outputFileName,
+                                      const QString &reasonForFailure) const
+{
+  QMutexLocker locker (&mutexStatus);
+  if (success) {
+    std::cout << "OK     : " << inputFileName.toLocal8Bit().data()
+              << " -> " << outputFileName.toLocal8Bit().data() << std::endl;
+  } else {
+    std::cout << "FAIL   : " << inputFileName.toLocal8Bit().data()
+              << ": " << reasonForFailure.toLocal8Bit().data() << std::endl;
+  }
+}
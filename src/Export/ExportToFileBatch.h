@@ -0,0 +1,61 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef EXPORT_TO_FILE_BATCH_H
+#define EXPORT_TO_FILE_BATCH_H
+
+#include "MainWindowModel.h"
+#include <QString>
+#include <QStringList>
+
+class Document;
+class QMutex;
+class Transformation;
+
+/// Export-only processing of many Document files inside a single process. Each file is loaded, has its transformation
+/// computed from its axis points, and is then exported by its own task in a thread pool. No gui objects are involved, so
+/// the application startup cost is paid once for the whole batch rather than once per file
+class ExportToFileBatch
+{
+public:
+  /// Single constructor. The MainWindowModel supplies the locale and other settings that affect formatting. A thread
+  /// count of zero selects one thread per core
+  ExportToFileBatch(const MainWindowModel &modelMainWindow,
+                    int threadCount);
+
+  /// Export each input file into the output file at the same index. One status line per file is written to stdout
+  /// as each file finishes. Returns the number of files that failed, including files that could not be written
+  int exportFiles (const QStringList &inputFileNames,
+                   const QStringList &outputFileNames) const;
+
+private:
+  ExportToFileBatch();
+
+  // Export a loaded Document. This is the only step that runs in the thread pool
+  bool exportDocument (const Document &document,
+                       const Transformation &transformation,
+                       const QString &outputFileName,
+                       QString &reasonForFailure) const;
+
+  // Load a Document file, or an image file as a new Document like the gui does, and apply the load steps that the gui
+  // applies. Returns null on failure. This runs on the calling thread since loading generates Point identifiers from
+  // a shared counter
+  Document *loadDocument (const QString &inputFileName,
+                          Transformation &transformation,
+                          QString &reasonForFailure) const;
+
+  // Write status line for one file
+  void reportStatus (QMutex &mutexStatus,
+                     bool success,
+                     const QString &inputFileName,
+                     const QString &outputFileName,
+                     const QString &reasonForFailure) const;
+
+  MainWindowModel m_modelMainWindow;
+  int m_threadCount;
+};
+
+#endif // EXPORT_TO_FILE_BATCH_H
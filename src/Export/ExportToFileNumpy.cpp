@@ -0,0 +1,354 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#include "CoordScale.h"
+#include "CoordsType.h"
+#include "CoordUnitsNonPolarTheta.h"
+#include "CoordUnitsPolarTheta.h"
+#include "Document.h"
+#include "DocumentModelCoords.h"
+#include "ExportFileAbstractBase.h"
+#include "ExportFileFunctions.h"
+#include "ExportFileRelations.h"
+#include "ExportToFileNumpy.h"
+#include "ExportZipStored.h"
+#include <QDataStream>
+#include <QFileInfo>
+#include <QIODevice>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QList>
+#include <qnumeric.h>
+#include <QSet>
+#include <QSharedPointer>
+#include <QTemporaryFile>
+#include <QVector>
+
+const QString HEADER_JSON_MEMBER ("header.json");
+const QString NPY_FILENAME_EXTENSION ("npy");
+const QString NPZ_FILENAME_EXTENSION ("npz");
+
+const int NPY_ALIGNMENT = 64; // Array data starts on a multiple of this, as numpy expects
+const int NPY_PREAMBLE_LENGTH = 10; // Magic string, two version bytes and two header length bytes
+const int NPY_VALUE_LENGTH = 8; // Bytes in each float64 value
+
+ExportToFileNumpy::ExportToFileNumpy()
+{
+}
+
+QStringList ExportToFileNumpy::arrayNamesNpz (const QStringList &curveNames) const
+{
+  QStringList arrayNames;
+  QSet<QString> arrayNamesUsed;
+
+  QStringList::const_iterator itr;
+  for (itr = curveNames.begin (); itr != curveNames.end (); itr++) {
+
+    QString arrayNameBase = *itr;
+    arrayNameBase.replace ('/', '_');
+    arrayNameBase.replace ('\\', '_');
+
+    QString arrayName = arrayNameBase;
+    int suffix = 1;
+    while (arrayNamesUsed.contains (arrayName)) {
+      arrayName = QString ("%1_%2")
+                  .arg (arrayNameBase)
+                  .arg (++suffix);
+    }
+
+    arrayNames << arrayName;
+    arrayNamesUsed << arrayName;
+  }
+
+  return arrayNames;
+}
+
+bool ExportToFileNumpy::exportToFile (const DocumentModelExportFormat &modelExport,
+                                      const Document &document,
+                                      const MainWindowModel &modelMainWindow,
+                                      const Transformation &transformation,
+                                      const QString &fileName,
+                                      QIODevice &device) const
+{
+  QStringList curveNames;
+  int rowCount;
+  ExportColumnsLoader loader = loadColumns (modelExport,
+                                            document,
+                                            modelMainWindow,
+                                            transformation,
+                                            curveNames,
+                                            rowCount);
+
+  if (QFileInfo (fileName).suffix ().compare (NPZ_FILENAME_EXTENSION, Qt::CaseInsensitive) == 0) {
+    return writeNpz (document,
+                     loader,
+                     curveNames,
+                     device);
+  } else {
+    return writeNpy (loader,
+                     curveNames.count (),
+                     rowCount,
+                     device);
+  }
+}
+
+QString ExportToFileNumpy::fileExtensionNpy () const
+{
+  return NPY_FILENAME_EXTENSION;
+}
+
+QString ExportToFileNumpy::fileExtensionNpz () const
+{
+  return NPZ_FILENAME_EXTENSION;
+}
+
+QString ExportToFileNumpy::filterNpy () const
+{
+  return QString ("NumPy array (*.%1)")
+      .arg (NPY_FILENAME_EXTENSION);
+}
+
+QString ExportToFileNumpy::filterNpz () const
+{
+  return QString ("NumPy arrays with header (*.%1)")
+      .arg (NPZ_FILENAME_EXTENSION);
+}
+
+QByteArray ExportToFileNumpy::headerJson (const Document &document,
+                                          const QStringList &curveNames,
+                                          const QStringList &arrayNames) const
+{
+  const DocumentModelCoords &modelCoords = document.modelCoords ();
+  bool isPolar = (modelCoords.coordsType () == COORDS_TYPE_POLAR);
+
+  QJsonObject header;
+  header ["coordsType"] = coordsTypeToString (modelCoords.coordsType ());
+  header ["xThetaScale"] = coordScaleToString (modelCoords.coordScaleXTheta ());
+  header ["yRadiusScale"] = coordScaleToString (modelCoords.coordScaleYRadius ());
+  header ["xThetaUnits"] = (isPolar ?
+                              coordUnitsPolarThetaToString (modelCoords.coordUnitsTheta ()) :
+                              coordUnitsNonPolarThetaToString (modelCoords.coordUnitsX ()));
+  header ["yRadiusUnits"] = (isPolar ?
+                               coordUnitsNonPolarThetaToString (modelCoords.coordUnitsRadius ()) :
+                               coordUnitsNonPolarThetaToString (modelCoords.coordUnitsY ()));
+
+  QJsonArray curves;
+  for (int i = 0; i < curveNames.count (); i++) {
+    QJsonObject curve;
+    curve ["name"] = curveNames.at (i);
+    curve ["x"] = arrayNames.at (i) + "_x";
+    curve ["y"] = arrayNames.at (i) + "_y";
+    curves.append (curve);
+  }
+  header ["curves"] = curves;
+
+  return QJsonDocument (header).toJson ();
+}
+
+QByteArray ExportToFileNumpy::headerNpy (const QString &shape) const
+{
+  // Spaces pad the header, which ends with a newline, so the data is aligned
+  QString header = QString ("{'descr': '<f8', 'fortran_order': False, 'shape': %1, }")
+                   .arg (shape);
+  int padding = (NPY_ALIGNMENT - (NPY_PREAMBLE_LENGTH + header.size () + 1) % NPY_ALIGNMENT) % NPY_ALIGNMENT;
+  header += QString (padding, ' ') + "\n";
+
+  QByteArray npy;
+  QDataStream str (&npy, QIODevice::WriteOnly);
+  str.setByteOrder (QDataStream::LittleEndian);
+
+  str.writeRawData ("\x93NUMPY", 6);
+  str << quint8 (1) << quint8 (0) << quint16 (header.size ());
+  str.writeRawData (header.toLatin1 ().constData (),
+                    header.size ());
+
+  return npy;
+}
+
+bool ExportToFileNumpy::isNumpyFileName (const QString &fileName) const
+{
+  QString suffix = QFileInfo (fileName).suffix ();
+
+  return (suffix.compare (NPY_FILENAME_EXTENSION, Qt::CaseInsensitive) == 0) ||
+         (suffix.compare (NPZ_FILENAME_EXTENSION, Qt::CaseInsensitive) == 0);
+}
+
+ExportColumnsLoader ExportToFileNumpy::loadColumns (const DocumentModelExportFormat &modelExport,
+                                                    const Document &document,
+                                                    const MainWindowModel &modelMainWindow,
+                                                    const Transformation &transformation,
+                                                    QStringList &curveNames,
+                                                    int &rowCount) const
+{
+  QStringList curveNamesFunctions, curveNamesRelations;
+  int rowCountFunctions, rowCountRelations;
+
+  ExportFileFunctions exportFunctions;
+  ExportColumnsLoader loaderFunctions = exportFunctions.exportToColumns (modelExport,
+                                                                         document,
+                                                                         modelMainWindow,
+                                                                         transformation,
+                                                                         curveNamesFunctions,
+                                                                         rowCountFunctions);
+
+  ExportFileRelations exportRelations;
+  ExportColumnsLoader loaderRelations = exportRelations.exportToColumns (modelExport,
+                                                                         document,
+                                                                         transformation,
+                                                                         curveNamesRelations,
+                                                                         rowCountRelations);
+
+  curveNames = curveNamesFunctions + curveNamesRelations;
+  rowCount = qMax (rowCountFunctions,
+                   rowCountRelations);
+
+  return [=] (int blockCount,
+              QVector<ExportValuesColumn> &columns) mutable -> int {
+
+    QVector<ExportValuesColumn> columnsRelations;
+    int blockCountFunctions = loaderFunctions (blockCount,
+                                               columns);
+    int blockCountRelations = loaderRelations (blockCount,
+                                               columnsRelations);
+    columns += columnsRelations;
+
+    return qMax (blockCountFunctions,
+                 blockCountRelations);
+  };
+}
+
+bool ExportToFileNumpy::writeNpy (const ExportColumnsLoader &loader,
+                                  int columnCount,
+                                  int rowCount,
+                                  QIODevice &device) const
+{
+  QDataStream str (&device);
+  str.setByteOrder (QDataStream::LittleEndian);
+  str.setFloatingPointPrecision (QDataStream::DoublePrecision);
+
+  QByteArray header = headerNpy (QString ("(%1, %2)")
+                                 .arg (rowCount)
+                                 .arg (2 * columnCount));
+  str.writeRawData (header.constData (),
+                    header.size ());
+
+  // Row-major order, with x/theta and y/radius for each curve across each row. Each block is written as soon as it
+  // is loaded, so only one block is held at a time
+  QVector<ExportValuesColumn> columns;
+  int blockCount;
+  while ((blockCount = loader (EXPORT_ROWS_PER_BLOCK,
+                               columns)) > 0) {
+
+    for (int row = 0; row < blockCount; row++) {
+      QVector<ExportValuesColumn>::const_iterator itr;
+      for (itr = columns.begin (); itr != columns.end (); itr++) {
+        if (row < itr->rowCount () && itr->isValid (row)) {
+          str << itr->xTheta (row)
+              << itr->yRadius (row);
+        } else {
+          str << qQNaN ()
+              << qQNaN ();
+        }
+      }
+    }
+  }
+
+  return (str.status () == QDataStream::Ok);
+}
+
+bool ExportToFileNumpy::writeNpz (const Document &document,
+                                  const ExportColumnsLoader &loader,
+                                  const QStringList &curveNames,
+                                  QIODevice &device) const
+{
+  QStringList arrayNames = arrayNamesNpz (curveNames);
+
+  // Only the rows with values are kept, since each curve has its own arrays. The array lengths, which go in the npy
+  // headers, are therefore not known until every block has been loaded, so the x/theta and y/radius pairs of each
+  // curve are appended to a temporary file as each block is loaded, and streamed from there into the archive
+  QList<QSharedPointer<QTemporaryFile> > spools;
+  QVector<int> counts (curveNames.count (), 0);
+  for (int i = 0; i < curveNames.count (); i++) {
+    QSharedPointer<QTemporaryFile> spool (new QTemporaryFile);
+    if (!spool->open ()) {
+      return false;
+    }
+    spools << spool;
+  }
+
+  QVector<ExportValuesColumn> columns;
+  while (loader (EXPORT_ROWS_PER_BLOCK,
+                 columns) > 0) {
+
+    for (int i = 0; i < columns.count (); i++) {
+
+      const ExportValuesColumn &column = columns.at (i);
+
+      QByteArray pairs;
+      QDataStream strPairs (&pairs, QIODevice::WriteOnly);
+      strPairs.setByteOrder (QDataStream::LittleEndian);
+      strPairs.setFloatingPointPrecision (QDataStream::DoublePrecision);
+      for (int row = 0; row < column.rowCount (); row++) {
+        if (column.isValid (row)) {
+          strPairs << column.xTheta (row)
+                   << column.yRadius (row);
+          ++counts [i];
+        }
+      }
+
+      if (spools.at (i)->write (pairs) != pairs.size ()) {
+        return false;
+      }
+    }
+  }
+
+  ExportZipStored zip (device);
+  for (int i = 0; i < curveNames.count (); i++) {
+
+    QTemporaryFile &spool = *spools.at (i);
+    QByteArray header = headerNpy (QString ("(%1,)")
+                                   .arg (counts.at (i)));
+
+    // First array has the x/theta value of each pair and the second has the y/radius value
+    for (int axis = 0; axis < 2; axis++) {
+
+      zip.beginMember (QString ("%1_%2.%3")
+                       .arg (arrayNames.at (i))
+                       .arg (axis == 0 ? "x" : "y")
+                       .arg (NPY_FILENAME_EXTENSION));
+      zip.writeMember (header);
+
+      if (!spool.seek (0)) {
+        return false;
+      }
+
+      while (!spool.atEnd ()) {
+
+        QByteArray pairs = spool.read (EXPORT_ROWS_PER_BLOCK * 2 * NPY_VALUE_LENGTH);
+        if (pairs.isEmpty ()) {
+          return false;
+        }
+
+        QByteArray values;
+        values.reserve (pairs.size () / 2);
+        for (int pair = 0; pair < pairs.size () / (2 * NPY_VALUE_LENGTH); pair++) {
+          values.append (pairs.constData () + (2 * pair + axis) * NPY_VALUE_LENGTH,
+                         NPY_VALUE_LENGTH);
+        }
+
+        zip.writeMember (values);
+      }
+    }
+  }
+
+  zip.beginMember (HEADER_JSON_MEMBER);
+  zip.writeMember (headerJson (document,
+                               curveNames,
+                               arrayNames));
+
+  return zip.finish ();
+}
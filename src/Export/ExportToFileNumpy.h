@@ -0,0 +1,97 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef EXPORT_TO_FILE_NUMPY_H
+#define EXPORT_TO_FILE_NUMPY_H
+
+#include "ExportColumnsLoader.h"
+#include <QByteArray>
+#include <QStringList>
+
+class Document;
+class DocumentModelExportFormat;
+class MainWindowModel;
+class QIODevice;
+class Transformation;
+
+/// Strategy class for exporting to binary NumPy files, which load much faster than delimited text. Values are written
+/// as float64 straight from the export columns without any formatting, so dates and times stay as the numbers in the
+/// graph coordinates and angles stay as decimal numbers. There are two file types:
+/// -# A .npy file has one 2D array with x/theta and y/radius columns for each curve. Functions come before relations
+///    and rows without a value are NaN
+/// -# A .npz bundle has separate x/theta and y/radius arrays for each curve, without the rows that have no value, plus
+///    header.json with the curve and array names and the coordinate settings
+///
+/// Rows are loaded and written one block at a time, so there is no limit on their number
+class ExportToFileNumpy
+{
+  friend class TestExport;
+
+public:
+  /// Single constructor.
+  ExportToFileNumpy();
+
+  /// Export Document points according to the settings, as a .npz bundle if the file name has that extension and as
+  /// a .npy array otherwise. The DocumentModelExportFormat inside the Document is ignored, as with ExportToFile.
+  /// Returns false if writing failed
+  bool exportToFile (const DocumentModelExportFormat &modelExport,
+                     const Document &document,
+                     const MainWindowModel &modelMainWindow,
+                     const Transformation &transformation,
+                     const QString &fileName,
+                     QIODevice &device) const;
+
+  /// File extension for npy export files
+  QString fileExtensionNpy () const;
+
+  /// File extension for npz export files
+  QString fileExtensionNpz () const;
+
+  /// QFileDialog filter for NPY files
+  QString filterNpy () const;
+
+  /// QFileDialog filter for NPZ files
+  QString filterNpz () const;
+
+  /// True if the file name has the extension of one of the binary formats
+  bool isNumpyFileName (const QString &fileName) const;
+
+private:
+
+  // Name of the array for each curve in the .npz bundle, from the curve name. Characters that zip treats as
+  // directory separators are replaced, and names are made unique
+  QStringList arrayNamesNpz (const QStringList &curveNames) const;
+
+  // Contents of header.json in the .npz bundle
+  QByteArray headerJson (const Document &document,
+                         const QStringList &curveNames,
+                         const QStringList &arrayNames) const;
+
+  // Magic string, version and header of a .npy file with a float64 array of the specified shape, like "(3, 2)" or
+  // "(3,)". The header is padded so the values that follow are aligned
+  QByteArray headerNpy (const QString &shape) const;
+
+  // Prepare the function curves and then the relation curves for loading in blocks. Each block has the function
+  // columns first, and has as many rows as the longer of the two sets of columns
+  ExportColumnsLoader loadColumns (const DocumentModelExportFormat &modelExport,
+                                   const Document &document,
+                                   const MainWindowModel &modelMainWindow,
+                                   const Transformation &transformation,
+                                   QStringList &curveNames,
+                                   int &rowCount) const;
+
+  // Each write returns false if the device, or a temporary file, did not accept everything
+  bool writeNpy (const ExportColumnsLoader &loader,
+                 int columnCount,
+                 int rowCount,
+                 QIODevice &device) const;
+  bool writeNpz (const Document &document,
+                 const ExportColumnsLoader &loader,
+                 const QStringList &curveNames,
+                 QIODevice &device) const;
+};
+
+#endif // EXPORT_TO_FILE_NUMPY_H
@@ -0,0 +1,57 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#include "EngaugeAssert.h"
+#include "ExportValuesColumn.h"
+
+ExportValuesColumn::ExportValuesColumn()
+{
+}
+
+ExportValuesColumn::ExportValuesColumn(int rowCount) :
+  m_xThetas (rowCount, 0.0),
+  m_yRadii (rowCount, 0.0),
+  m_valid (rowCount, false)
+{
+}
+
+void ExportValuesColumn::clearValue (int row)
+{
+  ENGAUGE_ASSERT (row < m_valid.count ());
+
+  m_valid [row] = false;
+}
+
+bool ExportValuesColumn::isValid (int row) const
+{
+  return m_valid.at (row);
+}
+
+int ExportValuesColumn::rowCount () const
+{
+  return m_valid.count ();
+}
+
+void ExportValuesColumn::setValue (int row,
+                                   double xTheta,
+                                   double yRadius)
+{
+  ENGAUGE_ASSERT (row < m_valid.count ());
+
+  m_xThetas [row] = xTheta;
+  m_yRadii [row] = yRadius;
+  m_valid [row] = true;
+}
+
+double ExportValuesColumn::xTheta (int row) const
+{
+  return m_xThetas.at (row);
+}
+
+double ExportValuesColumn::yRadius (int row) const
+{
+  return m_yRadii.at (row);
+}
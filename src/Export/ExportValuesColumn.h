@@ -0,0 +1,52 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef EXPORT_VALUES_COLUMN_H
+#define EXPORT_VALUES_COLUMN_H
+
+#include <QVector>
+
+/// Column of unformatted x/theta and y/radius export values, one pair per row, with a flag for each row that
+/// says whether the row has a value. Values are kept as numbers and only converted to strings as each row is
+/// written, so a table of these columns takes far less memory than a table of strings. Rows without a value
+/// are written as empty cells
+class ExportValuesColumn
+{
+public:
+  /// Default constructor for use in QVector, giving a column with no rows
+  ExportValuesColumn();
+
+  /// Constructor for column with the specified number of rows, all initially without a value
+  ExportValuesColumn(int rowCount);
+
+  /// Remove the value in the specified row, if there is one
+  void clearValue (int row);
+
+  /// True if the specified row has a value
+  bool isValid (int row) const;
+
+  /// Number of rows, with or without values
+  int rowCount () const;
+
+  /// Set the value in the specified row
+  void setValue (int row,
+                 double xTheta,
+                 double yRadius);
+
+  /// X/theta value in the specified row. Only applicable if isValid is true for that row
+  double xTheta (int row) const;
+
+  /// Y/radius value in the specified row. Only applicable if isValid is true for that row
+  double yRadius (int row) const;
+
+private:
+
+  QVector<double> m_xThetas;
+  QVector<double> m_yRadii;
+  QVector<bool> m_valid;
+};
+
+#endif // EXPORT_VALUES_COLUMN_H
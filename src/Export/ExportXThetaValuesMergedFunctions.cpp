@@ -11,6 +11,7 @@
 #include "ExportXThetaValuesMergedFunctions.h"
 #include "Logger.h"
 #include "Point.h"
+#include <limits>
 #include <qmath.h>
 #include "Transformation.h"
 
@@ -18,23 +19,28 @@ using namespace std;
 
 ExportXThetaValuesMergedFunctions::ExportXThetaValuesMergedFunctions(const DocumentModelExportFormat &modelExport,
                                                                      const MainWindowModel &modelMainWindow,
-                                                                     const ValuesVectorXOrY &xThetaValuesRaw,
+                                                                     const ExportValuesXOrY &xThetaValuesRaw,
                                                                      const Transformation &transformation) :
   m_modelExport (modelExport),
   m_modelMainWindow (modelMainWindow),
   m_xThetaValuesRaw (xThetaValuesRaw),
   m_transformation (transformation)
 {
+  restart ();
 }
 
-bool ExportXThetaValuesMergedFunctions::breakForPointOverrun (unsigned int curveSize,
-                                                              bool &isOverrun) const
+int ExportXThetaValuesMergedFunctions::count () const
 {
-  // Break if we will overrun the maximum point limit. As per issue #401 a change of scale
-  // can result in a huge (new) range with a small (old) delta - resulting in so many values
-  // that this loop effectively hangs. Set flag if overrun occurred
-  isOverrun = (curveSize > (unsigned int) m_modelMainWindow.maximumExportedPointsPerCurve ());
-  return isOverrun;
+  ExportXThetaValuesMergedFunctions values (*this);
+  values.restart ();
+
+  int count = 0;
+  double xTheta;
+  while (values.nextValue (xTheta)) {
+    ++count;
+  }
+
+  return count;
 }
 
 void ExportXThetaValuesMergedFunctions::firstSimplestNumberLinear (double &xThetaFirstSimplestNumber,
@@ -43,8 +49,8 @@ void ExportXThetaValuesMergedFunctions::firstSimplestNumberLinear (double &xThet
 {
 
   // X/theta range
-  xThetaMin = m_xThetaValuesRaw.firstKey();
-  xThetaMax = m_xThetaValuesRaw.lastKey();
+  xThetaMin = m_xThetaValuesRaw.first();
+  xThetaMax = m_xThetaValuesRaw.last();
 
   // Compute offset that gives the simplest numbers
   ExportAlignLinear alignLinear (xThetaMin,
@@ -59,8 +65,8 @@ void ExportXThetaValuesMergedFunctions::firstSimplestNumberLog (double &xThetaFi
 {
 
   // X/theta range
-  xThetaMin = m_xThetaValuesRaw.firstKey();
-  xThetaMax = m_xThetaValuesRaw.lastKey();
+  xThetaMin = m_xThetaValuesRaw.first();
+  xThetaMax = m_xThetaValuesRaw.last();
 
   // Compute offset that gives the simplest numbers
   ExportAlignLog alignLog (xThetaMin,
@@ -69,73 +75,155 @@ void ExportXThetaValuesMergedFunctions::firstSimplestNumberLog (double &xThetaFi
   xThetaFirstSimplestNumber = alignLog.firstSimplestNumber();
 }
 
-ExportValuesXOrY ExportXThetaValuesMergedFunctions::periodicLinear(bool &isOverrun) const
+bool ExportXThetaValuesMergedFunctions::isOverrun () const
 {
+  ExportXThetaValuesMergedFunctions values (*this);
+  values.restart ();
+
+  int count = 0;
+  double xTheta;
+  while (values.nextValue (xTheta)) {
+    if (++count > m_modelMainWindow.maximumExportedPointsPerCurve ()) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool ExportXThetaValuesMergedFunctions::nextValue (double &xTheta)
+{
+  if (!m_isPeriodic) {
+
+    // Return the gathered values
+    if (m_indexRaw < m_xThetaValuesRaw.count ()) {
+      xTheta = m_xThetaValuesRaw.at (m_indexRaw++);
+      return true;
+    }
+
+    return false;
+  }
+
+  while (true) {
+
+    double xThetaCandidate;
+    if (m_hasFirst) {
+
+      m_hasFirst = false;
+      xThetaCandidate = m_xThetaFirst;
+
+    } else if (m_isStepping && (m_xThetaNext <= m_xThetaMax)) {
+
+      xThetaCandidate = m_xThetaNext;
+      m_xThetaNext = (m_isStepMultiplied ? m_xThetaNext * m_step : m_xThetaNext + m_step);
+
+      // As per issue #401 a change of scale can result in a huge (new) range with a small (old) delta. A delta that is
+      // lost to rounding would never reach the maximum, so the values end here
+      if (m_xThetaNext <= xThetaCandidate) {
+        m_isStepping = false;
+        m_canEndAtMax = false;
+      }
+
+    } else if (m_canEndAtMax && (m_xThetaNext > m_xThetaMax)) {
 
-  if (m_xThetaValuesRaw.count () > 0) {
+      // We passed maximum so insert point right at xThetaMax
+      m_isStepping = false;
+      m_canEndAtMax = false;
+      xThetaCandidate = m_xThetaMax;
 
-    double xThetaFirstSimplestNumber, xThetaMin, xThetaMax;
-    firstSimplestNumberLinear (xThetaFirstSimplestNumber,
-                               xThetaMin,
-                               xThetaMax);
+    } else {
+
+      m_isStepping = false;
+      m_canEndAtMax = false;
+      return false;
+    }
 
-    // Assuming user picks an appropriate interval increment, numbering starting at xThetaFirstSimplestNumber
-    // will give nice x/theta numbers
-    if (m_modelExport.pointsIntervalUnitsFunctions() == EXPORT_POINTS_INTERVAL_UNITS_GRAPH) {
-      return periodicLinearGraph(xThetaFirstSimplestNumber,
-                                 xThetaMin,
-                                 xThetaMax,
-                                 isOverrun);
+    // Values are increasing and without duplicates, as when they were sorted
+    if (!m_hasPrevious || (m_xThetaPrevious < xThetaCandidate)) {
+
+      m_hasPrevious = true;
+      m_xThetaPrevious = xThetaCandidate;
+      xTheta = xThetaCandidate;
+      return true;
+    }
+  }
+}
+
+void ExportXThetaValuesMergedFunctions::restart ()
+{
+  m_isPeriodic = (m_modelExport.pointsSelectionFunctions() == EXPORT_POINTS_SELECTION_FUNCTIONS_INTERPOLATE_PERIODIC);
+  m_indexRaw = 0;
+  m_hasFirst = false;
+  m_xThetaFirst = 0;
+  m_isStepping = false;
+  m_isStepMultiplied = false;
+  m_step = 0;
+  m_xThetaNext = 0;
+  m_xThetaMax = 0;
+  m_canEndAtMax = false;
+  m_hasPrevious = false;
+  m_xThetaPrevious = 0;
+
+  // Special case that occurs when there are no points, in which case there are no values
+  if (m_isPeriodic &&
+      (qAbs (m_modelExport.pointsIntervalFunctions()) > 0) &&
+      (m_xThetaValuesRaw.count () > 0)) {
+
+    bool isLinear =  (m_transformation.modelCoords().coordScaleXTheta() == COORD_SCALE_LINEAR);
+
+    if (isLinear) {
+      restartPeriodicLinear ();
     } else {
-      return periodicLinearScreen(xThetaMin,
-                                  xThetaMax,
-                                  isOverrun);
+      restartPeriodicLog ();
     }
-  } else {
+  }
+}
+
+void ExportXThetaValuesMergedFunctions::restartPeriodicLinear ()
+{
 
-    ExportValuesXOrY emptyList;
-    return emptyList;
+  double xThetaFirstSimplestNumber, xThetaMin, xThetaMax;
+  firstSimplestNumberLinear (xThetaFirstSimplestNumber,
+                             xThetaMin,
+                             xThetaMax);
+
+  // Assuming user picks an appropriate interval increment, numbering starting at xThetaFirstSimplestNumber
+  // will give nice x/theta numbers
+  if (m_modelExport.pointsIntervalUnitsFunctions() == EXPORT_POINTS_INTERVAL_UNITS_GRAPH) {
+    restartPeriodicLinearGraph (xThetaFirstSimplestNumber,
+                                xThetaMin,
+                                xThetaMax);
+  } else {
+    restartPeriodicLinearScreen (xThetaMin,
+                                 xThetaMax);
   }
 }
 
-ExportValuesXOrY ExportXThetaValuesMergedFunctions::periodicLinearGraph(double xThetaFirstSimplestNumber,
-                                                                        double xThetaMin,
-                                                                        double xThetaMax,
-                                                                        bool &isOverrun) const
+void ExportXThetaValuesMergedFunctions::restartPeriodicLinearGraph (double xThetaFirstSimplestNumber,
+                                                                    double xThetaMin,
+                                                                    double xThetaMax)
 {
 
   // Convert the gathered values into a periodic sequence
-  ValuesVectorXOrY values;
   double xTheta = xThetaFirstSimplestNumber;
   while (xTheta > xThetaMin) {
     xTheta -= m_modelExport.pointsIntervalFunctions(); // Go backwards until reaching or passing minimum
   }
   if (xTheta < xThetaMin) {
-    values [xThetaMin] = true; // We passed minimum so insert point right at xThetaMin
-  }
-
-  xTheta += m_modelExport.pointsIntervalFunctions();
-  while (xTheta <= xThetaMax) {
-
-    values [xTheta] = true;
-    xTheta += m_modelExport.pointsIntervalFunctions(); // Insert point at a simple number
-
-    if (breakForPointOverrun (values.count(),
-                              isOverrun)) {
-      break;
-    }
-  }
-
-  if (xTheta > xThetaMax) {
-    values [xThetaMax] = true; // We passed maximum so insert point right at xThetaMax
+    m_hasFirst = true; // We passed minimum so insert point right at xThetaMin
+    m_xThetaFirst = xThetaMin;
   }
 
-  return values.keys();
+  // Insert points at simple numbers
+  m_isStepping = true;
+  m_step = m_modelExport.pointsIntervalFunctions();
+  m_xThetaNext = xTheta + m_step;
+  m_xThetaMax = xThetaMax;
+  m_canEndAtMax = true;
 }
 
-ExportValuesXOrY ExportXThetaValuesMergedFunctions::periodicLinearScreen (double xThetaMin,
-                                                                          double xThetaMax,
-                                                                          bool &isOverrun) const
+void ExportXThetaValuesMergedFunctions::restartPeriodicLinearScreen (double xThetaMin,
+                                                                     double xThetaMax)
 {
 
   // This must be greater than zero. Otherwise, logarithmic y axis will trigger errors in the
@@ -163,26 +251,14 @@ ExportValuesXOrY ExportXThetaValuesMergedFunctions::periodicLinearScreen (double
   // Example: xThetaMin=0.1 and xThetaMax=100 (points are 0.1, 1, 10, 100) with s=1/3 so scale should be 10
   // which multiples 0.1 to get 1. This uses s=(log(xNext)-log(xMin))/(log(xMax)-log(xMin))
   double xNext = xThetaMin + s * (xThetaMax - xThetaMin);
-  double delta = xNext - xThetaMin;
-
-  ValuesVectorXOrY values;
-
-  double xTheta = xThetaMin;
-  while (xTheta <= xThetaMax) {
-
-    values [xTheta] = true;
-    xTheta += delta;
-
-    if (breakForPointOverrun (values.count(),
-                              isOverrun)) {
-      break;
-    }
-  }
 
-  return values.keys();
+  m_isStepping = true;
+  m_step = xNext - xThetaMin;
+  m_xThetaNext = xThetaMin;
+  m_xThetaMax = xThetaMax;
 }
 
-ExportValuesXOrY ExportXThetaValuesMergedFunctions::periodicLog(bool &isOverrun) const
+void ExportXThetaValuesMergedFunctions::restartPeriodicLog ()
 {
 
   double xThetaFirstSimplestNumber, xThetaMin, xThetaMax;
@@ -193,25 +269,21 @@ ExportValuesXOrY ExportXThetaValuesMergedFunctions::periodicLog(bool &isOverrun)
   // Assuming user picks an appropriate interval increment, numbering starting at xThetaFirstSimplestNumber
   // will give nice x/theta numbers
   if (m_modelExport.pointsIntervalUnitsFunctions() == EXPORT_POINTS_INTERVAL_UNITS_GRAPH) {
-    return periodicLogGraph(xThetaFirstSimplestNumber,
-                            xThetaMin,
-                            xThetaMax,
-                            isOverrun);
+    restartPeriodicLogGraph (xThetaFirstSimplestNumber,
+                             xThetaMin,
+                             xThetaMax);
   } else {
-    return periodicLogScreen(xThetaMin,
-                             xThetaMax,
-                             isOverrun);
+    restartPeriodicLogScreen (xThetaMin,
+                              xThetaMax);
   }
 }
 
-ExportValuesXOrY ExportXThetaValuesMergedFunctions::periodicLogGraph (double xThetaFirstSimplestNumber,
-                                                                      double xThetaMin,
-                                                                      double xThetaMax,
-                                                                      bool &isOverrun) const
+void ExportXThetaValuesMergedFunctions::restartPeriodicLogGraph (double xThetaFirstSimplestNumber,
+                                                                 double xThetaMin,
+                                                                 double xThetaMax)
 {
 
   // Convert the gathered values into a periodic sequence
-  ValuesVectorXOrY values;
   double xTheta = xThetaFirstSimplestNumber;
   if (m_modelExport.pointsIntervalFunctions() > 1) { // Safe to iterate
     while (xTheta > xThetaMin) {
@@ -219,33 +291,24 @@ ExportValuesXOrY ExportXThetaValuesMergedFunctions::periodicLogGraph (double xTh
     }
   }
   if (xTheta < xThetaMin) {
-    values [xThetaMin] = true; // We passed minimum so insert point right at xThetaMin
+    m_hasFirst = true; // We passed minimum so insert point right at xThetaMin
+    m_xThetaFirst = xThetaMin;
   }
 
+  // Insert points at simple numbers
+  m_isStepMultiplied = true;
+  m_step = m_modelExport.pointsIntervalFunctions();
+  m_xThetaNext = xTheta;
   if (m_modelExport.pointsIntervalFunctions() > 1) { // Safe to iterate
-    xTheta *= m_modelExport.pointsIntervalFunctions();
-    while (xTheta <= xThetaMax) {
-
-      values [xTheta] = true;
-      xTheta *= m_modelExport.pointsIntervalFunctions(); // Insert point at a simple number
-
-      if (breakForPointOverrun (values.count(),
-                                isOverrun)) {
-        break;
-      }
-    }
+    m_isStepping = true;
+    m_xThetaNext *= m_step;
   }
-
-  if (xTheta > xThetaMax) {
-    values [xThetaMax] = true; // We passed maximum so insert point right at xThetaMax
-  }
-
-  return values.keys();
+  m_xThetaMax = xThetaMax;
+  m_canEndAtMax = true;
 }
 
-ExportValuesXOrY ExportXThetaValuesMergedFunctions::periodicLogScreen (double xThetaMin,
-                                                                       double xThetaMax,
-                                                                       bool &isOverrun) const
+void ExportXThetaValuesMergedFunctions::restartPeriodicLogScreen (double xThetaMin,
+                                                                  double xThetaMax)
 {
 
   const double ARBITRARY_Y = 0.0;
@@ -273,61 +336,39 @@ ExportValuesXOrY ExportXThetaValuesMergedFunctions::periodicLogScreen (double xT
   // Example: xThetaMin=0.1 and xThetaMax=100 (points are 0.1, 1, 10, 100) with s=1/3 so scale should be 10
   // which multiples 0.1 to get 1. This uses s=(log(xNext)-log(xMin))/(log(xMax)-log(xMin))
   double xNext = qExp (qLn (xThetaMin) + s * (qLn (xThetaMax) - qLn (xThetaMin)));
-  double scale = xNext / xThetaMin;
-
-  ValuesVectorXOrY values;
-
-  double xTheta = xThetaMin;
-  while (xTheta <= xThetaMax) {
-
-    values [xTheta] = true;
-    xTheta *= scale;
 
-    if (breakForPointOverrun (values.count(),
-                              isOverrun)) {
-      break;
-    }
-  }
-
-  return values.keys();
+  m_isStepping = true;
+  m_isStepMultiplied = true;
+  m_step = xNext / xThetaMin;
+  m_xThetaNext = xThetaMin;
+  m_xThetaMax = xThetaMax;
 }
 
 ExportValuesXOrY ExportXThetaValuesMergedFunctions::xThetaValues (bool &isOverrun) const
 {
+  ExportValuesXOrY values;
 
-  if (m_modelExport.pointsSelectionFunctions() == EXPORT_POINTS_SELECTION_FUNCTIONS_INTERPOLATE_PERIODIC) {
-
-    ExportValuesXOrY values;
-
-    // Special case that occurs when there are no points
-    if (qAbs (m_modelExport.pointsIntervalFunctions()) <= 0) {
-
-      // Return empty array
-
-    } else {
-
-      bool isLinear =  (m_transformation.modelCoords().coordScaleXTheta() == COORD_SCALE_LINEAR);
-
-      if (isLinear) {
-        values = periodicLinear (isOverrun);
-      } else {
-        values = periodicLog (isOverrun);
-      }
-
-      if (isOverrun) {
-
-        // Empty out the array since it is, in the case of overrun, incomplete and therefore confusing at best
-        values.clear();
-
-      }
-    }
+  // In the case of overrun the array is left empty since it would be too large
+  isOverrun = this->isOverrun ();
+  if (!isOverrun) {
 
-    return values;
+    ExportXThetaValuesMergedFunctions valuesAll (*this);
+    valuesAll.restart ();
+    values = valuesAll.xThetaValuesBlock (std::numeric_limits<int>::max ());
+  }
 
-  } else {
+  return values;
+}
 
-    // Return the gathered values
-    return m_xThetaValuesRaw.keys();
+ExportValuesXOrY ExportXThetaValuesMergedFunctions::xThetaValuesBlock (int blockCount)
+{
+  ExportValuesXOrY values;
 
+  double xTheta;
+  while ((values.count () < blockCount) &&
+         nextValue (xTheta)) {
+    values << xTheta;
   }
+
+  return values;
 }
@@ -11,56 +11,84 @@
 #include "ExportValuesXOrY.h"
 #include "MainWindowModel.h"
 #include "Transformation.h"
-#include "ValuesVectorXOrY.h"
 
 class Point;
 class Transformation;
 
-/// Creates the set of merged x/theta values for exporting functions, using interpolation
+/// Creates the set of merged x/theta values for exporting functions, using interpolation. The values are generated
+/// one at a time, in increasing order, so an export can load them in blocks and its memory use does not grow with
+/// the number of values
 class ExportXThetaValuesMergedFunctions
 {
 public:
-  /// Single constructor.
+  /// Single constructor. Generation starts at the first value
   ExportXThetaValuesMergedFunctions(const DocumentModelExportFormat &modelExport,
                                     const MainWindowModel &modelMainWindow,
-                                    const ValuesVectorXOrY &xThetaValuesRaw,
+                                    const ExportValuesXOrY &xThetaValuesRaw,
                                     const Transformation &transformation);
 
-  /// Resulting x/theta values for all included functions
+  /// Number of values, which are counted without being kept. There is no limit on the count
+  int count () const;
+
+  /// True if there are more values than the maximum number of exported points per curve. The values are counted,
+  /// without being kept, only until that maximum is passed
+  bool isOverrun () const;
+
+  /// Start generating the values again from the first one, as when another curve is exported one per line
+  void restart ();
+
+  /// Resulting x/theta values for all included functions, generated at once. If there are more than the maximum
+  /// number of exported points per curve then isOverrun is set and no values are returned
   ExportValuesXOrY xThetaValues (bool &isOverrun) const;
 
+  /// Next block of at most blockCount x/theta values. The block is empty after every value has been generated
+  ExportValuesXOrY xThetaValuesBlock (int blockCount);
+
 private:
   ExportXThetaValuesMergedFunctions();
 
-  bool breakForPointOverrun (unsigned int curveSize,
-                             bool &isOverrun) const;
   void firstSimplestNumberLinear (double &xThetaFirstSimplestNumber,
                                   double &xThetaMin,
                                   double &xThetaMax) const;
   void firstSimplestNumberLog (double &xThetaFirstSimplestNumber,
                                double &xThetaMin,
                                double &xThetaMax) const;
-  ExportValuesXOrY periodicLinear(bool &isOverrun) const;
-  ExportValuesXOrY periodicLinearGraph (double xThetaFirstSimplestNumber,
-                                        double xThetaMin,
-                                        double xThetaMax,
-                                        bool &isOverrun) const;
-  ExportValuesXOrY periodicLinearScreen (double xThetaMin,
-                                         double xThetaMax,
-                                         bool &isOverrun) const;
-  ExportValuesXOrY periodicLog(bool &isOverrun) const;
-  ExportValuesXOrY periodicLogGraph (double xThetaFirstSimplestNumber,
-                                     double xThetaMin,
-                                     double xThetaMax,
-                                     bool &isOverrun) const;
-  ExportValuesXOrY periodicLogScreen (double xThetaMin,
-                                      double xThetaMax,
-                                      bool &isOverrun) const;
+
+  // Generate the next value, returning false after the last value
+  bool nextValue (double &xTheta);
+
+  void restartPeriodicLinear ();
+  void restartPeriodicLinearGraph (double xThetaFirstSimplestNumber,
+                                   double xThetaMin,
+                                   double xThetaMax);
+  void restartPeriodicLinearScreen (double xThetaMin,
+                                    double xThetaMax);
+  void restartPeriodicLog ();
+  void restartPeriodicLogGraph (double xThetaFirstSimplestNumber,
+                                double xThetaMin,
+                                double xThetaMax);
+  void restartPeriodicLogScreen (double xThetaMin,
+                                 double xThetaMax);
 
   const DocumentModelExportFormat m_modelExport;
   const MainWindowModel m_modelMainWindow;
-  const ValuesVectorXOrY m_xThetaValuesRaw;
+  const ExportValuesXOrY m_xThetaValuesRaw; // Sorted, without duplicates
   const Transformation m_transformation;
+
+  // Generation state. Periodic values are the optional first value, then the values at each interval up to the
+  // maximum, then the optional maximum itself
+  bool m_isPeriodic; // False when the raw values are used as they are
+  int m_indexRaw; // Next raw value, when not periodic
+  bool m_hasFirst;
+  double m_xThetaFirst;
+  bool m_isStepping;
+  bool m_isStepMultiplied; // True for log scale, where the step multiplies rather than adds
+  double m_step;
+  double m_xThetaNext;
+  double m_xThetaMax;
+  bool m_canEndAtMax; // True if the maximum is inserted when the interval values pass it
+  bool m_hasPrevious;
+  double m_xThetaPrevious;
 };
 
 #endif // EXPORT_X_THETA_VALUES_MERGED_FUNCTIONS_H
@@ -0,0 +1,157 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#include "ExportZipStored.h"
+#include <QIODevice>
+#include <QVector>
+
+const quint16 ZIP_DOS_DATE = (1 << 5) | 1; // 1980-01-01, so exporting the same document twice gives identical files
+const quint16 ZIP_DOS_TIME = 0;
+const quint16 ZIP_FLAG_DATA_DESCRIPTOR = 0x0008; // Crc and sizes follow the member data rather than preceding it
+const quint16 ZIP_FLAG_UTF8_NAMES = 0x0800;
+const quint16 ZIP_METHOD_STORED = 0;
+const quint16 ZIP_VERSION = 20;
+const quint32 ZIP_SIGNATURE_CENTRAL_HEADER = 0x02014b50;
+const quint32 ZIP_SIGNATURE_DATA_DESCRIPTOR = 0x08074b50;
+const quint32 ZIP_SIGNATURE_END_OF_CENTRAL_DIRECTORY = 0x06054b50;
+const quint32 ZIP_SIGNATURE_LOCAL_HEADER = 0x04034b50;
+const int ZIP_LENGTH_CENTRAL_HEADER = 46;
+const int ZIP_LENGTH_DATA_DESCRIPTOR = 16;
+const int ZIP_LENGTH_LOCAL_HEADER = 30;
+
+static QVector<quint32> crc32Table ()
+{
+  QVector<quint32> table (256);
+  for (quint32 n = 0; n < 256; n++) {
+    quint32 c = n;
+    for (int k = 0; k < 8; k++) {
+      c = (c & 1) ? (0xedb88320 ^ (c >> 1)) : (c >> 1);
+    }
+    table [signed (n)] = c;
+  }
+
+  return table;
+}
+
+ExportZipStored::ExportZipStored(QIODevice &device) :
+  m_str (&device),
+  m_isMemberOpen (false),
+  m_crc (0),
+  m_size (0),
+  m_offset (0)
+{
+  m_str.setByteOrder (QDataStream::LittleEndian);
+}
+
+void ExportZipStored::beginMember (const QString &memberName)
+{
+  endMember ();
+
+  QByteArray nameUtf8 = memberName.toUtf8 ();
+
+  // Crc and sizes are left as zero here, as the data descriptor flag allows
+  m_str << ZIP_SIGNATURE_LOCAL_HEADER
+        << ZIP_VERSION
+        << quint16 (ZIP_FLAG_UTF8_NAMES | ZIP_FLAG_DATA_DESCRIPTOR)
+        << ZIP_METHOD_STORED
+        << ZIP_DOS_TIME
+        << ZIP_DOS_DATE
+        << quint32 (0) // Crc
+        << quint32 (0) // Compressed size
+        << quint32 (0) // Uncompressed size
+        << quint16 (nameUtf8.size ())
+        << quint16 (0); // Extra field length
+  m_str.writeRawData (nameUtf8.constData (),
+                      nameUtf8.size ());
+
+  m_namesUtf8 << nameUtf8;
+  m_offsets << m_offset;
+  m_offset += quint32 (ZIP_LENGTH_LOCAL_HEADER + nameUtf8.size ());
+
+  m_isMemberOpen = true;
+  m_crc = 0xffffffff;
+  m_size = 0;
+}
+
+void ExportZipStored::endMember ()
+{
+  if (m_isMemberOpen) {
+
+    quint32 crc = m_crc ^ 0xffffffff;
+
+    m_str << ZIP_SIGNATURE_DATA_DESCRIPTOR
+          << crc
+          << m_size // Compressed size
+          << m_size; // Uncompressed size
+
+    m_crcs << crc;
+    m_sizes << m_size;
+    m_offset += quint32 (ZIP_LENGTH_DATA_DESCRIPTOR);
+
+    m_isMemberOpen = false;
+  }
+}
+
+bool ExportZipStored::finish ()
+{
+  endMember ();
+
+  // Central directory
+  quint32 offsetCentralDirectory = m_offset;
+  quint32 sizeCentralDirectory = 0;
+  for (int i = 0; i < m_namesUtf8.count (); i++) {
+
+    const QByteArray &nameUtf8 = m_namesUtf8.at (i);
+
+    m_str << ZIP_SIGNATURE_CENTRAL_HEADER
+          << ZIP_VERSION // Version made by
+          << ZIP_VERSION // Version needed to extract
+          << quint16 (ZIP_FLAG_UTF8_NAMES | ZIP_FLAG_DATA_DESCRIPTOR)
+          << ZIP_METHOD_STORED
+          << ZIP_DOS_TIME
+          << ZIP_DOS_DATE
+          << m_crcs.at (i)
+          << m_sizes.at (i) // Compressed size
+          << m_sizes.at (i) // Uncompressed size
+          << quint16 (nameUtf8.size ())
+          << quint16 (0) // Extra field length
+          << quint16 (0) // Comment length
+          << quint16 (0) // Disk number
+          << quint16 (0) // Internal attributes
+          << quint32 (0) // External attributes
+          << m_offsets.at (i);
+    m_str.writeRawData (nameUtf8.constData (),
+                        nameUtf8.size ());
+
+    sizeCentralDirectory += quint32 (ZIP_LENGTH_CENTRAL_HEADER + nameUtf8.size ());
+  }
+
+  m_str << ZIP_SIGNATURE_END_OF_CENTRAL_DIRECTORY
+        << quint16 (0) // Disk number
+        << quint16 (0) // Disk with central directory
+        << quint16 (m_namesUtf8.count ()) // Entries on this disk
+        << quint16 (m_namesUtf8.count ()) // Entries in total
+        << sizeCentralDirectory
+        << offsetCentralDirectory
+        << quint16 (0); // Comment length
+
+  return (m_str.status () == QDataStream::Ok);
+}
+
+void ExportZipStored::writeMember (const QByteArray &bytes)
+{
+  static const QVector<quint32> table = crc32Table ();
+
+  for (int i = 0; i < bytes.size (); i++) {
+    m_crc = table [signed ((m_crc ^ quint8 (bytes.at (i))) & 0xff)] ^ (m_crc >> 8);
+  }
+
+  m_str.writeRawData (bytes.constData (),
+                      bytes.size ());
+
+  m_size += quint32 (bytes.size ());
+  m_offset += quint32 (bytes.size ());
+}
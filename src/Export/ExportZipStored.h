@@ -0,0 +1,55 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef EXPORT_ZIP_STORED_H
+#define EXPORT_ZIP_STORED_H
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QList>
+#include <QString>
+
+class QIODevice;
+
+/// Writer of a zip archive whose members are stored without compression, which is what numpy.savez produces. Member
+/// bytes go straight to the device as they are written, while the crc and size are accumulated. Those follow each
+/// member in a data descriptor, so no member is held in memory and the device need not be seekable
+class ExportZipStored
+{
+public:
+  /// Single constructor, for writing to the specified device
+  ExportZipStored(QIODevice &device);
+
+  /// Start the next member, after ending the current member if there is one
+  void beginMember (const QString &memberName);
+
+  /// End the last member and write the central directory. Returns false if the device did not accept everything
+  bool finish ();
+
+  /// Append bytes to the current member
+  void writeMember (const QByteArray &bytes);
+
+private:
+  ExportZipStored();
+
+  void endMember ();
+
+  QDataStream m_str;
+  bool m_isMemberOpen;
+
+  // Current member
+  quint32 m_crc; // Running crc, before the final inversion
+  quint32 m_size;
+
+  // Every member so far, for the central directory
+  QList<QByteArray> m_namesUtf8;
+  QList<quint32> m_crcs;
+  QList<quint32> m_sizes;
+  QList<quint32> m_offsets;
+  quint32 m_offset; // Offset of the next local header
+};
+
+#endif // EXPORT_ZIP_STORED_H
@@ -11,19 +11,18 @@
 #include "GridRemoval.h"
 #include "Logger.h"
 #include <QImage>
-#include <QPixmap>
 #include "Transformation.h"
 
 FilterImage::FilterImage ()
 {
 }
 
-QPixmap FilterImage::filter (bool isGnuplot,
-                             const QImage &imageUnfiltered,
-                             const Transformation &transformation,
-                             const QString &curveSelected,
-                             const DocumentModelColorFilter &modelColorFilter,
-                             const DocumentModelGridRemoval &modelGridRemoval) const
+QImage FilterImage::filter (bool isGnuplot,
+                            const QImage &imageUnfiltered,
+                            const Transformation &transformation,
+                            const QString &curveSelected,
+                            const DocumentModelColorFilter &modelColorFilter,
+                            const DocumentModelGridRemoval &modelGridRemoval) const
 {
   // Filtered image
   ColorFilter filter;
@@ -39,11 +38,9 @@ QPixmap FilterImage::filter (bool isGnuplot,
                       rgbBackground);
   
   GridRemoval gridRemoval (isGnuplot);
-  QPixmap pixmapFiltered = gridRemoval.remove (transformation,
-                                               modelGridRemoval,
-                                               imageFiltered);
-
-  return pixmapFiltered;
+  return gridRemoval.remove (transformation,
+                             modelGridRemoval,
+                             imageFiltered);
 }
 
 
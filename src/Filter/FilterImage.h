@@ -7,11 +7,10 @@
 #ifndef FILTER_IMAGE_H
 #define FILTER_IMAGE_H
 
-#include <QPixmap>
+#include <QImage>
 
 class DocumentModelColorFilter;
 class DocumentModelGridRemoval;
-class QImage;
 class Transformation;
 
 /// Filters an image using a combination of color filtering and grid removal
@@ -21,13 +20,13 @@ class FilterImage
   /// Single constructor
   FilterImage();
 
-  /// Filter original unfiltered image into filtered pixmap
-  QPixmap filter (bool isGnuplot,
-                  const QImage &imageUnfiltered,
-                  const Transformation &transformation,
-                  const QString &curveSelected,
-                  const DocumentModelColorFilter &modelColorFilter,
-                  const DocumentModelGridRemoval &modelGridRemoval) const;
+  /// Filter original unfiltered image into filtered image
+  QImage filter (bool isGnuplot,
+                 const QImage &imageUnfiltered,
+                 const Transformation &transformation,
+                 const QString &curveSelected,
+                 const DocumentModelColorFilter &modelColorFilter,
+                 const DocumentModelGridRemoval &modelGridRemoval) const;
 };
 
 #endif // FILTER_IMAGE_H
@@ -7,8 +7,7 @@
 #include "DocumentModelCoords.h"
 #include "DocumentModelGeneral.h"
 #include "FormatCoordsUnits.h"
-#include "FormatCoordsUnitsStrategyNonPolarTheta.h"
-#include "FormatCoordsUnitsStrategyPolarTheta.h"
+#include "FormatPrecisionPlan.h"
 #include "Logger.h"
 #include "MainWindowModel.h"
 #include "Transformation.h"
@@ -27,32 +26,29 @@ void FormatCoordsUnits::formattedToUnformatted (const QString &xThetaFormatted,
                                                 double &xThetaUnformatted,
                                                 double &yRadiusUnformatted) const
 {
-  FormatCoordsUnitsStrategyNonPolarTheta formatNonPolarTheta;
-  FormatCoordsUnitsStrategyPolarTheta formatPolarTheta;
-
   if (modelCoords.coordsType() == COORDS_TYPE_CARTESIAN) {
 
-    xThetaUnformatted = formatNonPolarTheta.formattedToUnformatted (xThetaFormatted,
-                                                                    mainWindowModel.locale(),
-                                                                    modelCoords.coordUnitsX(),
-                                                                    modelCoords.coordUnitsDate(),
-                                                                    modelCoords.coordUnitsTime());
-    yRadiusUnformatted = formatNonPolarTheta.formattedToUnformatted (yRadiusFormatted,
-                                                                     mainWindowModel.locale(),
-                                                                     modelCoords.coordUnitsY(),
-                                                                     modelCoords.coordUnitsDate(),
-                                                                     modelCoords.coordUnitsTime());
+    xThetaUnformatted = m_formatNonPolarTheta.formattedToUnformatted (xThetaFormatted,
+                                                                      mainWindowModel.locale(),
+                                                                      modelCoords.coordUnitsX(),
+                                                                      modelCoords.coordUnitsDate(),
+                                                                      modelCoords.coordUnitsTime());
+    yRadiusUnformatted = m_formatNonPolarTheta.formattedToUnformatted (yRadiusFormatted,
+                                                                       mainWindowModel.locale(),
+                                                                       modelCoords.coordUnitsY(),
+                                                                       modelCoords.coordUnitsDate(),
+                                                                       modelCoords.coordUnitsTime());
 
   } else {
 
-    xThetaUnformatted = formatPolarTheta.formattedToUnformatted (xThetaFormatted,
-                                                                 mainWindowModel.locale(),
-                                                                 modelCoords.coordUnitsTheta());
-    yRadiusUnformatted = formatNonPolarTheta.formattedToUnformatted (yRadiusFormatted,
-                                                                     mainWindowModel.locale(),
-                                                                     modelCoords.coordUnitsRadius(),
-                                                                     modelCoords.coordUnitsDate(),
-                                                                     modelCoords.coordUnitsTime());
+    xThetaUnformatted = m_formatPolarTheta.formattedToUnformatted (xThetaFormatted,
+                                                                   mainWindowModel.locale(),
+                                                                   modelCoords.coordUnitsTheta());
+    yRadiusUnformatted = m_formatNonPolarTheta.formattedToUnformatted (yRadiusFormatted,
+                                                                       mainWindowModel.locale(),
+                                                                       modelCoords.coordUnitsRadius(),
+                                                                       modelCoords.coordUnitsDate(),
+                                                                       modelCoords.coordUnitsTime());
 
   }
 }
@@ -66,46 +62,59 @@ void FormatCoordsUnits::unformattedToFormatted (double xThetaUnformatted,
                                                 QString &yRadiusFormatted,
                                                 const Transformation &transformation) const
 {
-  FormatCoordsUnitsStrategyNonPolarTheta formatNonPolarTheta;
-  FormatCoordsUnitsStrategyPolarTheta formatPolarTheta;
+  FormatPrecisionPlan precisionPlan (modelGeneral,
+                                     transformation);
+
+  unformattedToFormatted (xThetaUnformatted,
+                          yRadiusUnformatted,
+                          modelCoords,
+                          mainWindowModel.locale(),
+                          precisionPlan,
+                          xThetaFormatted,
+                          yRadiusFormatted);
+}
 
+void FormatCoordsUnits::unformattedToFormatted (double xThetaUnformatted,
+                                                double yRadiusUnformatted,
+                                                const DocumentModelCoords &modelCoords,
+                                                const QLocale &locale,
+                                                const FormatPrecisionPlan &precisionPlan,
+                                                QString &xThetaFormatted,
+                                                QString &yRadiusFormatted) const
+{
   if (modelCoords.coordsType() == COORDS_TYPE_CARTESIAN) {
 
-    xThetaFormatted = formatNonPolarTheta.unformattedToFormatted (xThetaUnformatted,
-                                                                  mainWindowModel.locale(),
-                                                                  modelCoords.coordUnitsX(),
-                                                                  modelCoords.coordUnitsDate(),
-                                                                  modelCoords.coordUnitsTime(),
-                                                                  IS_X_THETA,
-                                                                  modelGeneral,
-                                                                  transformation,
-                                                                  yRadiusUnformatted);
-    yRadiusFormatted = formatNonPolarTheta.unformattedToFormatted (yRadiusUnformatted,
-                                                                   mainWindowModel.locale(),
-                                                                   modelCoords.coordUnitsY(),
-                                                                   modelCoords.coordUnitsDate(),
-                                                                   modelCoords.coordUnitsTime(),
-                                                                   IS_NOT_X_THETA,
-                                                                   modelGeneral,
-                                                                   transformation,
-                                                                   xThetaUnformatted);
-    
+    xThetaFormatted = m_formatNonPolarTheta.unformattedToFormatted (xThetaUnformatted,
+                                                                    locale,
+                                                                    modelCoords.coordUnitsX(),
+                                                                    modelCoords.coordUnitsDate(),
+                                                                    modelCoords.coordUnitsTime(),
+                                                                    IS_X_THETA,
+                                                                    precisionPlan,
+                                                                    yRadiusUnformatted);
+    yRadiusFormatted = m_formatNonPolarTheta.unformattedToFormatted (yRadiusUnformatted,
+                                                                     locale,
+                                                                     modelCoords.coordUnitsY(),
+                                                                     modelCoords.coordUnitsDate(),
+                                                                     modelCoords.coordUnitsTime(),
+                                                                     IS_NOT_X_THETA,
+                                                                     precisionPlan,
+                                                                     xThetaUnformatted);
+
   } else {
-    
-    xThetaFormatted = formatPolarTheta.unformattedToFormatted (xThetaUnformatted,
-                                                               mainWindowModel.locale(),
-                                                               modelCoords.coordUnitsTheta(),
-                                                               modelGeneral,
-                                                               transformation,
-                                                               yRadiusUnformatted);
-    yRadiusFormatted = formatNonPolarTheta.unformattedToFormatted (yRadiusUnformatted,
-                                                                   mainWindowModel.locale(),
-                                                                   modelCoords.coordUnitsRadius(),
-                                                                   modelCoords.coordUnitsDate(),
-                                                                   modelCoords.coordUnitsTime(),
-                                                                   IS_NOT_X_THETA,
-                                                                   modelGeneral,
-                                                                   transformation,
-                                                                   xThetaUnformatted);
+
+    xThetaFormatted = m_formatPolarTheta.unformattedToFormatted (xThetaUnformatted,
+                                                                 locale,
+                                                                 modelCoords.coordUnitsTheta(),
+                                                                 precisionPlan,
+                                                                 yRadiusUnformatted);
+    yRadiusFormatted = m_formatNonPolarTheta.unformattedToFormatted (yRadiusUnformatted,
+                                                                     locale,
+                                                                     modelCoords.coordUnitsRadius(),
+                                                                     modelCoords.coordUnitsDate(),
+                                                                     modelCoords.coordUnitsTime(),
+                                                                     IS_NOT_X_THETA,
+                                                                     precisionPlan,
+                                                                     xThetaUnformatted);
   }
 }
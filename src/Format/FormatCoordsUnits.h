@@ -7,13 +7,19 @@
 #ifndef FORMAT_COORDS_UNITS_H
 #define FORMAT_COORDS_UNITS_H
 
+#include "FormatCoordsUnitsStrategyNonPolarTheta.h"
+#include "FormatCoordsUnitsStrategyPolarTheta.h"
+
 class DocumentModelCoords;
 class DocumentModelGeneral;
+class FormatPrecisionPlan;
 class MainWindowModel;
+class QLocale;
 class QString;
 class Transformation;
 
-/// Highest-level wrapper around other Formats classes
+/// Highest-level wrapper around other Formats classes. When many values are formatted, as during export, the caller
+/// sets up the locale and FormatPrecisionPlan once and uses the unformattedToFormatted overload that accepts them
 class FormatCoordsUnits {
  public:
   /// Single constructor
@@ -36,6 +42,21 @@ class FormatCoordsUnits {
                                QString &xThetaFormatted,
                                QString &yRadiusFormatted,
                                const Transformation &transformation) const;
+
+  /// Convert unformatted numeric value to formatted string, using a locale and precision plan that were computed once
+  /// for many values
+  void unformattedToFormatted (double xThetaUnformatted,
+                               double yRadiusUnformatted,
+                               const DocumentModelCoords &modelCoords,
+                               const QLocale &locale,
+                               const FormatPrecisionPlan &precisionPlan,
+                               QString &xThetaFormatted,
+                               QString &yRadiusFormatted) const;
+
+ private:
+
+  FormatCoordsUnitsStrategyNonPolarTheta m_formatNonPolarTheta;
+  FormatCoordsUnitsStrategyPolarTheta m_formatPolarTheta;
 };
 
 #endif // FORMAT_COORDS_UNITS_H
@@ -4,14 +4,13 @@
  * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
  ******************************************************************************************************/
 
-#include "DocumentModelGeneral.h"
 #include "EngaugeAssert.h"
 #include "FormatCoordsUnitsStrategyNonPolarTheta.h"
 #include "FormatDateTime.h"
 #include "FormatDegreesMinutesSecondsNonPolarTheta.h"
+#include "FormatPrecisionPlan.h"
 #include "Logger.h"
 #include <QLocale>
-#include "Transformation.h"
 
 FormatCoordsUnitsStrategyNonPolarTheta::FormatCoordsUnitsStrategyNonPolarTheta ()
 {
@@ -63,8 +62,7 @@ QString FormatCoordsUnitsStrategyNonPolarTheta::unformattedToFormatted (double v
                                                                         CoordUnitsDate coordUnitsDate,
                                                                         CoordUnitsTime coordUnitsTime,
                                                                         bool isXTheta,
-                                                                        const DocumentModelGeneral &modelGeneral,
-                                                                        const Transformation &transformation,
+                                                                        const FormatPrecisionPlan &precisionPlan,
                                                                         double valueUnformattedOther) const
 {
   const char FORMAT ('g');
@@ -94,11 +92,9 @@ QString FormatCoordsUnitsStrategyNonPolarTheta::unformattedToFormatted (double v
     case COORD_UNITS_NON_POLAR_THETA_NUMBER:
       valueFormatted = locale.toString (valueUnformatted,
                                         FORMAT,
-                                        precisionDigitsForRawNumber (valueUnformatted,
-                                                                     valueUnformattedOther,
-                                                                     isXTheta,
-                                                                     modelGeneral,
-                                                                     transformation));
+                                        precisionPlan.precisionDigitsForRawNumber (valueUnformatted,
+                                                                                   valueUnformattedOther,
+                                                                                   isXTheta));
       break;
 
     default:
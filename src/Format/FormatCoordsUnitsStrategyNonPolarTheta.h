@@ -13,9 +13,8 @@
 #include "FormatCoordsUnitsStrategyAbstractBase.h"
 #include <QString>
 
-class DocumentModelGeneral;
+class FormatPrecisionPlan;
 class QLocale;
-class Transformation;
 
 /// Format conversions between unformatted and formatted for CoordUnitsNonPolarTheta
 class FormatCoordsUnitsStrategyNonPolarTheta : public FormatCoordsUnitsStrategyAbstractBase
@@ -38,8 +37,7 @@ class FormatCoordsUnitsStrategyNonPolarTheta : public FormatCoordsUnitsStrategyA
                                   CoordUnitsDate coordUnitsDate,
                                   CoordUnitsTime coordUnitsTime,
                                   bool isXTheta,
-                                  const DocumentModelGeneral &modelGeneral,
-                                  const Transformation &transformation,
+                                  const FormatPrecisionPlan &precisionPlan,
                                   double valueUnformattedOther) const;
 
 };
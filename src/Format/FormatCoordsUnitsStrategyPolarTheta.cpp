@@ -4,10 +4,10 @@
  * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
  ******************************************************************************************************/
 
-#include "DocumentModelGeneral.h"
 #include "EngaugeAssert.h"
 #include "FormatCoordsUnitsStrategyPolarTheta.h"
 #include "FormatDegreesMinutesSecondsPolarTheta.h"
+#include "FormatPrecisionPlan.h"
 #include "Logger.h"
 #include <QLocale>
 
@@ -50,8 +50,7 @@ double FormatCoordsUnitsStrategyPolarTheta::formattedToUnformatted (const QStrin
 QString FormatCoordsUnitsStrategyPolarTheta::unformattedToFormatted (double valueUnformatted,
                                                                      const QLocale &locale,
                                                                      CoordUnitsPolarTheta coordUnits,
-                                                                     const DocumentModelGeneral &modelGeneral,
-                                                                     const Transformation &transformation,
+                                                                     const FormatPrecisionPlan &precisionPlan,
                                                                      double valueUnformattedOther) const
 {
   const char FORMAT ('g');
@@ -77,11 +76,9 @@ QString FormatCoordsUnitsStrategyPolarTheta::unformattedToFormatted (double valu
     case COORD_UNITS_POLAR_THETA_TURNS:
       valueFormatted = locale.toString (valueUnformatted,
                                         FORMAT,
-                                        precisionDigitsForRawNumber (valueUnformatted,
-                                                                     valueUnformattedOther,
-                                                                     IS_X_THETA,
-                                                                     modelGeneral,
-                                                                     transformation));
+                                        precisionPlan.precisionDigitsForRawNumber (valueUnformatted,
+                                                                                   valueUnformattedOther,
+                                                                                   IS_X_THETA));
       break;
 
     default:
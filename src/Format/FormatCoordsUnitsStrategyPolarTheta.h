@@ -8,12 +8,11 @@
 #define FORMAT_COORDS_UNITS_STRATEGY_POLAR_THETA_H
 
 #include "CoordUnitsPolarTheta.h"
-#include "DocumentModelGeneral.h"
 #include "FormatCoordsUnitsStrategyAbstractBase.h"
 #include <QString>
 
+class FormatPrecisionPlan;
 class QLocale;
-class Transformation;
 
 /// Format conversions between unformatted and formatted for CoordUnitsStrategyPolarTheta
 class FormatCoordsUnitsStrategyPolarTheta : public FormatCoordsUnitsStrategyAbstractBase {
@@ -30,8 +29,7 @@ class FormatCoordsUnitsStrategyPolarTheta : public FormatCoordsUnitsStrategyAbst
   QString unformattedToFormatted (double valueUnformatted,
                                   const QLocale &locale,
                                   CoordUnitsPolarTheta coordUnits,
-                                  const DocumentModelGeneral &modelGeneral,
-                                  const Transformation &transformation,
+                                  const FormatPrecisionPlan &precisionPlan,
                                   double valueUnformattedOther) const;
 };
 
@@ -15,7 +15,6 @@ FormatDateTime::FormatDateTime()
 {
   loadFormatsFormat();
   loadFormatsParseAcceptable();
-  loadFormatsParseIncomplete();
 }
 
 bool FormatDateTime::ambiguityBetweenDateAndTime (CoordUnitsDate coordUnitsDate,
@@ -43,73 +42,19 @@ bool FormatDateTime::ambiguityBetweenDateAndTime (CoordUnitsDate coordUnitsDate,
   return ambiguous;
 }
 
-void FormatDateTime::dateTimeLookup (const FormatsDate &formatsDateAll,
-                                     const FormatsTime &formatsTimeAll,
-                                     CoordUnitsDate coordUnitsDate,
-                                     CoordUnitsTime coordUnitsTime,
-                                     const QString &string,
-                                     bool useQDateTimeElseQRegExp,
-                                     double &value,
-                                     bool &success) const
+QList<FormatDateTimeMatcher> FormatDateTime::compileMatchers () const
 {
+  QList<FormatDateTimeMatcher> matchers;
 
-  success = false;
+  for (int date = 0; date < NUM_COORD_UNITS_DATE; date++) {
+    for (int time = 0; time < NUM_COORD_UNITS_TIME; time++) {
 
-  ENGAUGE_ASSERT (formatsDateAll.contains (coordUnitsDate));
-  ENGAUGE_ASSERT (formatsTimeAll.contains (coordUnitsTime));
-
-  QStringList formatsDate = formatsDateAll [coordUnitsDate];
-  QStringList formatsTime = formatsTimeAll [coordUnitsTime];
-
-  // Loop through the legal date/time combinations
-  QStringList::const_iterator itrDate, itrTime;
-  bool iterating = true;
-  for (itrDate = formatsDate.begin(); itrDate != formatsDate.end() && iterating; itrDate++) {
-
-    QString formatDate = *itrDate;
-
-    for (itrTime = formatsTime.begin(); itrTime != formatsTime.end() && iterating; itrTime++) {
-
-      QString formatTime = *itrTime;
-
-      // Insert space as separator only if needed. Do not use trim around here since formatDate may or may not end in a space
-      QString separator = (!formatDate.isEmpty() && !formatTime.isEmpty() ? " " : "");
-
-      QString formatDateTime = formatDate + separator + formatTime;
-
-      if (!formatDateTime.isEmpty()) {
-
-        // Try parsing according to the current format
-        if (useQDateTimeElseQRegExp) {
-
-          QDateTime dt = QDateTime::fromString (string,
-                                                formatDateTime);
-
-          if (dt.isValid() && !ambiguityBetweenDateAndTime (coordUnitsDate,
-                                                            coordUnitsTime,
-                                                            string)) {
-
-            success = true;
-            // Convert using local time to prevent addition of utc offset. Number of seconds since 1970 epoch
-            // is used with 64 bits resolution, versus time_t with only 32 bits resolution (and limites to 1970 to 2038).
-            // Time value is negative for pre-epoch. Grep for fromSecsSinceEpoch in this same file
-            value = toSecsSinceEpoch (dt.toLocalTime ());
-            iterating = false; // Stop iterating
-
-          }
-        } else {
-
-          QRegularExpression reg (formatDateTime);
-          if (reg.match(string).hasMatch()) {
-
-            success = true; // Note that value does not get set in QRegExp case
-            iterating = false; // Stop iterating
-
-          }
-        }
-      }
+      matchers.append (FormatDateTimeMatcher (formatsParseAcceptable (static_cast<CoordUnitsDate> (date),
+                                                                      static_cast<CoordUnitsTime> (time))));
     }
   }
+
+  return matchers;
 }
 
 QString FormatDateTime::formatOutput (CoordUnitsDate coordUnitsDate,
@@ -131,6 +76,40 @@ QString FormatDateTime::formatOutput (CoordUnitsDate coordUnitsDate,
   return dt.toLocalTime ().toString (format); // Convert using local time to prevent addition of utc offset
 }
 
+QStringList FormatDateTime::formatsParseAcceptable (CoordUnitsDate coordUnitsDate,
+                                                    CoordUnitsTime coordUnitsTime) const
+{
+  ENGAUGE_ASSERT (m_formatsDateParseAcceptable.contains (coordUnitsDate));
+  ENGAUGE_ASSERT (m_formatsTimeParseAcceptable.contains (coordUnitsTime));
+
+  QStringList formatsDate = m_formatsDateParseAcceptable [coordUnitsDate];
+  QStringList formatsTime = m_formatsTimeParseAcceptable [coordUnitsTime];
+
+  QStringList formatsDateTime;
+
+  QStringList::const_iterator itrDate, itrTime;
+  for (itrDate = formatsDate.begin(); itrDate != formatsDate.end(); itrDate++) {
+
+    QString formatDate = *itrDate;
+
+    for (itrTime = formatsTime.begin(); itrTime != formatsTime.end(); itrTime++) {
+
+      QString formatTime = *itrTime;
+
+      // Insert space as separator only if needed. Do not use trim around here since formatDate may or may not end in a space
+      QString separator = (!formatDate.isEmpty() && !formatTime.isEmpty() ? " " : "");
+
+      QString formatDateTime = formatDate + separator + formatTime;
+
+      if (!formatDateTime.isEmpty()) {
+        formatsDateTime << formatDateTime;
+      }
+    }
+  }
+
+  return formatsDateTime;
+}
+
 QDateTime FormatDateTime::fromSecsSinceEpoch (qint64 secs) const
 {
   return QDateTime::fromMSecsSinceEpoch (secs * 1000);
@@ -307,117 +286,14 @@ void FormatDateTime::loadFormatsParseAcceptable()
   ENGAUGE_ASSERT (m_formatsTimeParseAcceptable.count () == NUM_COORD_UNITS_TIME);
 }
 
-void FormatDateTime::loadFormatsParseIncomplete()
+const FormatDateTimeMatcher &FormatDateTime::matcher (CoordUnitsDate coordUnitsDate,
+                                                      CoordUnitsTime coordUnitsTime) const
 {
+  // The formats are the same for every instance, so they are compiled once on first use and then shared. A
+  // function static is initialized safely even when several threads get here together
+  static const QList<FormatDateTimeMatcher> matchers = compileMatchers ();
 
-  QStringList skip, day, dayMonth, dayMonthYear, month, monthDay, monthDayYear, year, yearMonth, yearMonthDay;
-
-  // COORD_UNITS_DATE_SKIP and COORD_UNITS_TIME_SKIP allow date/time respectively even when skipped,
-  // although there can be ambiguity with between COORD_UNITS_DATE_MONTH_DAY_YEAR and COORD_UNITS_DATE_DAY_MONTH_YEAR
-  skip << "";
-
-  // IMPORTANT! Be sure to include complete date values since the date, which goes before the time, will be
-  //            complete when the time is getting
-  day << "\\d{1,2}"
-      << "\\d{1,2}/"
-      << "\\d{1,2}-";
-  dayMonth << "\\d{1,2}/\\d{1,2}"
-           << "\\d{1,2}/\\d{1,2} "
-           << "\\d{1,2}/\\d{1,2}/"
-           << "\\d{1,2}-\\d{1,2}-"
-           << "\\d{1,2}/[a-zA-Z]{1,12}/"
-           << "\\d{1,2}-[a-zA-Z]{1,12}-"
-           << "\\d{1,2} [a-zA-Z]{1,12} ";
-  dayMonthYear << "\\d{1,2}/\\d{1,2}/\\d{1,4}"
-               << "\\d{1,2}/\\d{1,2}/\\d{1,4} "
-               << "\\d{1,2}-\\d{1,2}-\\d{1,4}"
-               << "\\d{1,2}-\\d{1,2}-\\d{1,4} ";
-  month << "\\d{1,2}"
-        << "\\d{1,2}/"
-        << "[a-zA-Z]{1,12}"
-        << "[a-zA-Z]{1,12} ";
-  monthDay << "\\d{1,2}/\\d{1,2}"
-           << "\\d{1,2}/\\d{1,2} "
-           << "\\d{1,2}/\\d{1,2}/"
-           << "\\d{1,2} \\d{1,2}"
-           << "\\d{1,2} \\d{1,2} "
-           << "\\d{1,2}-\\d{1,2}-"
-           << "[a-zA-Z]{1,12}"
-           << "[a-zA-Z]{1,12} "
-           << "[a-zA-Z]{1,12} \\d{1,2}"
-           << "[a-zA-Z]{1,12} \\d{1,2} ";
-  monthDayYear << "\\d{1,2}/\\d{1,2}/\\d{1,4}"
-               << "\\d{1,2}/\\d{1,2}/\\d{1,4} "
-               << "\\d{1,2}-\\d{1,2}-\\d{1,4}"
-               << "\\d{1,2}-\\d{1,2}-\\d{1,4} "
-               << "\\d{1,2} \\d{1,2} \\d{1,4}"
-               << "\\d{1,2} \\d{1,2} \\d{1,4} ";
-  year << "\\d{1,4}"
-       << "\\d{1,4} "
-       << "\\d{1,4}/"
-       << "\\d{1,4}-";
-  yearMonth << "\\d{4}/\\d{1,2}"
-            << "\\d{4}/\\d{1,2} "
-            << "\\d{4}/\\d{1,2}/"
-            << "\\d{4}-\\d{1,2}"
-            << "\\d{4}-\\d{1,2} "
-            << "\\d{4}-\\d{1,2}-"
-            << "\\d{4} \\d{1,2}"
-            << "\\d{4} \\d{1,2} "
-            << "\\d{4}/[a-zA-Z]{1,12}"
-            << "\\d{4}/[a-zA-Z]{1,12} "
-            << "\\d{4}/[a-zA-Z]{1,12}/"
-            << "\\d{4}-[a-zA-Z]{1,12}"
-            << "\\d{4}-[a-zA-Z]{1,12} "
-            << "\\d{4}-[a-zA-Z]{1,12}-"
-            << "\\d{4} [a-zA-Z]{1,12}"
-            << "\\d{4} [a-zA-Z]{1,12} ";
-  yearMonthDay << "\\d{4}/\\d{1,2}/\\d{1,2}"
-               << "\\d{4}/\\d{1,2}/\\d{1,2} "    
-               << "\\d{4}/\\d{1,2}-\\d{1,2}"
-               << "\\d{4}/\\d{1,2}-\\d{1,2} "    
-               << "\\d{4} \\d{1,2} \\d{1,2}"
-               << "\\d{4}/[a-zA-Z]{1,12}/\\d{1,2}"
-               << "\\d{4}/[a-zA-Z]{1,12}/\\d{1,2} "    
-               << "\\d{4}-[a-zA-Z]{1,12}-\\d{1,2}"
-               << "\\d{4}-[a-zA-Z]{1,12}-\\d{1,2} ";    
-
-  // For every entry, the possible states leading up to the Acceptable states in m_formatsDateParseIncomplete are all included.
-  // Potential day-month ambiguity for COORD_UNITS_DATE_SKIP gets treated as month/day.
-  m_formatsDateParseIncomplete [COORD_UNITS_DATE_SKIP] = skip + month + monthDay + monthDayYear + year + yearMonth + yearMonthDay;
-  m_formatsDateParseIncomplete [COORD_UNITS_DATE_MONTH_DAY_YEAR] = skip + month + monthDay + monthDayYear + year + yearMonth + yearMonthDay;
-  m_formatsDateParseIncomplete [COORD_UNITS_DATE_DAY_MONTH_YEAR] = skip + day + dayMonth + dayMonthYear + year + yearMonth + yearMonthDay;
-  m_formatsDateParseIncomplete [COORD_UNITS_DATE_YEAR_MONTH_DAY] = skip + year + yearMonth + yearMonthDay;
-
-  ENGAUGE_ASSERT (m_formatsDateParseIncomplete.count () == NUM_COORD_UNITS_DATE);
-
-  QStringList hour, hourMinute, hourMinuteAmPm, hourMinuteSecond,  hourMinuteSecondAmPm;
-
-  hour << "\\d{1,2}"
-       << "\\d{1,2}:";
-  hourMinute << "\\d{1,2}:\\d{1,2}"
-             << "\\d{1,2}:\\d{1,2}:"
-             << "\\d{1,2}:\\d{1,2} ";
-  hourMinuteAmPm << "\\d{1,2}:\\d{1,2} [aApP]";
-  hourMinuteSecond << "\\d{1,2}:\\d{1,2}:\\d{1,2}"
-                   << "\\d{1,2}:\\d{1,2}:\\d{1,2} ";
-  hourMinuteSecondAmPm << "\\d{1,2}:\\d{1,2}:\\d{1,2} [aApP]";
-
-  // For every entry, the possible states leading up to the Acceptable states in m_formatsTimeParseIncomplete are all included.
-  m_formatsTimeParseIncomplete [COORD_UNITS_TIME_SKIP] = skip +
-                                                         hour +
-                                                         hourMinute + hourMinuteAmPm +
-                                                         hourMinuteSecond + hourMinuteSecondAmPm;
-  m_formatsTimeParseIncomplete [COORD_UNITS_TIME_HOUR_MINUTE] = skip +
-                                                                hour +
-                                                                hourMinute + hourMinuteAmPm +
-                                                                hourMinuteSecond + hourMinuteSecondAmPm;
-  m_formatsTimeParseIncomplete [COORD_UNITS_TIME_HOUR_MINUTE_SECOND] = skip +
-                                                                       hour +
-                                                                       hourMinute + hourMinuteAmPm +
-                                                                       hourMinuteSecond + hourMinuteSecondAmPm;
-
-  ENGAUGE_ASSERT (m_formatsTimeParseIncomplete.count () == NUM_COORD_UNITS_TIME);
+  return matchers.at (coordUnitsDate * NUM_COORD_UNITS_TIME + coordUnitsTime);
 }
 
 QValidator::State FormatDateTime::parseInput (CoordUnitsDate coordUnitsDate,
@@ -425,8 +301,6 @@ QValidator::State FormatDateTime::parseInput (CoordUnitsDate coordUnitsDate,
                                               const QString &stringUntrimmed,
                                               double &value) const
 {
-  const bool USE_QREGEXP = true, DO_NOT_USE_QREGEXP = false;
-
   const QString string = stringUntrimmed.trimmed();
 
   QValidator::State state;
@@ -438,37 +312,38 @@ QValidator::State FormatDateTime::parseInput (CoordUnitsDate coordUnitsDate,
 
     state = QValidator::Invalid;
 
-    // First see if value is acceptable
-    bool success = false;
-    dateTimeLookup (m_formatsDateParseAcceptable,
-                    m_formatsTimeParseAcceptable,
-                    coordUnitsDate,
-                    coordUnitsTime,
-                    string,
-                    USE_QREGEXP,
-                    value,
-                    success);
-    if (success) {
-      
-      state = QValidator::Acceptable;
-      
-    } else {
-      
-      // Not acceptable, but perhaps it is just incomplete
-      dateTimeLookup (m_formatsDateParseIncomplete,
-                      m_formatsTimeParseIncomplete,
-                      coordUnitsDate,
-                      coordUnitsTime,
-                      string,
-                      DO_NOT_USE_QREGEXP,
-                      value,
-                      success);
-      if (success) {
-        
-        state = QValidator::Intermediate;
-        
+    // One pass over the string finds the few formats with the same shape, and only those are tried by QDateTime
+    bool isPrefix = false;
+    QStringList formats = matcher (coordUnitsDate,
+                                   coordUnitsTime).formatsFittingString (string,
+                                                                         isPrefix);
+
+    QStringList::const_iterator itr;
+    for (itr = formats.begin(); itr != formats.end(); itr++) {
+
+      QDateTime dt = QDateTime::fromString (string,
+                                            *itr);
+
+      if (dt.isValid() && !ambiguityBetweenDateAndTime (coordUnitsDate,
+                                                        coordUnitsTime,
+                                                        string)) {
+
+        state = QValidator::Acceptable;
+        // Convert using local time to prevent addition of utc offset. Number of seconds since 1970 epoch
+        // is used with 64 bits resolution, versus time_t with only 32 bits resolution (and limites to 1970 to 2038).
+        // Time value is negative for pre-epoch. Grep for fromSecsSinceEpoch in this same file
+        value = toSecsSinceEpoch (dt.toLocalTime ());
+        break;
+
       }
     }
+
+    if (state != QValidator::Acceptable && isPrefix) {
+
+      // Not acceptable, but it is the start of at least one format so it is perhaps just incomplete
+      state = QValidator::Intermediate;
+
+    }
   }
 
   return state;
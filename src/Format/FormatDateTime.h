@@ -9,8 +9,10 @@
 
 #include "CoordUnitsDate.h"
 #include "CoordUnitsTime.h"
+#include "FormatDateTimeMatcher.h"
 #include <QDateTime>
 #include <QHash>
+#include <QList>
 #include <QString>
 #include <QStringList>
 #include <QValidator>
@@ -44,33 +46,26 @@ class FormatDateTime {
   bool ambiguityBetweenDateAndTime (CoordUnitsDate coordUnitsDate,
                                     CoordUnitsTime coordUnitsTime,
                                     const QString &string) const;
-  void dateTimeLookup (const FormatsDate &formatsDate,
-                       const FormatsTime &formatsTime,
-                       CoordUnitsDate coordUnitsDate,
-                       CoordUnitsTime coordUnitsTime,
-                       const QString &string,
-                       bool useQDateTimeElseQRegExp,
-                       double &value, // Set only if useQDateTimeElseQRegExp=success=true
-                       bool &success) const;
+  QList<FormatDateTimeMatcher> compileMatchers () const; // One matcher for each date and time units combination
+  QStringList formatsParseAcceptable (CoordUnitsDate coordUnitsDate,
+                                      CoordUnitsTime coordUnitsTime) const; // Legal date/time combinations
   QDateTime fromSecsSinceEpoch (qint64 secs) const; // Emulate QDateTime::fromSecsSinceEpoch in Qt 5.8
   void loadFormatsFormat();
   void loadFormatsParseAcceptable();
-  void loadFormatsParseIncomplete();
+  const FormatDateTimeMatcher &matcher (CoordUnitsDate coordUnitsDate,
+                                        CoordUnitsTime coordUnitsTime) const;
   qint64 toSecsSinceEpoch(const QDateTime &dt) const; // Emulate QDateTime::toSecsSinceEpoch in Qt 5.8
 
   // For formatting output
   FormatDate m_formatsDateFormat;
   FormatTime m_formatsTimeFormat;
 
-  // For parsing input, using built in Qt date/time parsing according to QDateTime
+  // For parsing input, using built in Qt date/time parsing according to QDateTime. These are compiled into a
+  // FormatDateTimeMatcher for each combination, which also finds Intermediate strings since Qt date/time parsing of
+  // those does not work. Example, 'J' and 'Ja' would be rejected although they are typed in the process of entering
+  // 'Jan' for the month
   FormatsDate m_formatsDateParseAcceptable;
   FormatsTime m_formatsTimeParseAcceptable;
-
-  // For parsing input, after input has been found to not be Acceptable. Regular expressions are used since Qt date/time
-  // parsing of Intermediate strings does not work. Example, 'J' and 'Ja' would be rejected although they are typed
-  // in the process of entering 'Jan' for the month
-  FormatsDate m_formatsDateParseIncomplete;
-  FormatsTime m_formatsTimeParseIncomplete;
 };
 
 #endif // FORMAT_DATE_TIME_H
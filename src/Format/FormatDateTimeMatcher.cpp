@@ -0,0 +1,292 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#include <algorithm>
+#include "FormatDateTimeMatcher.h"
+#include <QChar>
+#include <QMap>
+
+// Tokens read from the input. Separators are not listed since each separator character is its own token, with code
+// SEPARATOR_OFFSET plus the character. Runs of whitespace are read as a single space
+const int TOKEN_NUMBER_SHORT = 0; // One or two digits
+const int TOKEN_NUMBER_LONG = 1; // Three or four digits
+const int TOKEN_NUMBER_TOO_LONG = 2; // More than four digits, which no element accepts
+const int TOKEN_WORD = 3; // Letters, with periods for abbreviations
+
+// Elements of the formats. Separators use the same codes as the separator tokens
+const int ELEMENT_NUMBER = 0; // Day, month, hour, minute or second number
+const int ELEMENT_YEAR = 1; // Year number, which is also accepted while it is partially typed
+const int ELEMENT_WORD = 2; // Month name, or AM/PM
+
+const int SEPARATOR_OFFSET = 0x100;
+
+FormatDateTimeMatcher::FormatDateTimeMatcher(const QStringList &formats) :
+  m_formats (formats)
+{
+  // Trie of the element sequences, where node 0 is the root. Each node has its outgoing edges, keyed by element,
+  // and the formats that end at that node
+  QVector<QHash<int, int> > trieEdges (1);
+  QVector<QList<int> > trieFormats (1);
+
+  // Every token that some format can read, so the DFA only has transitions for those
+  QList<int> tokens;
+  tokens << TOKEN_NUMBER_SHORT
+         << TOKEN_NUMBER_LONG
+         << TOKEN_WORD;
+
+  for (int index = 0; index < formats.count(); index++) {
+
+    int node = 0;
+    QList<int> elements = elementsInFormat (formats.at (index));
+    QList<int>::const_iterator itr;
+    for (itr = elements.begin(); itr != elements.end(); itr++) {
+
+      int element = *itr;
+
+      if (!trieEdges [node].contains (element)) {
+        trieEdges.append (QHash<int, int> ());
+        trieFormats.append (QList<int> ());
+        trieEdges [node] [element] = trieEdges.count() - 1;
+      }
+      node = trieEdges [node] [element];
+
+      if (element >= SEPARATOR_OFFSET &&
+          !tokens.contains (element)) {
+        tokens << element;
+      }
+    }
+
+    trieFormats [node].append (index);
+  }
+
+  compileStates (trieEdges,
+                 trieFormats,
+                 tokens);
+}
+
+void FormatDateTimeMatcher::compileStates (const QVector<QHash<int, int> > &trieEdges,
+                                           const QVector<QList<int> > &trieFormats,
+                                           const QList<int> &tokens)
+{
+  // Each DFA state is identified by its sorted set of trie nodes
+  QMap<QVector<int>, int> stateForNodes;
+  QVector<QVector<int> > nodesForState;
+
+  QVector<int> nodesStart (1, 0);
+  stateForNodes [nodesStart] = 0;
+  nodesForState.append (nodesStart);
+
+  // States are appended as they are found, so this loop ends after the last new state has been followed
+  for (int state = 0; state < nodesForState.count(); state++) {
+
+    m_transitions.append (QHash<int, int> ());
+
+    QVector<int> nodes = nodesForState.at (state);
+
+    // Formats ending at this state. The nodes are sorted and each format ends at one node, so sorting the
+    // indexes restores the order of the format list
+    QList<int> formatIndexes;
+    QVector<int>::const_iterator itrNode;
+    for (itrNode = nodes.begin(); itrNode != nodes.end(); itrNode++) {
+      formatIndexes += trieFormats.at (*itrNode);
+    }
+    std::sort (formatIndexes.begin(),
+               formatIndexes.end());
+    m_formatIndexes.append (formatIndexes);
+
+    QList<int>::const_iterator itrToken;
+    for (itrToken = tokens.begin(); itrToken != tokens.end(); itrToken++) {
+
+      int token = *itrToken;
+
+      // Trie nodes reached by reading this token from any node of this state
+      QVector<int> nodesNext;
+      QList<int> elements = elementsForToken (token);
+      for (itrNode = nodes.begin(); itrNode != nodes.end(); itrNode++) {
+        QList<int>::const_iterator itrElement;
+        for (itrElement = elements.begin(); itrElement != elements.end(); itrElement++) {
+          if (trieEdges.at (*itrNode).contains (*itrElement)) {
+            nodesNext.append (trieEdges.at (*itrNode).value (*itrElement));
+          }
+        }
+      }
+
+      if (!nodesNext.isEmpty ()) {
+
+        std::sort (nodesNext.begin(),
+                   nodesNext.end());
+        nodesNext.erase (std::unique (nodesNext.begin(),
+                                      nodesNext.end()),
+                         nodesNext.end());
+
+        if (!stateForNodes.contains (nodesNext)) {
+          stateForNodes [nodesNext] = nodesForState.count();
+          nodesForState.append (nodesNext);
+        }
+
+        m_transitions [state] [token] = stateForNodes.value (nodesNext);
+      }
+    }
+  }
+}
+
+QList<int> FormatDateTimeMatcher::elementsForToken (int token) const
+{
+  QList<int> elements;
+
+  if (token == TOKEN_NUMBER_SHORT) {
+    elements << ELEMENT_NUMBER
+             << ELEMENT_YEAR;
+  } else if (token == TOKEN_NUMBER_LONG) {
+    elements << ELEMENT_YEAR;
+  } else if (token == TOKEN_WORD) {
+    elements << ELEMENT_WORD;
+  } else if (token >= SEPARATOR_OFFSET) {
+    elements << token;
+  }
+
+  return elements;
+}
+
+QList<int> FormatDateTimeMatcher::elementsInFormat (const QString &format) const
+{
+  QList<int> elements;
+
+  int pos = 0;
+  while (pos < format.length()) {
+
+    QChar ch = format.at (pos);
+
+    // Length of the run of this character, since QDateTime format fields are runs like 'dd' and 'MMMM'
+    int count = 1;
+    while (pos + count < format.length() &&
+           format.at (pos + count) == ch) {
+      ++count;
+    }
+
+    if (ch == 'd' || ch == 'M') {
+
+      // Numbers for up to two characters, and names (day of week or month) for longer runs
+      elements << (count <= 2 ? ELEMENT_NUMBER : ELEMENT_WORD);
+
+    } else if (ch == 'h' || ch == 'H' || ch == 'm' || ch == 's') {
+
+      elements << ELEMENT_NUMBER;
+
+    } else if (ch == 'y' || ch == 'z') {
+
+      elements << ELEMENT_YEAR;
+
+    } else if (ch == 'A' || ch == 'a') {
+
+      // AM/PM, which is written as 'A', 'a', 'AP' or 'ap'
+      elements << ELEMENT_WORD;
+      if (count == 1 &&
+          pos + 1 < format.length() &&
+          format.at (pos + 1).toLower() == 'p') {
+        ++count;
+      }
+
+    } else if (ch.isSpace ()) {
+
+      while (pos + count < format.length() &&
+             format.at (pos + count).isSpace ()) {
+        ++count;
+      }
+      elements << SEPARATOR_OFFSET + ' ';
+
+    } else {
+
+      // Every other character is a literal separator, so each character of the run is one element
+      for (int i = 0; i < count; i++) {
+        elements << SEPARATOR_OFFSET + ch.unicode ();
+      }
+
+    }
+
+    pos += count;
+  }
+
+  return elements;
+}
+
+QStringList FormatDateTimeMatcher::formatsFittingString (const QString &string,
+                                                         bool &isPrefix) const
+{
+  QStringList formats;
+
+  int state = 0;
+  int pos = 0;
+  while (pos < string.length()) {
+
+    int token = nextToken (string,
+                           pos);
+
+    if (!m_transitions.at (state).contains (token)) {
+
+      // No format starts with these tokens
+      isPrefix = false;
+      return formats;
+    }
+
+    state = m_transitions.at (state).value (token);
+  }
+
+  isPrefix = true;
+
+  QList<int>::const_iterator itr;
+  for (itr = m_formatIndexes.at (state).begin(); itr != m_formatIndexes.at (state).end(); itr++) {
+    formats << m_formats.at (*itr);
+  }
+
+  return formats;
+}
+
+int FormatDateTimeMatcher::nextToken (const QString &string,
+                                      int &pos) const
+{
+  QChar ch = string.at (pos++);
+
+  if (ch.isDigit ()) {
+
+    int count = 1;
+    while (pos < string.length() &&
+           string.at (pos).isDigit ()) {
+      ++count;
+      ++pos;
+    }
+
+    if (count <= 2) {
+      return TOKEN_NUMBER_SHORT;
+    } else if (count <= 4) {
+      return TOKEN_NUMBER_LONG;
+    } else {
+      return TOKEN_NUMBER_TOO_LONG;
+    }
+
+  } else if (ch.isLetter () || ch == '.') {
+
+    // Localized month names and AM/PM text may be abbreviated with periods
+    while (pos < string.length() &&
+           (string.at (pos).isLetter () || string.at (pos) == '.')) {
+      ++pos;
+    }
+
+    return TOKEN_WORD;
+
+  } else if (ch.isSpace ()) {
+
+    while (pos < string.length() &&
+           string.at (pos).isSpace ()) {
+      ++pos;
+    }
+
+    return SEPARATOR_OFFSET + ' ';
+
+  }
+
+  return SEPARATOR_OFFSET + ch.unicode ();
+}
@@ -0,0 +1,65 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef FORMAT_DATE_TIME_MATCHER_H
+#define FORMAT_DATE_TIME_MATCHER_H
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/// Matcher compiled from a list of QDateTime format strings, for parsing input without trying every format. Input is
+/// read as a sequence of tokens (short numbers, long numbers, words like month names, and separators), and the
+/// formats are compiled into a DFA over those tokens. One pass over the input then gives:
+/// -# whether the input is the start of at least one format, which means it could become acceptable as typing
+///    continues
+/// -# the few formats whose tokens fit the whole input. Only these need to be checked by QDateTime, which does the
+///    final check on the field values
+///
+/// The token shapes are looser than QDateTime (for example any one or two digits fit a month) so no input that
+/// QDateTime would accept is ever filtered out
+class FormatDateTimeMatcher
+{
+public:
+  /// Compile the formats, which use the QDateTime format syntax
+  FormatDateTimeMatcher(const QStringList &formats);
+
+  /// Return the formats whose tokens fit the whole string, in the order they were compiled. Flag isPrefix is true
+  /// if the string is the start of at least one format, which is always true when any format fits
+  QStringList formatsFittingString (const QString &string,
+                                    bool &isPrefix) const;
+
+private:
+  FormatDateTimeMatcher();
+
+  // Build the DFA from the trie of element sequences, by following every set of trie nodes that can be active
+  // together after reading the same tokens
+  void compileStates (const QVector<QHash<int, int> > &trieEdges,
+                      const QVector<QList<int> > &trieFormats,
+                      const QList<int> &tokens);
+
+  // Sequence of elements (numbers, years, words and separators) in the format
+  QList<int> elementsInFormat (const QString &format) const;
+
+  // Elements that the token can stand for
+  QList<int> elementsForToken (int token) const;
+
+  // Read the next token of the string, starting at pos which is moved past the token
+  int nextToken (const QString &string,
+                 int &pos) const;
+
+  QStringList m_formats;
+
+  // For each DFA state, the next state for each token that can follow. State 0 is the start state
+  QVector<QHash<int, int> > m_transitions;
+
+  // For each DFA state, the indexes of the formats that end there
+  QVector<QList<int> > m_formatIndexes;
+};
+
+#endif // FORMAT_DATE_TIME_MATCHER_H
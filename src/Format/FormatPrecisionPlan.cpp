@@ -0,0 +1,161 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#include "DocumentModelCoords.h"
+#include "DocumentModelGeneral.h"
+#include "FormatPrecisionPlan.h"
+#include <qmath.h>
+#include <QTransform>
+#include "Transformation.h"
+
+const double PIXEL_SHIFT = 1;
+const int DEFAULT_PRECISION = 5; // Precision used before transformation is available. Equal or greater than x/y pixel counts
+const double ROUND_TRIP_NOISE = 1e-6; // Relative margin around a resolution for the rounding of the screen round trip
+
+// Number of digits ahead of the decimal point (any single decimal place would work but the decimal point is easiest)
+static int powerOfTen (double value)
+{
+  return qFloor (qLn (qAbs (value)) / qLn (10.0));
+}
+
+// True if a resolution is so close to a power of ten that the rounding in the screen round trip can put it on
+// either side. The round trip then decides, since that is where the digit count has always come from
+static bool isNearPowerOfTen (double resolution)
+{
+  return powerOfTen (resolution * (1.0 - ROUND_TRIP_NOISE)) != powerOfTen (resolution * (1.0 + ROUND_TRIP_NOISE));
+}
+
+FormatPrecisionPlan::FormatPrecisionPlan(const DocumentModelGeneral &modelGeneral,
+                                         const Transformation &transformation) :
+  m_transformation (transformation),
+  m_extraPrecision (modelGeneral.extraPrecision()),
+  m_isAffine (false),
+  m_isLinearCartesian (false),
+  m_powerResolutionXTheta (0),
+  m_powerResolutionYRadius (0),
+  m_isNearPowerOfTenXTheta (false),
+  m_isNearPowerOfTenYRadius (false)
+{
+  if (transformation.transformIsDefined()) {
+
+    // Jacobian of the screen to linear cartesian graph transform, which is constant when the transform is affine,
+    // applied to a shift of PIXEL_SHIFT in both screen coordinates. This uses the same matrix convention as
+    // Transformation::transformScreenToLinearCartesianGraph
+    QTransform matrix = transformation.transformMatrix ().transposed ();
+    m_isAffine = matrix.isAffine ();
+    m_deltaLinearCartesian = QPointF ((matrix.m11 () + matrix.m21 ()) * PIXEL_SHIFT,
+                                      (matrix.m12 () + matrix.m22 ()) * PIXEL_SHIFT);
+
+    DocumentModelCoords modelCoords = transformation.modelCoords ();
+    m_isLinearCartesian = (modelCoords.coordsType () == COORDS_TYPE_CARTESIAN &&
+                           modelCoords.coordScaleXTheta () == COORD_SCALE_LINEAR &&
+                           modelCoords.coordScaleYRadius () == COORD_SCALE_LINEAR);
+
+    if (m_isAffine && m_isLinearCartesian) {
+
+      // Resolution is the same at every point
+      m_powerResolutionXTheta = powerOfTen (m_deltaLinearCartesian.x () / PIXEL_SHIFT);
+      m_powerResolutionYRadius = powerOfTen (m_deltaLinearCartesian.y () / PIXEL_SHIFT);
+      m_isNearPowerOfTenXTheta = isNearPowerOfTen (m_deltaLinearCartesian.x () / PIXEL_SHIFT);
+      m_isNearPowerOfTenYRadius = isNearPowerOfTen (m_deltaLinearCartesian.y () / PIXEL_SHIFT);
+    }
+  }
+}
+
+int FormatPrecisionPlan::powerResolutionAtPoint (double valueUnformatted,
+                                                 double valueUnformattedOther,
+                                                 bool isXTheta) const
+{
+  if (m_isAffine && m_isLinearCartesian) {
+
+    bool isNearPowerOfTen = (isXTheta ? m_isNearPowerOfTenXTheta : m_isNearPowerOfTenYRadius);
+    if (!isNearPowerOfTen) {
+      return (isXTheta ? m_powerResolutionXTheta : m_powerResolutionYRadius);
+    }
+
+  } else if (m_isAffine) {
+
+    // Only the log and/or polar part of the transformation is applied to this point
+    QPointF posGraph = posGraphForRawNumber (valueUnformatted,
+                                             valueUnformattedOther,
+                                             isXTheta);
+    QPointF posLinearCartesian, posGraphShifted;
+    m_transformation.transformRawGraphToLinearCartesianGraph (posGraph,
+                                                              posLinearCartesian);
+    m_transformation.transformLinearCartesianGraphToRawGraph (posLinearCartesian + m_deltaLinearCartesian,
+                                                              posGraphShifted);
+
+    double resolutionPerPixel = (isXTheta ?
+                                   (posGraphShifted.x() - posGraph.x()) / PIXEL_SHIFT :
+                                   (posGraphShifted.y() - posGraph.y()) / PIXEL_SHIFT);
+    if (!isNearPowerOfTen (resolutionPerPixel)) {
+      return powerOfTen (resolutionPerPixel);
+    }
+  }
+
+  return powerResolutionRoundTrip (valueUnformatted,
+                                   valueUnformattedOther,
+                                   isXTheta);
+}
+
+int FormatPrecisionPlan::powerResolutionRoundTrip (double valueUnformatted,
+                                                   double valueUnformattedOther,
+                                                   bool isXTheta) const
+{
+  // Measure the resolution if the point is moved some number of pixels in screen coordinates
+  QPointF posGraph = posGraphForRawNumber (valueUnformatted,
+                                           valueUnformattedOther,
+                                           isXTheta);
+
+  QPointF posScreen, posGraphShifted;
+  m_transformation.transformRawGraphToScreen (posGraph,
+                                              posScreen);
+  m_transformation.transformScreenToRawGraph (posScreen + QPointF (PIXEL_SHIFT, PIXEL_SHIFT),
+                                              posGraphShifted);
+
+  double xResolutionPerPixel = (posGraphShifted.x() - posGraph.x()) / PIXEL_SHIFT;
+  double yResolutionPerPixel = (posGraphShifted.y() - posGraph.y()) / PIXEL_SHIFT;
+
+  return powerOfTen (isXTheta ? xResolutionPerPixel : yResolutionPerPixel);
+}
+
+QPointF FormatPrecisionPlan::posGraphForRawNumber (double valueUnformatted,
+                                                   double valueUnformattedOther,
+                                                   bool isXTheta) const
+{
+  if (isXTheta) {
+
+    return QPointF (valueUnformatted,
+                    valueUnformattedOther);
+
+  } else {
+
+    return QPointF (valueUnformattedOther,
+                    valueUnformatted);
+
+  }
+}
+
+int FormatPrecisionPlan::precisionDigitsForRawNumber (double valueUnformatted,
+                                                      double valueUnformattedOther,
+                                                      bool isXTheta) const
+{
+  if (m_transformation.transformIsDefined()) {
+
+    int powerValue = powerOfTen (valueUnformatted);
+    int powerResolution = powerResolutionAtPoint (valueUnformatted,
+                                                  valueUnformattedOther,
+                                                  isXTheta);
+
+    int numberDigitsForResolution = powerValue - powerResolution + 1 + m_extraPrecision;
+
+    return numberDigitsForResolution + 1; // Add one just to be safe
+
+  } else {
+
+    return DEFAULT_PRECISION;
+  }
+}
@@ -0,0 +1,69 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef FORMAT_PRECISION_PLAN_H
+#define FORMAT_PRECISION_PLAN_H
+
+#include <QPointF>
+
+class DocumentModelGeneral;
+class Transformation;
+
+/// Plan for choosing the number of digits when formatting raw numbers, so each value gets a precision consistent
+/// with the graph resolution at the point where it lies. The screen to linear cartesian graph part of the
+/// transformation is affine (with rare exceptions), so the graph shift caused by moving one pixel is computed once
+/// here from its Jacobian. For linear cartesian coordinates that shift is the resolution everywhere, and only the
+/// magnitude of each value is computed per value. For log and polar coordinates only the nonlinear part of the
+/// transformation is applied per value. A resolution within rounding noise of a power of ten is measured with the
+/// full screen round trip instead, so the digit count is always the one the round trip gives.
+///
+/// The Transformation is referenced rather than copied, so the plan must not outlive it
+class FormatPrecisionPlan
+{
+public:
+  /// Single constructor
+  FormatPrecisionPlan(const DocumentModelGeneral &modelGeneral,
+                      const Transformation &transformation);
+
+  /// Compute precision for outputting an unformatted value, consistent with the resolution at the point where that
+  /// point lies. This algorithm causes many digits to appear when a graph's dynamic range is relatively small (like
+  /// -118.4 to -118.2 degrees in longitude), and fewer digits to appear when a graph's dynamic range is relatively
+  /// large (like 0 to 100)
+  int precisionDigitsForRawNumber (double valueUnformatted,
+                                   double valueUnformattedOther,
+                                   bool isXTheta) const;
+
+private:
+  FormatPrecisionPlan();
+
+  int powerResolutionAtPoint (double valueUnformatted,
+                              double valueUnformattedOther,
+                              bool isXTheta) const;
+  int powerResolutionRoundTrip (double valueUnformatted,
+                                double valueUnformattedOther,
+                                bool isXTheta) const;
+  QPointF posGraphForRawNumber (double valueUnformatted,
+                                double valueUnformattedOther,
+                                bool isXTheta) const;
+
+  const Transformation &m_transformation;
+  int m_extraPrecision;
+
+  bool m_isAffine; // True if the linear cartesian graph shift per pixel is the same everywhere
+  bool m_isLinearCartesian; // True if the raw graph coordinates are the linear cartesian graph coordinates
+  QPointF m_deltaLinearCartesian; // Linear cartesian graph shift caused by a shift of PIXEL_SHIFT in both screen coordinates
+
+  // Powers of ten of the x/theta and y/radius resolutions. Only applicable if m_isAffine and m_isLinearCartesian are true
+  int m_powerResolutionXTheta;
+  int m_powerResolutionYRadius;
+
+  // True if the x/theta or y/radius resolution is so close to a power of ten that the screen round trip decides its
+  // power of ten. Only applicable if m_isAffine and m_isLinearCartesian are true
+  bool m_isNearPowerOfTenXTheta;
+  bool m_isNearPowerOfTenYRadius;
+};
+
+#endif // FORMAT_PRECISION_PLAN_H
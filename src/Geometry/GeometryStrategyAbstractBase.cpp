@@ -9,13 +9,15 @@
 #include "GeometryStrategyAbstractBase.h"
 #include <qmath.h>
 #include <QPointF>
-#include "Spline.h"
+#include "SplineArcLength.h"
 #include "SplinePair.h"
 #include "Transformation.h"
 #include <vector>
 
 using namespace std;
 
+SplineArcLengthCache GeometryStrategyAbstractBase::m_arcLengthCache;
+
 GeometryStrategyAbstractBase::GeometryStrategyAbstractBase()
 {
 }
@@ -58,7 +60,8 @@ double GeometryStrategyAbstractBase::functionArea (const QVector<QPointF> &posit
   return sum;
 }
 
-void GeometryStrategyAbstractBase::insertSubintervalsAndLoadDistances (int subintervalsPerInterval,
+void GeometryStrategyAbstractBase::insertSubintervalsAndLoadDistances (const QString &curveName,
+                                                                       int subintervalsPerInterval,
                                                                        const QVector<QPointF> &positionsGraph,
                                                                        QVector<QPointF> &positionsGraphWithSubintervals,
                                                                        QVector<QString> &distanceGraphForward,
@@ -68,8 +71,6 @@ void GeometryStrategyAbstractBase::insertSubintervalsAndLoadDistances (int subin
 {
   if (positionsGraph.size () > 0) {
 
-    int i;
-
     // Fit splines to the points
     vector<double> t;
     vector<SplinePair> xy;
@@ -79,52 +80,22 @@ void GeometryStrategyAbstractBase::insertSubintervalsAndLoadDistances (int subin
                                 positionsGraph [i].y()));
     }
 
-    Spline spline (t,
-                   xy);
-
-    // Loop over the original points, with one original point per original interval
-    QVector<double> distanceGraphDouble;
-    double xLast = 0, yLast = 0, distance = 0;
-    for (i = 0; i < positionsGraph.size(); i++) {
-
-      // In the interval i-1 to i we insert points to create smaller subintervals
-      for (int subinterval = 0; subinterval < subintervalsPerInterval; subinterval++) {
-
-        // Go from i-1 (exclusive) to i (inclusive)
-        double t = double (i - 1.0) + double (subinterval + 1) / double (subintervalsPerInterval);
-
-        SplinePair splinePair = spline.interpolateCoeff (t);
-
-        double x = splinePair.x ();
-        double y = splinePair.y ();
-
-        // All points from intervals where i>0, and last point from interval i=0
-        if (i > 0 || subinterval == subintervalsPerInterval - 1) {
+    // Each original interval is broken into subintervalsPerInterval smaller intervals
+    QSharedPointer<const SplineArcLength> arcLength = m_arcLengthCache.arcLength (curveName,
+                                                                                  t,
+                                                                                  xy,
+                                                                                  (positionsGraph.size () - 1) * subintervalsPerInterval + 1);
 
-          // Insert one of several new points for each original point
-          positionsGraphWithSubintervals.push_back (QPointF (x, y));
-
-        }
-
-        if (i > 0) {
-
-          // Add to cumulative distance
-          distance += qSqrt ((x - xLast) * (x - xLast) + (y - yLast) * (y - yLast));
-
-        }
-
-        xLast = x;
-        yLast = y;
-      }
-
-      // Insert one distance entry for each original point
-      distanceGraphDouble.push_back (distance);
+    for (int sample = 0; sample < arcLength->numSamples (); sample++) {
+      const SplinePair &xySample = arcLength->xyAtSample (sample);
+      positionsGraphWithSubintervals.push_back (QPointF (xySample.x (),
+                                                         xySample.y ()));
     }
 
-    // Compute distance columns
-    double dTotal = qMax (1.0, distanceGraphDouble [distanceGraphDouble.size() - 1]); // qMax prevents divide by zero
-    for (i = 0; i < distanceGraphDouble.size (); i++) {
-      double d = distanceGraphDouble [i];
+    // Compute distance columns, with one distance entry for each original point
+    double dTotal = qMax (1.0, arcLength->length ()); // qMax prevents divide by zero
+    for (int i = 0; i < positionsGraph.size (); i++) {
+      double d = arcLength->distanceAtSample (i * subintervalsPerInterval);
       distanceGraphForward.push_back (QString::number (d));
       distancePercentForward.push_back (QString::number (100.0 * d / dTotal));
       distanceGraphBackward.push_back (QString::number (dTotal - d));
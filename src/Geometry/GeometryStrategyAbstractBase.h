@@ -11,6 +11,7 @@
 #include <QPolygonF>
 #include <QString>
 #include <QVector>
+#include "SplineArcLengthCache.h"
 
 class DocumentModelCoords;
 class DocumentModelGeneral;
@@ -29,7 +30,8 @@ public:
   virtual ~GeometryStrategyAbstractBase ();
 
   /// Calculate geometry parameters
-  virtual void calculateGeometry (const Points &points,
+  virtual void calculateGeometry (const QString &curveName,
+                                  const Points &points,
                                   const DocumentModelCoords &modelCoords,
                                   const DocumentModelGeneral &modelGeneral,
                                   const MainWindowModel &modelMainWindow,
@@ -56,8 +58,9 @@ protected:
 
   /// Insert the specified number of subintervals into each interval. For straight curves subintervalsPerInterval=1 so the
   /// linearity is maintained, and for smooth curves subintervalsPerInterval>1 so the geometry calculations take into account
-  /// the curvature(s) of the line
-  void insertSubintervalsAndLoadDistances (int subintervalsPerInterval,
+  /// the curvature(s) of the line. The arc length table of the curve is reused until its points change
+  void insertSubintervalsAndLoadDistances (const QString &curveName,
+                                           int subintervalsPerInterval,
                                            const QVector<QPointF> &positionsGraph,
                                            QVector<QPointF> &positionsGraphWithSubintervals,
                                            QVector<QString> &distanceGraphForward,
@@ -84,6 +87,10 @@ protected:
   /// check to see if the polygon is simply connected since that would be (1) slow and (2) much work
   double polygonAreaForSimplyConnected (const QVector<QPointF> &points) const;
 
+private:
+
+  // Shared by every strategy and keyed by curve name, so selecting another curve does not discard the previous table
+  static SplineArcLengthCache m_arcLengthCache;
 };
 
 #endif // GEOMETRY_STRATEGY_ABSTRACT_BASE_H
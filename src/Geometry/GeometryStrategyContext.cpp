@@ -27,7 +27,8 @@ GeometryStrategyContext::~GeometryStrategyContext()
   qDeleteAll (m_strategies);
 }
 
-void GeometryStrategyContext::calculateGeometry (const Points &points,
+void GeometryStrategyContext::calculateGeometry (const QString &curveName,
+                                                 const Points &points,
                                                  const DocumentModelCoords &modelCoords,
                                                  const DocumentModelGeneral &modelGeneral,
                                                  const MainWindowModel &modelMainWindow,
@@ -45,7 +46,8 @@ void GeometryStrategyContext::calculateGeometry (const Points &points,
 {
   if (transformation.transformIsDefined()) {
 
-    m_strategies [connectAs]->calculateGeometry (points,
+    m_strategies [connectAs]->calculateGeometry (curveName,
+                                                 points,
                                                  modelCoords,
                                                  modelGeneral,
                                                  modelMainWindow,
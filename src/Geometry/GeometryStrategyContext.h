@@ -26,7 +26,8 @@ public:
   virtual ~GeometryStrategyContext ();
 
   /// Calculate geometry parameters
-  void calculateGeometry (const Points &points,
+  void calculateGeometry (const QString &curveName,
+                          const Points &points,
                           const DocumentModelCoords &modelCoords,
                           const DocumentModelGeneral &modelGeneral,
                           const MainWindowModel &modelMainWindow,
@@ -20,7 +20,8 @@ GeometryStrategyFunctionSmooth::~GeometryStrategyFunctionSmooth()
 {
 }
 
-void GeometryStrategyFunctionSmooth::calculateGeometry (const Points &points,
+void GeometryStrategyFunctionSmooth::calculateGeometry (const QString &curveName,
+                                                        const Points &points,
                                                         const DocumentModelCoords &modelCoords,
                                                         const DocumentModelGeneral &modelGeneral,
                                                         const MainWindowModel &modelMainWindow,
@@ -42,7 +43,8 @@ void GeometryStrategyFunctionSmooth::calculateGeometry (const Points &points,
                            transformation,
                            positionsGraph);
 
-  insertSubintervalsAndLoadDistances (NUM_SUB_INTERVALS_SMOOTH,
+  insertSubintervalsAndLoadDistances (curveName,
+                                      NUM_SUB_INTERVALS_SMOOTH,
                                       positionsGraph,
                                       positionsGraphWithSubintervals,
                                       distanceGraphForward,
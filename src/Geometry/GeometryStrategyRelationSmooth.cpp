@@ -15,7 +15,8 @@ GeometryStrategyRelationSmooth::~GeometryStrategyRelationSmooth()
 {
 }
 
-void GeometryStrategyRelationSmooth::calculateGeometry (const Points &points,
+void GeometryStrategyRelationSmooth::calculateGeometry (const QString &curveName,
+                                                        const Points &points,
                                                         const DocumentModelCoords &modelCoords,
                                                         const DocumentModelGeneral &modelGeneral,
                                                         const MainWindowModel &modelMainWindow,
@@ -37,7 +38,8 @@ void GeometryStrategyRelationSmooth::calculateGeometry (const Points &points,
                            transformation,
                            positionsGraph);
 
-  insertSubintervalsAndLoadDistances (NUM_SUB_INTERVALS_SMOOTH,
+  insertSubintervalsAndLoadDistances (curveName,
+                                      NUM_SUB_INTERVALS_SMOOTH,
                                       positionsGraph,
                                       positionsGraphWithSubintervals,
                                       distanceGraphForward,
@@ -15,7 +15,8 @@ GeometryStrategyRelationStraight::~GeometryStrategyRelationStraight()
 {
 }
 
-void GeometryStrategyRelationStraight::calculateGeometry (const Points &points,
+void GeometryStrategyRelationStraight::calculateGeometry (const QString &curveName,
+                                                          const Points &points,
                                                           const DocumentModelCoords &modelCoords,
                                                           const DocumentModelGeneral &modelGeneral,
                                                           const MainWindowModel &modelMainWindow,
@@ -37,7 +38,8 @@ void GeometryStrategyRelationStraight::calculateGeometry (const Points &points,
                            transformation,
                            positionsGraph);
 
-  insertSubintervalsAndLoadDistances (NUM_SUB_INTERVALS_STRAIGHT,
+  insertSubintervalsAndLoadDistances (curveName,
+                                      NUM_SUB_INTERVALS_STRAIGHT,
                                       positionsGraph,
                                       positionsGraphWithSubintervals,
                                       distanceGraphForward,
@@ -21,7 +21,8 @@ public:
   virtual ~GeometryStrategyRelationStraight ();
 
   /// Calculate geometry parameters
-  virtual void calculateGeometry (const Points &points,
+  virtual void calculateGeometry (const QString &curveName,
+                                  const Points &points,
                                   const DocumentModelCoords &modelCoords,
                                   const DocumentModelGeneral &modelGeneral,
                                   const MainWindowModel &modelMainWindow,
@@ -209,7 +209,8 @@ void GeometryWindow::update (const CmdMediator &cmdMediator,
   QVector<bool> isPotentialExportAmbiguity;
 
   CurveStyle curveStyle = cmdMediator.document().modelCurveStyles().curveStyle (curveSelected);
-  m_geometryStrategyContext.calculateGeometry (points,
+  m_geometryStrategyContext.calculateGeometry (curveSelected,
+                                               points,
                                                cmdMediator.document().modelCoords(),
                                                cmdMediator.document().modelGeneral(),
                                                modelMainWindow,
@@ -258,7 +259,7 @@ void GeometryWindow::update (const CmdMediator &cmdMediator,
       m_model->setItem (row, COLUMN_BODY_DISTANCE_PERCENT_FORWARD, new QStandardItem (distancePercentForward [index]));
       m_model->setItem (row, COLUMN_BODY_DISTANCE_GRAPH_BACKWARD, new QStandardItem (distanceGraphBackward [index]));
       m_model->setItem (row, COLUMN_BODY_DISTANCE_PERCENT_BACKWARD, new QStandardItem (distancePercentBackward [index]));
-      m_model->setItem (row, COLUMN_BODY_POINT_IDENTIFIERS, new QStandardItem (point.identifier()));
+      m_model->setItem (row, COLUMN_BODY_POINT_IDENTIFIERS, new QStandardItem (point.identifier (curveSelected)));
     }
 
     if (wasAmbiguity) {
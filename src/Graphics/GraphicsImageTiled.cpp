@@ -0,0 +1,365 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#include "GraphicsImageTiled.h"
+#include "MainWindowModel.h"
+#include <qmath.h>
+#include <QCoreApplication>
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+#include <QThreadPool>
+#include <QWidget>
+
+const int TILE_SIZE = 512; // Pixels along each side of a tile, at every level
+const int BYTES_PER_PIXEL = 4; // Pixmaps are converted to the 32 bit screen format
+const int BYTES_PER_KILOBYTE = 1024;
+const int KILOBYTES_PER_MEGABYTE = 1024;
+
+GraphicsImageTiled::GraphicsImageTiled() :
+  m_generation (new QAtomicInt (0)),
+  m_cacheKilobytes (DEFAULT_TILE_CACHE_MEGABYTES * KILOBYTES_PER_MEGABYTE)
+{
+  // Exposed rectangle is used to select the tiles that need drawing
+  setFlag (QGraphicsItem::ItemUsesExtendedStyleOption, true);
+
+  m_tiles.setMaxCost (m_cacheKilobytes);
+}
+
+GraphicsImageTiled::~GraphicsImageTiled()
+{
+  // Tiles in progress refer to this object, so they are skipped when they arrive. Queued tiles are skipped without
+  // being scaled
+  m_generation->ref ();
+}
+
+QRectF GraphicsImageTiled::boundingRect () const
+{
+  return QRectF (0,
+                 0,
+                 m_image.width (),
+                 m_image.height ());
+}
+
+void GraphicsImageTiled::drawTile (QPainter *painter,
+                                   int level,
+                                   int column,
+                                   int row,
+                                   bool isSynchronous)
+{
+  QPixmap *pixmap = m_tiles.object (tileKey (level, column, row));
+  if (pixmap != nullptr) {
+
+    painter->drawPixmap (QRectF (tileRectSource (level, column, row)),
+                         *pixmap,
+                         QRectF (pixmap->rect ()));
+
+  } else if (isSynchronous) {
+
+    // There is no later repaint when printing, so the tile is scaled right away. It is not cached since printing
+    // usually needs a finer level than the view
+    QRect rectSource = tileRectSource (level, column, row);
+    painter->drawImage (QRectF (rectSource),
+                        scaleTile (m_image,
+                                   rectSource,
+                                   tileSizeScaled (level,
+                                                   rectSource)));
+
+  } else {
+
+    requestTile (level,
+                 column,
+                 row);
+
+    drawTileFromCoarserLevel (painter,
+                              level,
+                              column,
+                              row);
+  }
+}
+
+bool GraphicsImageTiled::drawTileFromCoarserLevel (QPainter *painter,
+                                                   int level,
+                                                   int column,
+                                                   int row)
+{
+  QRect rectTile = tileRectSource (level, column, row);
+
+  for (int levelCoarser = level + 1; levelCoarser <= maxLevel (); levelCoarser++) {
+
+    int shift = levelCoarser - level;
+    QPixmap *pixmap = m_tiles.object (tileKey (levelCoarser, column >> shift, row >> shift));
+    if (pixmap != nullptr) {
+
+      // Stretch the part of the coarser tile that covers this tile
+      QRect rectCoarser = tileRectSource (levelCoarser, column >> shift, row >> shift);
+      double scale = 1 << levelCoarser;
+      QRectF rectInPixmap ((rectTile.x () - rectCoarser.x ()) / scale,
+                           (rectTile.y () - rectCoarser.y ()) / scale,
+                           rectTile.width () / scale,
+                           rectTile.height () / scale);
+
+      painter->drawPixmap (QRectF (rectTile),
+                           *pixmap,
+                           rectInPixmap);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void GraphicsImageTiled::handleTileReady (int level,
+                                          int column,
+                                          int row,
+                                          const QImage &tile)
+{
+  quint64 key = tileKey (level, column, row);
+  m_tilesPending.remove (key);
+
+  // Pixmaps can only be created in the gui thread
+  QPixmap *pixmap = new QPixmap (QPixmap::fromImage (tile));
+  int cost = qMax (1, pixmap->width () * pixmap->height () * pixmap->depth () / 8 / BYTES_PER_KILOBYTE);
+
+  // QCache deletes an object costing more than the whole cache instead of inserting it, and then the tile would be
+  // requested again by every paint
+  if (cost > m_tiles.maxCost ()) {
+    m_tiles.setMaxCost (cost);
+  }
+
+  m_tiles.insert (key,
+                  pixmap,
+                  cost);
+
+  update (QRectF (tileRectSource (level, column, row)));
+}
+
+QImage GraphicsImageTiled::image () const
+{
+  return m_image;
+}
+
+QVariant GraphicsImageTiled::itemChange (GraphicsItemChange change,
+                                         const QVariant &value)
+{
+  if (change == QGraphicsItem::ItemVisibleHasChanged &&
+      !value.toBool ()) {
+
+    // Tiles in progress would otherwise refill the cache after it was released
+    m_generation->ref ();
+
+    m_tiles.clear ();
+    m_tilesPending.clear ();
+  }
+
+  return QGraphicsObject::itemChange (change,
+                                      value);
+}
+
+int GraphicsImageTiled::levelForLevelOfDetail (double levelOfDetail) const
+{
+  // Each level halves the resolution, so the level is chosen to have about one tile pixel per screen pixel
+  int level = 0;
+  if (levelOfDetail > 0 && levelOfDetail < 1.0) {
+    level = qFloor (qLn (1.0 / levelOfDetail) / qLn (2.0));
+  }
+
+  return qMin (level,
+               maxLevel ());
+}
+
+int GraphicsImageTiled::maxLevel () const
+{
+  // Coarsest level has the whole image in a single tile
+  int extent = qMax (m_image.width (),
+                     m_image.height ());
+  int level = 0;
+  while ((TILE_SIZE << level) < extent) {
+    ++level;
+  }
+
+  return level;
+}
+
+void GraphicsImageTiled::paint (QPainter *painter,
+                                const QStyleOptionGraphicsItem *option,
+                                QWidget *widget)
+{
+  QRectF rectExposed = option->exposedRect & boundingRect ();
+  if (rectExposed.isEmpty ()) {
+    return;
+  }
+
+  // Painting into anything other than the view, like a printer through QGraphicsView::render, happens just once
+  bool isSynchronous = (painter->device () != widget);
+  if (!isSynchronous) {
+    updateCacheFloor (widget);
+  }
+
+  int level = levelForLevelOfDetail (option->levelOfDetailFromTransform (painter->worldTransform ()));
+  int extent = TILE_SIZE << level;
+
+  int columnFirst = qFloor (rectExposed.left () / extent);
+  int columnLast = qCeil (rectExposed.right () / extent) - 1;
+  int rowFirst = qFloor (rectExposed.top () / extent);
+  int rowLast = qCeil (rectExposed.bottom () / extent) - 1;
+
+  for (int row = rowFirst; row <= rowLast; row++) {
+    for (int column = columnFirst; column <= columnLast; column++) {
+
+      drawTile (painter,
+                level,
+                column,
+                row,
+                isSynchronous);
+    }
+  }
+}
+
+void GraphicsImageTiled::requestTile (int level,
+                                      int column,
+                                      int row)
+{
+  quint64 key = tileKey (level, column, row);
+  if (m_tilesPending.contains (key)) {
+    return;
+  }
+
+  m_tilesPending.insert (key);
+
+  GraphicsImageTiled *item = this;
+  QSharedPointer<QAtomicInt> generationShared = m_generation;
+  int generation = m_generation->load ();
+  QImage image = m_image;
+  QRect rectSource = tileRectSource (level, column, row);
+  QSize sizeTile = tileSizeScaled (level,
+                                   rectSource);
+
+  QThreadPool::globalInstance ()->start ([item, generationShared, generation, image, level, column, row, rectSource, sizeTile] () {
+
+    // Skip tiles that are no longer wanted, before spending time on them
+    if (generationShared->load () != generation) {
+      return;
+    }
+
+    QImage tile = scaleTile (image,
+                             rectSource,
+                             sizeTile);
+
+    // Hand the tile back to the gui thread. The generation is checked again there, before this object is touched,
+    // since this object may have been deleted in the meantime
+    QMetaObject::invokeMethod (qApp,
+                               [item, generationShared, generation, level, column, row, tile] () {
+                                 if (generationShared->load () == generation) {
+                                   item->handleTileReady (level,
+                                                          column,
+                                                          row,
+                                                          tile);
+                                 }
+                               },
+                               Qt::QueuedConnection);
+  });
+}
+
+QImage GraphicsImageTiled::scaleTile (const QImage &image,
+                                      const QRect &rectSource,
+                                      const QSize &sizeTile)
+{
+  // Wrap the source rectangle without copying, when the pixel format allows addressing a pixel by byte offset
+  QImage source;
+  if (image.depth () % 8 == 0) {
+
+    const uchar *bits = image.constBits () +
+                        rectSource.y () * image.bytesPerLine () +
+                        rectSource.x () * (image.depth () / 8);
+    source = QImage (bits,
+                     rectSource.width (),
+                     rectSource.height (),
+                     image.bytesPerLine (),
+                     image.format ());
+    source.setColorTable (image.colorTable ());
+
+  } else {
+
+    source = image.copy (rectSource);
+
+  }
+
+  // Result always gets its own pixel buffer, since the wrapper above does not own its pixels
+  if (sizeTile == rectSource.size ()) {
+    return source.copy ();
+  }
+
+  return source.scaled (sizeTile,
+                        Qt::IgnoreAspectRatio,
+                        Qt::SmoothTransformation);
+}
+
+void GraphicsImageTiled::setCacheMegabytes (int cacheMegabytes)
+{
+  m_cacheKilobytes = cacheMegabytes * KILOBYTES_PER_MEGABYTE;
+  m_tiles.setMaxCost (m_cacheKilobytes);
+}
+
+void GraphicsImageTiled::setImage (const QImage &image)
+{
+  prepareGeometryChange ();
+
+  m_image = image;
+  m_generation->ref ();
+
+  m_tiles.clear ();
+  m_tilesPending.clear ();
+
+  update ();
+}
+
+quint64 GraphicsImageTiled::tileKey (int level,
+                                     int column,
+                                     int row)
+{
+  return (quint64 (level) << 56) |
+         (quint64 (column) << 28) |
+         quint64 (row);
+}
+
+QRect GraphicsImageTiled::tileRectSource (int level,
+                                          int column,
+                                          int row) const
+{
+  int extent = TILE_SIZE << level;
+
+  return QRect (column * extent,
+                row * extent,
+                extent,
+                extent) & QRect (0,
+                                 0,
+                                 m_image.width (),
+                                 m_image.height ());
+}
+
+QSize GraphicsImageTiled::tileSizeScaled (int level,
+                                          const QRect &rectSource)
+{
+  return QSize (qMax (1, rectSource.width () >> level),
+                qMax (1, rectSource.height () >> level));
+}
+
+void GraphicsImageTiled::updateCacheFloor (const QWidget *widget)
+{
+  // The level is chosen so each tile covers between half and all of TILE_SIZE screen pixels along each side, so this
+  // many tiles, including the partial tiles along the edges, can be visible at once. Twice that leaves room for the
+  // coarser tiles that stand in for tiles that have not arrived yet. Without this floor the tiles arriving for one
+  // paint would evict each other, and be requested again by the next paint
+  int columns = widget->width () / (TILE_SIZE / 2) + 2;
+  int rows = widget->height () / (TILE_SIZE / 2) + 2;
+  int floorKilobytes = 2 * columns * rows * (TILE_SIZE * TILE_SIZE * BYTES_PER_PIXEL / BYTES_PER_KILOBYTE);
+
+  int maxCost = qMax (m_cacheKilobytes,
+                      floorKilobytes);
+  if (maxCost != m_tiles.maxCost ()) {
+    m_tiles.setMaxCost (maxCost);
+  }
+}
@@ -0,0 +1,106 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef GRAPHICS_IMAGE_TILED_H
+#define GRAPHICS_IMAGE_TILED_H
+
+#include <QAtomicInt>
+#include <QCache>
+#include <QGraphicsObject>
+#include <QImage>
+#include <QPixmap>
+#include <QRectF>
+#include <QSet>
+#include <QSharedPointer>
+
+class QPainter;
+
+/// Background image item that draws the image as a pyramid of tiles, rather than as one pixmap of the full image
+/// like QGraphicsPixmapItem. Level 0 of the pyramid has the full resolution, and each following level has half the
+/// resolution of the previous level. Only the tiles that are visible at the current zoom are converted to pixmaps,
+/// and those pixmaps are kept in a cache with a limited size, which is raised if needed to hold the tiles of one view.
+/// Tiles are scaled from the image by the global thread pool, and until a tile arrives the best available coarser
+/// tile is stretched over its area. Printing and other painting outside of the view scales the missing tiles right
+/// away, since there is no later repaint to show them.
+///
+/// The image itself is shared with the caller (QImage is implicitly shared) so no extra copy is made
+class GraphicsImageTiled : public QGraphicsObject
+{
+  Q_OBJECT;
+
+public:
+  /// Single constructor
+  GraphicsImageTiled();
+  virtual ~GraphicsImageTiled();
+
+  /// Bounding rectangle, which is the full size image
+  virtual QRectF boundingRect () const;
+
+  /// Image being shown
+  QImage image () const;
+
+  /// Draw the tiles that overlap the exposed rectangle, at the pyramid level that fits the current zoom
+  virtual void paint (QPainter *painter,
+                      const QStyleOptionGraphicsItem *option,
+                      QWidget *widget);
+
+  /// Update the maximum size of the tile cache. The cache may still grow past this to hold the tiles of one view
+  void setCacheMegabytes (int cacheMegabytes);
+
+  /// Replace the image. All tiles of the previous image are discarded
+  void setImage (const QImage &image);
+
+protected:
+  /// Release the tile cache, and drop the tiles in progress, when hidden since only one background image is shown at
+  /// a time
+  virtual QVariant itemChange (GraphicsItemChange change,
+                               const QVariant &value);
+
+private:
+
+  void drawTile (QPainter *painter,
+                 int level,
+                 int column,
+                 int row,
+                 bool isSynchronous);
+  bool drawTileFromCoarserLevel (QPainter *painter,
+                                 int level,
+                                 int column,
+                                 int row);
+  void handleTileReady (int level,
+                        int column,
+                        int row,
+                        const QImage &tile);
+  int levelForLevelOfDetail (double levelOfDetail) const;
+  int maxLevel () const;
+  void requestTile (int level,
+                    int column,
+                    int row);
+  static QImage scaleTile (const QImage &image,
+                           const QRect &rectSource,
+                           const QSize &sizeTile);
+  static quint64 tileKey (int level,
+                          int column,
+                          int row);
+  QRect tileRectSource (int level,
+                        int column,
+                        int row) const;
+  static QSize tileSizeScaled (int level,
+                               const QRect &rectSource);
+  void updateCacheFloor (const QWidget *widget);
+
+  QImage m_image;
+
+  // Incremented with each new image, each hide and on destruction, so tiles requested earlier are skipped. Shared with
+  // the requests since they may outlive this object
+  QSharedPointer<QAtomicInt> m_generation;
+
+  QCache<quint64, QPixmap> m_tiles; // Cost is in kilobytes
+  QSet<quint64> m_tilesPending; // Tiles being scaled by the thread pool
+  int m_cacheKilobytes; // Configured maximum cost of m_tiles, before raising it to fit the view
+};
+
+#endif // GRAPHICS_IMAGE_TILED_H
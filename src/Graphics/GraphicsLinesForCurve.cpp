@@ -4,6 +4,7 @@
  * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
  ******************************************************************************************************/
 
+#include "CurveStyle.h"
 #include "DataKey.h"
 #include "EngaugeAssert.h"
 #include "EnumsToQt.h"
@@ -11,16 +12,20 @@
 #include "GraphicsItemType.h"
 #include "GraphicsLinesForCurve.h"
 #include "GraphicsPoint.h"
+#include "GraphicsPointsBatch.h"
 #include "GraphicsScene.h"
 #include "LineStyle.h"
 #include "Logger.h"
 #include "Point.h"
+#include "Points.h"
 #include "PointStyle.h"
 #include <QGraphicsItem>
 #include <QMap>
 #include <QPainterPath>
 #include <QPen>
+#include <QRectF>
 #include <QTextStream>
+#include <QVector>
 #include "QtToString.h"
 #include "Spline.h"
 #include "SplineDrawer.h"
@@ -31,8 +36,15 @@ using namespace std;
 
 typedef QMap<double, double> XOrThetaToOrdinal;
 
+// Points within this fraction of the view size outside of the view keep their graphics items, so small scrolls do
+// not delete and recreate them
+const double VISIBLE_MARGIN_FRACTION = 0.5;
+
 GraphicsLinesForCurve::GraphicsLinesForCurve(const QString &curveName) :
-  m_curveName (curveName)
+  m_curveName (curveName),
+  m_smoothCurveConnectAs (CONNECT_AS_FUNCTION_SMOOTH),
+  m_isMultiValued (false),
+  m_pointsBatch (new GraphicsPointsBatch (this))
 {
   setZValue (Z_VALUE_CURVE);
   setData (DATA_KEY_GRAPHICS_ITEM_TYPE,
@@ -50,6 +62,7 @@ GraphicsLinesForCurve::~GraphicsLinesForCurve()
   }
 
   m_graphicsPoints.clear();
+  m_graphicsPointsByIdentifier.clear();
 }
 
 void GraphicsLinesForCurve::addPoint (const QString &pointIdentifier,
@@ -57,92 +70,79 @@ void GraphicsLinesForCurve::addPoint (const QString &pointIdentifier,
                                       GraphicsPoint &graphicsPoint)
 {
   m_graphicsPoints [ordinal] = &graphicsPoint;
+  m_graphicsPointsByIdentifier [Point::identifierNumberFromPointIdentifier (pointIdentifier)] = &graphicsPoint;
+}
+
+void GraphicsLinesForCurve::appendMultiValued (QPainterPath &pathMultiValued,
+                                               LineStyle &lineMultiValued) const
+{
+  pathMultiValued.addPath (m_pathMultiValued);
+
+  if (m_isMultiValued) {
+    lineMultiValued = m_lineMultiValued;
+  }
 }
 
 QPainterPath GraphicsLinesForCurve::drawLinesSmooth (const LineStyle &lineStyle,
-                                                     SplineDrawer &splineDrawer,
-                                                     QPainterPath &pathMultiValued,
-                                                     LineStyle &lineMultiValued)
+                                                     SplineDrawer &splineDrawer)
 {
 
   QPainterPath path;
 
-  // Prepare spline inputs. Note that the ordinal values may not start at 0
-  vector<double> t;
-  vector<SplinePair> xy;
+  // Current point positions, in ordinal order
+  QVector<QPointF> positions;
+  positions.reserve (m_graphicsPoints.count ());
   OrdinalToGraphicsPoint::const_iterator itr;
   for (itr = m_graphicsPoints.begin(); itr != m_graphicsPoints.end(); itr++) {
-
-    double ordinal = itr.key();
-    const GraphicsPoint *point = itr.value();
-
-    t.push_back (ordinal);
-    xy.push_back (SplinePair (point->pos ().x(),
-                              point->pos ().y()));
+    positions.append (itr.value()->pos ());
   }
 
   // Spline class requires at least one point
-  if (xy.size() > 0) {
+  if (positions.count () > 0) {
 
-    // Spline through points
-    Spline spline (t, xy);
+    updateSmoothSegments (lineStyle,
+                          splineDrawer,
+                          positions);
 
-    splineDrawer.bindToSpline (lineStyle,
-                               m_graphicsPoints.count(),
-                               spline);
-
-    // Create QPainterPath through the points. Loop has one segment per stop point,
+    // Create QPainterPath through the points from the bezier segments. Loop has one segment per stop point,
     // with first point handled outside first
-    int segment; // Only incremented after a draw, corresponding to finishing a segment
-    OrdinalToGraphicsPoint::const_iterator itr = m_graphicsPoints.begin();
-
-    const GraphicsPoint *point = itr.value();
-    path.moveTo (point->pos ());
-    pathMultiValued.moveTo (point->pos ());
-    ++itr;
-
-    for (segment = 0;
-         itr != m_graphicsPoints.end();
-         segment++, itr++) {
-
-      const GraphicsPoint *point = itr.value();
+    path.moveTo (positions.first ());
+    m_pathMultiValued.moveTo (positions.first ());
 
-      SplineDrawerOperation operation = splineDrawer.segmentOperation (segment);
+    for (int segment = 0; segment < positions.count () - 1; segment++) {
 
-      QPointF p1 (spline.p1 (unsigned (segment)).x(),
-                  spline.p1 (unsigned (segment)).y());
-      QPointF p2 (spline.p2 (unsigned (segment)).x(),
-                  spline.p2 (unsigned (segment)).y());
+      const QPointF &pos = positions.at (segment + 1);
+      const QPointF &p1 = m_smoothP1.at (segment);
+      const QPointF &p2 = m_smoothP2.at (segment);
 
-      switch (operation) {
+      switch (m_smoothOperations.at (segment)) {
       case SPLINE_DRAWER_ENUM_VISIBLE_DRAW:
         {
           // Show this segment
           path.cubicTo (p1,
                         p2,
-                        point->pos ());
+                        pos);
         }
         break;
 
       case SPLINE_DRAWER_ENUM_INVISIBLE_MOVE:
 
         // Hide this segment as a regular curve, and show it as the error curve
-        path.moveTo (point->pos ());
+        path.moveTo (pos);
 
         // Show curveMultiValued instead in what would have been the original curve's path
-        OrdinalToGraphicsPoint::const_iterator itrBefore = itr - 1;
-        const GraphicsPoint *pointBefore = itrBefore.value();
-        pathMultiValued.moveTo (pointBefore->pos ());
-        pathMultiValued.cubicTo (p1,
-                                 p2,
-                                 point->pos ());
-        lineMultiValued = lineStyle; // Remember to not use the same line style
+        m_pathMultiValued.moveTo (positions.at (segment));
+        m_pathMultiValued.cubicTo (p1,
+                                   p2,
+                                   pos);
+        m_lineMultiValued = lineStyle; // Remember to not use the same line style
+        m_isMultiValued = true;
         break;
 
       }
 
       // Always move to next point for curveMultiValued
-      pathMultiValued.moveTo (point->pos ());
+      m_pathMultiValued.moveTo (pos);
     }
   }
 
@@ -172,6 +172,12 @@ QPainterPath GraphicsLinesForCurve::drawLinesStraight (QPainterPath  & /* pathMu
   return path;
 }
 
+GraphicsPoint *GraphicsLinesForCurve::graphicsPointForIdentifier (const QString &identifier) const
+{
+  return m_graphicsPointsByIdentifier.value (Point::identifierNumberFromPointIdentifier (identifier),
+                                             nullptr);
+}
+
 double GraphicsLinesForCurve::identifierToOrdinal (const QString &identifier) const
 {
 
@@ -190,7 +196,22 @@ double GraphicsLinesForCurve::identifierToOrdinal (const QString &identifier) co
   return 0;
 }
 
+bool GraphicsLinesForCurve::isSmoothSegmentsCurrent (const LineStyle &lineStyle,
+                                                     const SplineDrawer &splineDrawer,
+                                                     int numPoints)
+{
+  // Segments from the last draw can be reused, at least partly, if nothing other than point positions has changed
+  const Transformation &transformation = splineDrawer.transformation ();
+
+  return (m_smoothPositions.count () == numPoints) &&
+         (m_smoothCurveConnectAs == lineStyle.curveConnectAs ()) &&
+         !(m_smoothTransformation != transformation) &&
+         (m_smoothTransformation.modelCoords().coordsType() == transformation.modelCoords().coordsType()) &&
+         (m_smoothTransformation.modelCoords().coordScaleXTheta() == transformation.modelCoords().coordScaleXTheta());
+}
+
 void GraphicsLinesForCurve::lineMembershipPurge (const LineStyle &lineStyle,
+                                                 const PointStyle &pointStyle,
                                                  SplineDrawer &splineDrawer,
                                                  QPainterPath &pathMultiValued,
                                                  LineStyle &lineMultiValued)
@@ -208,6 +229,7 @@ void GraphicsLinesForCurve::lineMembershipPurge (const LineStyle &lineStyle,
 
       double ordinal = itr.key ();
 
+      removeGraphicsPointIdentifier (point);
       delete point;
       m_graphicsPoints.remove (ordinal);
     }
@@ -228,6 +250,8 @@ void GraphicsLinesForCurve::lineMembershipPurge (const LineStyle &lineStyle,
 
   setPen (pen);
 
+  m_pointsBatch->setPointStyle (pointStyle);
+
   updateGraphicsLinesToMatchGraphicsPoints (lineStyle,
                                             splineDrawer,
                                             pathMultiValued,
@@ -266,6 +290,22 @@ bool GraphicsLinesForCurve::needOrdinalRenumbering () const
   return needRenumbering;
 }
 
+QStringList GraphicsLinesForCurve::positionHasChangedPointIdentifiers () const
+{
+  QStringList movedIds;
+
+  OrdinalToGraphicsPoint::const_iterator itr;
+  for (itr = m_graphicsPoints.begin(); itr != m_graphicsPoints.end(); itr++) {
+
+    const GraphicsPoint *point = itr.value();
+    if (point->data (DATA_KEY_POSITION_HAS_CHANGED).toBool ()) {
+      movedIds << point->data (DATA_KEY_IDENTIFIER).toString ();
+    }
+  }
+
+  return movedIds;
+}
+
 void GraphicsLinesForCurve::printStream (QString indentation,
                                          QTextStream &str) const
 {
@@ -295,10 +335,21 @@ void GraphicsLinesForCurve::removePoint (double ordinal)
   GraphicsPoint *graphicsPoint = m_graphicsPoints [ordinal];
 
   m_graphicsPoints.remove (ordinal);
+  removeGraphicsPointIdentifier (graphicsPoint);
+  m_pointsBatch->removePoint (graphicsPoint);
 
   delete graphicsPoint;
 }
 
+void GraphicsLinesForCurve::removeGraphicsPointIdentifier (GraphicsPoint *graphicsPoint)
+{
+  // Another point may have taken over the identifier during renumbering, in which case its entry is kept
+  unsigned int identifierNumber = Point::identifierNumberFromPointIdentifier (graphicsPoint->data (DATA_KEY_IDENTIFIER).toString ());
+  if (m_graphicsPointsByIdentifier.value (identifierNumber, nullptr) == graphicsPoint) {
+    m_graphicsPointsByIdentifier.remove (identifierNumber);
+  }
+}
+
 void GraphicsLinesForCurve::removeTemporaryPointIfExists()
 {
 
@@ -310,6 +361,8 @@ void GraphicsLinesForCurve::removeTemporaryPointIfExists()
     GraphicsPoint *graphicsPoint = itr.value();
 
     m_graphicsPoints.remove (itr.key());
+    removeGraphicsPointIdentifier (graphicsPoint);
+    m_pointsBatch->removePoint (graphicsPoint);
 
     delete graphicsPoint;
 
@@ -340,11 +393,67 @@ void GraphicsLinesForCurve::renumberOrdinals ()
   }
 }
 
+void GraphicsLinesForCurve::resetPositionHasChangedFlags ()
+{
+  OrdinalToGraphicsPoint::const_iterator itr;
+  for (itr = m_graphicsPoints.begin(); itr != m_graphicsPoints.end(); itr++) {
+
+    GraphicsPoint *point = itr.value();
+    point->setData (DATA_KEY_POSITION_HAS_CHANGED, QVariant (false));
+  }
+}
+
+void GraphicsLinesForCurve::setPointsAcceptHoverEvents (bool enabled)
+{
+  OrdinalToGraphicsPoint::const_iterator itr;
+  for (itr = m_graphicsPoints.begin(); itr != m_graphicsPoints.end(); itr++) {
+
+    GraphicsPoint *point = itr.value();
+    point->setAcceptHoverEvents (enabled);
+  }
+}
+
+void GraphicsLinesForCurve::setPointsEditable (bool enabled)
+{
+  OrdinalToGraphicsPoint::const_iterator itr;
+  for (itr = m_graphicsPoints.begin(); itr != m_graphicsPoints.end(); itr++) {
+
+    GraphicsPoint *point = itr.value();
+    point->setFlag (QGraphicsItem::ItemIsSelectable, enabled);
+    point->setFlag (QGraphicsItem::ItemIsMovable, enabled);
+    point->setFlag (QGraphicsItem::ItemIsFocusable, enabled);
+  }
+}
+
+void GraphicsLinesForCurve::setPointsOpacity (double opacity)
+{
+  OrdinalToGraphicsPoint::const_iterator itr;
+  for (itr = m_graphicsPoints.begin(); itr != m_graphicsPoints.end(); itr++) {
+
+    GraphicsPoint *point = itr.value();
+    point->setOpacity (opacity);
+  }
+}
+
+void GraphicsLinesForCurve::setVisibleLineAndPoints (bool visible)
+{
+  setVisible (visible);
+
+  OrdinalToGraphicsPoint::const_iterator itr;
+  for (itr = m_graphicsPoints.begin(); itr != m_graphicsPoints.end(); itr++) {
+
+    GraphicsPoint *point = itr.value();
+    point->setVisible (visible);
+  }
+}
+
 void GraphicsLinesForCurve::updateAfterCommand (GraphicsScene &scene,
                                                 const PointStyle &pointStyle,
                                                 const Point &point,
                                                 GeometryWindow *geometryWindow)
 {
+  QString identifier = point.identifier (m_curveName);
+
   GraphicsPoint *graphicsPoint = nullptr;
   if (m_graphicsPoints.contains (point.ordinal())) {
 
@@ -355,16 +464,19 @@ void GraphicsLinesForCurve::updateAfterCommand (GraphicsScene &scene,
     // better logging (i.e. consistency between Document and GraphicsScene dumps), but happened
     // to fix a bug with the wrong set of points getting deleted from Cut and Delete
     graphicsPoint->setPos (point.posScreen());
-    graphicsPoint->setData (DATA_KEY_IDENTIFIER, point.identifier());
+    removeGraphicsPointIdentifier (graphicsPoint);
+    graphicsPoint->setData (DATA_KEY_IDENTIFIER, identifier);
+    m_graphicsPointsByIdentifier [point.identifierNumber ()] = graphicsPoint;
 
   } else {
 
     // Point does not exist in scene so create it
-    graphicsPoint = scene.createPoint (point.identifier (),
+    graphicsPoint = scene.createPoint (identifier,
                                        pointStyle,
                                        point.posScreen(),
                                        geometryWindow);
     m_graphicsPoints [point.ordinal ()] = graphicsPoint;
+    m_graphicsPointsByIdentifier [point.identifierNumber ()] = graphicsPoint;
 
   }
 
@@ -373,6 +485,60 @@ void GraphicsLinesForCurve::updateAfterCommand (GraphicsScene &scene,
   graphicsPoint->setWanted ();
 }
 
+void GraphicsLinesForCurve::updateAfterCommandPoints (GraphicsScene &scene,
+                                                      const PointStyle &pointStyle,
+                                                      const Points &points,
+                                                      GeometryWindow *geometryWindow)
+{
+  // The maps are rebuilt rather than updated one point at a time. Points arrive in ordinal order, so each item is
+  // appended to the end of the new ordinal map
+  OrdinalToGraphicsPoint graphicsPoints;
+  QHash<unsigned int, GraphicsPoint*> graphicsPointsByIdentifier;
+  graphicsPointsByIdentifier.reserve (points.count ());
+
+  Points::const_iterator itr;
+  for (itr = points.begin (); itr != points.end (); itr++) {
+
+    const Point &point = *itr;
+    double ordinal = point.ordinal ();
+    QString identifier = point.identifier (m_curveName);
+
+    GraphicsPoint *graphicsPoint = m_graphicsPoints.take (ordinal);
+    if (graphicsPoint != nullptr) {
+
+      // Same override of position and identifier as in updateAfterCommand, since ordinals may have been renumbered
+      graphicsPoint->setPos (point.posScreen());
+      graphicsPoint->setData (DATA_KEY_IDENTIFIER, identifier);
+
+    } else {
+
+      graphicsPoint = scene.createPoint (identifier,
+                                         pointStyle,
+                                         point.posScreen(),
+                                         geometryWindow);
+    }
+
+    graphicsPoint->setWanted ();
+
+    if (graphicsPoints.isEmpty () || ordinal > graphicsPoints.lastKey ()) {
+      graphicsPoints.insert (graphicsPoints.constEnd (),
+                             ordinal,
+                             graphicsPoint);
+    } else {
+      graphicsPoints.insert (ordinal,
+                             graphicsPoint);
+    }
+    graphicsPointsByIdentifier.insert (point.identifierNumber (),
+                                       graphicsPoint);
+  }
+
+  // Items that were not taken above belong to points that were removed from the Document
+  qDeleteAll (m_graphicsPoints);
+
+  m_graphicsPoints = graphicsPoints;
+  m_graphicsPointsByIdentifier = graphicsPointsByIdentifier;
+}
+
 void GraphicsLinesForCurve::updateCurveStyle (const CurveStyle &curveStyle)
 {
 
@@ -382,6 +548,8 @@ void GraphicsLinesForCurve::updateCurveStyle (const CurveStyle &curveStyle)
      GraphicsPoint *point = itr.value();
      point->updateCurveStyle (curveStyle);
   }
+
+  m_pointsBatch->setPointStyle (curveStyle.pointStyle ());
 }
 
 void GraphicsLinesForCurve::updateHighlightOpacity (double highlightOpacity)
@@ -407,6 +575,9 @@ void GraphicsLinesForCurve::updateGraphicsLinesToMatchGraphicsPoints (const Line
 
   }
 
+  m_pathMultiValued = QPainterPath ();
+  m_isMultiValued = false;
+
   if (lineStyle.curveConnectAs() != CONNECT_SKIP_FOR_AXIS_CURVE) {
 
     // Draw as either straight or smoothed. The function/relation differences were handled already with ordinals. The
@@ -416,16 +587,19 @@ void GraphicsLinesForCurve::updateGraphicsLinesToMatchGraphicsPoints (const Line
         lineStyle.curveConnectAs() == CONNECT_AS_RELATION_STRAIGHT ||
         m_graphicsPoints.count () < 3) {
 
-      path = drawLinesStraight (pathMultiValued);
+      path = drawLinesStraight (m_pathMultiValued);
     } else {
       path = drawLinesSmooth (lineStyle,
-                              splineDrawer,
-                              pathMultiValued,
-                              lineMultiValued);
+                              splineDrawer);
     }
 
    setPath (path);
   }
+
+  appendMultiValued (pathMultiValued,
+                     lineMultiValued);
+
+  updatePointsBatch ();
 }
 
 void GraphicsLinesForCurve::updatePointOrdinalsAfterDrag (const LineStyle &lineStyle,
@@ -477,3 +651,160 @@ void GraphicsLinesForCurve::updatePointOrdinalsAfterDrag (const LineStyle &lineS
     }
   }
 }
+
+void GraphicsLinesForCurve::updatePointsBatch ()
+{
+  bool batched = (m_graphicsPoints.count () >= GraphicsPointsBatch::batchMinimumPoints ());
+
+  QVector<const GraphicsPoint*> points;
+  if (batched) {
+    points.reserve (m_graphicsPoints.count ());
+  }
+
+  OrdinalToGraphicsPoint::const_iterator itr;
+  for (itr = m_graphicsPoints.begin(); itr != m_graphicsPoints.end(); itr++) {
+
+    GraphicsPoint *point = itr.value();
+    point->setPointsBatch (batched ? m_pointsBatch : nullptr);
+
+    if (batched) {
+      points.append (point);
+    }
+  }
+
+  m_pointsBatch->setPoints (points);
+
+  updatePointsDetached ();
+}
+
+void GraphicsLinesForCurve::updatePointsDetached ()
+{
+  // Only points drawn by m_pointsBatch can do without their graphics items
+  bool batched = (m_graphicsPoints.count () >= GraphicsPointsBatch::batchMinimumPoints ());
+
+  double xMargin = VISIBLE_MARGIN_FRACTION * m_visibleSceneRect.width ();
+  double yMargin = VISIBLE_MARGIN_FRACTION * m_visibleSceneRect.height ();
+  QRectF rectAttached = m_visibleSceneRect.adjusted (-xMargin, -yMargin, xMargin, yMargin);
+
+  OrdinalToGraphicsPoint::const_iterator itr;
+  for (itr = m_graphicsPoints.begin(); itr != m_graphicsPoints.end(); itr++) {
+
+    GraphicsPoint *point = itr.value();
+
+    // Selected points keep their graphics items since the selection is kept there
+    bool detached = batched &&
+                    !m_visibleSceneRect.isNull () &&
+                    !point->isSelected () &&
+                    !rectAttached.contains (point->pos ());
+
+    point->setDetached (detached);
+  }
+}
+
+void GraphicsLinesForCurve::updateSmoothSegments (const LineStyle &lineStyle,
+                                                  SplineDrawer &splineDrawer,
+                                                  const QVector<QPointF> &positions)
+{
+  // Moving one point changes the natural cubic spline coefficients by a factor of roughly 0.27 per interval
+  // away from it, so after this many intervals the change is far below a pixel. The spline is fit over twice
+  // that margin so the artificial end conditions of the partial fit are just as far from the replaced segments
+  const int NEIGHBOR_INTERVALS = 10;
+
+  int numPoints = positions.count ();
+  int numSegments = numPoints - 1;
+
+  int indexChangedFirst = numPoints, indexChangedLast = -1;
+  bool isCurrent = isSmoothSegmentsCurrent (lineStyle,
+                                            splineDrawer,
+                                            numPoints);
+  if (isCurrent) {
+    for (int index = 0; index < numPoints; index++) {
+      if (positions.at (index) != m_smoothPositions.at (index)) {
+        indexChangedFirst = qMin (indexChangedFirst, index);
+        indexChangedLast = index;
+      }
+    }
+
+    if (indexChangedLast < 0) {
+
+      // Nothing moved so every segment is still good
+      return;
+    }
+  }
+
+  if (!isCurrent ||
+      (indexChangedLast - indexChangedFirst) > numPoints / 4) {
+
+    // Refit everything
+    m_smoothP1.resize (numSegments);
+    m_smoothP2.resize (numSegments);
+    m_smoothOperations.resize (numSegments);
+
+    updateSmoothSegmentsInRange (lineStyle,
+                                 splineDrawer,
+                                 positions,
+                                 0,
+                                 numPoints - 1,
+                                 0,
+                                 numSegments - 1);
+
+  } else {
+
+    // Refit just the neighborhood of the moved points
+    updateSmoothSegmentsInRange (lineStyle,
+                                 splineDrawer,
+                                 positions,
+                                 qMax (0, indexChangedFirst - 2 * NEIGHBOR_INTERVALS),
+                                 qMin (numPoints - 1, indexChangedLast + 2 * NEIGHBOR_INTERVALS),
+                                 qMax (0, indexChangedFirst - NEIGHBOR_INTERVALS),
+                                 qMin (numSegments - 1, indexChangedLast + NEIGHBOR_INTERVALS - 1));
+  }
+
+  m_smoothPositions = positions;
+  m_smoothCurveConnectAs = lineStyle.curveConnectAs ();
+  m_smoothTransformation = splineDrawer.transformation ();
+}
+
+void GraphicsLinesForCurve::updateSmoothSegmentsInRange (const LineStyle &lineStyle,
+                                                         SplineDrawer &splineDrawer,
+                                                         const QVector<QPointF> &positions,
+                                                         int indexFitFirst,
+                                                         int indexFitLast,
+                                                         int segmentFirst,
+                                                         int segmentLast)
+{
+  // Prepare spline inputs. The t values start at zero for the first fitted point, which SplineDrawer expects
+  vector<double> t;
+  vector<SplinePair> xy;
+  for (int index = indexFitFirst; index <= indexFitLast; index++) {
+
+    t.push_back (index - indexFitFirst);
+    xy.push_back (SplinePair (positions.at (index).x(),
+                              positions.at (index).y()));
+  }
+
+  // Spline through points
+  Spline spline (t, xy);
+
+  splineDrawer.bindToSpline (lineStyle,
+                             indexFitLast - indexFitFirst + 1,
+                             spline);
+
+  for (int segment = segmentFirst; segment <= segmentLast; segment++) {
+
+    unsigned int segmentInFit = unsigned (segment - indexFitFirst);
+
+    m_smoothP1 [segment] = QPointF (spline.p1 (segmentInFit).x(),
+                                    spline.p1 (segmentInFit).y());
+    m_smoothP2 [segment] = QPointF (spline.p2 (segmentInFit).x(),
+                                    spline.p2 (segmentInFit).y());
+    m_smoothOperations [segment] = splineDrawer.segmentOperation (signed (segmentInFit));
+  }
+}
+
+void GraphicsLinesForCurve::updateVisibleSceneRect (const QRectF &visibleSceneRect)
+{
+  m_visibleSceneRect = visibleSceneRect;
+
+  updatePointsDetached ();
+}
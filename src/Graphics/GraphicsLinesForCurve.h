@@ -7,23 +7,40 @@
 #ifndef GRAPHICS_LINES_FOR_CURVE_H
 #define GRAPHICS_LINES_FOR_CURVE_H
 
+#include "CurveConnectAs.h"
+#include "LineStyle.h"
 #include "Point.h"
+#include "Points.h"
 #include "OrdinalToGraphicsPoint.h"
 #include <QGraphicsPathItem>
+#include <QHash>
+#include <QPainterPath>
+#include <QPointF>
+#include <QRectF>
+#include <QStringList>
+#include <QVector>
+#include "SplineDrawer.h"
+#include "Transformation.h"
 
 class CurveStyle;
 class GeometryWindow;
 class GraphicsPoint;
+class GraphicsPointsBatch;
 class GraphicsScene;
-class LineStyle;
 class PointStyle;
-class QPainterPath;
 class QTestStream;
-class SplineDrawer;
-class Transformation;
 
 /// This class stores the GraphicsLine objects for one Curve. The container is a QMap since that container
-/// maintains order by key
+/// maintains order by key.
+///
+/// Smooth lines are kept as one bezier segment per interval between successive points. When only a few points
+/// have moved since the last draw, the spline is refit over just the neighboring intervals, since the influence
+/// of a moved point on the natural cubic spline dies off quickly with distance, and only those segments are replaced
+///
+/// Curves with many points also own a GraphicsPointsBatch child item that draws all of their points at once when
+/// zoomed out, in place of the per-point items. Points of those curves that are well outside of the visible part of
+/// the scene are detached from their graphics items, so the number of items in the scene stays near the number
+/// that can be seen
 class GraphicsLinesForCurve : public QGraphicsPathItem
 {
 public:
@@ -39,11 +56,20 @@ public:
                  double ordinal,
                  GraphicsPoint &point);
 
+  /// Add the multi-valued sections from the last draw to the path shared by all curves. Curves that were not changed
+  /// by a command are not redrawn, and this keeps their sections in the shared path
+  void appendMultiValued (QPainterPath &pathMultiValued,
+                          LineStyle &lineMultiValued) const;
+
+  /// Return the point with the specified identifier, or null if there is no such point in this curve
+  GraphicsPoint *graphicsPointForIdentifier (const QString &identifier) const;
+
   ///  Get ordinal for specified identifier
   double identifierToOrdinal (const QString &identifier) const;
 
   /// Mark the end of addPoint calls. Remove stale lines, insert missing lines, and draw the graphics lines
   void lineMembershipPurge (const LineStyle &lineStyle,
+                            const PointStyle &pointStyle,
                             SplineDrawer &splineDrawer,
                             QPainterPath &pathMultiValued,
                             LineStyle &lineMultiValued);
@@ -51,6 +77,9 @@ public:
   /// Mark points as unwanted. Afterwards, lineMembershipPurge gets called
   void lineMembershipReset ();
 
+  /// Identifiers of the points that have moved since the last call to GraphicsScene::resetPositionHasChangedFlags
+  QStringList positionHasChangedPointIdentifiers () const;
+
   /// Debugging method that supports print method of this class and printStream method of some other class(es)
   void printStream (QString indentation,
                     QTextStream &str) const;
@@ -62,12 +91,34 @@ public:
   /// allows redundant calls to this method, without complaining that the point has already been removed when called again
   void removeTemporaryPointIfExists ();
 
+  /// Reset the flag read by positionHasChangedPointIdentifiers for all of the points
+  void resetPositionHasChangedFlags ();
+
+  /// Enable or disable hover events for all of the points, including the detached points
+  void setPointsAcceptHoverEvents (bool enabled);
+
+  /// Allow or prevent selecting, moving and focusing of all of the points, including the detached points
+  void setPointsEditable (bool enabled);
+
+  /// Set opacity of all of the points, including the detached points
+  void setPointsOpacity (double opacity);
+
+  /// Show or hide the line and all of the points
+  void setVisibleLineAndPoints (bool visible);
+
   /// Update the GraphicsScene with the specified Point from the Document. If it does not exist yet in the scene, we add it
   void updateAfterCommand (GraphicsScene &scene,
                            const PointStyle &pointStyle,
                            const Point &point,
                            GeometryWindow *geometryWindow);
 
+  /// Update the GraphicsScene with all of the Points of this curve from the Document in one pass. Items are reused by
+  /// ordinal or else created, and items whose ordinals are gone are deleted. Lines are left for lineMembershipPurge
+  void updateAfterCommandPoints (GraphicsScene &scene,
+                                 const PointStyle &pointStyle,
+                                 const Points &points,
+                                 GeometryWindow *geometryWindow);
+
   /// Update the curve style for this curve
   void updateCurveStyle (const CurveStyle &curveStyle);
 
@@ -84,18 +135,53 @@ public:
   void updatePointOrdinalsAfterDrag (const LineStyle &lineStyle,
                                      const Transformation &transformation);
 
+  /// Detach the points that are well outside of the visible part of the scene, and attach the others. A null
+  /// rectangle means the whole scene is visible
+  void updateVisibleSceneRect (const QRectF &visibleSceneRect);
+
 private:
 
   QPainterPath drawLinesSmooth (const LineStyle &lineStyle,
-                                SplineDrawer &splineDrawer,
-                                QPainterPath &pathMultiValued,
-                                LineStyle &lineMultiValued);
+                                SplineDrawer &splineDrawer);
   QPainterPath drawLinesStraight (QPainterPath &pathMultiValued);
+  bool isSmoothSegmentsCurrent (const LineStyle &lineStyle,
+                                const SplineDrawer &splineDrawer,
+                                int numPoints);
   bool needOrdinalRenumbering () const; // True if m_graphicsPoints ordinal keys need renumbering
+  void removeGraphicsPointIdentifier (GraphicsPoint *graphicsPoint); // Remove from m_graphicsPointsByIdentifier
   void renumberOrdinals(); // Renumbers m_graphicsPoints ordinal keys
+  void updatePointsBatch (); // Update batch of the points, and the points drawn by m_pointsBatch
+  void updatePointsDetached (); // Detach or attach points according to m_visibleSceneRect
+  void updateSmoothSegments (const LineStyle &lineStyle,
+                             SplineDrawer &splineDrawer,
+                             const QVector<QPointF> &positions);
+  void updateSmoothSegmentsInRange (const LineStyle &lineStyle,
+                                    SplineDrawer &splineDrawer,
+                                    const QVector<QPointF> &positions,
+                                    int indexFitFirst,
+                                    int indexFitLast,
+                                    int segmentFirst,
+                                    int segmentLast);
 
   const QString m_curveName;
   OrdinalToGraphicsPoint m_graphicsPoints;
+  QHash<unsigned int, GraphicsPoint*> m_graphicsPointsByIdentifier; // Same points as m_graphicsPoints, by number of DATA_KEY_IDENTIFIER
+
+  // Smooth line segments from the last draw, with one entry per interval, and the inputs they were computed from
+  QVector<QPointF> m_smoothPositions;
+  QVector<QPointF> m_smoothP1;
+  QVector<QPointF> m_smoothP2;
+  SegmentOperations m_smoothOperations;
+  CurveConnectAs m_smoothCurveConnectAs;
+  Transformation m_smoothTransformation;
+
+  // Multi-valued sections from the last draw, with the line style if there were any
+  QPainterPath m_pathMultiValued;
+  LineStyle m_lineMultiValued;
+  bool m_isMultiValued;
+
+  GraphicsPointsBatch *m_pointsBatch; // Child item so it is shown, hidden and deleted along with this item
+  QRectF m_visibleSceneRect; // Null until the view reports what it shows
 };
 
 #endif // GRAPHICS_LINES_FOR_CURVE_H
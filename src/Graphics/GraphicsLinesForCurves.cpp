@@ -4,6 +4,7 @@
  * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
  ******************************************************************************************************/
 
+#include "CmdDirty.h"
 #include "Curve.h"
 #include "CurveStyles.h"
 #include "DataKey.h"
@@ -51,6 +52,7 @@ void GraphicsLinesForCurves::addRemoveCurves (GraphicsScene &scene,
 
       GraphicsLinesForCurve *item = new GraphicsLinesForCurve(curveName);
       scene.addItem (item);
+      item->updateVisibleSceneRect (m_visibleSceneRect);
 
       m_graphicsLinesForCurve [curveName] = item;
     }
@@ -74,7 +76,20 @@ void GraphicsLinesForCurves::addRemoveCurves (GraphicsScene &scene,
   }
 }
 
+GraphicsPoint *GraphicsLinesForCurves::graphicsPointForIdentifier (const QString &identifier) const
+{
+  QString curveName = Point::curveNameFromPointIdentifier (identifier);
+
+  const GraphicsLinesForCurve *graphicsLines = m_graphicsLinesForCurve.value (curveName, nullptr);
+  if (graphicsLines != nullptr) {
+    return graphicsLines->graphicsPointForIdentifier (identifier);
+  }
+
+  return nullptr;
+}
+
 void GraphicsLinesForCurves::lineMembershipPurge(const CurveStyles &curveStyles,
+                                                 const CmdDirty &cmdDirty,
                                                  SplineDrawer &splineDrawer,
                                                  QPainterPath &pathMultiValued,
                                                  LineStyle &lineMultiValued)
@@ -86,14 +101,25 @@ void GraphicsLinesForCurves::lineMembershipPurge(const CurveStyles &curveStyles,
     const QString curveName = itr.key ();
     GraphicsLinesForCurve *graphicsLines = itr.value();
 
-    graphicsLines->lineMembershipPurge (curveStyles.lineStyle (curveName),
-                                        splineDrawer,
-                                        pathMultiValued,
+    if (cmdDirty.isCurveOrAxes (curveName)) {
+
+      graphicsLines->lineMembershipPurge (curveStyles.lineStyle (curveName),
+                                          curveStyles.pointStyle (curveName),
+                                          splineDrawer,
+                                          pathMultiValued,
+                                          lineMultiValued);
+
+    } else {
+
+      // Unchanged curve keeps its lines, but its multi-valued sections still belong in the shared path
+      graphicsLines->appendMultiValued (pathMultiValued,
                                         lineMultiValued);
+
+    }
   }
 }
 
-void GraphicsLinesForCurves::lineMembershipReset()
+void GraphicsLinesForCurves::lineMembershipReset(const CmdDirty &cmdDirty)
 {
 
   GraphicsLinesContainer::const_iterator itr;
@@ -101,8 +127,24 @@ void GraphicsLinesForCurves::lineMembershipReset()
 
     GraphicsLinesForCurve *graphicsLines = itr.value();
 
-    graphicsLines->lineMembershipReset ();
+    if (cmdDirty.isCurveOrAxes (itr.key ())) {
+      graphicsLines->lineMembershipReset ();
+    }
+  }
+}
+
+QStringList GraphicsLinesForCurves::positionHasChangedPointIdentifiers () const
+{
+  QStringList movedIds;
+
+  GraphicsLinesContainer::const_iterator itr;
+  for (itr = m_graphicsLinesForCurve.begin (); itr != m_graphicsLinesForCurve.end (); itr++) {
+
+    const GraphicsLinesForCurve *graphicsLines = itr.value();
+    movedIds << graphicsLines->positionHasChangedPointIdentifiers ();
   }
+
+  return movedIds;
 }
 
 void GraphicsLinesForCurves::print () const
@@ -161,6 +203,62 @@ void GraphicsLinesForCurves::resetOnLoad()
   m_graphicsLinesForCurve.clear();
 }
 
+void GraphicsLinesForCurves::resetPositionHasChangedFlags ()
+{
+  GraphicsLinesContainer::const_iterator itr;
+  for (itr = m_graphicsLinesForCurve.begin (); itr != m_graphicsLinesForCurve.end (); itr++) {
+
+    GraphicsLinesForCurve *graphicsLines = itr.value();
+    graphicsLines->resetPositionHasChangedFlags ();
+  }
+}
+
+void GraphicsLinesForCurves::setPointsAcceptHoverEvents (bool enabled)
+{
+  GraphicsLinesContainer::const_iterator itr;
+  for (itr = m_graphicsLinesForCurve.begin (); itr != m_graphicsLinesForCurve.end (); itr++) {
+
+    GraphicsLinesForCurve *graphicsLines = itr.value();
+    graphicsLines->setPointsAcceptHoverEvents (enabled);
+  }
+}
+
+void GraphicsLinesForCurves::setPointsEditable (bool enabled)
+{
+  GraphicsLinesContainer::const_iterator itr;
+  for (itr = m_graphicsLinesForCurve.begin (); itr != m_graphicsLinesForCurve.end (); itr++) {
+
+    GraphicsLinesForCurve *graphicsLines = itr.value();
+    graphicsLines->setPointsEditable (enabled);
+  }
+}
+
+void GraphicsLinesForCurves::setPointsOpacity (double opacity)
+{
+  GraphicsLinesContainer::const_iterator itr;
+  for (itr = m_graphicsLinesForCurve.begin (); itr != m_graphicsLinesForCurve.end (); itr++) {
+
+    GraphicsLinesForCurve *graphicsLines = itr.value();
+    graphicsLines->setPointsOpacity (opacity);
+  }
+}
+
+void GraphicsLinesForCurves::showCurves (bool show,
+                                         bool showAll,
+                                         const QString &curveNameWanted)
+{
+  GraphicsLinesContainer::iterator itr;
+  for (itr = m_graphicsLinesForCurve.begin (); itr != m_graphicsLinesForCurve.end (); itr++) {
+
+    QString curveName = itr.key();
+    GraphicsLinesForCurve *graphicsLines = itr.value();
+
+    bool showThis = show && (showAll || (curveName == curveNameWanted));
+
+    graphicsLines->setVisibleLineAndPoints (showThis);
+  }
+}
+
 void GraphicsLinesForCurves::updateAfterCommand (GraphicsScene &scene,
                                                  const CurveStyles &curveStyles,
                                                  const QString &curveName,
@@ -174,6 +272,19 @@ void GraphicsLinesForCurves::updateAfterCommand (GraphicsScene &scene,
                                                            geometryWindow);
 }
 
+void GraphicsLinesForCurves::updateAfterCommandPoints (GraphicsScene &scene,
+                                                       const CurveStyles &curveStyles,
+                                                       const QString &curveName,
+                                                       const Points &points,
+                                                       GeometryWindow *geometryWindow)
+{
+  ENGAUGE_ASSERT (m_graphicsLinesForCurve.contains (curveName));
+  m_graphicsLinesForCurve [curveName]->updateAfterCommandPoints (scene,
+                                                                 curveStyles.pointStyle(curveName),
+                                                                 points,
+                                                                 geometryWindow);
+}
+
 void GraphicsLinesForCurves::updateCurveStyles (const CurveStyles &modelCurveStyles)
 {
 
@@ -208,7 +319,8 @@ void GraphicsLinesForCurves::updateGraphicsLinesToMatchGraphicsPoints (const Cur
   }
 }
 
-void GraphicsLinesForCurves::updateHighlightOpacity (double highlightOpacity)
+void GraphicsLinesForCurves::updateHighlightOpacity (double highlightOpacity,
+                                                     const CmdDirty &cmdDirty)
 {
 
   GraphicsLinesContainer::const_iterator itr;
@@ -216,7 +328,9 @@ void GraphicsLinesForCurves::updateHighlightOpacity (double highlightOpacity)
 
     QString curveName = itr.key();
 
-    m_graphicsLinesForCurve [curveName]->updateHighlightOpacity (highlightOpacity);
+    if (cmdDirty.isCurveOrAxes (curveName)) {
+      m_graphicsLinesForCurve [curveName]->updateHighlightOpacity (highlightOpacity);
+    }
   }
 }
 
@@ -234,3 +348,15 @@ void GraphicsLinesForCurves::updatePointOrdinalsAfterDrag (const CurveStyles &cu
                                                  transformation);
   }
 }
+
+void GraphicsLinesForCurves::updateVisibleSceneRect (const QRectF &visibleSceneRect)
+{
+  m_visibleSceneRect = visibleSceneRect;
+
+  GraphicsLinesContainer::const_iterator itr;
+  for (itr = m_graphicsLinesForCurve.begin (); itr != m_graphicsLinesForCurve.end (); itr++) {
+
+    GraphicsLinesForCurve *graphicsLines = itr.value();
+    graphicsLines->updateVisibleSceneRect (visibleSceneRect);
+  }
+}
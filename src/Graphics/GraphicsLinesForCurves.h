@@ -7,8 +7,12 @@
 #ifndef GRAPHICS_LINES_FOR_CURVES_H
 #define GRAPHICS_LINES_FOR_CURVES_H
 
+#include "Points.h"
 #include <QHash>
+#include <QRectF>
+#include <QStringList>
 
+class CmdDirty;
 class CurveStyles;
 class GeometryWindow;
 class GraphicsLinesForCurve;
@@ -43,14 +47,22 @@ public:
   void addRemoveCurves (GraphicsScene &scene,
                         const QStringList &curveNames);
 
-  /// Mark the end of addPoint calls. Remove stale lines, insert missing lines, and draw the graphics lines
+  /// Return the point with the specified identifier, or null if there is no such point
+  GraphicsPoint *graphicsPointForIdentifier (const QString &identifier) const;
+
+  /// Mark the end of addPoint calls. Remove stale lines, insert missing lines, and draw the graphics lines. Curves
+  /// that are not in the dirty set are left as they are
   void lineMembershipPurge (const CurveStyles &curveStyles,
+                            const CmdDirty &cmdDirty,
                             SplineDrawer &splineDrawer,
                             QPainterPath &pathMultiValued,
                             LineStyle &lineMultiValued);
 
-  /// Mark points as unwanted. Afterwards, lineMembershipPurge gets called
-  void lineMembershipReset ();
+  /// Mark points of the curves in the dirty set as unwanted. Afterwards, lineMembershipPurge gets called
+  void lineMembershipReset (const CmdDirty &cmdDirty);
+
+  /// Identifiers of the points, in all curves, that have moved since the last reset of their position flags
+  QStringList positionHasChangedPointIdentifiers () const;
 
   /// Debugging method for printing directly from symbolic debugger
   void print () const;
@@ -69,6 +81,23 @@ public:
   /// Reset, when loading a document after the first, to same state that first document was at when loaded
   void resetOnLoad();
 
+  /// See GraphicsScene::resetPositionHasChangedFlags
+  void resetPositionHasChangedFlags ();
+
+  /// See GraphicsScene::setPointsAcceptHoverEvents
+  void setPointsAcceptHoverEvents (bool enabled);
+
+  /// See GraphicsScene::setPointsEditable
+  void setPointsEditable (bool enabled);
+
+  /// See GraphicsScene::setPointsOpacity
+  void setPointsOpacity (double opacity);
+
+  /// See GraphicsScene::showCurves
+  void showCurves (bool show,
+                   bool showAll,
+                   const QString &curveName);
+
   /// Update the GraphicsScene with the specified Point from the Document. If it does not exist yet in the scene, we add it
   void updateAfterCommand (GraphicsScene &scene,
                            const CurveStyles &curveStyles,
@@ -76,6 +105,14 @@ public:
                            const Point &point,
                            GeometryWindow *geometryWindow);
 
+  /// Update the GraphicsScene with all of the Points of the specified curve in one pass. See
+  /// GraphicsLinesForCurve::updateAfterCommandPoints
+  void updateAfterCommandPoints (GraphicsScene &scene,
+                                 const CurveStyles &curveStyles,
+                                 const QString &curveName,
+                                 const Points &points,
+                                 GeometryWindow *geometryWindow);
+
   /// Update the curve style for every curve
   void updateCurveStyles (const CurveStyles &modelCurveStyles);
 
@@ -85,16 +122,22 @@ public:
                                                  QPainterPath &pathMultiValued,
                                                  LineStyle &lineMultiValued);
 
-  /// Update the highlight opacity value. This may or may not affect the current display immediately depending on the state
-  void updateHighlightOpacity (double highlightOpacity);
+  /// Update the highlight opacity value of the curves in the dirty set. This may or may not affect the current display
+  /// immediately depending on the state
+  void updateHighlightOpacity (double highlightOpacity,
+                               const CmdDirty &cmdDirty);
 
   /// See GraphicsScene::updateOrdinalsAfterDrag
   void updatePointOrdinalsAfterDrag (const CurveStyles &curveStyles,
                                      const Transformation &transformation);
 
+  /// See GraphicsScene::slotVisibleSceneRectChanged
+  void updateVisibleSceneRect (const QRectF &visibleSceneRect);
+
 private:
 
   GraphicsLinesContainer m_graphicsLinesForCurve;
+  QRectF m_visibleSceneRect; // Passed on to curves that are added later
 };
 
 #endif // GRAPHICS_LINES_FOR_CURVES_H
@@ -12,7 +12,9 @@
 #include "GraphicsPoint.h"
 #include "GraphicsPointEllipse.h"
 #include "GraphicsPointPolygon.h"
+#include "GraphicsPointsBatch.h"
 #include "Logger.h"
+#include "MainWindowModel.h"
 #include "PointStyle.h"
 #include <QGraphicsEllipseItem>
 #include <QGraphicsPolygonItem>
@@ -24,10 +26,13 @@
 #include "QtToString.h"
 #include "ZValues.h"
 
-const double DEFAULT_HIGHLIGHT_OPACITY = 0.35; // 0=transparent to 1=opaque. Values above 0.5 are very hard to notice
 const double MAX_OPACITY = 1.0;
 const double ZERO_WIDTH = 0.0;
 
+const QGraphicsItem::GraphicsItemFlags DEFAULT_FLAGS = QGraphicsItem::ItemIsSelectable |
+                                                       QGraphicsItem::ItemIsMovable |
+                                                       QGraphicsItem::ItemSendsGeometryChanges;
+
 GraphicsPoint::GraphicsPoint(QGraphicsScene &scene,
                              const QString &identifier,
                              const QPointF &posScreen,
@@ -45,10 +50,21 @@ GraphicsPoint::GraphicsPoint(QGraphicsScene &scene,
   m_posScreen (posScreen),
   m_color (color),
   m_lineWidth (lineWidth),
+  m_isCircle (true),
+  m_radius (radius),
+  m_flags (DEFAULT_FLAGS),
+  m_acceptHoverEvents (false),
+  m_opacity (MAX_OPACITY),
+  m_visible (true),
   m_wanted (true),
+  m_hovered (false),
+  m_pointsBatch (nullptr),
   m_highlightOpacity (DEFAULT_HIGHLIGHT_OPACITY),
   m_geometryWindow (geometryWindow)
 {
+  m_data [DATA_KEY_IDENTIFIER] = m_identifier;
+  m_data [DATA_KEY_GRAPHICS_ITEM_TYPE] = GRAPHICS_ITEM_TYPE_POINT;
+
   createPointEllipse (radius);
 }
 
@@ -69,42 +85,48 @@ GraphicsPoint::GraphicsPoint(QGraphicsScene &scene,
   m_posScreen (posScreen),
   m_color (color),
   m_lineWidth (lineWidth),
+  m_isCircle (false),
+  m_radius (0),
+  m_polygon (polygon),
+  m_flags (DEFAULT_FLAGS),
+  m_acceptHoverEvents (false),
+  m_opacity (MAX_OPACITY),
+  m_visible (true),
   m_wanted (true),
+  m_hovered (false),
+  m_pointsBatch (nullptr),
   m_highlightOpacity (DEFAULT_HIGHLIGHT_OPACITY),
   m_geometryWindow (geometryWindow)
 {
+  m_data [DATA_KEY_IDENTIFIER] = m_identifier;
+  m_data [DATA_KEY_GRAPHICS_ITEM_TYPE] = GRAPHICS_ITEM_TYPE_POINT;
+
   createPointPolygon (polygon);
 }
 
 GraphicsPoint::~GraphicsPoint()
 {
-  if (m_graphicsItemEllipse == nullptr) {
-
-    QGraphicsScene *scene = m_graphicsItemPolygon->scene();
-
-    // Since m_shadowZeroWidthPolygon is a child of m_graphicsItemPolygon, removing the parent removes both
-    scene->removeItem (m_graphicsItemPolygon);
-    delete m_graphicsItemPolygon;
-    m_graphicsItemPolygon = nullptr;
-    m_shadowZeroWidthPolygon = nullptr;
-
-
-  } else {
-
-    QGraphicsScene *scene = m_graphicsItemEllipse->scene();
-
-    // Since m_shadowZeroWidthEllipse is a child of m_graphicsItemEllipse, removing the parent removes both
-    scene->removeItem (m_graphicsItemEllipse);
-    delete m_graphicsItemEllipse;
-    m_graphicsItemEllipse = nullptr;
-    m_shadowZeroWidthEllipse = nullptr;
-
+  if (!isDetached ()) {
+    deleteGraphicsItems ();
   }
 }
 
 QRectF GraphicsPoint::boundingRect () const
 {
-  if (m_graphicsItemEllipse == nullptr) {
+  if (isDetached ()) {
+
+    // Same rectangle as the graphics item would have
+    if (m_isCircle) {
+      const int radiusSigned = signed (m_radius);
+      return QRectF (- radiusSigned,
+                     - radiusSigned,
+                     2 * radiusSigned + 1,
+                     2 * radiusSigned + 1);
+    } else {
+      return m_polygon.boundingRect ();
+    }
+
+  } else if (m_graphicsItemEllipse == nullptr) {
     return m_graphicsItemPolygon->boundingRect ();
   } else {
     return m_graphicsItemEllipse->boundingRect ();
@@ -122,16 +144,18 @@ void GraphicsPoint::createPointEllipse (unsigned int radius)
   m_scene.addItem (m_graphicsItemEllipse);
 
   m_graphicsItemEllipse->setZValue (Z_VALUE_POINT);
-  m_graphicsItemEllipse->setData (DATA_KEY_IDENTIFIER, m_identifier);
-  m_graphicsItemEllipse->setData (DATA_KEY_GRAPHICS_ITEM_TYPE, GRAPHICS_ITEM_TYPE_POINT);
+  QHash<int, QVariant>::const_iterator itr;
+  for (itr = m_data.begin(); itr != m_data.end(); itr++) {
+    m_graphicsItemEllipse->setData (itr.key(), itr.value());
+  }
   m_graphicsItemEllipse->setPos (m_posScreen.x (),
                                  m_posScreen.y ());
   m_graphicsItemEllipse->setPen (QPen (QBrush (m_color), m_lineWidth));
   m_graphicsItemEllipse->setEnabled (true);
-  m_graphicsItemEllipse->setFlags (QGraphicsItem::ItemIsSelectable |
-                                   QGraphicsItem::ItemIsMovable |
-                                   QGraphicsItem::ItemSendsGeometryChanges);
-  m_graphicsItemEllipse->setData (DATA_KEY_GRAPHICS_ITEM_TYPE, GRAPHICS_ITEM_TYPE_POINT);
+  m_graphicsItemEllipse->setFlags (m_flags);
+  m_graphicsItemEllipse->setAcceptHoverEvents (m_acceptHoverEvents);
+  m_graphicsItemEllipse->setOpacity (m_opacity);
+  m_graphicsItemEllipse->setVisible (m_visible);
   if (m_geometryWindow != nullptr) {
     QObject::connect (m_graphicsItemEllipse, SIGNAL (signalPointHoverEnter (QString)), m_geometryWindow, SLOT (slotPointHoverEnter (QString)));
     QObject::connect (m_graphicsItemEllipse, SIGNAL (signalPointHoverLeave (QString)), m_geometryWindow, SLOT (slotPointHoverLeave (QString)));
@@ -144,7 +168,7 @@ void GraphicsPoint::createPointEllipse (unsigned int radius)
                                                               - radiusSigned,
                                                               2 * radiusSigned + 1,
                                                               2 * radiusSigned + 1));
-  m_shadowZeroWidthEllipse->setParentItem(m_graphicsItemPolygon); // Dragging parent also drags child
+  m_shadowZeroWidthEllipse->setParentItem(m_graphicsItemEllipse); // Dragging parent also drags child
 
   m_shadowZeroWidthEllipse->setPen (QPen (QBrush (m_color), ZERO_WIDTH));
   m_shadowZeroWidthEllipse->setEnabled (true);
@@ -159,16 +183,18 @@ void GraphicsPoint::createPointPolygon (const QPolygonF &polygon)
   m_scene.addItem (m_graphicsItemPolygon);
 
   m_graphicsItemPolygon->setZValue (Z_VALUE_POINT);
-  m_graphicsItemPolygon->setData (DATA_KEY_IDENTIFIER, m_identifier);
-  m_graphicsItemPolygon->setData (DATA_KEY_GRAPHICS_ITEM_TYPE, GRAPHICS_ITEM_TYPE_POINT);
+  QHash<int, QVariant>::const_iterator itr;
+  for (itr = m_data.begin(); itr != m_data.end(); itr++) {
+    m_graphicsItemPolygon->setData (itr.key(), itr.value());
+  }
   m_graphicsItemPolygon->setPos (m_posScreen.x (),
                                  m_posScreen.y ());
   m_graphicsItemPolygon->setPen (QPen (QBrush (m_color), m_lineWidth));
   m_graphicsItemPolygon->setEnabled (true);
-  m_graphicsItemPolygon->setFlags (QGraphicsItem::ItemIsSelectable |
-                                   QGraphicsItem::ItemIsMovable |
-                                   QGraphicsItem::ItemSendsGeometryChanges);
-  m_graphicsItemPolygon->setData (DATA_KEY_GRAPHICS_ITEM_TYPE, GRAPHICS_ITEM_TYPE_POINT);
+  m_graphicsItemPolygon->setFlags (m_flags);
+  m_graphicsItemPolygon->setAcceptHoverEvents (m_acceptHoverEvents);
+  m_graphicsItemPolygon->setOpacity (m_opacity);
+  m_graphicsItemPolygon->setVisible (m_visible);
   if (m_geometryWindow != nullptr) {
     QObject::connect (m_graphicsItemPolygon, SIGNAL (signalPointHoverEnter (QString)), m_geometryWindow, SLOT (slotPointHoverEnter (QString)));
     QObject::connect (m_graphicsItemPolygon, SIGNAL (signalPointHoverLeave (QString)), m_geometryWindow, SLOT (slotPointHoverLeave (QString)));
@@ -187,11 +213,38 @@ void GraphicsPoint::createPointPolygon (const QPolygonF &polygon)
 }
 
 QVariant GraphicsPoint::data (int key) const
+{
+  return m_data.value (key);
+}
+
+void GraphicsPoint::deleteGraphicsItems ()
+{
+  QGraphicsItem *item = graphicsItem ();
+
+  // Save the state that may have been changed directly on the graphics item, so a recreated item starts out the same
+  m_flags = item->flags ();
+  m_acceptHoverEvents = item->acceptHoverEvents ();
+  m_opacity = item->opacity ();
+  m_visible = item->isVisible ();
+
+  // Since the shadow item is a child of the graphics item, removing the parent removes both
+  item->scene()->removeItem (item);
+  delete item;
+
+  m_graphicsItemEllipse = nullptr;
+  m_shadowZeroWidthEllipse = nullptr;
+  m_graphicsItemPolygon = nullptr;
+  m_shadowZeroWidthPolygon = nullptr;
+
+  m_hovered = false;
+}
+
+QGraphicsItem *GraphicsPoint::graphicsItem () const
 {
   if (m_graphicsItemEllipse == nullptr) {
-    return m_graphicsItemPolygon->data (key);
+    return m_graphicsItemPolygon;
   } else {
-    return m_graphicsItemEllipse->data (key);
+    return m_graphicsItemEllipse;
   }
 }
 
@@ -200,13 +253,51 @@ double GraphicsPoint::highlightOpacity () const
   return m_highlightOpacity;
 }
 
-QPointF GraphicsPoint::pos () const
+bool GraphicsPoint::isDetached () const
 {
-  if (m_graphicsItemEllipse == nullptr) {
-    return m_graphicsItemPolygon->pos ();
-  } else {
-    return m_graphicsItemEllipse->pos ();
+  return (m_graphicsItemEllipse == nullptr &&
+          m_graphicsItemPolygon == nullptr);
+}
+
+bool GraphicsPoint::isPaintedByBatch (double levelOfDetail) const
+{
+  if (m_pointsBatch == nullptr ||
+      !m_visible) {
+    return false;
+  }
+
+  if (isDetached ()) {
+    return true;
   }
+
+  return !isSelected () &&
+         !m_hovered &&
+         GraphicsPointsBatch::isBatchedAtLevelOfDetail (levelOfDetail);
+}
+
+bool GraphicsPoint::isSelected () const
+{
+  if (isDetached ()) {
+    return false;
+  }
+
+  return graphicsItem ()->isSelected ();
+}
+
+QPointF GraphicsPoint::pos () const
+{
+  return m_posScreen;
+}
+
+void GraphicsPoint::positionHasChanged (const QPointF &pos)
+{
+  // Marker at the old position is erased, and then drawn at the new position
+  updatePointsBatch ();
+
+  m_posScreen = pos;
+  setData (DATA_KEY_POSITION_HAS_CHANGED, QVariant (true));
+
+  updatePointsBatch ();
 }
 
 void GraphicsPoint::printStream (QString indentation,
@@ -217,26 +308,16 @@ void GraphicsPoint::printStream (QString indentation,
 
   indentation += INDENTATION_DELTA;
 
-  QString identifier;
-  QString pointType;
-  QPointF pos;
-  if (m_graphicsItemEllipse == nullptr) {
-    identifier = m_graphicsItemPolygon->data (DATA_KEY_IDENTIFIER).toString ();
-    pointType = "polygon";
-    pos = m_graphicsItemPolygon->pos();
-  } else {
-    identifier = m_graphicsItemEllipse->data (DATA_KEY_IDENTIFIER).toString ();
-    pointType = "ellipse";
-    pos = m_graphicsItemEllipse->pos();
-  }
+  QString pointType = (m_isCircle ? "ellipse" : "polygon");
 
   DataKey type = static_cast<DataKey> (data (DATA_KEY_GRAPHICS_ITEM_TYPE).toInt());
 
-  str << indentation << identifier
+  str << indentation << m_identifier
       << " ordinalKey=" << ordinalKey
       << " dataIdentifier=" << data (DATA_KEY_IDENTIFIER).toString().toLatin1().data()
       << " dataType=" << dataKeyToString (type).toLatin1().data()
-      << " " << pointType << "Pos=" << QPointFToString (pos) << "\n";
+      << " " << pointType << "Pos=" << QPointFToString (m_posScreen)
+      << (isDetached () ? " detached" : "") << "\n";
 }
 
 void GraphicsPoint::reset ()
@@ -244,12 +325,53 @@ void GraphicsPoint::reset ()
   m_wanted = false;
 }
 
+void GraphicsPoint::setAcceptHoverEvents (bool enabled)
+{
+  m_acceptHoverEvents = enabled;
+
+  if (!isDetached ()) {
+    graphicsItem ()->setAcceptHoverEvents (enabled);
+  }
+}
+
 void GraphicsPoint::setData (int key, const QVariant &data)
 {
-  if (m_graphicsItemEllipse == nullptr) {
-    m_graphicsItemPolygon->setData (key, data);
+  m_data [key] = data;
+
+  if (!isDetached ()) {
+    graphicsItem ()->setData (key, data);
+  }
+}
+
+void GraphicsPoint::setDetached (bool detached)
+{
+  if (detached == isDetached ()) {
+    return;
+  }
+
+  if (detached) {
+    deleteGraphicsItems ();
+  } else if (m_isCircle) {
+    createPointEllipse (m_radius);
   } else {
-    m_graphicsItemEllipse->setData (key, data);
+    createPointPolygon (m_polygon);
+  }
+
+  // Batch takes over drawing this point, or hands it back
+  updatePointsBatch ();
+}
+
+void GraphicsPoint::setFlag (QGraphicsItem::GraphicsItemFlag flag,
+                             bool enabled)
+{
+  if (enabled) {
+    m_flags |= flag;
+  } else {
+    m_flags &= ~flag;
+  }
+
+  if (!isDetached ()) {
+    graphicsItem ()->setFlag (flag, enabled);
   }
 }
 
@@ -258,73 +380,121 @@ void GraphicsPoint::setHighlightOpacity (double highlightOpacity)
   m_highlightOpacity = highlightOpacity;
 }
 
-void GraphicsPoint::setPassive ()
+void GraphicsPoint::setHovered (bool hovered)
 {
-  if (m_graphicsItemEllipse == nullptr) {
-    m_graphicsItemPolygon->setFlag (QGraphicsItem::ItemIsFocusable, false);
-    m_graphicsItemPolygon->setFlag (QGraphicsItem::ItemIsMovable, false);
-    m_graphicsItemPolygon->setFlag (QGraphicsItem::ItemIsSelectable, false);
-  } else {
-    m_graphicsItemEllipse->setFlag (QGraphicsItem::ItemIsFocusable, false);
-    m_graphicsItemEllipse->setFlag (QGraphicsItem::ItemIsMovable, false);
-    m_graphicsItemEllipse->setFlag (QGraphicsItem::ItemIsSelectable, false);
+  m_hovered = hovered;
+
+  updatePointsBatch ();
+}
+
+void GraphicsPoint::setOpacity (double opacity)
+{
+  m_opacity = opacity;
+
+  if (!isDetached ()) {
+    graphicsItem ()->setOpacity (opacity);
   }
 }
 
+void GraphicsPoint::setPassive ()
+{
+  setFlag (QGraphicsItem::ItemIsFocusable, false);
+  setFlag (QGraphicsItem::ItemIsMovable, false);
+  setFlag (QGraphicsItem::ItemIsSelectable, false);
+}
+
+void GraphicsPoint::setPointsBatch (GraphicsPointsBatch *pointsBatch)
+{
+  m_pointsBatch = pointsBatch;
+}
+
 void GraphicsPoint::setPointStyle(const PointStyle &pointStyle)
 {
+  // Saved so the graphics items can be recreated after being detached, or after a change of shape below
+  m_color = ColorPaletteToQColor (pointStyle.paletteColor());
+  m_lineWidth = pointStyle.lineWidth();
+  m_isCircle = (pointStyle.shape() == POINT_SHAPE_CIRCLE);
+  m_radius = pointStyle.radius();
+  m_polygon = (m_isCircle ? QPolygonF () : pointStyle.polygon());
+
+  if (isDetached ()) {
+    return;
+  }
+
   // Setting pen and radius of parent graphics items below also affects the child shadows
   // (m_shadowItemPolygon and m_shadowItemEllipse)
   if (m_graphicsItemEllipse == nullptr) {
-    if (pointStyle.shape() == POINT_SHAPE_CIRCLE) {
+    if (m_isCircle) {
 
       // Transition from non-circle to circle. Deleting parent also deletes child shadow
-      delete m_graphicsItemPolygon;
-      m_graphicsItemPolygon = nullptr;
-      m_shadowZeroWidthPolygon = nullptr;
-
-      createPointEllipse (unsigned (pointStyle.radius()));
+      deleteGraphicsItems ();
+      createPointEllipse (m_radius);
 
     } else {
 
       // Update polygon
-      m_graphicsItemPolygon->setPen (QPen (ColorPaletteToQColor(pointStyle.paletteColor()),
-                                           pointStyle.lineWidth()));
-      m_shadowZeroWidthPolygon->setPen (QPen (ColorPaletteToQColor(pointStyle.paletteColor()),
-                                              pointStyle.lineWidth()));
-      m_graphicsItemPolygon->setPolygon (pointStyle.polygon());
-      m_shadowZeroWidthPolygon->setPolygon (pointStyle.polygon());
+      m_graphicsItemPolygon->setPen (QPen (m_color,
+                                           m_lineWidth));
+      m_shadowZeroWidthPolygon->setPen (QPen (m_color,
+                                              m_lineWidth));
+      m_graphicsItemPolygon->setPolygon (m_polygon);
+      m_shadowZeroWidthPolygon->setPolygon (m_polygon);
 
     }
   } else {
-    if (pointStyle.shape() != POINT_SHAPE_CIRCLE) {
+    if (!m_isCircle) {
 
       // Transition from circle to non-circlee. Deleting parent also deletes child shadow
-      delete m_graphicsItemEllipse;
-      m_graphicsItemEllipse = nullptr;
-      m_shadowZeroWidthEllipse = nullptr;
-
-      createPointPolygon (pointStyle.polygon());
+      deleteGraphicsItems ();
+      createPointPolygon (m_polygon);
 
     } else {
 
       // Update circle
-      m_graphicsItemEllipse->setPen (QPen (ColorPaletteToQColor(pointStyle.paletteColor()),
-                                           pointStyle.lineWidth()));
-      m_shadowZeroWidthEllipse->setPen (QPen (ColorPaletteToQColor(pointStyle.paletteColor()),
-                                           pointStyle.lineWidth()));
-      m_graphicsItemEllipse->setRadius (pointStyle.radius());
-      m_shadowZeroWidthEllipse->setRadius (pointStyle.radius());
+      m_graphicsItemEllipse->setPen (QPen (m_color,
+                                           m_lineWidth));
+      m_shadowZeroWidthEllipse->setPen (QPen (m_color,
+                                              m_lineWidth));
+      m_graphicsItemEllipse->setRadius (signed (m_radius)); // Child shadow is scaled along with its parent
     }
   }
 }
 
 void GraphicsPoint::setPos (const QPointF pos)
 {
-  if (m_graphicsItemEllipse == nullptr) {
-    m_graphicsItemPolygon->setPos (pos);
+  if (isDetached ()) {
+
+    // Graphics item would report the move through positionHasChanged, so a detached point does the same
+    if (pos != m_posScreen) {
+      positionHasChanged (pos);
+    }
+
   } else {
-    m_graphicsItemEllipse->setPos (pos);
+    graphicsItem ()->setPos (pos);
+  }
+}
+
+void GraphicsPoint::setSelected (bool selected)
+{
+  if (isDetached ()) {
+
+    if (!selected) {
+      return;
+    }
+
+    // Selection lives in the graphics items, so they are recreated
+    setDetached (false);
+  }
+
+  graphicsItem ()->setSelected (selected);
+}
+
+void GraphicsPoint::setVisible (bool visible)
+{
+  m_visible = visible;
+
+  if (!isDetached ()) {
+    graphicsItem ()->setVisible (visible);
   }
 }
 
@@ -338,6 +508,13 @@ void GraphicsPoint::updateCurveStyle (const CurveStyle &curveStyle)
   setPointStyle (curveStyle.pointStyle()); // This point
 }
 
+void GraphicsPoint::updatePointsBatch ()
+{
+  if (m_pointsBatch != nullptr) {
+    m_pointsBatch->updatePoint (m_posScreen);
+  }
+}
+
 bool GraphicsPoint::wanted () const
 {
   return m_wanted;
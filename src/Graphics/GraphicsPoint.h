@@ -9,22 +9,23 @@
 
 #include "GraphicsPointAbstractBase.h"
 #include <QColor>
+#include <QGraphicsItem>
+#include <QHash>
 #include <QPointF>
+#include <QPolygonF>
 #include <QRectF>
+#include <QVariant>
 
-extern const double DEFAULT_HIGHLIGHT_OPACITY;
 extern const double MAX_OPACITY;
 
 class CurveStyle;
 class GeometryWindow;
 class GraphicsPointEllipse;
 class GraphicsPointPolygon;
+class GraphicsPointsBatch;
 class PointStyle;
-class QColor;
 class QGraphicsScene;
-class QPolygonF;
 class QTextStream;
-class QVariant;
 
 /// Graphics item for drawing a circular or polygonal Point. 
 ///
@@ -40,6 +41,10 @@ class QVariant;
 /// based on QGraphicsEllipseItem and another on QGraphicsPolygonItem, so having a single class (for the convenience
 /// of the external code) would involve multiple inheritance (of those two classes). With the inheritance approach, 
 /// using just the methods supplied by QGraphicsItem would be inadequate.
+///
+/// Points of dense curves can be detached, which deletes the graphics items while GraphicsPointsBatch draws the
+/// point. The state of the graphics items (position, data, flags, opacity, visibility) is kept here so the graphics
+/// items can be recreated with the same state when the point scrolls back into view
 class GraphicsPoint : public GraphicsPointAbstractBase
 {
 public:
@@ -73,9 +78,24 @@ public:
   /// Get method for highlight opacity
   double highlightOpacity () const;
 
+  /// True if the graphics items have been deleted by setDetached
+  bool isDetached () const;
+
+  /// True if this point skips its own painting at the specified level of detail since GraphicsPointsBatch draws
+  /// it instead. Selected and hovered points are always painted individually so they stay highlighted. Detached
+  /// points have no graphics items so they are always drawn by GraphicsPointsBatch
+  bool isPaintedByBatch (double levelOfDetail) const;
+
+  /// Proxy method for QGraphicsItem::isSelected. Detached points are never selected
+  bool isSelected () const;
+
   /// Proxy method for QGraphicsItem::pos.
   QPointF pos () const;
 
+  /// Called by the graphics item after it has moved, so the flag read by positionHasChangedPointIdentifiers is
+  /// set and GraphicsPointsBatch repaints the old and new positions
+  void positionHasChanged (const QPointF &pos);
+
   /// Debugging method that supports print method of this class and printStream method of some other class(es)
   void printStream (QString indentation,
                     QTextStream &str,
@@ -84,12 +104,29 @@ public:
   /// Mark point as unwanted, and unbind any bound lines.
   void reset();
 
+  /// Proxy method for QGraphicsItem::setAcceptHoverEvents
+  void setAcceptHoverEvents (bool enabled);
+
   /// Proxy method for QGraphicsItem::setData
   void setData (int key, const QVariant &data);
 
+  /// Delete the graphics items, or recreate them with the saved state. Selecting a detached point recreates them
+  void setDetached (bool detached);
+
+  /// Proxy method for QGraphicsItem::setFlag
+  void setFlag (QGraphicsItem::GraphicsItemFlag flag,
+                bool enabled);
+
   /// Set method for highlight opacity
   void setHighlightOpacity (double highlightOpacity);
 
+  /// Called by the graphics item when the cursor enters or leaves it, so GraphicsPointsBatch skips this point while
+  /// it is highlighted
+  void setHovered (bool hovered);
+
+  /// Proxy method for QGraphicsItem::setOpacity
+  void setOpacity (double opacity);
+
   /// Update the point style
   void setPointStyle (const PointStyle &pointStyle);
 
@@ -99,6 +136,15 @@ public:
   /// Prevent automatic focus on point (=make it passive) for scale bar so drags can be made to work properly
   void setPassive ();
 
+  /// Set the GraphicsPointsBatch of a curve dense enough to be drawn that way, or null if the curve is not
+  void setPointsBatch (GraphicsPointsBatch *pointsBatch);
+
+  /// Proxy method for QGraphicsItem::setSelected
+  void setSelected (bool selected);
+
+  /// Proxy method for QGraphicsItem::setVisible
+  void setVisible (bool visible);
+
   /// Mark point as wanted. Marking as unwanted is done by the reset function
   void setWanted ();
 
@@ -113,6 +159,9 @@ private:
 
   void createPointEllipse (unsigned int radius); // Attributes shared by circle and polygon points are passed through member variables
   void createPointPolygon (const QPolygonF &polygon); // Attributes shared by circle and polygon points are passed through member variables
+  void deleteGraphicsItems (); // Shadow items are children so they are deleted along with their parents
+  QGraphicsItem *graphicsItem () const; // Ellipse or polygon item, or null if detached
+  void updatePointsBatch (); // Repaint the marker that GraphicsPointsBatch may draw at the current position
 
   QGraphicsScene &m_scene;
 
@@ -126,12 +175,25 @@ private:
 
   // Shared attributes
   const QString m_identifier;
-  const QPointF m_posScreen;
-  const QColor m_color;
+  QPointF m_posScreen; // Kept current so detached points can be drawn and recreated
+  QColor m_color;
   double m_lineWidth;
+  bool m_isCircle;
+  unsigned int m_radius; // Unused if point is polygonal
+  QPolygonF m_polygon; // Unused if point is elliptical
+
+  // State of the graphics items, which is kept while detached
+  QHash<int, QVariant> m_data;
+  QGraphicsItem::GraphicsItemFlags m_flags;
+  bool m_acceptHoverEvents;
+  double m_opacity;
+  bool m_visible;
 
   // Housekeeping
   bool m_wanted;
+  bool m_hovered;
+
+  GraphicsPointsBatch *m_pointsBatch; // Null if this point is not batched
 
   double m_highlightOpacity;
 
@@ -10,6 +10,8 @@
 #include "Logger.h"
 #include <QColor>
 #include <QGraphicsScene>
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
 #include "QtToString.h"
 
 GraphicsPointEllipse::GraphicsPointEllipse(GraphicsPoint &graphicsPoint,
@@ -25,6 +27,8 @@ void GraphicsPointEllipse::hoverEnterEvent(QGraphicsSceneHoverEvent *event)
   // Highlighted
   setOpacityForSubtree (m_graphicsPoint.highlightOpacity());
 
+  m_graphicsPoint.setHovered (true);
+
   emit signalPointHoverEnter (data (DATA_KEY_IDENTIFIER).toString ());
 
   QGraphicsEllipseItem::hoverEnterEvent (event);
@@ -35,6 +39,8 @@ void GraphicsPointEllipse::hoverLeaveEvent(QGraphicsSceneHoverEvent *event)
   // Unhighlighted
   setOpacityForSubtree (MAX_OPACITY);
 
+  m_graphicsPoint.setHovered (false);
+
   emit signalPointHoverLeave (data (DATA_KEY_IDENTIFIER).toString ());
 
   QGraphicsEllipseItem::hoverLeaveEvent (event);
@@ -44,13 +50,26 @@ QVariant GraphicsPointEllipse::itemChange(GraphicsItemChange change,
                                           const QVariant &value)
 {
   if (change == QGraphicsItem::ItemPositionHasChanged) {
-    setData (DATA_KEY_POSITION_HAS_CHANGED, QVariant (true));
+    m_graphicsPoint.positionHasChanged (value.toPointF ());
   }
 
   return QGraphicsEllipseItem::itemChange(change,
                                           value);
 }
 
+void GraphicsPointEllipse::paint(QPainter *painter,
+                                 const QStyleOptionGraphicsItem *option,
+                                 QWidget *widget)
+{
+  if (m_graphicsPoint.isPaintedByBatch (option->levelOfDetailFromTransform (painter->worldTransform ()))) {
+    return;
+  }
+
+  QGraphicsEllipseItem::paint (painter,
+                               option,
+                               widget);
+}
+
 void GraphicsPointEllipse::setOpacityForSubtree (double opacity)
 {
   // Set this item
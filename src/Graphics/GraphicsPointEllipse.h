@@ -23,7 +23,8 @@ public:
   GraphicsPointEllipse(GraphicsPoint &graphicsPoint,
                        const QRect &rect);
 
-  /// Intercept moves by dragging so moved items can be identified. This replaces unreliable hit tests.
+  /// Intercept moves by dragging so moved items can be identified. This replaces unreliable hit tests. The
+  /// GraphicsPoint is told so it can update GraphicsPointsBatch
   QVariant itemChange(GraphicsItemChange change, const QVariant &value);
 
   /// Accept hover so point can be highlighted when cursor is over it as a guide to user
@@ -32,6 +33,11 @@ public:
   /// Unhighlight this point
   virtual void hoverLeaveEvent(QGraphicsSceneHoverEvent *event);
 
+  /// Skip painting when zoomed out far enough that GraphicsPointsBatch draws this point along with the rest of its curve
+  virtual void paint(QPainter *painter,
+                     const QStyleOptionGraphicsItem *option,
+                     QWidget *widget);
+
   /// Update the radius
   void setRadius(int radius);
 
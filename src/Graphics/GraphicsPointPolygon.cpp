@@ -9,6 +9,8 @@
 #include "GraphicsPointPolygon.h"
 #include "Logger.h"
 #include <QGraphicsScene>
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
 #include "QtToString.h"
 
 GraphicsPointPolygon::GraphicsPointPolygon(GraphicsPoint &graphicsPoint,
@@ -24,6 +26,8 @@ void GraphicsPointPolygon::hoverEnterEvent(QGraphicsSceneHoverEvent *event)
   // Highlighted
   setOpacityForSubtree (m_graphicsPoint.highlightOpacity ());
 
+  m_graphicsPoint.setHovered (true);
+
   emit signalPointHoverEnter (data (DATA_KEY_IDENTIFIER).toString ());
 
   QGraphicsPolygonItem::hoverEnterEvent (event);
@@ -34,6 +38,8 @@ void GraphicsPointPolygon::hoverLeaveEvent(QGraphicsSceneHoverEvent *event)
   // Unhighlighted
   setOpacityForSubtree (MAX_OPACITY);
 
+  m_graphicsPoint.setHovered (false);
+
   emit signalPointHoverLeave (data (DATA_KEY_IDENTIFIER).toString ());
 
   QGraphicsPolygonItem::hoverLeaveEvent (event);
@@ -43,13 +49,26 @@ QVariant GraphicsPointPolygon::itemChange(GraphicsItemChange change,
                                           const QVariant &value)
 {
   if (change == QGraphicsItem::ItemPositionHasChanged) {
-    setData (DATA_KEY_POSITION_HAS_CHANGED, QVariant (true));
+    m_graphicsPoint.positionHasChanged (value.toPointF ());
   }
 
   return QGraphicsPolygonItem::itemChange(change,
                                           value);
 }
 
+void GraphicsPointPolygon::paint(QPainter *painter,
+                                 const QStyleOptionGraphicsItem *option,
+                                 QWidget *widget)
+{
+  if (m_graphicsPoint.isPaintedByBatch (option->levelOfDetailFromTransform (painter->worldTransform ()))) {
+    return;
+  }
+
+  QGraphicsPolygonItem::paint (painter,
+                               option,
+                               widget);
+}
+
 void GraphicsPointPolygon::setOpacityForSubtree (double opacity)
 {
   // Set this item
@@ -0,0 +1,158 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#include "EnumsToQt.h"
+#include "GraphicsPoint.h"
+#include "GraphicsPointsBatch.h"
+#include <QPainter>
+#include <QPainterPath>
+#include <QStyleOptionGraphicsItem>
+#include "PointStyle.h"
+
+const int BATCH_MINIMUM_POINTS = 1000; // Below this the per-point items draw fast enough
+const double BATCH_MAXIMUM_LEVEL_OF_DETAIL = 1.0; // Batch below actual size, where markers are too small to inspect
+
+GraphicsPointsBatch::GraphicsPointsBatch(QGraphicsItem *parent) :
+  QGraphicsItem (parent),
+  m_isCircle (true),
+  m_radius (0)
+{
+  // Exposed rectangle is used to skip markers that are off screen
+  setFlag (QGraphicsItem::ItemUsesExtendedStyleOption, true);
+}
+
+int GraphicsPointsBatch::batchMinimumPoints ()
+{
+  return BATCH_MINIMUM_POINTS;
+}
+
+QRectF GraphicsPointsBatch::boundingRect () const
+{
+  return m_boundingRect;
+}
+
+bool GraphicsPointsBatch::isBatchedAtLevelOfDetail (double levelOfDetail)
+{
+  return levelOfDetail < BATCH_MAXIMUM_LEVEL_OF_DETAIL;
+}
+
+QRectF GraphicsPointsBatch::markerRect (const QPointF &pos) const
+{
+  double margin = m_radius + m_pen.widthF ();
+  return QRectF (pos.x () - margin,
+                 pos.y () - margin,
+                 2 * margin,
+                 2 * margin);
+}
+
+void GraphicsPointsBatch::paint (QPainter *painter,
+                                 const QStyleOptionGraphicsItem *option,
+                                 QWidget * /* widget */)
+{
+  if (m_points.isEmpty ()) {
+    return;
+  }
+
+  double levelOfDetail = option->levelOfDetailFromTransform (painter->worldTransform ());
+
+  painter->setPen (m_pen);
+  painter->setBrush (Qt::NoBrush);
+
+  // Markers that overlap the exposed rectangle are drawn
+  double margin = m_radius + m_pen.widthF ();
+  QRectF exposedRect = option->exposedRect.adjusted (-margin, -margin, margin, margin);
+
+  QVector<const GraphicsPoint*>::const_iterator itr;
+  for (itr = m_points.begin (); itr != m_points.end (); itr++) {
+
+    const GraphicsPoint *point = *itr;
+    QPointF pos = point->pos ();
+    if (exposedRect.contains (pos) &&
+        point->isPaintedByBatch (levelOfDetail)) {
+
+      if (m_isCircle) {
+        painter->drawEllipse (pos, m_radius, m_radius);
+      } else {
+        painter->drawPolygon (m_polygon.translated (pos));
+      }
+    }
+  }
+}
+
+void GraphicsPointsBatch::removePoint (const GraphicsPoint *point)
+{
+  if (m_points.removeOne (point)) {
+    update (markerRect (point->pos ()));
+  }
+}
+
+void GraphicsPointsBatch::setPointStyle (const PointStyle &pointStyle)
+{
+  prepareGeometryChange ();
+
+  m_pen = QPen (QBrush (ColorPaletteToQColor (pointStyle.paletteColor ())),
+                pointStyle.lineWidth ());
+  m_isCircle = pointStyle.isCircle ();
+  m_radius = pointStyle.radius ();
+  m_polygon = (m_isCircle ? QPolygonF () : pointStyle.polygon ());
+
+  updateBoundingRect ();
+}
+
+void GraphicsPointsBatch::setPoints (const QVector<const GraphicsPoint*> &points)
+{
+  prepareGeometryChange ();
+
+  m_points = points;
+
+  updateBoundingRect ();
+}
+
+QPainterPath GraphicsPointsBatch::shape () const
+{
+  return QPainterPath ();
+}
+
+void GraphicsPointsBatch::updateBoundingRect ()
+{
+  if (m_points.isEmpty ()) {
+
+    m_boundingRect = QRectF ();
+
+  } else {
+
+    double xMin = m_points.first ()->pos ().x (), xMax = xMin;
+    double yMin = m_points.first ()->pos ().y (), yMax = yMin;
+
+    QVector<const GraphicsPoint*>::const_iterator itr;
+    for (itr = m_points.begin (); itr != m_points.end (); itr++) {
+      QPointF pos = (*itr)->pos ();
+      xMin = qMin (xMin, pos.x ());
+      xMax = qMax (xMax, pos.x ());
+      yMin = qMin (yMin, pos.y ());
+      yMax = qMax (yMax, pos.y ());
+    }
+
+    double margin = m_radius + m_pen.widthF ();
+    m_boundingRect = QRectF (QPointF (xMin - margin, yMin - margin),
+                             QPointF (xMax + margin, yMax + margin));
+  }
+}
+
+void GraphicsPointsBatch::updatePoint (const QPointF &pos)
+{
+  if (m_points.isEmpty ()) {
+    return;
+  }
+
+  QRectF rect = markerRect (pos);
+  if (!m_boundingRect.contains (rect)) {
+    prepareGeometryChange ();
+    m_boundingRect |= rect;
+  }
+
+  update (rect);
+}
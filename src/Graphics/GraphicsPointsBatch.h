@@ -0,0 +1,79 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef GRAPHICS_POINTS_BATCH_H
+#define GRAPHICS_POINTS_BATCH_H
+
+#include <QGraphicsItem>
+#include <QPen>
+#include <QPolygonF>
+#include <QRectF>
+#include <QVector>
+
+class GraphicsPoint;
+class PointStyle;
+class QPainter;
+
+/// Level of detail renderer that draws all points of one dense curve in a single paint call when the view is zoomed
+/// out. The per-point GraphicsPoint items handle selection, dragging and hovering, but skip their own painting at
+/// that zoom level. Zoomed in, the per-point items take over. Points far outside the view are detached from their
+/// graphics items, and this item draws them at every zoom level. Positions are read from the points when painting,
+/// so dragged points are drawn where they are. This item has an empty shape so it never takes mouse events away from
+/// the points
+class GraphicsPointsBatch : public QGraphicsItem
+{
+public:
+  /// Single constructor. The parent is the GraphicsLinesForCurve of the same curve, so this item shows, hides and
+  /// is deleted along with it
+  GraphicsPointsBatch(QGraphicsItem *parent);
+
+  /// Curves with fewer points than this are always drawn point by point
+  static int batchMinimumPoints ();
+
+  /// Bounding rectangle of all markers
+  virtual QRectF boundingRect () const;
+
+  /// True if a curve with batching enabled is drawn by this class at the specified level of detail, from
+  /// QStyleOptionGraphicsItem::levelOfDetailFromTransform
+  static bool isBatchedAtLevelOfDetail (double levelOfDetail);
+
+  /// Draw the markers, of the points that are not drawn by their own graphics items, that fall inside the exposed
+  /// rectangle
+  virtual void paint (QPainter *painter,
+                      const QStyleOptionGraphicsItem *option,
+                      QWidget *widget);
+
+  /// Remove a point that is about to be deleted
+  void removePoint (const GraphicsPoint *point);
+
+  /// Update the marker shape and pen
+  void setPointStyle (const PointStyle &pointStyle);
+
+  /// Update the points. An empty list turns this item off
+  void setPoints (const QVector<const GraphicsPoint*> &points);
+
+  /// Empty, so mouse presses and rubber band selection go to the per-point items
+  virtual QPainterPath shape () const;
+
+  /// Repaint the marker at the specified position, after a point has moved there, moved away, or changed between
+  /// being drawn here and being drawn by its own graphics items. The bounding rectangle grows to include the marker
+  void updatePoint (const QPointF &pos);
+
+private:
+  GraphicsPointsBatch();
+
+  QRectF markerRect (const QPointF &pos) const; // Rectangle covered by the marker at the specified position
+  void updateBoundingRect ();
+
+  QVector<const GraphicsPoint*> m_points;
+  QPen m_pen;
+  bool m_isCircle;
+  double m_radius;
+  QPolygonF m_polygon; // Marker for a non-circle, centered on the origin
+  QRectF m_boundingRect;
+};
+
+#endif // GRAPHICS_POINTS_BATCH_H
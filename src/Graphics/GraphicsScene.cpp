@@ -5,6 +5,7 @@
  ******************************************************************************************************/
 
 #include "CallbackSceneUpdateAfterCommand.h"
+#include "CmdDirty.h"
 #include "Curve.h"
 #include "CurvesGraphs.h"
 #include "CurveStyles.h"
@@ -12,6 +13,7 @@
 #include "EngaugeAssert.h"
 #include "EnumsToQt.h"
 #include "GeometryWindow.h"
+#include "GraphicsImageTiled.h"
 #include "GraphicsItemType.h"
 #include "GraphicsPoint.h"
 #include "GraphicsPointFactory.h"
@@ -36,6 +38,16 @@ GraphicsScene::~GraphicsScene()
 {
 }
 
+GraphicsImageTiled *GraphicsScene::addImage (const QImage &image)
+{
+  GraphicsImageTiled *imageItem = new GraphicsImageTiled;
+  imageItem->setImage (image);
+  addItem (imageItem);
+  m_imageItems << imageItem;
+
+  return imageItem;
+}
+
 void GraphicsScene::addTemporaryPoint (const QString &identifier,
                                        GraphicsPoint *point)
 {
@@ -100,11 +112,19 @@ QString GraphicsScene::dumpCursors () const
   return dump;
 }
 
+GraphicsPoint *GraphicsScene::graphicsPointForIdentifier (const QString &identifier) const
+{
+  return m_graphicsLinesForCurves.graphicsPointForIdentifier (identifier);
+}
+
 void GraphicsScene::hideAllItemsExceptImage()
 {
 
-  for (int index = 0; index < QGraphicsScene::items().count(); index++) {
-    QGraphicsItem *item = QGraphicsScene::items().at(index);
+  // Every item is visited, so the item list is copied just once
+  const QList<QGraphicsItem*> items = QGraphicsScene::items();
+  QList<QGraphicsItem*>::const_iterator itr;
+  for (itr = items.begin(); itr != items.end(); itr++) {
+    QGraphicsItem *item = *itr;
 
     if (item->data (DATA_KEY_GRAPHICS_ITEM_TYPE).toInt() == GRAPHICS_ITEM_TYPE_IMAGE) {
 
@@ -118,51 +138,22 @@ void GraphicsScene::hideAllItemsExceptImage()
   }
 }
 
-const QGraphicsPixmapItem *GraphicsScene::image () const
+const GraphicsImageTiled *GraphicsScene::image () const
 {
-  // Loop through items in scene to find the image
-  QList<QGraphicsItem*> items = QGraphicsScene::items();
-  QList<QGraphicsItem*>::iterator itr;
-  for (itr = items.begin(); itr != items.end(); itr++) {
-
-    QGraphicsItem* item = *itr;
-    if (item->data (DATA_KEY_GRAPHICS_ITEM_TYPE).toInt () == GRAPHICS_ITEM_TYPE_IMAGE) {
-
-      return dynamic_cast<QGraphicsPixmapItem *> (item);
-    }
+  // Image items share one z value, so the most recently added one is on top. That is the one that a search through
+  // the items in stacking order would find first
+  if (m_imageItems.isEmpty ()) {
+    return nullptr;
   }
 
-  return nullptr;
+  return m_imageItems.last ();
 }
 
 QStringList GraphicsScene::positionHasChangedPointIdentifiers () const
 {
 
-  QStringList movedIds;
-
-  const QList<QGraphicsItem*> &items = QGraphicsScene::items();
-  QList<QGraphicsItem*>::const_iterator itr;
-  for (itr = items.begin(); itr != items.end(); itr++) {
-
-    const QGraphicsItem *item = *itr;
-
-    // Skip the image and only keep the Points
-    bool isPoint = (item->data (DATA_KEY_GRAPHICS_ITEM_TYPE).toInt () == GRAPHICS_ITEM_TYPE_POINT);
-    if (isPoint) {
-
-      QString identifier = item->data (DATA_KEY_IDENTIFIER).toString ();
-      bool positionHasChanged = item->data (DATA_KEY_POSITION_HAS_CHANGED).toBool ();
-
-      if (isPoint && positionHasChanged) {
-
-        // Add Point to the list
-        movedIds << item->data(DATA_KEY_IDENTIFIER).toString ();
-
-      }
-    }
-  }
-
-  return  movedIds;
+  // Only the points are visited, rather than every item in the scene
+  return m_graphicsLinesForCurves.positionHasChangedPointIdentifiers ();
 }
 
 void GraphicsScene::printStream (QString indentation,
@@ -191,78 +182,66 @@ void GraphicsScene::removeTemporaryScaleBarIfExists ()
 void GraphicsScene::resetOnLoad()
 {
 
-  int itemsBefore = items().count();
-
   m_graphicsLinesForCurves.resetOnLoad();
+}
 
-  int itemsAfter = items().count();
+void GraphicsScene::resetPositionHasChangedFlags()
+{
 
+  // Only the points are visited, rather than every item in the scene
+  m_graphicsLinesForCurves.resetPositionHasChangedFlags ();
 }
 
-void GraphicsScene::resetPositionHasChangedFlags()
+void GraphicsScene::setPointsAcceptHoverEvents (bool enabled)
 {
+  m_graphicsLinesForCurves.setPointsAcceptHoverEvents (enabled);
+}
 
-  QList<QGraphicsItem*> itms = items ();
-  QList<QGraphicsItem*>::const_iterator itr;
-  for (itr = itms.begin (); itr != itms.end (); itr++) {
+void GraphicsScene::setPointsEditable (bool enabled)
+{
+  m_graphicsLinesForCurves.setPointsEditable (enabled);
+}
 
-    QGraphicsItem *item = *itr;
-    item->setData (DATA_KEY_POSITION_HAS_CHANGED, false);
-  }
+void GraphicsScene::setPointsOpacity (double opacity)
+{
+  m_graphicsLinesForCurves.setPointsOpacity (opacity);
 }
 
 void GraphicsScene::showCurves (bool show,
                                 bool showAll,
                                 const QString &curveNameWanted)
 {
-  const QList<QGraphicsItem*> &items = QGraphicsScene::items();
-  QList<QGraphicsItem*>::const_iterator itr;
-  for (itr = items.begin(); itr != items.end(); itr++) {
-
-    QGraphicsItem* item = *itr;
-
-    // Skip the image and only process the Points
-    bool isPoint = (item->data (DATA_KEY_GRAPHICS_ITEM_TYPE).toInt () == GRAPHICS_ITEM_TYPE_POINT);
-    bool isCurve = (item->data (DATA_KEY_GRAPHICS_ITEM_TYPE).toInt () == GRAPHICS_ITEM_TYPE_LINE);
-
-    if (isPoint || isCurve) {
-
-      bool showThis = show;
-      if (show && !showAll) {
-        QString identifier = item->data (DATA_KEY_IDENTIFIER).toString ();
-
-        if (isPoint) {
-
-          QString curveNameGot = Point::curveNameFromPointIdentifier (identifier);
-          showThis = (curveNameWanted == curveNameGot);
-
-        } else {
-
-          showThis = (curveNameWanted == identifier);
-
-        }
-      }
-
-      item->setVisible (showThis);
+  // Points and lines are already grouped by curve, so no identifiers need to be parsed
+  m_graphicsLinesForCurves.showCurves (show,
+                                       showAll,
+                                       curveNameWanted);
+}
 
-    }
-  }
+void GraphicsScene::slotVisibleSceneRectChanged (QRectF visibleSceneRect)
+{
+  m_graphicsLinesForCurves.updateVisibleSceneRect (visibleSceneRect);
 }
 
 void GraphicsScene::updateAfterCommand (CmdMediator &cmdMediator,
                                         double highlightOpacity,
                                         GeometryWindow *geometryWindow,
-                                        const Transformation &transformation)
+                                        const Transformation &transformation,
+                                        const CmdDirty &cmdDirty)
 {
 
-  m_graphicsLinesForCurves.updateHighlightOpacity (highlightOpacity);
+  m_graphicsLinesForCurves.updateHighlightOpacity (highlightOpacity,
+                                                   cmdDirty);
 
-  updateCurves (cmdMediator);
+  // Curves are only added and removed by settings and loading, which mark everything as changed
+  if (cmdDirty.isAll ()) {
+    updateCurves (cmdMediator);
+  }
 
   // Update the points
   updatePointMembership (cmdMediator,
                          geometryWindow,
-                         transformation);
+                         transformation,
+                         cmdDirty);
 }
 
 void GraphicsScene::updateCurves (CmdMediator &cmdMediator)
@@ -326,7 +305,8 @@ void GraphicsScene::updatePathItemMultiValued (const QPainterPath &pathMultiValu
 
 void GraphicsScene::updatePointMembership (CmdMediator &cmdMediator,
                                            GeometryWindow *geometryWindow,
-                                           const Transformation &transformation)
+                                           const Transformation &transformation,
+                                           const CmdDirty &cmdDirty)
 {
 
   CallbackSceneUpdateAfterCommand ftor (m_graphicsLinesForCurves,
@@ -338,20 +318,41 @@ void GraphicsScene::updatePointMembership (CmdMediator &cmdMediator,
 
   // First pass:
   // 1) Mark all points as Not Wanted (this is done while creating the map)
-  m_graphicsLinesForCurves.lineMembershipReset ();
+  m_graphicsLinesForCurves.lineMembershipReset (cmdDirty);
 
   // Next pass:
   // 1) Existing points that are found in the map are marked as Wanted
   // 2) Add new points that were just created in the Document. The new points are marked as Wanted
-  cmdMediator.iterateThroughCurvePointsAxes (ftorWithCallback);
-  cmdMediator.iterateThroughCurvesPointsGraphs (ftorWithCallback);
+  // Only the curves that were reset are visited, since points of the other curves were never marked as Not Wanted.
+  // Each graph curve is handled in one pass over its points, so a curve that just received many points gets all
+  // of its new items at once
+  if (cmdDirty.isAxes ()) {
+    cmdMediator.iterateThroughCurvePointsAxes (ftorWithCallback);
+  }
+
+  const Document &document = cmdMediator.document ();
+  const CurveStyles curveStyles = document.modelCurveStyles ();
+  QStringList curveNames = document.curvesGraphsNames ();
+  QStringList::const_iterator itr;
+  for (itr = curveNames.begin(); itr != curveNames.end(); itr++) {
+
+    const QString &curveName = *itr;
+    if (cmdDirty.isCurveOrAxes (curveName)) {
+      m_graphicsLinesForCurves.updateAfterCommandPoints (*this,
+                                                         curveStyles,
+                                                         curveName,
+                                                         document.curveForCurveName (curveName)->points (),
+                                                         geometryWindow);
+    }
+  }
 
   // Next pass:
   // 1) Remove points that were just removed from the Document
   SplineDrawer splineDrawer (transformation);
   QPainterPath pathMultiValued;
   LineStyle lineMultiValued;
-  m_graphicsLinesForCurves.lineMembershipPurge (cmdMediator.document().modelCurveStyles(),
+  m_graphicsLinesForCurves.lineMembershipPurge (curveStyles,
+                                                cmdDirty,
                                                 splineDrawer,
                                                 pathMultiValued,
                                                 lineMultiValued);
@@ -10,19 +10,23 @@
 #include "CmdMediator.h"
 #include "GraphicsLinesForCurves.h"
 #include <QGraphicsScene>
+#include <QList>
 #include <QObject>
 #include <QStringList>
 
+class CmdDirty;
 class CmdMediator;
 class Curve;
 class CurvesGraphs;
 class CurveStyles;
 class GeometryWindow;
+class GraphicsImageTiled;
 class GraphicsPoint;
 class LineStyle;
 class MainWindow;
 class PointStyle;
 class QGraphicsPathItem;
+class QImage;
 class QTextStream;
 class ScaleBar;
 class Transformation;
@@ -45,6 +49,9 @@ public:
   /// Virtual destructor needed since using Q_OBJECT
   virtual ~GraphicsScene();
 
+  /// Add a background image item. Image items are tracked so they can be found without searching through every item
+  GraphicsImageTiled *addImage (const QImage &image);
+
   /// Add one temporary point to m_graphicsLinesForCurves. Non-temporary points are handled by the updateLineMembership functions
   void addTemporaryPoint (const QString &identifier,
                           GraphicsPoint *point);
@@ -62,6 +69,9 @@ public:
                               const QPointF &posScreen,
                               GeometryWindow *geometryWindow);
 
+  /// Return the point with the specified identifier, or null if there is no such point. This is a hash lookup
+  GraphicsPoint *graphicsPointForIdentifier (const QString &identifier) const;
+
   /// Hide all graphics items, except background image, in preparation for preview during IMPORT_TYPE_ADVANCED
   void hideAllItemsExceptImage();
 
@@ -85,20 +95,32 @@ public:
   /// Reset, when loading a document after the first, to same state that first document was at when loaded
   void resetOnLoad();
 
-  /// Reset positionHasChanged flag for all items. Typically this is done as part of mousePressEvent.
+  /// Reset positionHasChanged flag for all points. Typically this is done as part of mousePressEvent.
   void resetPositionHasChangedFlags();
 
+  /// Enable or disable hover highlighting of all points. Unlike looping through the items, this includes points that
+  /// are detached from their graphics items since they are outside of the view
+  void setPointsAcceptHoverEvents (bool enabled);
+
+  /// Allow or prevent selecting, moving and focusing of all points, including detached points
+  void setPointsEditable (bool enabled);
+
+  /// Set opacity of all points, including detached points
+  void setPointsOpacity (double opacity);
+
   /// Show or hide all Curves (if showAll is true) or just the selected Curve (if showAll is false);
   void showCurves (bool show,
                    bool showAll = false,
                    const QString &curveName = "");
 
   /// Update the Points and their Curves after executing a command. After a mouse drag, the lines are already updated and
-  /// updating would be done on out of date information (since that would be brought up to date by the NEXT command)
+  /// updating would be done on out of date information (since that would be brought up to date by the NEXT command).
+  /// Only the curves in the dirty set are updated
   void updateAfterCommand (CmdMediator &cmdMediator,
                            double highlightOpacity,
                            GeometryWindow *geometryWindow,
-                           const Transformation &transformation);
+                           const Transformation &transformation,
+                           const CmdDirty &cmdDirty);
 
   /// Update curve styles after settings changed.
   void updateCurveStyles(const CurveStyles &modelCurveStyles);
@@ -108,12 +130,17 @@ public:
   void updateGraphicsLinesToMatchGraphicsPoints (const CurveStyles &modelCurveStyles,
                                                  const Transformation &transformation);
 
+public slots:
+  /// Receive the part of the scene that the view shows, so points of dense curves that are well outside of it can
+  /// be detached from their graphics items. A null rectangle attaches every point
+  void slotVisibleSceneRectChanged (QRectF visibleSceneRect);
+
 private:
 
   /// Dump all important cursors
   QString dumpCursors () const;
 
-  const QGraphicsPixmapItem *image () const;
+  const GraphicsImageTiled *image () const;
 
   /// Remove expired curves and add new curves
   void updateCurves (CmdMediator &cmdMediator);
@@ -122,10 +149,11 @@ private:
   void updatePathItemMultiValued (const QPainterPath &pathMultiValued,
                                   const LineStyle &lineMultiValued);
 
-  /// Update Points using a multi-pass algorithm.
+  /// Update Points of the curves in the dirty set using a multi-pass algorithm.
   void updatePointMembership (CmdMediator &cmdMediator,
                               GeometryWindow *geometryWindow,
-                              const Transformation &transformation);
+                              const Transformation &transformation,
+                              const CmdDirty &cmdDirty);
 
   /// Curve name to GraphicsLinesForCurve
   GraphicsLinesForCurves m_graphicsLinesForCurves;
@@ -135,6 +163,9 @@ private:
   /// This special curve lives here rather than in m_graphicsLinesForCurves so it is decoupled from
   /// that member (especially since that gets serialized)
   QGraphicsPathItem *m_pathItemMultiValued;
+
+  /// Background image items in the order they were added, so the last one is on top
+  QList<GraphicsImageTiled*> m_imageItems;
 };
 
 #endif // GRAPHICS_SCENE_H
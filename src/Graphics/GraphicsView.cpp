@@ -22,6 +22,7 @@
 #include <QGraphicsScene>
 #include <QMimeData>
 #include <QMouseEvent>
+#include <QPaintEvent>
 #include <QScrollBar>
 #include "QtToString.h"
 #include "UrlDirty.h"
@@ -274,6 +275,20 @@ void GraphicsView::mouseReleaseEvent (QMouseEvent *event)
   QGraphicsView::mouseReleaseEvent (event);
 }
 
+void GraphicsView::paintEvent (QPaintEvent *event)
+{
+  QGraphicsView::paintEvent (event);
+
+  // Every scroll, zoom and resize ends up here, so comparing with the last paint catches all of them
+  QRectF visibleSceneRect = mapToScene (viewport ()->rect ()).boundingRect ();
+  if (visibleSceneRect != m_visibleSceneRect) {
+
+    m_visibleSceneRect = visibleSceneRect;
+
+    emit signalVisibleSceneRectChanged (m_visibleSceneRect);
+  }
+}
+
 QStringList GraphicsView::pointIdentifiersFromSelection (const QList<QGraphicsItem*> &items) const
 {
   // This method assumes that all specified items are points
@@ -313,6 +328,11 @@ void GraphicsView::slotDropRegression (QString urlText)
                    emptyImage);
 }
 
+QRectF GraphicsView::visibleSceneRect () const
+{
+  return m_visibleSceneRect;
+}
+
 void GraphicsView::wheelEvent(QWheelEvent *event)
 {
   const int ANGLE_THRESHOLD = 15; // From QWheelEvent documentation
@@ -9,6 +9,7 @@
 
 #include <QGraphicsView>
 #include <QImage>
+#include <QRectF>
 #include <QUrl>
 
 class MainWindow;
@@ -51,6 +52,12 @@ public:
   /// Intercept mouse release events to move one or more Points.
   virtual void mouseReleaseEvent (QMouseEvent *event);
 
+  /// Intercept paint events to report the part of the scene that is shown, after scrolling, zooming or resizing
+  virtual void paintEvent (QPaintEvent *event);
+
+  /// Part of the scene that was shown by the last paint
+  QRectF visibleSceneRect () const;
+
   /// Convert wheel events into zoom in/out
   virtual void wheelEvent(QWheelEvent *event);
 
@@ -88,6 +95,9 @@ signals:
   /// Send wheel event to MainWindow for zooming out
   void signalViewZoomOut();
 
+  /// Send part of the scene that is shown to GraphicsScene, whenever it changes
+  void signalVisibleSceneRectChanged (QRectF);
+
 public slots:
   /// Receive drag and drop regression test url
   void slotDropRegression (QString);
@@ -103,6 +113,7 @@ private:
   QStringList pointIdentifiersFromSelection (const QList<QGraphicsItem*> &items) const;
   bool inBounds (const QPointF &posScreen);
 
+  QRectF m_visibleSceneRect;
 };
 
 #endif // GRAPHICSVIEW_H
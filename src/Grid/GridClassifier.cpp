@@ -48,7 +48,7 @@ int GridClassifier::binFromCoordinate (double coord,
 }
 
 void GridClassifier::classify (bool isGnuplot,
-                               const QPixmap &originalPixmap,
+                               const QImage &originalImage,
                                const Transformation &transformation,
                                int &countX,
                                double &startX,
@@ -58,7 +58,7 @@ void GridClassifier::classify (bool isGnuplot,
                                double &stepY)
 {
 
-  QImage image = originalPixmap.toImage ();
+  QImage image = originalImage;
 
   m_numHistogramBins = image.width() / NUM_PIXELS_PER_HISTOGRAM_BINS;
   ENGAUGE_ASSERT (m_numHistogramBins > 1);
@@ -9,7 +9,7 @@
 
 #include "ColorFilterHistogram.h"
 
-class QPixmap;
+class QImage;
 class Transformation;
 
 /// Classify the grid pattern in an original image.
@@ -31,7 +31,7 @@ public:
 
   /// Classify the specified image, and return the most probably x and y grid settings.
   void classify (bool isGnuplot,
-                 const QPixmap &originalPixmap,
+                 const QImage &originalImage,
                  const Transformation &transformation,
                  int &countX,
                  double &startX,
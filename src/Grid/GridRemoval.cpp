@@ -50,9 +50,9 @@ QPointF GridRemoval::clipY (const QPointF &posUnprojected,
                   (1.0 - s) * posUnprojected.y() + s * posOther.y());
 }
 
-QPixmap GridRemoval::remove (const Transformation &transformation,
-                             const DocumentModelGridRemoval &modelGridRemoval,
-                             const QImage &imageBefore)
+QImage GridRemoval::remove (const Transformation &transformation,
+                            const DocumentModelGridRemoval &modelGridRemoval,
+                            const QImage &imageBefore)
 {
   QImage image = imageBefore;
 
@@ -114,7 +114,7 @@ QPixmap GridRemoval::remove (const Transformation &transformation,
     }
   }
 
-  return QPixmap::fromImage (image);
+  return image;
 }
 
 void GridRemoval::removeLine (const QPointF &posMin,
@@ -9,7 +9,6 @@
 
 #include "GridLog.h"
 #include <QList>
-#include <QPixmap>
 #include <QPointF>
 
 class DocumentModelGridRemoval;
@@ -27,10 +26,10 @@ class GridRemoval
   /// Single constructor
   GridRemoval(bool isGnuplot);
 
-  /// Process QImage into QPixmap, removing the grid lines
-  QPixmap remove (const Transformation &transformation,
-                  const DocumentModelGridRemoval &modelGridRemoval,
-                  const QImage &imageBefore);
+  /// Process QImage, removing the grid lines
+  QImage remove (const Transformation &transformation,
+                 const DocumentModelGridRemoval &modelGridRemoval,
+                 const QImage &imageBefore);
 
 private:
   GridRemoval();
@@ -6,17 +6,16 @@
 
 #include <iostream>
 #include "LoggerUpload.h"
-#include "MainWindow.h"
 
-MainWindow *LoggerUpload::m_mainWindow = static_cast<MainWindow*> (nullptr);
+LoggerUploadErrorReport LoggerUpload::m_errorReport;
 
 LoggerUpload::LoggerUpload()
 {
 }
 
-void LoggerUpload::bindToMainWindow (MainWindow *mainWindow)
+void LoggerUpload::bindToErrorReport (const LoggerUploadErrorReport &errorReport)
 {
-  m_mainWindow = mainWindow;
+  m_errorReport = errorReport;
 }
 
 void LoggerUpload::loggerAssert(const char *condition,
@@ -44,11 +43,11 @@ void LoggerUpload::loggerOutput(const char *comment,
                                 int line,
                                 const char *context)
 {
-  if (m_mainWindow != nullptr) {
-    m_mainWindow->saveErrorReportFileAndExit(comment,
-                                             file,
-                                             line,
-                                             context);
+  if (m_errorReport) {
+    m_errorReport (comment,
+                   file,
+                   line,
+                   context);
   }
 
   std::cerr << "Error '" << context << "' at file " << file << " line " << line << ": " << comment << std::endl;
@@ -7,6 +7,7 @@
 #ifndef LOGGER_UPLOAD_H
 #define LOGGER_UPLOAD_H
 
+#include <functional>
 #include <QtGlobal>
 
 #if defined(WIN32) || defined(WIN64)
@@ -15,7 +16,8 @@
 #define NO_RETURN_VALUE Q_NORETURN
 #endif
 
-class MainWindow;
+/// Handler that saves an error report for the comment, file, line and context of a failure
+typedef std::function<void (const char *, const char *, int, const char *)> LoggerUploadErrorReport;
 
 /// Upload logging information to website for developer support
 class LoggerUpload
@@ -24,8 +26,9 @@ public:
   /// Single constructor
   LoggerUpload();
 
-  /// Bind to MainWindow so this class can access the command stack
-  static void bindToMainWindow (MainWindow *mainWindow);
+  /// Bind to the error report handler of MainWindow, which can access the command stack. Without a binding, as in
+  /// headless builds, failures are only written to stderr
+  static void bindToErrorReport (const LoggerUploadErrorReport &errorReport);
 
   /// Smart equivalent to standard assert method and Q_ASSERT (in qglobal.h). Upon error, an upload is proposed.
   /// This is static for easy access from anywhere else in the application
@@ -45,7 +48,7 @@ private:
                             int line,
                             const char* context) NO_RETURN_VALUE;
 
-  static MainWindow *m_mainWindow;
+  static LoggerUploadErrorReport m_errorReport;
 };
 
 #endif // LOGGER_UPLOAD_H
@@ -9,7 +9,6 @@
 #include "Logger.h"
 #include "Point.h"
 #include <QObject>
-#include <QStringList>
 #include <QTextStream>
 #include "QtToString.h"
 #include <QXmlStreamReader>
@@ -23,6 +22,10 @@ extern const QString DUMMY_CURVE_NAME;
 const QString POINT_IDENTIFIER_DELIMITER_SAFE ("\t"); // Character that could never be entered when editing curve names
 const QString POINT_IDENTIFIER_DELIMITER_XML ("_"); // From incoming xml that does not like tabs
 
+// Number of the temporary point, which the generator never reaches so the temporary point cannot be confused with a
+// real axis point in the lookups by number
+const unsigned int TEMPORARY_IDENTIFIER_NUMBER = 0xffffffff;
+
 const double MISSING_ORDINAL_VALUE = 0;
 const double MISSING_POSGRAPH_VALUE = 0;
 
@@ -33,7 +36,7 @@ Point::Point ()
 Point::Point(const QString &curveName,
              const QPointF &posScreen) :
   m_isAxisPoint (curveName == AXIS_CURVE_NAME),
-  m_identifier (uniqueIdentifierGenerator(curveName)),
+  m_identifierNumber (uniqueIdentifierGenerator()),
   m_posScreen (posScreen),
   m_hasPosGraph (false),
   m_posGraph (MISSING_POSGRAPH_VALUE, MISSING_POSGRAPH_VALUE),
@@ -49,7 +52,7 @@ Point::Point(const QString &curveName,
              const QPointF &posGraph,
              bool isXOnly) :
   m_isAxisPoint (true),
-  m_identifier (uniqueIdentifierGenerator(curveName)),
+  m_identifierNumber (uniqueIdentifierGenerator()),
   m_posScreen (posScreen),
   m_hasPosGraph (true),
   m_posGraph (posGraph),
@@ -70,7 +73,7 @@ Point::Point(const QString &curveName,
              double ordinal,
              bool isXOnly) :
   m_isAxisPoint (true),
-  m_identifier (identifier),
+  m_identifierNumber (identifierNumberFromPointIdentifier (identifier)),
   m_posScreen (posScreen),
   m_hasPosGraph (true),
   m_posGraph (posGraph),
@@ -89,7 +92,7 @@ Point::Point(const QString &curveName,
              double ordinal,
              bool isXOnly) :
   m_isAxisPoint (true),
-  m_identifier (uniqueIdentifierGenerator(curveName)),
+  m_identifierNumber (uniqueIdentifierGenerator()),
   m_posScreen (posScreen),
   m_hasPosGraph (true),
   m_posGraph (posGraph),
@@ -107,7 +110,7 @@ Point::Point(const QString &curveName,
              const QPointF &posScreen,
              double ordinal) :
   m_isAxisPoint (false),
-  m_identifier (identifier),
+  m_identifierNumber (identifierNumberFromPointIdentifier (identifier)),
   m_posScreen (posScreen),
   m_hasPosGraph (false),
   m_posGraph (MISSING_POSGRAPH_VALUE, MISSING_POSGRAPH_VALUE),
@@ -124,7 +127,7 @@ Point::Point (const QString &curveName,
               const QPointF &posScreen,
               double ordinal) :
   m_isAxisPoint (false),
-  m_identifier (uniqueIdentifierGenerator(curveName)),
+  m_identifierNumber (uniqueIdentifierGenerator()),
   m_posScreen (posScreen),
   m_hasPosGraph (false),
   m_posGraph (MISSING_POSGRAPH_VALUE, MISSING_POSGRAPH_VALUE),
@@ -144,7 +147,7 @@ Point::Point (QXmlStreamReader &reader)
 Point::Point (const Point &other)
 {
   m_isAxisPoint = other.isAxisPoint ();
-  m_identifier = other.identifier ();
+  m_identifierNumber = other.identifierNumber ();
   m_posScreen = other.posScreen ();
   m_hasPosGraph = other.hasPosGraph ();
   m_posGraph = other.posGraph (SKIP_HAS_CHECK);
@@ -156,7 +159,7 @@ Point::Point (const Point &other)
 Point &Point::operator=(const Point &point)
 {
   m_isAxisPoint = point.isAxisPoint ();
-  m_identifier = point.identifier ();
+  m_identifierNumber = point.identifierNumber ();
   m_posScreen = point.posScreen ();
   m_hasPosGraph = point.hasPosGraph ();
   m_posGraph = point.posGraph (SKIP_HAS_CHECK);
@@ -169,21 +172,31 @@ Point &Point::operator=(const Point &point)
 
 QString Point::curveNameFromPointIdentifier (const QString &pointIdentifier)
 {
-  QStringList tokens;
-
-  if (pointIdentifier.contains (POINT_IDENTIFIER_DELIMITER_SAFE)) {
+  int pos = pointIdentifier.indexOf (POINT_IDENTIFIER_DELIMITER_SAFE);
 
-    tokens = pointIdentifier.split (POINT_IDENTIFIER_DELIMITER_SAFE);
-
-  } else {
+  if (pos < 0) {
 
     // Yes, this is a hack - underscores could have been inserted by user (in the curve name) and/or this source code,
     // but there are many dig files laying around that have underscores so we need to support them
-    tokens = pointIdentifier.split (POINT_IDENTIFIER_DELIMITER_XML);
+    pos = pointIdentifier.indexOf (POINT_IDENTIFIER_DELIMITER_XML);
+
+  }
+
+  return (pos < 0 ? pointIdentifier : pointIdentifier.left (pos));
+}
+
+DocumentHash Point::documentHash () const
+{
+  DocumentHash documentHash = documentHashMix (DocumentHash (0),
+                                               quint64 (m_identifierNumber));
+  documentHash = documentHashMix (documentHash, m_posScreen.x ());
+  documentHash = documentHashMix (documentHash, m_posScreen.y ());
 
+  if (m_hasOrdinal) {
+    documentHash = documentHashMix (documentHash, m_ordinal);
   }
 
-  return tokens.value (0);
+  return documentHash;
 }
 
 QString Point::fixUnderscores (const QString &identifier) const
@@ -208,9 +221,46 @@ bool Point::hasPosGraph () const
   return m_hasPosGraph;
 }
 
-QString Point::identifier() const
+QString Point::identifier (const QString &curveName) const
 {
-  return m_identifier;
+  if (m_identifierNumber == TEMPORARY_IDENTIFIER_NUMBER) {
+    return temporaryPointIdentifier ();
+  }
+
+  return QString ("%1%2point%3%4")
+      .arg (curveName)
+      .arg (POINT_IDENTIFIER_DELIMITER_SAFE)
+      .arg (POINT_IDENTIFIER_DELIMITER_SAFE)
+      .arg (m_identifierNumber);
+}
+
+unsigned int Point::identifierNumber () const
+{
+  return m_identifierNumber;
+}
+
+unsigned int Point::identifierNumberFromPointIdentifier (const QString &pointIdentifier,
+                                                         bool *ok)
+{
+  // Number follows the last delimiter. The temporary point is the only identifier with a single delimiter
+  QString delimiter = (pointIdentifier.contains (POINT_IDENTIFIER_DELIMITER_SAFE) ?
+                         POINT_IDENTIFIER_DELIMITER_SAFE :
+                         POINT_IDENTIFIER_DELIMITER_XML);
+  int posFirst = pointIdentifier.indexOf (delimiter);
+  int posLast = pointIdentifier.lastIndexOf (delimiter);
+
+  bool isNumber = false;
+  unsigned int number = pointIdentifier.midRef (posLast + 1).toUInt (&isNumber);
+
+  if (isNumber && posFirst >= 0 && posFirst == posLast) {
+    number = TEMPORARY_IDENTIFIER_NUMBER;
+  }
+
+  if (ok != nullptr) {
+    *ok = isNumber && posFirst >= 0;
+  }
+
+  return number;
 }
 
 unsigned int Point::identifierIndex ()
@@ -255,7 +305,13 @@ void Point::loadXml(QXmlStreamReader &reader)
       isXOnly = attributes.value(DOCUMENT_SERIALIZE_POINT_IS_X_ONLY).toString();
     }
 
-    m_identifier = fixUnderscores (attributes.value(DOCUMENT_SERIALIZE_POINT_IDENTIFIER).toString());
+    // Only the number is kept from the identifier, since the curve name comes from the Curve holding this Point
+    bool isNumber = false;
+    m_identifierNumber = identifierNumberFromPointIdentifier (fixUnderscores (attributes.value(DOCUMENT_SERIALIZE_POINT_IDENTIFIER).toString()),
+                                                              &isNumber);
+    if (!isNumber) {
+      success = false;
+    }
     m_identifierIndex = attributes.value(DOCUMENT_SERIALIZE_POINT_IDENTIFIER_INDEX).toUInt();
     m_isAxisPoint = (isAxisPoint == DOCUMENT_SERIALIZE_BOOL_TRUE);
     m_hasPosGraph = false;
@@ -348,7 +404,7 @@ void Point::printStream(QString indentation,
 
   indentation += INDENTATION_DELTA;
 
-  str << indentation << "identifier=" << m_identifier << "\n";
+  str << indentation << "identifierNumber=" << m_identifierNumber << "\n";
   str << indentation << "posScreen=" << QPointFToString (m_posScreen) << "\n";
   if (m_hasPosGraph) {
     str << indentation << "posGraph=" << QPointFToString (m_posGraph) << "\n";
@@ -362,11 +418,12 @@ void Point::printStream(QString indentation,
   }
 }
 
-void Point::saveXml(QXmlStreamWriter &writer) const
+void Point::saveXml(QXmlStreamWriter &writer,
+                    const QString &curveName) const
 {
 
   writer.writeStartElement(DOCUMENT_SERIALIZE_POINT);
-  writer.writeAttribute(DOCUMENT_SERIALIZE_POINT_IDENTIFIER, m_identifier);
+  writer.writeAttribute(DOCUMENT_SERIALIZE_POINT_IDENTIFIER, identifier (curveName));
   if (m_hasOrdinal) {
     writer.writeAttribute(DOCUMENT_SERIALIZE_POINT_ORDINAL, QString::number (m_ordinal));
   }
@@ -400,13 +457,6 @@ void Point::saveXml(QXmlStreamWriter &writer) const
   writer.writeEndElement();
 }
 
-void Point::setCurveName(const QString &curveNameNew)
-{
-  // Replace the old curve name at the start of the string
-  QString curveNameOld = Point::curveNameFromPointIdentifier (m_identifier);
-  m_identifier = curveNameNew  + m_identifier.mid (curveNameOld.length());
-}
-
 void Point::setIdentifierIndex (unsigned int identifierIndex)
 {
   m_identifierIndex = identifierIndex;
@@ -441,11 +491,7 @@ QString Point::temporaryPointIdentifier ()
       .arg (0);
 }
 
-QString Point::uniqueIdentifierGenerator (const QString &curveName)
+unsigned int Point::uniqueIdentifierGenerator ()
 {
-  return QString ("%1%2point%3%4")
-      .arg (curveName)
-      .arg (POINT_IDENTIFIER_DELIMITER_SAFE)
-      .arg (POINT_IDENTIFIER_DELIMITER_SAFE)
-      .arg (m_identifierIndex++);
+  return m_identifierIndex++;
 }
@@ -7,6 +7,7 @@
 #ifndef POINT_H
 #define POINT_H
 
+#include "DocumentHash.h"
 #include <QPointF>
 #include <QString>
 
@@ -20,6 +21,7 @@ enum ApplyHasCheck {
 };
 
 extern const QString POINT_IDENTIFIER_DELIMITER_SAFE;
+extern const QString POINT_IDENTIFIER_DELIMITER_XML;
 
 /// Class that represents one digitized point. The screen-to-graph coordinate transformation is always external to this class
 class Point
@@ -75,17 +77,30 @@ public:
   /// Copy constructor.
   Point (const Point &point);
 
-  /// Parse the curve name from the specified point identifier. This does the opposite of uniqueIdentifierGenerator
+  /// Parse the curve name from the specified point identifier. This does the opposite of identifier
   static QString curveNameFromPointIdentifier (const QString &pointIdentifier);
 
+  /// Digest of identifier, screen position and ordinal, which Curve adds up into its DocumentHash. Graph position is
+  /// left out since it is only meaningful for axis points, and then only some of its coordinates
+  DocumentHash documentHash () const;
+
   /// True if ordinal is defined.
   bool hasOrdinal () const;
 
   /// True if graph position is defined.
   bool hasPosGraph () const;
 
-  /// Unique identifier for a specific Point.
-  QString identifier () const;
+  /// Unique identifier text for a specific Point, which starts with the name of the curve holding the Point. The text
+  /// is built on request, for serialization, the clipboard, undo xml and the graphics items
+  QString identifier (const QString &curveName) const;
+
+  /// Number that identifies this Point among all Points. Lookups inside a Curve use this rather than the text
+  unsigned int identifierNumber () const;
+
+  /// Parse the number from the specified point identifier. This does the opposite of identifier, together with
+  /// curveNameFromPointIdentifier. The optional flag is cleared if there is no number
+  static unsigned int identifierNumberFromPointIdentifier (const QString &pointIdentifier,
+                                                           bool *ok = nullptr);
 
   /// In DOCUMENT_AXES_POINTS_REQUIRED_4 modes, this is true/false if y/x coordinate is undefined
   bool isXOnly() const;
@@ -109,11 +124,9 @@ public:
   void printStream (QString indentation,
                     QTextStream &str) const;
 
-  /// Serialize to stream
-  void saveXml(QXmlStreamWriter &writer) const;
-
-  /// Update the point identifier to match the specified curve name
-  void setCurveName (const QString &curveName);
+  /// Serialize to stream. The curve name is needed for the identifier text
+  void saveXml(QXmlStreamWriter &writer,
+               const QString &curveName) const;
 
   /// Reset the current index while performing a Redo.
   static void setIdentifierIndex (unsigned int identifierIndex);
@@ -142,15 +155,15 @@ private:
   /// Load from serialized xml
   void loadXml(QXmlStreamReader &reader);
 
-  /// Generate a unique identifier for a Point. This is static so it can be used while a
+  /// Generate a unique identifier number for a Point. This is static so it can be used while a
   /// GraphicsPointAbstractBase-based object is being constructed.
   ///
   /// Identifiers follow sequential counting numbers since those are easier to deal with
   /// than alternatives such as 64-bit guids (like Microsoft)
-  static QString uniqueIdentifierGenerator(const QString &curveName);
+  static unsigned int uniqueIdentifierGenerator();
 
   bool m_isAxisPoint;
-  QString m_identifier;
+  unsigned int m_identifierNumber; // Curve name is not kept here, since the Curve holding this Point supplies it
   QPointF m_posScreen;
   bool m_hasPosGraph;
   QPointF m_posGraph;
@@ -17,7 +17,6 @@
 
 class DocumentModelPointMatch;
 class QImage;
-class QPixmap;
 
 typedef QList<PointMatchTriplet> PointMatchList;
 
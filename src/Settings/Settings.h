@@ -74,6 +74,7 @@ extern const QString SETTINGS_RECENT_FILE_LIST;
 extern const QString SETTINGS_SIGNIFICANT_DIGITS;
 extern const QString SETTINGS_SIZE;
 extern const QString SETTINGS_SMALL_DIALOGS;
+extern const QString SETTINGS_TILE_CACHE_MEGABYTES;
 extern const QString SETTINGS_VIEW_BACKGROUND_TOOLBAR;
 extern const QString SETTINGS_VIEW_COORD_SYSTEM_TOOLBAR;
 extern const QString SETTINGS_VIEW_DIGITIZE_TOOLBAR;
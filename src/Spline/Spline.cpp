@@ -2,6 +2,7 @@
  * this notice you can do whatever you want with this stuff. If we meet some day, and you
  * think this stuff is worth it, you can buy me a beer in return. */
 
+#include <algorithm>
 #include "EngaugeAssert.h"
 #include <iostream>
 #include "Logger.h"
@@ -10,9 +11,19 @@
 
 using namespace std;
 
+const double T_TOLERANCE = 1e-14; // Newton iteration stops when the t step is this small relative to the interval length
+
+static bool lessThanX (double x,
+                       const SplinePair &sp)
+{
+  return x < sp.x();
+}
+
 Spline::Spline(const std::vector<double> &t,
                const std::vector<SplinePair> &xy,
-               SplineTCheck splineTCheck)
+               SplineTCheck splineTCheck) :
+  m_isFunctionXIndexed (false),
+  m_isMonotoneX (false)
 {
   ENGAUGE_ASSERT (t.size() == xy.size());
   ENGAUGE_ASSERT (xy.size() > 0); // Need at least one point for this class to not fail with a crash
@@ -131,6 +142,41 @@ void Spline::computeControlPointsForIntervals ()
   }
 }
 
+void Spline::computeFunctionXIndex () const
+{
+  if (m_isFunctionXIndexed) {
+    return;
+  }
+  m_isFunctionXIndexed = true;
+
+  // Insert does not replace an earlier entry, so the first point with each x value is kept
+  for (unsigned int i = 0; i < m_xy.size(); i++) {
+    m_indexForX.insert (make_pair (m_xy [i].x(), i));
+  }
+
+  // Derivative of x=a+b*(t-ti)+c*(t-ti)^2+d*(t-ti)^3 is b+2*c*(t-ti)+3*d*(t-ti)^2, which cannot go negative in an
+  // interval if it is not negative at the two endpoints and at its extremum
+  m_isMonotoneX = (m_xy.size() > 1);
+  for (unsigned int i = 0; m_isMonotoneX && i + 1 < m_xy.size(); i++) {
+    const SplineCoeff &element = m_elements [i];
+    double b = element.b().x();
+    double c = element.c().x();
+    double d = element.d().x();
+    double h = m_t [i + 1] - m_t [i];
+
+    m_isMonotoneX = (m_xy [i].x() < m_xy [i + 1].x()) &&
+                    (b >= 0.0) &&
+                    (b + 2.0 * c * h + 3.0 * d * h * h >= 0.0);
+
+    if (m_isMonotoneX && d != 0.0) {
+      double deltatExtremum = -1.0 * c / (3.0 * d);
+      if (0.0 < deltatExtremum && deltatExtremum < h) {
+        m_isMonotoneX = (b + c * deltatExtremum >= 0.0);
+      }
+    }
+  }
+}
+
 void Spline::computeUntranslatedCoefficients (double aTranslated,
                                               double bTranslated,
                                               double cTranslated,
@@ -158,27 +204,14 @@ void Spline::computeUntranslatedCoefficients (double aTranslated,
   dUntranslated = dTranslated;
 }
 
-SplinePair Spline::findSplinePairForFunctionX (double x,
-                                               int numIterations) const
+SplinePair Spline::findSplinePairByBisection (double x,
+                                              int numIterations) const
 {
   SplinePair spCurrent;
 
   double tLow = m_t[0];
   double tHigh = m_t[m_xy.size() - 1];
 
-  // This method implicitly assumes that the x values are monotonically increasing - except for the
-  // "export raw points" exception right here
-
-  // Subtle stuff here - we first look for exact matches in m_elements. If a match is found, we exit
-  // immediately. This strategy works for "export raw points" option with functions having overlaps,
-  // in which case users expect interpolation to be used (issue #303)
-  for (unsigned int i = 0; i < m_xy.size(); i++) {
-    const SplinePair &sp = m_xy.at (i);
-    if (sp.x() == x) {
-      return sp;
-    }
-  }
-
   // Extrapolation that is performed if x is out of bounds. As a starting point, we assume that the t
   // values and x values behave the same, which is linearly. This assumption works best when user
   // has set the points so the spline line is linear at the endpoints - which is also preferred since
@@ -219,6 +252,64 @@ SplinePair Spline::findSplinePairForFunctionX (double x,
   return spCurrent;
 }
 
+SplinePair Spline::findSplinePairForFunctionX (double x,
+                                               int numIterations) const
+{
+  unsigned int intervalCursor = 0;
+
+  return findSplinePairForFunctionXWithCursor (x,
+                                               numIterations,
+                                               intervalCursor);
+}
+
+SplinePair Spline::findSplinePairForFunctionXWithCursor (double x,
+                                                         int numIterations,
+                                                         unsigned int &intervalCursor) const
+{
+  // This method implicitly assumes that the x values are monotonically increasing - except for the
+  // "export raw points" exception right here
+
+  // Splines that are only drawn never need the index, so it is built on first use
+  computeFunctionXIndex ();
+
+  // Subtle stuff here - we first look for exact matches in m_xy. If a match is found, we exit
+  // immediately. This strategy works for "export raw points" option with functions having overlaps,
+  // in which case users expect interpolation to be used (issue #303)
+  unordered_map<double, unsigned int>::const_iterator itr = m_indexForX.find (x);
+  if (itr != m_indexForX.end()) {
+    return m_xy [itr->second];
+  }
+
+  if (m_isMonotoneX &&
+      m_xy.front().x() < x &&
+      x < m_xy.back().x()) {
+
+    // Exactly one interval brackets x, and x(t) has only one solution inside it
+    return solveInInterval (intervalForFunctionX (x,
+                                                  intervalCursor),
+                            x,
+                            numIterations);
+  }
+
+  return findSplinePairByBisection (x,
+                                    numIterations);
+}
+
+void Spline::findSplinePairsForFunctionX (const std::vector<double> &x,
+                                          int numIterations,
+                                          std::vector<SplinePair> &splinePairs) const
+{
+  splinePairs.clear ();
+  splinePairs.reserve (x.size());
+
+  unsigned int intervalCursor = 0;
+  for (unsigned int i = 0; i < x.size(); i++) {
+    splinePairs.push_back (findSplinePairForFunctionXWithCursor (x [i],
+                                                                 numIterations,
+                                                                 intervalCursor));
+  }
+}
+
 SplinePair Spline::interpolateCoeff (double t) const
 {
   ENGAUGE_ASSERT (m_elements.size() != 0);
@@ -255,6 +346,34 @@ SplinePair Spline::interpolateControlPoints (double t) const
   return m_t[0];
 }
 
+unsigned int Spline::intervalForFunctionX (double x,
+                                           unsigned int &intervalCursor) const
+{
+  unsigned int intervalLast = unsigned (m_xy.size() - 2);
+
+  if (intervalCursor > intervalLast ||
+      x < m_xy [intervalCursor].x()) {
+
+    // Binary search since x is behind the cursor. The first point is skipped since x is greater than its x value
+    vector<SplinePair>::const_iterator itr = upper_bound (m_xy.begin() + 1,
+                                                          m_xy.end(),
+                                                          x,
+                                                          lessThanX);
+    intervalCursor = qMin (unsigned (itr - m_xy.begin()) - 1,
+                           intervalLast);
+
+  } else {
+
+    // Walk forward, which is quick for increasing x values
+    while (intervalCursor < intervalLast &&
+           m_xy [intervalCursor + 1].x() <= x) {
+      ++intervalCursor;
+    }
+  }
+
+  return intervalCursor;
+}
+
 SplinePair Spline::p1 (unsigned int i) const
 {
   ENGAUGE_ASSERT (i < m_p1.size ());
@@ -268,3 +387,58 @@ SplinePair Spline::p2 (unsigned int i) const
 
   return m_p2 [i];
 }
+
+SplinePair Spline::solveInInterval (unsigned int interval,
+                                    double x,
+                                    int numIterations) const
+{
+  const SplineCoeff &element = m_elements [interval];
+  double b = element.b().x();
+  double c = element.c().x();
+  double d = element.d().x();
+
+  // Bracket that always contains the solution, since x(tLow)<=x<=x(tHigh)
+  double tLow = m_t [interval];
+  double tHigh = m_t [interval + 1];
+  double tTolerance = T_TOLERANCE * (tHigh - tLow);
+
+  // Start from linear interpolation between the interval endpoints
+  double tCurrent = tLow + (tHigh - tLow) * (x - m_xy [interval].x()) / (m_xy [interval + 1].x() - m_xy [interval].x());
+  SplinePair spCurrent = element.eval (tCurrent);
+
+  for (int iteration = 0; iteration < numIterations; iteration++) {
+
+    double residual = spCurrent.x() - x;
+    if (residual == 0.0) {
+      break;
+    }
+
+    if (residual > 0.0) {
+      tHigh = tCurrent;
+    } else {
+      tLow = tCurrent;
+    }
+
+    // Newton step, replaced by a bisection step if the derivative vanishes or the step leaves the bracket
+    double deltat = tCurrent - element.t();
+    double derivative = b + deltat * (2.0 * c + 3.0 * d * deltat);
+    double tNext = (tLow + tHigh) / 2.0;
+    if (derivative > 0.0) {
+      double tNewton = tCurrent - residual / derivative;
+      if (tLow < tNewton && tNewton < tHigh) {
+        tNext = tNewton;
+      }
+    }
+
+    bool isConverged = (qAbs (tNext - tCurrent) <= tTolerance);
+
+    tCurrent = tNext;
+    spCurrent = element.eval (tCurrent);
+
+    if (isConverged) {
+      break;
+    }
+  }
+
+  return spCurrent;
+}
@@ -9,6 +9,7 @@
 
 #include "SplineCoeff.h"
 #include "SplinePair.h"
+#include <unordered_map>
 #include <vector>
 
 enum SplineTCheck {
@@ -55,11 +56,19 @@ class Spline
                                         double &cUntranslated,
                                         double &dUntranslated) const;
 
-  /// Use bisection algorithm to iteratively find the SplinePair interpolated to best match the specified x value.
-  /// This assumes the curve is a function since otherwise there is the potential for multiple solutions
+  /// Find the SplinePair interpolated to best match the specified x value. This assumes the curve is a function
+  /// since otherwise there is the potential for multiple solutions. If x(t) increases over every interval then the
+  /// single interval bracketing x is solved with a safeguarded Newton iteration, otherwise (and for extrapolation)
+  /// a bisection search with numIterations iterations is performed over the entire t range
   SplinePair findSplinePairForFunctionX (double x,
                                          int numIterations) const;
 
+  /// Same as findSplinePairForFunctionX but for many x values at once. When the x values are sorted in increasing
+  /// order, the bracketing intervals are found with one walk through the intervals rather than a search per value
+  void findSplinePairsForFunctionX (const std::vector<double> &x,
+                                    int numIterations,
+                                    std::vector<SplinePair> &splinePairs) const;
+
   /// Return interpolated y for specified x. The appropriate interval is selected from the entire
   /// set of piecewise-defined intervals, then the corresponding a,b,c,d coefficients are applied
   SplinePair interpolateCoeff (double t) const;
@@ -86,6 +95,31 @@ private:
                                         const std::vector<SplinePair> &xy);
   void computeControlPointsForIntervals ();
 
+  // Build the lookup table for exact x matches, and determine if x(t) is monotonically increasing so the bracketing
+  // interval of any x value can be found from the x values at the interval endpoints. Only the first call does any
+  // work
+  void computeFunctionXIndex () const;
+
+  // Bisection search over the entire t range, with extrapolation if x is out of bounds
+  SplinePair findSplinePairByBisection (double x,
+                                        int numIterations) const;
+
+  // Shared by findSplinePairForFunctionX and findSplinePairsForFunctionX. The interval cursor carries the bracketing
+  // interval from the previous call
+  SplinePair findSplinePairForFunctionXWithCursor (double x,
+                                                   int numIterations,
+                                                   unsigned int &intervalCursor) const;
+
+  // Return the interval whose endpoint x values bracket x, starting from the cursor. Requires m_isMonotoneX
+  unsigned int intervalForFunctionX (double x,
+                                     unsigned int &intervalCursor) const;
+
+  // Safeguarded Newton iteration for x(t)=x inside one interval, falling back to bisection whenever a Newton step
+  // leaves the bracket. Requires the interval endpoints to bracket x
+  SplinePair solveInInterval (unsigned int interval,
+                              double x,
+                              int numIterations) const;
+
   // Coefficients a,b,c,d
   std::vector<SplineCoeff> m_elements;
 
@@ -95,6 +129,14 @@ private:
   // Input points
   std::vector<SplinePair> m_xy;
 
+  // Index of first input point with each x value, for exact matches. This and m_isMonotoneX are built on first use
+  // by computeFunctionXIndex
+  mutable std::unordered_map<double, unsigned int> m_indexForX;
+  mutable bool m_isFunctionXIndexed;
+
+  // True if x(t) increases over every interval, in which case each x value inside the range has one solution
+  mutable bool m_isMonotoneX;
+
   // Control points for each interval
   std::vector<SplinePair> m_p1;
   std::vector<SplinePair> m_p2;
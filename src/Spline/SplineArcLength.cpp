@@ -0,0 +1,124 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#include <qmath.h>
+#include "Spline.h"
+#include "SplineArcLength.h"
+
+using namespace std;
+
+SplineArcLength::SplineArcLength()
+{
+}
+
+SplineArcLength::SplineArcLength(const Spline &spline,
+                                 double tMin,
+                                 double tMax,
+                                 int numSamples)
+{
+  m_t.reserve (unsigned (numSamples));
+  m_xy.reserve (unsigned (numSamples));
+  m_separation.reserve (unsigned (numSamples));
+  m_distance.reserve (unsigned (numSamples));
+
+  double distance = 0;
+  for (int sample = 0; sample < numSamples; sample++) {
+
+    double t = tMin;
+    if (numSamples > 1) {
+      t = tMin + ((tMax - tMin) * sample) / (numSamples - 1.0);
+    }
+
+    SplinePair xy = spline.interpolateCoeff (t);
+
+    double separation = 0;
+    if (sample > 0) {
+      double deltaX = xy.x() - m_xy.back ().x();
+      double deltaY = xy.y() - m_xy.back ().y();
+      separation = qSqrt (deltaX * deltaX + deltaY * deltaY);
+    }
+    distance += separation;
+
+    m_t.push_back (t);
+    m_xy.push_back (xy);
+    m_separation.push_back (separation);
+    m_distance.push_back (distance);
+  }
+}
+
+double SplineArcLength::distanceAtSample (int sample) const
+{
+  return m_distance.at (unsigned (sample));
+}
+
+double SplineArcLength::length () const
+{
+  if (m_distance.empty ()) {
+    return 0;
+  }
+
+  return m_distance.back ();
+}
+
+int SplineArcLength::numSamples () const
+{
+  return signed (m_t.size ());
+}
+
+vector<double> SplineArcLength::tAtIntervalsWithRemainder (double interval) const
+{
+  vector<double> ts;
+
+  // Nonpositive interval would never reach the end of the curve
+  if ((interval > 0) &&
+      (m_t.size () > 0)) {
+
+    int count = numSamples ();
+    double separation = 0; // Distance walked since the end of the previous interval
+    double tLast = m_t.front ();
+    int sampleEndingLastInterval = 0;
+    for (int sample = 0; sample < count; sample++) {
+
+      double tSample = m_t [unsigned (sample)];
+      separation += m_separation [unsigned (sample)];
+
+      while (separation >= interval) {
+
+        // End of current interval, and start of next interval. The first sample has no separation so it never
+        // ends an interval
+        double s = interval / separation;
+        double tInterp = (1.0 - s) * tLast + s * tSample;
+
+        separation -= interval; // Part of the separation that was not used gets applied to the next interval
+
+        tLast = tInterp;
+        ts.push_back (tInterp);
+        sampleEndingLastInterval = sample;
+      }
+
+      tLast = tSample;
+    }
+
+    if (sampleEndingLastInterval < count - 1) {
+
+      // Add last sample so we end up at the end of the curve
+      ts.push_back (m_t.back ());
+
+    }
+  }
+
+  return ts;
+}
+
+double SplineArcLength::tAtSample (int sample) const
+{
+  return m_t.at (unsigned (sample));
+}
+
+const SplinePair &SplineArcLength::xyAtSample (int sample) const
+{
+  return m_xy.at (unsigned (sample));
+}
@@ -0,0 +1,59 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef SPLINE_ARC_LENGTH_H
+#define SPLINE_ARC_LENGTH_H
+
+#include "SplinePair.h"
+#include <vector>
+
+class Spline;
+
+/// Table of cumulative arc length along a Spline, sampled at evenly spaced t values. The distance between
+/// successive samples is the straight line distance, and lookups between samples are linear, so the number of
+/// samples sets the accuracy. The table is built once and then answers any number of distance and t lookups
+class SplineArcLength
+{
+public:
+  /// Empty table, for holding a table that has not been built yet
+  SplineArcLength();
+
+  /// Build the table with numSamples samples from tMin to tMax inclusive
+  SplineArcLength(const Spline &spline,
+                  double tMin,
+                  double tMax,
+                  int numSamples);
+
+  /// Distance along the curve from the first sample to the specified sample
+  double distanceAtSample (int sample) const;
+
+  /// Total length of the curve, which is the distance to the last sample
+  double length () const;
+
+  /// Number of samples in the table
+  int numSamples () const;
+
+  /// Find the t values spaced the specified interval apart along the curve, starting one interval after the first
+  /// sample. This walks the samples once the way the original export did, carrying the unused part of each sample's
+  /// distance over to the next interval, so exported relations are unchanged. The t value of the last sample is added
+  /// unless the final interval ends in the last sample
+  std::vector<double> tAtIntervalsWithRemainder (double interval) const;
+
+  /// t value of the specified sample
+  double tAtSample (int sample) const;
+
+  /// Position of the specified sample
+  const SplinePair &xyAtSample (int sample) const;
+
+private:
+
+  std::vector<double> m_t;
+  std::vector<SplinePair> m_xy;
+  std::vector<double> m_separation; // Distance from the previous sample, which is zero for the first sample
+  std::vector<double> m_distance; // Cumulative, so it never decreases
+};
+
+#endif // SPLINE_ARC_LENGTH_H
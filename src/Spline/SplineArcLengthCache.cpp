@@ -0,0 +1,79 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#include <QMutexLocker>
+#include "Spline.h"
+#include "SplineArcLengthCache.h"
+
+using namespace std;
+
+const int MAX_CURVES_CACHED = 100; // Each entry costs one, so this bounds the memory as curves are renamed or deleted
+
+SplineArcLengthCache::SplineArcLengthCache()
+{
+  m_entries.setMaxCost (MAX_CURVES_CACHED);
+}
+
+QSharedPointer<const SplineArcLength> SplineArcLengthCache::arcLength (const QString &curveName,
+                                                                       const vector<double> &t,
+                                                                       const vector<SplinePair> &xy,
+                                                                       int numSamples)
+{
+  {
+    QMutexLocker locker (&m_mutex);
+
+    const Entry *entry = m_entries.object (curveName);
+    if ((entry != nullptr) &&
+        isEntryCurrent (*entry,
+                        t,
+                        xy,
+                        numSamples)) {
+      return entry->arcLength;
+    }
+  }
+
+  // Points of this curve changed, or it has not been seen before. The table is built without holding the lock, so
+  // other curves being exported in parallel are not held up
+  Spline spline (t,
+                 xy);
+
+  Entry *entry = new Entry;
+  entry->t = t;
+  entry->xy = xy;
+  entry->numSamples = numSamples;
+  entry->arcLength = QSharedPointer<const SplineArcLength> (new SplineArcLength (spline,
+                                                                                t.front (),
+                                                                                t.back (),
+                                                                                numSamples));
+  QSharedPointer<const SplineArcLength> arcLength = entry->arcLength;
+
+  QMutexLocker locker (&m_mutex);
+  m_entries.insert (curveName,
+                    entry);
+
+  return arcLength;
+}
+
+bool SplineArcLengthCache::isEntryCurrent (const Entry &entry,
+                                           const vector<double> &t,
+                                           const vector<SplinePair> &xy,
+                                           int numSamples) const
+{
+  if ((entry.numSamples != numSamples) ||
+      (entry.t != t) ||
+      (entry.xy.size () != xy.size ())) {
+    return false;
+  }
+
+  for (unsigned int i = 0; i < xy.size (); i++) {
+    if ((entry.xy [i].x () != xy [i].x ()) ||
+        (entry.xy [i].y () != xy [i].y ())) {
+      return false;
+    }
+  }
+
+  return true;
+}
@@ -0,0 +1,54 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef SPLINE_ARC_LENGTH_CACHE_H
+#define SPLINE_ARC_LENGTH_CACHE_H
+
+#include <QCache>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QString>
+#include "SplineArcLength.h"
+#include "SplinePair.h"
+#include <vector>
+
+/// Arc length tables of recently used curves, one table per curve name. A curve's table is reused until the spline
+/// inputs of that curve change, so repeated exports and geometry updates of unchanged curves skip the spline fit
+/// and sampling. Safe to use from several threads
+class SplineArcLengthCache
+{
+public:
+  /// Single constructor
+  SplineArcLengthCache();
+
+  /// Table for the specified curve, with numSamples samples across the spline fitted to t and xy. The table is
+  /// rebuilt if any of those inputs differ from the ones the curve's cached table was built from
+  QSharedPointer<const SplineArcLength> arcLength (const QString &curveName,
+                                                   const std::vector<double> &t,
+                                                   const std::vector<SplinePair> &xy,
+                                                   int numSamples);
+
+private:
+
+  // Table and the inputs it was built from
+  struct Entry {
+    std::vector<double> t;
+    std::vector<SplinePair> xy;
+    int numSamples;
+    QSharedPointer<const SplineArcLength> arcLength;
+  };
+
+  // True if the entry was built from the specified inputs
+  bool isEntryCurrent (const Entry &entry,
+                       const std::vector<double> &t,
+                       const std::vector<SplinePair> &xy,
+                       int numSamples) const;
+
+  QMutex m_mutex;
+  QCache<QString, Entry> m_entries;
+};
+
+#endif // SPLINE_ARC_LENGTH_CACHE_H
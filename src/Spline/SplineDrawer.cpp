@@ -115,3 +115,8 @@ SplineDrawerOperation SplineDrawer::segmentOperation (int segment) const
     return SPLINE_DRAWER_ENUM_INVISIBLE_MOVE;
   }
 }
+
+const Transformation &SplineDrawer::transformation () const
+{
+  return m_transformation;
+}
@@ -54,6 +54,9 @@ class SplineDrawer
   /// Indicate if, and how, segment is to be drawn
   SplineDrawerOperation segmentOperation (int segment) const;
 
+  /// Transformation used to check segments for single-valuedness
+  const Transformation &transformation () const;
+
 private:
   SplineDrawer();
 
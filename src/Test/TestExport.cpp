@@ -1,16 +1,27 @@
+#include "CallbackGatherXThetasInCurves.h"
+#include "Compatibility.h"
 #include "CurveConnectAs.h"
 #include "Document.h"
 #include "DocumentModelExportFormat.h"
+#include "ExportColumnsLoader.h"
 #include "ExportFileFunctions.h"
 #include "ExportFileRelations.h"
+#include "ExportToFileNumpy.h"
+#include "ExportValuesColumn.h"
 #include "ExportValuesXOrY.h"
+#include "ExportXThetaValuesMergedFunctions.h"
+#include "ExportZipStored.h"
 #include "LineStyle.h"
 #include "Logger.h"
 #include "MainWindow.h"
 #include "MainWindowModel.h"
 #include "PointStyle.h"
+#include <QBuffer>
+#include <QDataStream>
 #include <QImage>
+#include <QMap>
 #include <qmath.h>
+#include <qnumeric.h>
 #include <QtTest/QtTest>
 #include "Spline.h"
 #include "SplinePair.h"
@@ -67,11 +78,15 @@ bool TestExport::checkCommasInFunctionsForDelimiter (ExportDelimiter delimiter,
 
     ExportFileFunctions exportFile;
     CurveLimits curveLimitsMin, curveLimitsMax; // Empty containers mean no limits are in effect
+    ExportXThetaValuesMergedFunctions xThetaValues (m_modelExportOverride,
+                                                    m_modelMainWindow,
+                                                    m_xThetaValues,
+                                                    m_transformation);
     exportFile.exportAllPerLineXThetaValuesMerged (m_modelExportOverride,
                                                    *m_document,
                                                    m_modelMainWindow,
                                                    m_curvesIncluded,
-                                                   m_xThetaValues,
+                                                   xThetaValues,
                                                    exportDelimiterToText (delimiter, NOT_USING_GNUPLOT),
                                                    m_transformation,
                                                    isLogXTheta,
@@ -599,6 +614,91 @@ void TestExport::testExportOnlyRegressionUpperCase ()
   QVERIFY (outputGot == outputWanted);
 }
 
+void TestExport::testFunctionsRowsPastPointLimit ()
+{
+  initData (false,
+            EXPORT_DELIMITER_COMMA,
+            QLocale::UnitedStates);
+
+  // Interval gives twice as many rows as the maximum number of exported points per curve
+  int rowsWanted = 2 * m_modelMainWindow.maximumExportedPointsPerCurve ();
+  ExportValuesXOrY xThetaValuesRaw;
+  xThetaValuesRaw << 0.0 << 1.0;
+
+  DocumentModelExportFormat modelExport (m_modelExportOverride);
+  modelExport.setPointsSelectionFunctions (EXPORT_POINTS_SELECTION_FUNCTIONS_INTERPOLATE_PERIODIC);
+  modelExport.setPointsIntervalFunctions (1.0 / rowsWanted);
+  modelExport.setPointsIntervalUnitsFunctions (EXPORT_POINTS_INTERVAL_UNITS_GRAPH);
+
+  ExportXThetaValuesMergedFunctions xThetaValues (modelExport,
+                                                  m_modelMainWindow,
+                                                  xThetaValuesRaw,
+                                                  m_transformation);
+
+  // Loading every value at once is what the limit protects against, so that gives nothing
+  bool isOverrun = false;
+  QVERIFY (xThetaValues.xThetaValues (isOverrun).isEmpty ());
+  QVERIFY (isOverrun);
+
+  QString output;
+  QTextStream str (&output);
+  unsigned int numWritesSoFar = 0;
+
+  ExportFileFunctions exportFile;
+  CurveLimits curveLimitsMin, curveLimitsMax; // Empty containers mean no limits are in effect
+  exportFile.exportAllPerLineXThetaValuesMerged (modelExport,
+                                                 *m_document,
+                                                 m_modelMainWindow,
+                                                 m_curvesIncluded,
+                                                 xThetaValues,
+                                                 exportDelimiterToText (EXPORT_DELIMITER_COMMA, NOT_USING_GNUPLOT),
+                                                 m_transformation,
+                                                 false,
+                                                 false,
+                                                 curveLimitsMin,
+                                                 curveLimitsMax,
+                                                 str,
+                                                 numWritesSoFar);
+  str.flush ();
+
+  // Header line, then one line per interval up to and including the maximum
+  QStringList lines = output.split ("\n", Compatibility::SkipEmptyParts ());
+  QVERIFY (lines.count () - 1 >= rowsWanted);
+  QVERIFY (lines.count () - 1 <= rowsWanted + 1);
+  QVERIFY (lines.last ().startsWith ("1,"));
+}
+
+void TestExport::testGatherXThetasMergedRuns ()
+{
+  // Interleaved increasing runs with values shared between them, then a descending stretch with repeated values
+  // which splits into one run per value
+  QList<double> gathered;
+  gathered << 1.0 << 3.0 << 5.0 << 7.0
+           << 2.0 << 3.0 << 4.0 << 8.0
+           << 9.0 << 6.0 << 6.0 << 2.0 << 0.0
+           << -1.5 << 3.0 << 3.0 << 10.0;
+
+  DocumentModelExportFormat modelExport;
+  QStringList curvesIncluded;
+  curvesIncluded << "Curve1";
+
+  CallbackGatherXThetasInCurves ftor (modelExport,
+                                      curvesIncluded,
+                                      m_transformation);
+
+  // Expected result is what the QMap keys gave before the runs were merged
+  QMap<double, bool> xThetaValuesMap;
+  QList<double>::const_iterator itr;
+  for (itr = gathered.begin (); itr != gathered.end (); itr++) {
+    ftor.addGraphX (*itr);
+    xThetaValuesMap [*itr] = true;
+  }
+
+  ExportValuesXOrY xThetaValues = ftor.xThetaValuesRaw ();
+
+  QVERIFY (xThetaValues == ExportValuesXOrY (xThetaValuesMap.keys ()));
+}
+
 void TestExport::testLogExtrapolationFunctionsAll ()
 {
   initData (true,
@@ -616,11 +716,15 @@ void TestExport::testLogExtrapolationFunctionsAll ()
     
     ExportFileFunctions exportFile;
     CurveLimits curveLimitsMin, curveLimitsMax; // Empty containers mean no limits are in effect    
+    ExportXThetaValuesMergedFunctions xThetaValues (m_modelExportOverride,
+                                                    m_modelMainWindow,
+                                                    m_xThetaValues,
+                                                    m_transformation);
     exportFile.exportAllPerLineXThetaValuesMerged (m_modelExportOverride,
                                                    *m_document,
                                                    m_modelMainWindow,
                                                    m_curvesIncluded,
-                                                   m_xThetaValues,
+                                                   xThetaValues,
                                                    " ",
                                                    m_transformation,
                                                    isLogXTheta,
@@ -637,3 +741,146 @@ void TestExport::testLogExtrapolationFunctionsAll ()
 
   QVERIFY (success);
 }
+
+void TestExport::testNumpyNpyHeaderAndValues ()
+{
+  // Two blocks, where the second column has a row without a value and then ends early as a relation column can
+  int blockIndex = 0;
+  ExportColumnsLoader loader = [&blockIndex] (int,
+                                              QVector<ExportValuesColumn> &columns) -> int {
+    columns.clear ();
+    if (blockIndex == 0) {
+      ExportValuesColumn column0 (2), column1 (2);
+      column0.setValue (0, 1.5, -2.0);
+      column0.setValue (1, 3.25, 0.0);
+      column1.setValue (0, 1e300, -1e-300);
+      columns << column0 << column1;
+      ++blockIndex;
+      return 2;
+    } else if (blockIndex == 1) {
+      ExportValuesColumn column0 (1), column1;
+      column0.setValue (0, 4.0, 5.0);
+      columns << column0 << column1;
+      ++blockIndex;
+      return 1;
+    }
+    return 0;
+  };
+
+  QVector<double> values;
+  values << 1.5 << -2.0 << 1e300 << -1e-300
+         << 3.25 << 0.0 << qQNaN () << qQNaN ()
+         << 4.0 << 5.0 << qQNaN () << qQNaN ();
+
+  QBuffer buffer;
+  buffer.open (QIODevice::WriteOnly);
+
+  ExportToFileNumpy exportNumpy;
+  QVERIFY (exportNumpy.writeNpy (loader,
+                                 2,
+                                 3,
+                                 buffer));
+
+  QByteArray npy = buffer.data ();
+  QDataStream str (npy);
+  str.setByteOrder (QDataStream::LittleEndian);
+  str.setFloatingPointPrecision (QDataStream::DoublePrecision);
+
+  char magic [6];
+  quint8 versionMajor, versionMinor;
+  quint16 headerLength;
+  str.readRawData (magic, 6);
+  str >> versionMajor >> versionMinor >> headerLength;
+
+  QVERIFY (QByteArray (magic, 6) == QByteArray ("\x93NUMPY", 6));
+  QVERIFY (versionMajor == 1 && versionMinor == 0);
+
+  // Data must start on a 64 byte boundary, right after the newline that ends the header
+  int dataStart = 10 + headerLength;
+  QVERIFY (dataStart % 64 == 0);
+  QVERIFY (npy.at (dataStart - 1) == '\n');
+
+  QByteArray header = npy.mid (10, headerLength);
+  QVERIFY (header.contains ("'descr': '<f8'"));
+  QVERIFY (header.contains ("'fortran_order': False"));
+  QVERIFY (header.contains ("'shape': (3, 4)"));
+
+  QVERIFY (npy.size () == dataStart + values.count () * 8);
+
+  str.skipRawData (headerLength);
+  for (int i = 0; i < values.count (); i++) {
+    double value;
+    str >> value;
+    if (qIsNaN (values.at (i))) {
+      QVERIFY (qIsNaN (value));
+    } else {
+      QVERIFY (value == values.at (i));
+    }
+  }
+}
+
+void TestExport::testNumpyNpzMembersAndCrc ()
+{
+  QBuffer buffer;
+  buffer.open (QIODevice::WriteOnly);
+
+  // Crc32 check value of "123456789" is the standard 0xcbf43926. The first member is written in two pieces so the
+  // crc has to carry over from one piece to the next
+  ExportZipStored zipStored (buffer);
+  zipStored.beginMember ("check.npy");
+  zipStored.writeMember ("1234");
+  zipStored.writeMember ("56789");
+  zipStored.beginMember ("header.json");
+  zipStored.writeMember ("{}");
+  QVERIFY (zipStored.finish ());
+
+  QByteArray zip = buffer.data ();
+  QDataStream str (zip);
+  str.setByteOrder (QDataStream::LittleEndian);
+
+  // Local header of the first member, followed by its name and its stored bytes. The crc and sizes come after the
+  // stored bytes, in the data descriptor
+  quint32 signature, crc, sizeCompressed, sizeUncompressed;
+  quint16 versionNeeded, flags, method, time, date, nameLength, extraLength;
+  str >> signature >> versionNeeded >> flags >> method >> time >> date >> crc
+      >> sizeCompressed >> sizeUncompressed >> nameLength >> extraLength;
+
+  QVERIFY (signature == 0x04034b50);
+  QVERIFY (method == 0);
+  QVERIFY ((flags & 0x0008) != 0);
+  QVERIFY (zip.mid (30, nameLength) == "check.npy");
+
+  int dataStart = 30 + nameLength + extraLength;
+  QVERIFY (zip.mid (dataStart, 9) == "123456789");
+
+  QDataStream strDescriptor (zip.mid (dataStart + 9, 16));
+  strDescriptor.setByteOrder (QDataStream::LittleEndian);
+  strDescriptor >> signature >> crc >> sizeCompressed >> sizeUncompressed;
+
+  QVERIFY (signature == 0x08074b50);
+  QVERIFY (crc == 0xcbf43926);
+  QVERIFY (sizeCompressed == 9 && sizeUncompressed == 9);
+
+  // End of central directory record is the last 22 bytes, since there is no comment
+  QDataStream strEnd (zip.right (22));
+  strEnd.setByteOrder (QDataStream::LittleEndian);
+
+  quint16 diskNumber, diskCentral, entriesDisk, entriesTotal, commentLength;
+  quint32 sizeCentral, offsetCentral;
+  strEnd >> signature >> diskNumber >> diskCentral >> entriesDisk >> entriesTotal >> sizeCentral >> offsetCentral
+         >> commentLength;
+
+  QVERIFY (signature == 0x06054b50);
+  QVERIFY (entriesDisk == 2 && entriesTotal == 2);
+  QVERIFY (offsetCentral + sizeCentral + 22 == unsigned (zip.size ()));
+
+  // Central directory repeats the crc and sizes of the first member
+  quint16 versionMadeBy;
+  QDataStream strCentral (zip.mid (signed (offsetCentral)));
+  strCentral.setByteOrder (QDataStream::LittleEndian);
+  strCentral >> signature >> versionMadeBy >> versionNeeded >> flags >> method >> time >> date >> crc
+             >> sizeCompressed >> sizeUncompressed;
+  QVERIFY (signature == 0x02014b50);
+  QVERIFY (crc == 0xcbf43926);
+  QVERIFY (sizeCompressed == 9 && sizeUncompressed == 9);
+}
@@ -41,7 +41,11 @@ private slots:
   void testExportOnlyNonRegressionUpperCase ();  
   void testExportOnlyRegressionLowerCase ();
   void testExportOnlyRegressionUpperCase ();    
+  void testFunctionsRowsPastPointLimit ();
+  void testGatherXThetasMergedRuns ();
   void testLogExtrapolationFunctionsAll ();
+  void testNumpyNpyHeaderAndValues ();
+  void testNumpyNpzMembersAndCrc ();
 
 private:
   bool checkCommasInFunctionsForDelimiter (ExportDelimiter delimiter,
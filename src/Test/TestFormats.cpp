@@ -1,9 +1,18 @@
+#include "DocumentModelCoords.h"
+#include "DocumentModelGeneral.h"
 #include "FormatDateTime.h"
 #include "FormatDegreesMinutesSecondsBase.h"
+#include "FormatPrecisionPlan.h"
 #include "Logger.h"
 #include "MainWindow.h"
+#include "MainWindowModel.h"
+#include <qmath.h>
+#include <QTransform>
 #include <QtTest/QtTest>
 #include "Test/TestFormats.h"
+#include "Transformation.h"
+
+const int EXTRA_PRECISION = 1;
 
 QTEST_MAIN (TestFormats)
 
@@ -45,6 +54,70 @@ void TestFormats::initTestCase ()
   w.show ();
 }
 
+bool TestFormats::precisionPlanMatchesRoundTrip (const Transformation &transformation,
+                                                 const QList<double> &values) const
+{
+  DocumentModelGeneral modelGeneral;
+  modelGeneral.setExtraPrecision (EXTRA_PRECISION);
+
+  FormatPrecisionPlan plan (modelGeneral,
+                            transformation);
+
+  // Every value is tried as x/theta and as y/radius, against every other value
+  QList<double>::const_iterator itr, itrOther;
+  for (itr = values.begin (); itr != values.end (); itr++) {
+    for (itrOther = values.begin (); itrOther != values.end (); itrOther++) {
+      for (int isXTheta = 0; isXTheta < 2; isXTheta++) {
+
+        int digitsPlan = plan.precisionDigitsForRawNumber (*itr,
+                                                           *itrOther,
+                                                           isXTheta != 0);
+        int digitsRoundTrip = precisionDigitsRoundTrip (*itr,
+                                                        *itrOther,
+                                                        isXTheta != 0,
+                                                        transformation);
+        if (digitsPlan != digitsRoundTrip) {
+          qDebug() << "value" << *itr << "other" << *itrOther << "isXTheta" << isXTheta
+                   << "plan" << digitsPlan << "round trip" << digitsRoundTrip;
+          return false;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+int TestFormats::precisionDigitsRoundTrip (double valueUnformatted,
+                                           double valueUnformattedOther,
+                                           bool isXTheta,
+                                           const Transformation &transformation) const
+{
+  // Per value screen round trip that chose the precision before FormatPrecisionPlan existed
+  const double PIXEL_SHIFT = 1;
+
+  QPointF posGraph = (isXTheta ?
+                        QPointF (valueUnformatted, valueUnformattedOther) :
+                        QPointF (valueUnformattedOther, valueUnformatted));
+
+  QPointF posScreen, posGraphShifted;
+  transformation.transformRawGraphToScreen (posGraph,
+                                            posScreen);
+  transformation.transformScreenToRawGraph (posScreen + QPointF (PIXEL_SHIFT, PIXEL_SHIFT),
+                                            posGraphShifted);
+
+  double xResolutionPerPixel = (posGraphShifted.x() - posGraph.x()) / PIXEL_SHIFT;
+  double yResolutionPerPixel = (posGraphShifted.y() - posGraph.y()) / PIXEL_SHIFT;
+  double resolutionPerPixel = (isXTheta ? xResolutionPerPixel : yResolutionPerPixel);
+
+  int powerValue = qFloor (qLn (qAbs (valueUnformatted)) / qLn (10.0));
+  int powerResolution = qFloor (qLn (qAbs (resolutionPerPixel)) / qLn (10.0));
+
+  int numberDigitsForResolution = powerValue - powerResolution + 1 + EXTRA_PRECISION;
+
+  return numberDigitsForResolution + 1;
+}
+
 bool TestFormats::stateDegreesMinutesSeconds (const QString &string, QValidator::State stateExpected)
 {
   FormatDegreesMinutesSecondsBase format;
@@ -76,6 +149,33 @@ bool TestFormats::stateYearMonthDayHourMinuteSecond (const QString &string, QVal
   return success;
 }
 
+void TestFormats::transformationForAxes (const QPointF &s0,
+                                        const QPointF &s1,
+                                        const QPointF &s2,
+                                        const QPointF &g0,
+                                        const QPointF &g1,
+                                        const QPointF &g2,
+                                        const DocumentModelCoords &modelCoords,
+                                        Transformation &transformation) const
+{
+  QTransform matrixScreen (s0.x(), s1.x(), s2.x(),
+                           s0.y(), s1.y(), s2.y(),
+                           1.0, 1.0, 1.0);
+  QTransform matrixGraph (g0.x(), g1.x(), g2.x(),
+                          g0.y(), g1.y(), g2.y(),
+                          1.0, 1.0, 1.0);
+
+  DocumentModelGeneral modelGeneral;
+  modelGeneral.setExtraPrecision (EXTRA_PRECISION);
+
+  MainWindowModel mainWindowModel;
+  transformation.setModelCoords (modelCoords,
+                                 modelGeneral,
+                                 mainWindowModel);
+  transformation.updateTransformFromMatrices (matrixScreen,
+                                              matrixGraph);
+}
+
 void TestFormats::testDateTimeMdy ()
 {
   QVERIFY (stateMonthDayYearHourMinuteSecond ("", QValidator::Intermediate));
@@ -191,6 +291,16 @@ void TestFormats::testDateTimeMdy01Slash02Slash2020Space01Colon02Colon03SpaceAM
   QVERIFY (stateMonthDayYearHourMinuteSecond ("01/02/2020 01:02:03 AM", QValidator::Acceptable));
 }
 
+void TestFormats::testDateTimeMdy01Slash02Slash2020Space01Colon02Colon03SpaceAMSlash ()
+{
+  QVERIFY (stateMonthDayYearHourMinuteSecond ("01/02/2020 01:02:03 AM/", QValidator::Invalid));
+}
+
+void TestFormats::testDateTimeMdyJa ()
+{
+  QVERIFY (stateMonthDayYearHourMinuteSecond ("Ja", QValidator::Intermediate));
+}
+
 void TestFormats::testDateTimeYmd ()
 {
   QVERIFY (stateYearMonthDayHourMinuteSecond ("", QValidator::Intermediate));
@@ -335,3 +445,55 @@ void TestFormats::testDegreesMinutesSeconds180Space10Space20 ()
 {
   QVERIFY (stateDegreesMinutesSeconds ("180 10 20", QValidator::Acceptable));
 }
+
+void TestFormats::testPrecisionPlanLinearPowerOfTen ()
+{
+  // Axes chosen so a one pixel shift is exactly 0.1 in x and exactly 1 in y, which are the resolutions where the
+  // plan and the round trip could end up on different sides of a power of ten
+  DocumentModelCoords modelCoords;
+  modelCoords.setCoordScaleXTheta (COORD_SCALE_LINEAR);
+  modelCoords.setCoordScaleYRadius (COORD_SCALE_LINEAR);
+  modelCoords.setCoordsType (COORDS_TYPE_CARTESIAN);
+
+  Transformation transformation;
+  transformationForAxes (QPointF (100, 1100),
+                         QPointF (1100, 1100),
+                         QPointF (100, 100),
+                         QPointF (0, 0),
+                         QPointF (100, 0),
+                         QPointF (0, -1000),
+                         modelCoords,
+                         transformation);
+
+  QList<double> values;
+  values << 0.1 << 0.3 << 1.0 << 9.999999999999 << 10.0 << 10.000000000001 << 100.0 << -100.0 << 999.0 << 1000.0;
+
+  QVERIFY (precisionPlanMatchesRoundTrip (transformation,
+                                          values));
+}
+
+void TestFormats::testPrecisionPlanLogPowerOfTen ()
+{
+  // Log x axis with one decade per 100 pixels, and log y axis with three decades per 300 pixels. Values at and
+  // next to each power of ten are where the digit count of a value changes
+  DocumentModelCoords modelCoords;
+  modelCoords.setCoordScaleXTheta (COORD_SCALE_LOG);
+  modelCoords.setCoordScaleYRadius (COORD_SCALE_LOG);
+  modelCoords.setCoordsType (COORDS_TYPE_CARTESIAN);
+
+  Transformation transformation;
+  transformationForAxes (QPointF (100, 400),
+                         QPointF (200, 400),
+                         QPointF (100, 100),
+                         QPointF (1, 1),
+                         QPointF (10, 1),
+                         QPointF (1, 1000),
+                         modelCoords,
+                         transformation);
+
+  QList<double> values;
+  values << 0.01 << 0.1 << 1.0 << 2.0 << 9.999999999999 << 10.0 << 10.000000000001 << 100.0 << 1000.0;
+
+  QVERIFY (precisionPlanMatchesRoundTrip (transformation,
+                                          values));
+}
@@ -1,9 +1,14 @@
 #ifndef TEST_FORMATS_H
 #define TEST_FORMATS_H
 
+#include <QList>
 #include <QObject>
+#include <QPointF>
 #include <QValidator>
 
+class DocumentModelCoords;
+class Transformation;
+
 /// Unit tests of formats
 class TestFormats : public QObject
 {
@@ -41,6 +46,8 @@ class TestFormats : public QObject
   void testDateTimeMdy01Slash02Slash2020Space01Colon02Colon03Space ();
   void testDateTimeMdy01Slash02Slash2020Space01Colon02Colon03SpaceA ();
   void testDateTimeMdy01Slash02Slash2020Space01Colon02Colon03SpaceAM ();
+  void testDateTimeMdy01Slash02Slash2020Space01Colon02Colon03SpaceAMSlash ();
+  void testDateTimeMdyJa ();
   void testDateTimeYmd ();
   void testDateTimeYmd2 ();
   void testDateTimeYmd20 ();
@@ -70,11 +77,27 @@ class TestFormats : public QObject
   void testDegreesMinutesSeconds180Space10 ();
   void testDegreesMinutesSeconds180Space10Space ();
   void testDegreesMinutesSeconds180Space10Space20 ();
+  void testPrecisionPlanLinearPowerOfTen ();
+  void testPrecisionPlanLogPowerOfTen ();
 
  private:
+  bool precisionPlanMatchesRoundTrip (const Transformation &transformation,
+                                      const QList<double> &values) const;
+  int precisionDigitsRoundTrip (double valueUnformatted,
+                                double valueUnformattedOther,
+                                bool isXTheta,
+                                const Transformation &transformation) const;
   bool stateDegreesMinutesSeconds (const QString &string, QValidator::State stateExpected);
   bool stateMonthDayYearHourMinuteSecond (const QString &string, QValidator::State stateExpected);  
   bool stateYearMonthDayHourMinuteSecond (const QString &string, QValidator::State stateExpected);
+  void transformationForAxes (const QPointF &s0,
+                              const QPointF &s1,
+                              const QPointF &s2,
+                              const QPointF &g0,
+                              const QPointF &g1,
+                              const QPointF &g2,
+                              const DocumentModelCoords &modelCoords,
+                              Transformation &transformation) const;
 
 };
 
@@ -1,6 +1,7 @@
 #include "CmdAddPointAxis.h"
 #include "CmdDelete.h"
 #include "CmdGong.h"
+#include "CmdMediator.h"
 #include "GuidelineAbstract.h"
 #include "Guidelines.h"
 #include "Logger.h"
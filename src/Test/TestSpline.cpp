@@ -5,6 +5,7 @@
 #include <qmath.h>
 #include <QtTest/QtTest>
 #include "Spline.h"
+#include "SplineArcLength.h"
 #include "SplinePair.h"
 #include <sstream>
 #include "Test/TestSpline.h"
@@ -213,6 +214,46 @@ void TestSpline::initTestCase ()
   w.show ();
 }
 
+void TestSpline::testArcLength ()
+{
+  const double ARC_LENGTH_EPSILON = 1e-9;
+
+  bool success = true;
+  vector<double> t;
+  vector<SplinePair> xy;
+
+  // Evenly spaced points along a straight line, so the spline is the line itself and has length 10
+  for (int i = 0; i < 3; i++) {
+    t.push_back (i);
+    xy.push_back (SplinePair (3.0 * i, 4.0 * i));
+  }
+
+  Spline s (t, xy);
+  SplineArcLength arcLength (s,
+                             t.front (),
+                             t.back (),
+                             7);
+
+  success &= (arcLength.numSamples () == 7);
+  success &= (qAbs (arcLength.length () - 10.0) < ARC_LENGTH_EPSILON);
+  success &= (qAbs (arcLength.distanceAtSample (3) - 5.0) < ARC_LENGTH_EPSILON);
+
+  // Samples are 5/3 apart. Intervals of 3 end where the carried-over remainder puts them, which is at t=19/30, 14/11
+  // and 23/12 rather than the exact t=0.6, 1.2 and 1.8. The last interval ends in the last sample so t=2 is not added
+  vector<double> ts = arcLength.tAtIntervalsWithRemainder (3.0);
+  success &= (ts.size () == 3);
+  if (ts.size () == 3) {
+    success &= (qAbs (ts [0] - 19.0 / 30.0) < ARC_LENGTH_EPSILON);
+    success &= (qAbs (ts [1] - 14.0 / 11.0) < ARC_LENGTH_EPSILON);
+    success &= (qAbs (ts [2] - 23.0 / 12.0) < ARC_LENGTH_EPSILON);
+  }
+
+  // Nonpositive interval gives nothing rather than looping forever
+  success &= arcLength.tAtIntervalsWithRemainder (0.0).empty ();
+
+  QVERIFY (success);
+}
+
 void TestSpline::testCoefficientsFromOrdinals ()
 {
   bool success = true;
@@ -247,6 +288,48 @@ void TestSpline::testCoefficientsFromOrdinals ()
   QVERIFY(success);
 }
 
+void TestSpline::testFindSplinePairForFunctionX ()
+{
+  const int MAX_ITERATIONS = 32;
+  const double SPLINE_EPSILON = 1e-7;
+
+  bool success = true;
+  vector<double> t;
+  vector<SplinePair> xy;
+
+  // Increasing x values with uneven spacing, so x(t) is monotonic but not linear
+  for (int i = 0; i < 20; i++) {
+    double x = 0.1 * i * i + i;
+    t.push_back (i);
+    xy.push_back (SplinePair (x, qSin (x)));
+  }
+
+  Spline s (t, xy);
+
+  // Sorted x values that include extrapolation at both ends and exact matches of the input points
+  vector<double> xValues;
+  for (int i = -30; i < 600; i++) {
+    xValues.push_back (0.1 * i);
+  }
+
+  vector<SplinePair> splinePairs;
+  s.findSplinePairsForFunctionX (xValues,
+                                 MAX_ITERATIONS,
+                                 splinePairs);
+
+  for (unsigned int i = 0; i < xValues.size(); i++) {
+    SplinePair spOne = s.findSplinePairForFunctionX (xValues [i],
+                                                     MAX_ITERATIONS);
+    SplinePair spBisection = s.findSplinePairByBisection (xValues [i],
+                                                          MAX_ITERATIONS);
+
+    success &= (splinePairs [i].y() == spOne.y());
+    success &= (qAbs (spOne.y() - spBisection.y()) < SPLINE_EPSILON);
+  }
+
+  QVERIFY (success);
+}
+
 void TestSpline::testSharpTransition ()
 {
   const int NUM_T = 60;
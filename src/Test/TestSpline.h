@@ -22,7 +22,9 @@ private slots:
   void cleanupTestCase ();
   void initTestCase ();
 
+  void testArcLength (); /// Distance and t lookups along a straight line, where the arc length is known exactly
   void testCoefficientsFromOrdinals (); /// Compare with third party calculations on a web page
+  void testFindSplinePairForFunctionX (); /// Interval solve and batched solve must match the bisection search
   void testSharpTransition (); /// Uses x values in t array to get single-valued function across sharp transition
   void testSplinesAsControlPoints ();
 
@@ -1,9 +1,16 @@
+#include "ColorFilterSettings.h"
+#include "Curve.h"
+#include "CurveStyle.h"
 #include "DocumentModelCoords.h"
 #include "DocumentModelGeneral.h"
 #include "Logger.h"
 #include "MainWindow.h"
 #include "MainWindowModel.h"
+#include "Point.h"
+#include "PointStyle.h"
 #include <qmath.h>
+#include <QHash>
+#include <QMultiMap>
 #include <QtTest/QtTest>
 #include "Test/TestTransformation.h"
 #include "Transformation.h"
@@ -19,6 +26,40 @@ TestTransformation::TestTransformation(QObject *parent) :
 {
 }
 
+bool TestTransformation::checkCurveOrdinals (Curve &curve) const
+{
+  // Ordinals as the QMultiMap of x values gave them, before the batch and the incremental sort replaced it
+  QMultiMap<double, unsigned int> xToPointIdentifier;
+  const Points pointsBefore = curve.points ();
+  Points::const_iterator itr;
+  for (itr = pointsBefore.begin (); itr != pointsBefore.end (); itr++) {
+    xToPointIdentifier.insert (itr->posScreen ().x (),
+                               itr->identifierNumber ());
+  }
+
+  QHash<unsigned int, int> ordinalsExpected;
+  int ordinal = 0;
+  QMultiMap<double, unsigned int>::const_iterator itrX;
+  for (itrX = xToPointIdentifier.begin (); itrX != xToPointIdentifier.end (); itrX++) {
+    ordinalsExpected [itrX.value ()] = ordinal++;
+  }
+
+  Transformation transformation; // Undefined, so the screen coordinates are used directly
+  curve.updatePointOrdinals (transformation);
+
+  // Ordinals must match, and the list must be in ordinal order
+  const Points pointsAfter = curve.points ();
+  for (int index = 0; index < pointsAfter.count (); index++) {
+    const Point &point = pointsAfter.at (index);
+    if (qFloor (point.ordinal ()) != ordinalsExpected [point.identifierNumber ()] ||
+        qFloor (point.ordinal ()) != index) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 void TestTransformation::cleanupTestCase ()
 {
 
@@ -96,6 +137,15 @@ void TestTransformation::initTransformation (const QPointF &s0,
                                m_s1Transformed);
   t.transformRawGraphToScreen (g2,
                                m_s2Transformed);
+
+  QVector<double> xGraph, yGraph; // Screen coordinates that are replaced by graph coordinates
+  xGraph << s0.x() << s1.x() << s2.x();
+  yGraph << s0.y() << s1.y() << s2.y();
+  t.transformScreenToRawGraph (xGraph,
+                               yGraph);
+  m_batchDifference = qMax (qMax (differenceMagnitude (QPointF (xGraph [0], yGraph [0]), m_g0Transformed),
+                                  differenceMagnitude (QPointF (xGraph [1], yGraph [1]), m_g1Transformed)),
+                            differenceMagnitude (QPointF (xGraph [2], yGraph [2]), m_g2Transformed));
 }
 
 DocumentModelCoords TestTransformation::modelCoordsDefault() const
@@ -150,6 +200,7 @@ void TestTransformation::testCartesianLinearLinear ()
   QVERIFY ((differenceMagnitude (g0, m_g0Transformed) < EPSILON));
   QVERIFY ((differenceMagnitude (g1, m_g1Transformed) < EPSILON));
   QVERIFY ((differenceMagnitude (g2, m_g2Transformed) < EPSILON));
+  QVERIFY ((m_batchDifference < EPSILON));
 }
 
 void TestTransformation::testCartesianLinearLog ()
@@ -178,6 +229,7 @@ void TestTransformation::testCartesianLinearLog ()
   QVERIFY ((differenceMagnitude (g0, m_g0Transformed) < EPSILON));
   QVERIFY ((differenceMagnitude (g1, m_g1Transformed) < EPSILON));
   QVERIFY ((differenceMagnitude (g2, m_g2Transformed) < EPSILON));
+  QVERIFY ((m_batchDifference < EPSILON));
 }
 
 void TestTransformation::testCartesianLogLinear ()
@@ -206,6 +258,7 @@ void TestTransformation::testCartesianLogLinear ()
   QVERIFY ((differenceMagnitude (g0, m_g0Transformed) < EPSILON));
   QVERIFY ((differenceMagnitude (g1, m_g1Transformed) < EPSILON));
   QVERIFY ((differenceMagnitude (g2, m_g2Transformed) < EPSILON));
+  QVERIFY ((m_batchDifference < EPSILON));
 }
 
 void TestTransformation::testCartesianLogLog ()
@@ -235,6 +288,49 @@ void TestTransformation::testCartesianLogLog ()
   QVERIFY ((differenceMagnitude (g0, m_g0Transformed) < EPSILON));
   QVERIFY ((differenceMagnitude (g1, m_g1Transformed) < EPSILON));
   QVERIFY ((differenceMagnitude (g2, m_g2Transformed) < EPSILON));
+  QVERIFY ((m_batchDifference < EPSILON));
+}
+
+void TestTransformation::testCurveOrdinalsEqualX ()
+{
+  const int NUM_POINTS = 40;
+  const QString CURVE_NAME ("Curve1");
+
+  Curve curve (CURVE_NAME,
+               ColorFilterSettings::defaultFilter (),
+               CurveStyle (LineStyle (1,
+                                      COLOR_PALETTE_BLUE,
+                                      CONNECT_AS_FUNCTION_STRAIGHT),
+                           PointStyle::defaultGraphCurve (0)));
+
+  // Only 13 different x values, so most points share their x value with two or more others
+  for (int index = 0; index < NUM_POINTS; index++) {
+    Point point (CURVE_NAME,
+                 QPointF ((index * 5) % 13,
+                          index));
+    point.setOrdinal (index);
+    curve.addPoint (point);
+  }
+
+  QVERIFY (checkCurveOrdinals (curve));
+
+  // Nothing moved, so only points with equal x change places
+  QVERIFY (checkCurveOrdinals (curve));
+
+  // A few small moves, some onto the x value of another point, which the insertion sort handles locally
+  Points points = curve.points ();
+  curve.movePoint (points.at (3).identifier (CURVE_NAME), QPointF (1, 0));
+  curve.movePoint (points.at (17).identifier (CURVE_NAME), QPointF (-0.5, 0));
+  curve.movePoint (points.at (30).identifier (CURVE_NAME), QPointF (2, 0));
+  QVERIFY (checkCurveOrdinals (curve));
+
+  // Reversing the x values moves every point, so the full sort takes over
+  points = curve.points ();
+  Points::const_iterator itr;
+  for (itr = points.begin (); itr != points.end (); itr++) {
+    curve.movePoint (itr->identifier (CURVE_NAME), QPointF (-2.0 * itr->posScreen ().x (), 0));
+  }
+  QVERIFY (checkCurveOrdinals (curve));
 }
 
 void TestTransformation::testPolarLinear ()
@@ -263,6 +359,7 @@ void TestTransformation::testPolarLinear ()
   QVERIFY ((differenceMagnitude (g0, m_g0Transformed) < EPSILON));
   QVERIFY ((differenceMagnitude (g1, m_g1Transformed) < EPSILON));
   QVERIFY ((differenceMagnitude (g2, m_g2Transformed) < EPSILON));
+  QVERIFY ((m_batchDifference < EPSILON));
 }
 
 void TestTransformation::testPolarLogOffset1 ()
@@ -293,6 +390,7 @@ void TestTransformation::testPolarLogOffset1 ()
   QVERIFY ((differenceMagnitude (g0, m_g0Transformed) < EPSILON));
   QVERIFY ((differenceMagnitude (g1, m_g1Transformed) < EPSILON));
   QVERIFY ((differenceMagnitude (g2, m_g2Transformed) < EPSILON));
+  QVERIFY ((m_batchDifference < EPSILON));
 }
 
 void TestTransformation::testPolarLogOffset10 ()
@@ -323,4 +421,5 @@ void TestTransformation::testPolarLogOffset10 ()
   QVERIFY ((differenceMagnitude (g0, m_g0Transformed) < EPSILON));
   QVERIFY ((differenceMagnitude (g1, m_g1Transformed) < EPSILON));
   QVERIFY ((differenceMagnitude (g2, m_g2Transformed) < EPSILON));
+  QVERIFY ((m_batchDifference < EPSILON));
 }
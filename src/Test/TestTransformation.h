@@ -6,6 +6,8 @@
 #include <QObject>
 #include <QPointF>
 
+class Curve;
+
 /// Unit test of transformation class. Checking mostly involves verifying forward/reverse are inverses of each other
 class TestTransformation : public QObject
 {
@@ -22,11 +24,13 @@ private slots:
   void testCartesianLinearLog ();
   void testCartesianLogLinear ();
   void testCartesianLogLog ();
+  void testCurveOrdinalsEqualX ();
   void testPolarLinear ();
   void testPolarLogOffset1 ();
   void testPolarLogOffset10 ();
 
 private:
+  bool checkCurveOrdinals (Curve &curve) const;
   DocumentModelCoords modelCoordsDefault() const;
   DocumentModelGeneral modelGeneralDefault() const;
 
@@ -41,6 +45,7 @@ private:
                            const DocumentModelCoords &modelCoords,
                            const DocumentModelGeneral &modelGeneral);
 
+  double m_batchDifference; // Largest difference between batched and single point screen to graph transformations
   QPointF m_g0Transformed;
   QPointF m_g1Transformed;
   QPointF m_g2Transformed;
@@ -336,27 +336,39 @@ bool Transformation::transformIsDefined() const
 
 void Transformation::transformLinearCartesianGraphToRawGraph (const QPointF &pointLinearCartesianGraph,
                                                               QPointF &pointRawGraph) const
+{
+  double x = pointLinearCartesianGraph.x();
+  double y = pointLinearCartesianGraph.y();
+
+  transformLinearCartesianGraphToRawGraph (x,
+                                           y);
+
+  pointRawGraph = QPointF (x, y);
+}
+
+void Transformation::transformLinearCartesianGraphToRawGraph (double &x,
+                                                              double &y) const
 {
   // WARNING - the code in this method must mirror the code in transformRawGraphToLinearCartesianGraph. In
   //           other words, making a change here without a corresponding change there will produce a bug
 
-  pointRawGraph = pointLinearCartesianGraph;
-
   // Apply polar coordinates if appropriate
   if (m_modelCoords.coordsType() == COORDS_TYPE_POLAR) {
-    pointRawGraph = cartesianOrPolarFromCartesian (m_modelCoords,
-                                                   pointRawGraph);
+    QPointF pointPolar = cartesianOrPolarFromCartesian (m_modelCoords,
+                                                        QPointF (x, y));
+    x = pointPolar.x();
+    y = pointPolar.y();
   }
 
   // Apply linear offset to radius if appropriate
   if ((m_modelCoords.coordsType() == COORDS_TYPE_POLAR) &&
       (m_modelCoords.coordScaleYRadius() == COORD_SCALE_LINEAR)) {
-    pointRawGraph.setY (pointRawGraph.y() + m_modelCoords.originRadius());
+    y += m_modelCoords.originRadius();
   }
 
   // Apply log scaling if appropriate
   if (m_modelCoords.coordScaleXTheta() == COORD_SCALE_LOG) {
-    pointRawGraph.setX (qExp (pointRawGraph.x()));
+    x = qExp (x);
   }
 
   if (m_modelCoords.coordScaleYRadius() == COORD_SCALE_LOG) {
@@ -369,7 +381,7 @@ void Transformation::transformLinearCartesianGraphToRawGraph (const QPointF &poi
       offset = m_modelCoords.originRadius();
     }
 
-    pointRawGraph.setY (qExp (pointRawGraph.y() + qLn (offset)));
+    y = qExp (y + qLn (offset));
   }
 }
 
@@ -457,8 +469,33 @@ void Transformation::transformScreenToRawGraph (const QPointF &coordScreen,
                                            coordGraph);
 }
 
+void Transformation::transformScreenToRawGraph (QVector<double> &x,
+                                                QVector<double> &y) const
+{
+  ENGAUGE_ASSERT (m_transformIsDefined);
+  ENGAUGE_ASSERT (x.count () == y.count ());
+
+  // Each point goes through the same steps as the single point version, with the transposed matrix computed once
+  QTransform matrix = m_transform.transposed ();
+  int count = x.count ();
+  for (int i = 0; i < count; i++) {
+
+    double xGraph, yGraph;
+    matrix.map (x.at (i),
+                y.at (i),
+                &xGraph,
+                &yGraph);
+
+    transformLinearCartesianGraphToRawGraph (xGraph,
+                                             yGraph);
+
+    x [i] = xGraph;
+    y [i] = yGraph;
+  }
+}
+
 void Transformation::update (bool fileIsLoaded,
-                             const CmdMediator &cmdMediator,
+                             const Document &document,
                              const MainWindowModel &modelMainWindow)
 {
   if (!fileIsLoaded) {
@@ -467,27 +504,34 @@ void Transformation::update (bool fileIsLoaded,
 
   } else {
 
-    setModelCoords (cmdMediator.document().modelCoords(),
-                    cmdMediator.document().modelGeneral(),
-                    modelMainWindow);
+    update (document,
+            modelMainWindow);
+  }
+}
+
+void Transformation::update (const Document &document,
+                             const MainWindowModel &modelMainWindow)
+{
+  setModelCoords (document.modelCoords(),
+                  document.modelGeneral(),
+                  modelMainWindow);
 
-    CallbackUpdateTransform ftor (m_modelCoords,
-                                  cmdMediator.document().documentAxesPointsRequired());
+  CallbackUpdateTransform ftor (m_modelCoords,
+                                document.documentAxesPointsRequired());
 
-    Functor2wRet<const QString &, const Point&, CallbackSearchReturn> ftorWithCallback = functor_ret (ftor,
-                                                                                                      &CallbackUpdateTransform::callback);
-    cmdMediator.iterateThroughCurvePointsAxes (ftorWithCallback);
+  Functor2wRet<const QString &, const Point&, CallbackSearchReturn> ftorWithCallback = functor_ret (ftor,
+                                                                                                    &CallbackUpdateTransform::callback);
+  document.iterateThroughCurvePointsAxes (ftorWithCallback);
 
-    if (ftor.transformIsDefined ()) {
+  if (ftor.transformIsDefined ()) {
 
-      updateTransformFromMatrices (ftor.matrixScreen(),
-                                   ftor.matrixGraph());
+    updateTransformFromMatrices (ftor.matrixScreen(),
+                                 ftor.matrixGraph());
 
-    } else {
+  } else {
 
-      m_transformIsDefined = false;
+    m_transformIsDefined = false;
 
-    }
   }
 }
 
@@ -7,13 +7,14 @@
 #ifndef TRANSFORMATION_H
 #define TRANSFORMATION_H
 
-#include "CmdMediator.h"
+#include "Document.h"
 #include "DocumentModelCoords.h"
 #include "DocumentModelGeneral.h"
 #include "MainWindowModel.h"
 #include <QPointF>
 #include <QString>
 #include <QTransform>
+#include <QVector>
 
 /// Affine transformation between screen and graph coordinates, based on digitized axis points.
 ///
@@ -33,6 +34,7 @@ class Transformation
   // For unit testing
   friend class TestCentipedeEndpoints;
   friend class TestExport;
+  friend class TestFormats;
   friend class TestSplineDrawer;
   friend class TestTransformation;
 
@@ -133,9 +135,19 @@ public:
   void transformScreenToRawGraph (const QPointF &coordScreen,
                                   QPointF &coordGraph) const;
 
+  /// Same as the single point version, but for a batch of points whose screen coordinates are replaced in place
+  /// by their graph coordinates, so callers with many points need not build a QPointF for each one
+  void transformScreenToRawGraph (QVector<double> &x,
+                                  QVector<double> &y) const;
+
   /// Update transform by iterating through the axis points
   void update (bool fileIsLoaded,
-               const CmdMediator &cmdMediator,
+               const Document &document,
+               const MainWindowModel &modelMainWindow);
+
+  /// Update transform by iterating through the axis points of a loaded Document. This needs no MainWindow,
+  /// so it can be used on Documents loaded outside the gui such as during batch export
+  void update (const Document &document,
                const MainWindowModel &modelMainWindow);
 
 private:
@@ -148,6 +160,11 @@ private:
                        const DocumentModelGeneral &modelGeneral,
                        const MainWindowModel &modelMainWindow);
 
+  // Convert one point from linear cartesian graph coordinates to raw graph coordinates, in place. Both versions of
+  // transformScreenToRawGraph go through this
+  void transformLinearCartesianGraphToRawGraph (double &x,
+                                                double &y) const;
+
   // Compute transform from screen and graph points. The 3x3 matrices are handled as QTransform since QMatrix is deprecated
   void updateTransformFromMatrices (const QTransform &matrixScreen,
                                     const QTransform &matrixGraph);
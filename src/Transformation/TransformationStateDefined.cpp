@@ -80,19 +80,19 @@ void TransformationStateDefined::initializeModelGridRemoval (bool isGnuplot,
 
   // Generate filtered image
   FilterImage filterImage;
-  QPixmap pixmapFiltered = filterImage.filter (isGnuplot,
-                                               cmdMediator.document().pixmap().toImage(),
-                                               transformation,
-                                               selectedGraphCurve,
-                                               cmdMediator.document().modelColorFilter(),
-                                               cmdMediator.document().modelGridRemoval());
+  QImage imageFiltered = filterImage.filter (isGnuplot,
+                                             cmdMediator.document().image(),
+                                             transformation,
+                                             selectedGraphCurve,
+                                             cmdMediator.document().modelColorFilter(),
+                                             cmdMediator.document().modelGridRemoval());
 
   // Initialize grid removal settings so user does not have to
   int countX, countY;
   double startX, startY, stepX, stepY;
   GridClassifier gridClassifier;
   gridClassifier.classify (context().isGnuplot(),
-                           pixmapFiltered,
+                           imageFiltered,
                            transformation,
                            countX,
                            startX,
@@ -9,9 +9,9 @@
 #include "ColorFilterSettings.h"
 #include "EngaugeAssert.h"
 #include "Logger.h"
+#include <QImage>
 #include <qmath.h>
 #include <QPainter>
-#include <QPixmap>
 #include "ViewSegmentFilter.h"
 
 const QColor COLOR_FOR_BRUSH_DISABLED (Qt::gray);
@@ -183,7 +183,7 @@ void ViewSegmentFilter::paintEvent(QPaintEvent * /* event */)
 }
 
 void ViewSegmentFilter::setColorFilterSettings (const ColorFilterSettings &colorFilterSettings,
-                                                const QPixmap &pixmap)
+                                                const QImage &image)
 {
 
   m_colorFilterSettings = colorFilterSettings;
@@ -191,8 +191,7 @@ void ViewSegmentFilter::setColorFilterSettings (const ColorFilterSettings &color
 
   // Compute background color
   ColorFilter filter;
-  QImage img = pixmap.toImage();
-  m_rgbBackground = filter.marginColor(&img);
+  m_rgbBackground = filter.marginColor(&image);
 
   // Force a redraw
   update();
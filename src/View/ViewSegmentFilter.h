@@ -11,7 +11,7 @@
 #include <QColor>
 #include <QLabel>
 
-class QPixmap;
+class QImage;
 
 /// Class that displays the current Segment Filter in a MainWindow toolbar. A gradient is displayed. No border
 /// is drawn so the appearance is consistent with ViewPointStyle which would not work with a border.
@@ -24,9 +24,9 @@ public:
   /// Paint with a horizontal linear gradient.
   virtual void paintEvent(QPaintEvent *event);
 
-  /// Apply the color filter of the currently selected curve. The pixmap is included so the background color can be computed.
+  /// Apply the color filter of the currently selected curve. The image is included so the background color can be computed.
   void setColorFilterSettings (const ColorFilterSettings &colorFilterSettings,
-                               const QPixmap &pixmap);
+                               const QImage &image);
 
   /// Show the style with semi-transparency or full-transparency to indicate if associated Curve is active or not
   void setEnabled (bool enabled);
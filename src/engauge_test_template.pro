@@ -92,6 +92,7 @@ HEADERS  += \
     Cmd/CmdCopy.h \
     Cmd/CmdCut.h \
     Cmd/CmdDelete.h \
+    Cmd/CmdDirty.h \
     Cmd/CmdEditPointAxis.h \
     Cmd/CmdEditPointGraph.h \
     Cmd/CmdFactory.h \
@@ -232,8 +233,10 @@ HEADERS  += \
     Dlg/DlgValidatorNumber.h \
     Document/Document.h \
     Document/DocumentAxesPointsRequired.h \
+    Document/DocumentContainer.h \
     Document/DocumentHash.h \
     Document/DocumentHashGenerator.h \
+    Document/DocumentImageStorage.h \
     Document/DocumentModelAbstractBase.h \
     Document/DocumentModelAxesChecker.h \
     Document/DocumentModelColorFilter.h \
@@ -254,26 +257,33 @@ HEADERS  += \
     util/EnumsToQt.h \
     Export/ExportAlignLinear.h \
     Export/ExportAlignLog.h \
+    Export/ExportColumnsLoader.h \
     Export/ExportDelimiter.h \
     Export/ExportLayoutFunctions.h \
     Export/ExportPointsIntervalUnits.h \
     Export/ExportPointsSelectionFunctions.h \
     Export/ExportPointsSelectionRelations.h \
+    Export/ExportRelationFit.h \
     Export/ExportDelimiter.h \
     Export/ExportFileAbstractBase.h \
     Export/ExportFileExtension.h \
     Export/ExportFileExtensionOverride.h \
     Export/ExportFileFunctions.h \
     Export/ExportFileRelations.h \
+    Export/ExportFunctionFit.h \
     Export/ExportHeader.h \
     Export/ExportImageForRegression.h \
     Export/ExportOrdinalsSmooth.h \
     Export/ExportOrdinalsStraight.h \
     Export/ExportToClipboard.h \
     Export/ExportToFile.h \
+    Export/ExportToFileBatch.h \
+    Export/ExportToFileNumpy.h \
+    Export/ExportValuesColumn.h \
     Export/ExportValuesOrdinal.h \
     Export/ExportValuesXOrY.h \
     Export/ExportXThetaValuesMergedFunctions.h \
+    Export/ExportZipStored.h \
     FileCmd/FileCmdAbstract.h \
     FileCmd/FileCmdClose.h \
     FileCmd/FileCmdExport.h \
@@ -294,9 +304,11 @@ HEADERS  += \
     Format/FormatCoordsUnitsStrategyNonPolarTheta.h \
     Format/FormatCoordsUnitsStrategyPolarTheta.h \
     Format/FormatDateTime.h \
+    Format/FormatDateTimeMatcher.h \
     Format/FormatDegreesMinutesSecondsBase.h \
     Format/FormatDegreesMinutesSecondsNonPolarTheta.h \
     Format/FormatDegreesMinutesSecondsPolarTheta.h \
+    Format/FormatPrecisionPlan.h \
     Callback/functor.h \
     Geometry/GeometryModel.h \
     Geometry/GeometryStrategyAbstractBase.h \
@@ -313,6 +325,7 @@ HEADERS  += \
     util/gnuplot.h \
     Graphics/GraphicsArcItem.h \
     Graphics/GraphicsArcItemRelay.h \
+    Graphics/GraphicsImageTiled.h \
     Graphics/GraphicsItemsExtractor.h \
     Graphics/GraphicsItemType.h \
     Graphics/GraphicsLineItemRelay.h \
@@ -323,6 +336,7 @@ HEADERS  += \
     Graphics/GraphicsPointEllipse.h \
     Graphics/GraphicsPointFactory.h \
     Graphics/GraphicsPointPolygon.h \
+    Graphics/GraphicsPointsBatch.h \
     Graphics/GraphicsScene.h \
     Graphics/GraphicsView.h \
     Grid/GridClassifier.h \
@@ -451,6 +465,8 @@ HEADERS  += \
     Settings/Settings.h \
     Settings/SettingsForGraph.h \
     Spline/Spline.h \
+    Spline/SplineArcLength.h \
+    Spline/SplineArcLengthCache.h \
     Spline/SplineCoeff.h \
     Spline/SplineDrawer.h \
     Spline/SplinePair.h \
@@ -509,23 +525,11 @@ SOURCES += \
     Background/BackgroundStateOriginal.cpp \
     Background/BackgroundStateUnloaded.cpp \
     util/ButtonWhatsThis.cpp \
-    Callback/CallbackAddPointsInCurvesGraphs.cpp \
     Callback/CallbackAxesCheckerFromAxesPoints.cpp \
-    Callback/CallbackAxisPointsAbstract.cpp \
-    Callback/CallbackBoundingRects.cpp \
-    Callback/CallbackCheckAddPointAxis.cpp \
-    Callback/CallbackCheckEditPointAxis.cpp \
     Callback/CallbackDocumentHash.cpp \
     Callback/CallbackDocumentScrub.cpp \
-    Callback/CallbackGatherXThetasAbstractBase.cpp \
-    Callback/CallbackGatherXThetasInCurves.cpp \
-    Callback/CallbackGatherXThetasInGridLines.cpp \
-    Callback/CallbackNextOrdinal.cpp \
-    Callback/CallbackPointOrdinal.cpp \
-    Callback/CallbackRemovePointsInCurvesGraphs.cpp \
     Callback/CallbackScaleBar.cpp \
     Callback/CallbackSceneUpdateAfterCommand.cpp \
-    Callback/CallbackUpdateTransform.cpp \
     Centipede/CentipedeDebugPolar.cpp \
     Centipede/CentipedeEndpointsAbstract.cpp \
     Centipede/CentipedeEndpointsCartesian.cpp \
@@ -544,7 +548,6 @@ SOURCES += \
     Centipede/CentipedeStateContext.cpp \
     Centipede/CentipedeStatePrebuild.cpp \
     Checker/Checker.cpp \
-    Checker/CheckerMode.cpp \
     Checklist/ChecklistGuide.cpp \
     Checklist/ChecklistGuideBrowser.cpp \
     Checklist/ChecklistGuidePage.cpp \
@@ -562,6 +565,7 @@ SOURCES += \
     Cmd/CmdCopy.cpp \
     Cmd/CmdCut.cpp \
     Cmd/CmdDelete.cpp \
+    Cmd/CmdDirty.cpp \
     Cmd/CmdEditPointAxis.cpp \
     Cmd/CmdEditPointGraph.cpp \
     Cmd/CmdFactory.cpp \
@@ -592,34 +596,7 @@ SOURCES += \
     Cmd/CmdSettingsSegments.cpp \
     Cmd/CmdStackShadow.cpp \
     Cmd/CmdUndoForTest.cpp \
-    Color/ColorFilter.cpp \
     Color/ColorFilterHistogram.cpp \
-    Color/ColorFilterMode.cpp \
-    Color/ColorFilterSettings.cpp \
-    Color/ColorFilterSettingsStrategyAbstractBase.cpp \
-    Color/ColorFilterSettingsStrategyForeground.cpp \
-    Color/ColorFilterSettingsStrategyHue.cpp \
-    Color/ColorFilterSettingsStrategyIntensity.cpp \
-    Color/ColorFilterSettingsStrategySaturation.cpp \
-    Color/ColorFilterSettingsStrategyValue.cpp \
-    Color/ColorFilterStrategyAbstractBase.cpp \
-    Color/ColorFilterStrategyForeground.cpp \
-    Color/ColorFilterStrategyHue.cpp \
-    Color/ColorFilterStrategyIntensity.cpp \
-    Color/ColorFilterStrategySaturation.cpp \
-    Color/ColorFilterStrategyValue.cpp \
-    Color/ColorPalette.cpp \
-    util/Compatibility.cpp \
-    Coord/CoordScale.cpp \
-    Coord/CoordsType.cpp \
-    Coord/CoordSymbol.cpp \
-    CoordSystem/CoordSystem.cpp \
-    CoordSystem/CoordSystemContext.cpp \
-    CoordSystem/CoordSystemInterface.cpp \
-    Coord/CoordUnitsDate.cpp \
-    Coord/CoordUnitsNonPolarTheta.cpp \
-    Coord/CoordUnitsPolarTheta.cpp \
-    Coord/CoordUnitsTime.cpp \
     Correlation/Correlation.cpp \
     util/Crc32.cpp \
     Create/CreateActions.cpp \
@@ -640,14 +617,8 @@ SOURCES += \
     Create/CreateTutorial.cpp \
     Create/CreateZoomMaps.cpp \
     Cursor/CursorFactory.cpp \
-    Cursor/CursorSize.cpp \
-    Curve/Curve.cpp \
-    Curve/CurveConnectAs.cpp \
     Curve/CurveNameList.cpp \
     Curve/CurveSettingsInt.cpp \
-    Curve/CurvesGraphs.cpp \
-    Curve/CurveStyle.cpp \
-    Curve/CurveStyles.cpp \
     util/DataKey.cpp \
     DigitizeState/DigitizeState.cpp \
     DigitizeState/DigitizeStateAbstractBase.cpp \
@@ -695,44 +666,12 @@ SOURCES += \
     Dlg/DlgValidatorDegreesMinutesSeconds.cpp \
     Dlg/DlgValidatorFactory.cpp \
     Dlg/DlgValidatorNumber.cpp \
-    Document/Document.cpp \
     Document/DocumentHashGenerator.cpp \
-    Document/DocumentModelAbstractBase.cpp \
-    Document/DocumentModelAxesChecker.cpp \
-    Document/DocumentModelColorFilter.cpp \
-    Document/DocumentModelCoords.cpp \
-    Document/DocumentModelDigitizeCurve.cpp \
-    Document/DocumentModelExportFormat.cpp \
-    Document/DocumentModelGeneral.cpp \
-    Document/DocumentModelGridDisplay.cpp \
-    Document/DocumentModelGridRemoval.cpp \
-    Document/DocumentModelGuideline.cpp \
-    Document/DocumentModelLoadViews.cpp \
-    Document/DocumentModelPointMatch.cpp \
-    Document/DocumentModelSegments.cpp \
     Document/DocumentScrub.cpp \
-    Document/DocumentSerialize.cpp \
     util/EllipseParameters.cpp \
-    util/EnumsToQt.cpp \
-    Export/ExportAlignLinear.cpp \
-    Export/ExportAlignLog.cpp \
-    Export/ExportDelimiter.cpp \
-    Export/ExportFileAbstractBase.cpp \
     Export/ExportFileExtension.cpp \
-    Export/ExportFileExtensionOverride.cpp \
-    Export/ExportFileFunctions.cpp \
-    Export/ExportFileRelations.cpp \
-    Export/ExportHeader.cpp \
     Export/ExportImageForRegression.cpp \
-    Export/ExportLayoutFunctions.cpp \
-    Export/ExportOrdinalsSmooth.cpp \
-    Export/ExportOrdinalsStraight.cpp \
-    Export/ExportPointsIntervalUnits.cpp \
-    Export/ExportPointsSelectionFunctions.cpp \
-    Export/ExportPointsSelectionRelations.cpp \
     Export/ExportToClipboard.cpp \
-    Export/ExportToFile.cpp \
-    Export/ExportXThetaValuesMergedFunctions.cpp \
     FileCmd/FileCmdAbstract.cpp \
     FileCmd/FileCmdClose.cpp \
     FileCmd/FileCmdExport.cpp \
@@ -741,19 +680,10 @@ SOURCES += \
     FileCmd/FileCmdOpen.cpp \
     FileCmd/FileCmdSerialize.cpp \
     FileCmd/FileCmdScript.cpp \
-    Filter/FilterImage.cpp \
     Fitting/FittingCurve.cpp \    
     Fitting/FittingModel.cpp \
     Fitting/FittingStatistics.cpp \
     Fitting/FittingWindow.cpp \    
-    Format/FormatCoordsUnits.cpp \
-    Format/FormatCoordsUnitsStrategyAbstractBase.cpp \
-    Format/FormatCoordsUnitsStrategyNonPolarTheta.cpp \
-    Format/FormatCoordsUnitsStrategyPolarTheta.cpp \
-    Format/FormatDateTime.cpp \
-    Format/FormatDegreesMinutesSecondsBase.cpp \
-    Format/FormatDegreesMinutesSecondsNonPolarTheta.cpp \
-    Format/FormatDegreesMinutesSecondsPolarTheta.cpp \
     Geometry/GeometryModel.cpp \
     Geometry/GeometryStrategyAbstractBase.cpp \
     Geometry/GeometryStrategyContext.cpp \
@@ -766,9 +696,9 @@ SOURCES += \
     Ghosts/GhostPath.cpp \
     Ghosts/GhostPolygon.cpp \
     Ghosts/Ghosts.cpp \
-    util/gnuplot.cpp \
     Graphics/GraphicsArcItem.cpp \
     Graphics/GraphicsArcItemRelay.cpp \
+    Graphics/GraphicsImageTiled.cpp \
     Graphics/GraphicsItemsExtractor.cpp \
     Graphics/GraphicsLineItemRelay.cpp \
     Graphics/GraphicsLinesForCurve.cpp \
@@ -778,22 +708,14 @@ SOURCES += \
     Graphics/GraphicsPointEllipse.cpp \
     Graphics/GraphicsPointFactory.cpp \
     Graphics/GraphicsPointPolygon.cpp \
+    Graphics/GraphicsPointsBatch.cpp \
     Graphics/GraphicsScene.cpp \
     Graphics/GraphicsView.cpp \
     Grid/GridClassifier.cpp \
-    Grid/GridCoordDisable.cpp \
-    Grid/GridHealerAbstractBase.cpp \
-    Grid/GridHealerHorizontal.cpp \
-    Grid/GridHealerVertical.cpp \
-    Grid/GridInitializer.cpp \
     Grid/GridLine.cpp \
     Grid/GridLineFactory.cpp \
-    Grid/GridLineLimiter.cpp \
     Grid/GridLineNormalize.cpp \
     Grid/GridLines.cpp \
-    Grid/GridLog.cpp \
-    Grid/GridRemoval.cpp \
-    Grid/GridTriangleFill.cpp \
     Guideline/GuidelineAbstract.cpp \
     Guideline/GuidelineDragCommandFactory.cpp \
     Guideline/GuidelineEllipse.cpp \
@@ -855,56 +777,30 @@ SOURCES += \
     Guideline/GuidelineStateHandleY.cpp \
     Help/HelpBrowser.cpp \
     Help/HelpWindow.cpp \
-    Import/ImportCroppingUtilBase.cpp \
     Import/ImportCroppingUtilNonPdf.cpp \
     Import/ImportImageExtensions.cpp \
-    util/InactiveOpacity.cpp \
-    util/LinearToLog.cpp \
-    Line/LineStyle.cpp \
     Load/LoadFileInfo.cpp \
     Load/LoadImageFromUrl.cpp \
-    Load/LoadViews.cpp \
-    Logger/Logger.cpp \
-    Logger/LoggerUpload.cpp \
     main/MainDirectoryPersist.cpp \
     main/MainWindow.cpp \
-    main/MainWindowModel.cpp \
     main/MainWindowMsg.cpp \
     Matrix/Matrix.cpp \
-    util/MigrateToVersion6.cpp \
     Mime/MimePointsDetector.cpp \
     Mime/MimePointsExport.cpp \
     Mime/MimePointsImport.cpp \    
-    util/mmsubs.cpp \
     Network/NetworkClient.cpp \
     NonPdf/NonPdf.cpp \
     NonPdf/NonPdfCropping.cpp \
     NonPdf/NonPdfFrameHandle.cpp \
-    Ordinal/OrdinalGenerator.cpp \
-    Pdf/PdfResolution.cpp \
-    util/Pixels.cpp \
-    Point/Point.cpp \
     Point/PointIdentifiers.cpp \
-    Point/PointMatchAlgorithm.cpp \
-    Point/PointMatchPixel.cpp \
-    Point/PointMatchTriplet.cpp \
-    Point/PointShape.cpp \
-    Point/PointStyle.cpp \
-    util/QtToString.cpp \
     ScaleBar/ScaleBarAxisPointsUnite.cpp \    
     Segment/Segment.cpp \
     Segment/SegmentFactory.cpp \
     Segment/SegmentLine.cpp \
-    Settings/Settings.cpp \
-    Settings/SettingsForGraph.cpp \
-    Spline/Spline.cpp \
-    Spline/SplineCoeff.cpp \
     Spline/SplineDrawer.cpp \
-    Spline/SplinePair.cpp \
     StatusBar/StatusBar.cpp \
     StatusBar/StatusBarMode.cpp \
     Test/TEST.cpp \
-    Transformation/Transformation.cpp \
     Transformation/TransformationStateAbstractBase.cpp \
     Transformation/TransformationStateContext.cpp \
     Transformation/TransformationStateDefined.cpp \
@@ -926,8 +822,6 @@ SOURCES += \
     Tutorial/TutorialStateIntroduction.cpp \
     Tutorial/TutorialStatePointMatch.cpp \
     Tutorial/TutorialStateSegmentFill.cpp \
-    util/UrlDirty.cpp \
-    util/Version.cpp \
     View/ViewPointStyle.cpp \
     View/ViewPreview.cpp \
     View/ViewProfile.cpp \
@@ -938,7 +832,6 @@ SOURCES += \
     Window/WindowAbstractBase.cpp \    
     Window/WindowModelBase.cpp \
     Window/WindowTable.cpp \    
-    util/Xml.cpp \
     Zoom/ZoomLabels.cpp \
     Zoom/ZoomTransition.cpp \
     util/ZValues.cpp
@@ -953,6 +846,15 @@ win32-g++* {
 CONFIG += windows
 }
 
+# Document, Transformation, export and the other classes without widgets come from the engauge_core static library,
+# which build_and_run_all_cli_tests builds from engauge_core.pro before the tests
+LIBS += -L../lib -lengauge_core
+win32-msvc* {
+PRE_TARGETDEPS += ../lib/engauge_core.lib
+} else {
+PRE_TARGETDEPS += ../lib/libengauge_core.a
+}
+
 LIBS += -llog4cpp -lfftw3
 INCLUDEPATH += Background \
                Callback \
@@ -42,6 +42,7 @@
 #include "DlgSettingsMainWindow.h"
 #include "DlgSettingsPointMatch.h"
 #include "DlgSettingsSegments.h"
+#include "DocumentContainer.h"
 #include "DocumentModelCoords.h"
 #include "DocumentModelGuideline.h"
 #include "DocumentScrub.h"
@@ -51,6 +52,8 @@
 #include "ExportFileExtensionOverride.h"
 #include "ExportImageForRegression.h"
 #include "ExportToFile.h"
+#include "ExportToFileBatch.h"
+#include "ExportToFileNumpy.h"
 #include "FileCmdScript.h"
 #include "FittingCurve.h"
 #include "FittingWindow.h"
@@ -96,6 +99,7 @@
 #include <QDesktopServices>
 #include <QDockWidget>
 #include <QDomDocument>
+#include <QEventLoop>
 #include <QFileDialog>
 #include <QFileInfo>
 #include <QImageReader>
@@ -108,12 +112,14 @@
 #include <QPrinter>
 #include <QProcess>
 #include <QPushButton>
+#include <QSaveFile>
 #include <QSettings>
 #include <QSignalMapper>
 #include <QTextStream>
 #if !defined(OSX_DEBUG) && !defined(OSX_RELEASE)
 #include <QtHelp>
 #endif
+#include <QThreadPool>
 #include <QTimer>
 #include <QToolBar>
 #include <QToolButton>
@@ -152,6 +158,8 @@ MainWindow::MainWindow(const QString &errorReportFile,
                        const QString &extractImageOnlyExtension,
                        const QStringList &loadStartupFiles,
                        const QStringList &commandLineWithoutLoadStartupFiles,
+                       const QString &exportOnlyExtension,
+                       int exportThreadCount,
                        QWidget *parent) :
   QMainWindow(parent),
   m_originalFileWasImported (false),
@@ -178,9 +186,12 @@ MainWindow::MainWindow(const QString &errorReportFile,
   m_guidelines (*this),  
   m_fittingCurve (nullptr),
   m_isExportOnly (isExportOnly),
+  m_exportOnlyExtension (exportOnlyExtension),
   m_isExtractImageOnly (isExtractImageOnly),
   m_extractImageOnlyExtension (extractImageOnlyExtension),
-  m_timerChecklistGuideWizard (nullptr)
+  m_timerChecklistGuideWizard (nullptr),
+  m_timerUpdateAfterCommand (nullptr),
+  m_cmdDirtyThrottled (QStringList ())
 {
 
 #if defined(OSX_DEBUG) || defined(OSX_RELEASE)
@@ -188,7 +199,15 @@ MainWindow::MainWindow(const QString &errorReportFile,
   qApp->setOrganizationDomain ("Mark Mitchell");
 #endif
  
-  LoggerUpload::bindToMainWindow(this);
+  LoggerUpload::bindToErrorReport ([this] (const char *comment,
+                                           const char *file,
+                                           int line,
+                                           const char *context) {
+    saveErrorReportFileAndExit (comment,
+                                file,
+                                line,
+                                context);
+  });
 
   m_startupDirectory = QDir::currentPath();
 
@@ -210,11 +229,19 @@ MainWindow::MainWindow(const QString &errorReportFile,
   QString originalPath = QDir::currentPath();
   QDir::setCurrent (m_startupDirectory);
   if (isExportOnly) {
-    m_loadStartupFiles = loadStartupFiles;
-    m_regressionFile = exportRegressionFilenameFromInputFilename (loadStartupFiles.first ()); // For regression test
-    slotLoadStartupFiles ();
-    slotFileExport (); // Export one file. QProcess::startDetached will be called for each remaining file
-    exit (0);
+
+    // All files are exported by this process, using a thread pool, so startup is not repeated for every file
+    QStringList exportFiles;
+    QStringList::const_iterator itr;
+    for (itr = loadStartupFiles.begin(); itr != loadStartupFiles.end(); itr++) {
+      exportFiles << fileNameForExportOnly (*itr);
+    }
+
+    ExportToFileBatch exportBatch (m_modelMainWindow,
+                                   exportThreadCount);
+    int failureCount = exportBatch.exportFiles (loadStartupFiles,
+                                                exportFiles);
+    exit (failureCount > 0 ? 1 : 0);
   } else if (isExtractImageOnly) {
     m_loadStartupFiles = loadStartupFiles;
     m_regressionFile = exportRegressionFilenameFromInputFilename (loadStartupFiles.first ()); // For regression test
@@ -423,7 +450,7 @@ void MainWindow::exportAllCoordinateSystemsAfterRegressionTests()
     // get an export file when regression testing, we just output the image size
     if (m_isErrorReportRegressionTest && !m_transformation.transformIsDefined()) {
 
-      ExportImageForRegression exportStrategy (m_cmdMediator->pixmap ());
+      ExportImageForRegression exportStrategy (m_cmdMediator->document().image ());
       exportStrategy.fileExport (regressionFile);
 
     } else {
@@ -462,19 +489,38 @@ void MainWindow::fileExport(const QString &fileName,
 {
 
   QFile file (fileName);
-  if (file.open(QIODevice::WriteOnly)) {
+  bool success = file.open(QIODevice::WriteOnly);
+  if (success) {
 
-    QTextStream str (&file);
+    ExportToFileNumpy exportNumpy;
+    if (exportNumpy.isNumpyFileName (fileName)) {
 
-    ExportFileExtensionOverride extensionOverride;
-    DocumentModelExportFormat modelExportFormat = extensionOverride.modelExportOverride (m_cmdMediator->document().modelExport(),
-                                                                                         exportStrategy,
-                                                                                         fileName);
-    exportStrategy.exportToFile (modelExportFormat,
-                                 m_cmdMediator->document(),
-                                 m_modelMainWindow,
-                                 transformation (),
-                                 str);
+      // Binary formats have no delimiter so there is nothing to override
+      success = exportNumpy.exportToFile (m_cmdMediator->document().modelExport(),
+                                          m_cmdMediator->document(),
+                                          m_modelMainWindow,
+                                          transformation (),
+                                          fileName,
+                                          file) &&
+                file.flush ();
+
+    } else {
+
+      QTextStream str (&file);
+
+      ExportFileExtensionOverride extensionOverride;
+      DocumentModelExportFormat modelExportFormat = extensionOverride.modelExportOverride (m_cmdMediator->document().modelExport(),
+                                                                                           exportStrategy,
+                                                                                           fileName);
+      success = exportStrategy.exportToFile (modelExportFormat,
+                                             m_cmdMediator->document(),
+                                             m_modelMainWindow,
+                                             transformation (),
+                                             str);
+    }
+  }
+
+  if (success) {
 
     m_isDocumentExported = true; // Remember that export was performed
 
@@ -495,8 +541,8 @@ void MainWindow::fileExtractImage (const QString &fileName)
   bool success = true;  
   if (file.open(QIODevice::WriteOnly)) {
 
-    QPixmap pixmap = m_cmdMediator->pixmap();
-    pixmap.save (&file);
+    QImage image = m_cmdMediator->document().image();
+    image.save (&file);
 
     // Generate a checksum file if performing a regression test
     if (m_isErrorReportRegressionTest) {
@@ -697,7 +743,7 @@ void MainWindow::fileImportWithPrompts (ImportType importType)
   }
 }
 
-QString MainWindow::fileNameForExportOnly () const
+QString MainWindow::fileNameForExportOnly (const QString &inputFileName) const
 {
   ExportToFile exportStrategy;      
 
@@ -706,16 +752,17 @@ QString MainWindow::fileNameForExportOnly () const
 
     // Regression test has a specific file extension
     fileName = QString ("%1_1")
-      .arg (exportRegressionFilenameFromInputFilename (m_regressionFile));
+      .arg (exportRegressionFilenameFromInputFilename (inputFileName));
 
   } else {
 
-    // User requested export-only mode so just change file extension
-    QString dir = QFileInfo (m_currentFileWithPathAndFileExtension).absolutePath();
+    // User requested export-only mode so just change file extension. We use completeBaseName rather than baseName so
+    // files with multiple periods are handled correctly - all but last suffix gets kept. The extension selects the format
+    QFileInfo fileInfo (inputFileName);
     fileName = QString ("%1/%2.%3")
-      .arg (dir)
-      .arg (m_currentFile)
-      .arg (exportStrategy.fileExtensionCsv ());
+      .arg (fileInfo.absolutePath())
+      .arg (fileInfo.completeBaseName())
+      .arg (m_exportOnlyExtension.isEmpty () ? exportStrategy.fileExtensionCsv () : m_exportOnlyExtension);
   }
 
   return fileName;
@@ -802,6 +849,9 @@ void MainWindow::ghostsCreate ()
   ENGAUGE_ASSERT (m_ghosts == nullptr);
   m_ghosts = new Ghosts (m_cmdMediator->document().coordSystemIndex());
 
+  // Ghosts are copied from the graphics items, so no points can be detached from their graphics items
+  m_scene->slotVisibleSceneRectChanged (QRectF ());
+
   for (unsigned int index = 0; index < m_cmdMediator->document().coordSystemCount(); index++) {
 
     // Skip this coordinate system if it is the selected coordinate system since it will be displayed anyway, so no ghosts are required
@@ -819,6 +869,9 @@ void MainWindow::ghostsCreate ()
 
   // Make visible ghosts
   m_ghosts->createGhosts (*m_scene);
+
+  // Points outside of the view can be detached again
+  m_scene->slotVisibleSceneRectChanged (m_view->visibleSceneRect ());
 }
 
 void MainWindow::ghostsDestroy ()
@@ -952,6 +1005,24 @@ void MainWindow::handlerFileExtractImage ()
   }
 }
 
+QImage MainWindow::imageDecodedOffGuiThread () const
+{
+  // Decoding a large scan takes a while, so it is done by the thread pool while this thread keeps repainting. User
+  // input waits until the image is available, since nearly every action needs it
+  QImage image;
+  QEventLoop loop;
+  const Document &document = m_cmdMediator->document ();
+  QThreadPool::globalInstance ()->start ([&document, &image, &loop] () {
+    image = document.image ();
+    QMetaObject::invokeMethod (&loop,
+                               "quit",
+                               Qt::QueuedConnection);
+  });
+  loop.exec (QEventLoop::ExcludeUserInputEvents);
+
+  return image;
+}
+
 QImage MainWindow::imageFiltered () const
 {
   return m_backgroundStateContext->imageForCurveState();
@@ -1201,7 +1272,14 @@ void MainWindow::loadInputFileForErrorReport(QDomDocument &domInputFile) const
     return;
   }
 
-  domInputFile.setContent (&file);
+  // Only the xml member of a DocumentContainer is wanted, since the image is removed from error reports anyway
+  DocumentContainer container;
+  if (container.readLayout (file)) {
+    domInputFile.setContent (container.readXml (file));
+  } else {
+    file.seek (0);
+    domInputFile.setContent (&file);
+  }
   file.close();
 }
 
@@ -1345,7 +1423,20 @@ bool MainWindow::saveDocumentFile (const QString &fileName)
 
   loadViewsSave(); // Save views settings just before saving file
 
-  QFile file(fileName);
+  // A loaded image may still be waiting to be decoded from fileName, so that is done before fileName is touched
+  QString reasonForUnsuccessfulRead;
+  if (!m_cmdMediator->document().decodePendingImage (reasonForUnsuccessfulRead)) {
+    QMessageBox::warning (this,
+                          engaugeWindowTitle(),
+                          QString ("%1 %2: \n%3.")
+                          .arg(tr ("Cannot read image to save in file"))
+                          .arg(fileName)
+                          .arg(reasonForUnsuccessfulRead));
+    return false;
+  }
+
+  // QSaveFile leaves any existing file untouched until the new contents have been completely written
+  QSaveFile file(fileName);
   if (!file.open(QFile::WriteOnly)) {
     QMessageBox::warning (this,
                           engaugeWindowTitle(),
@@ -1359,14 +1450,26 @@ bool MainWindow::saveDocumentFile (const QString &fileName)
   rebuildRecentFileListForCurrentFile (fileName);
 
   QApplication::setOverrideCursor (Qt::WaitCursor);
-  QXmlStreamWriter writer(&file);
-  writer.setAutoFormatting(true);
-  writer.writeStartDocument();
-  writer.writeDTD("<!DOCTYPE engauge>");
-  m_cmdMediator->document().saveXml(writer);
-  writer.writeEndDocument();
+  DocumentContainer container;
+  bool success = container.write (file,
+                                  m_cmdMediator->document());
+  if (success) {
+    success = file.commit ();
+  } else {
+    file.cancelWriting ();
+  }
   QApplication::restoreOverrideCursor ();
 
+  if (!success) {
+    QMessageBox::warning (this,
+                          engaugeWindowTitle(),
+                          QString ("%1 %2: \n%3.")
+                          .arg(tr ("Cannot write file"))
+                          .arg(fileName)
+                          .arg(file.errorString()));
+    return false;
+  }
+
   // Notify the undo stack that the current state is now considered "clean". This will automatically trigger a
   // signal back to this class that will update the modified marker in the title bar
   m_cmdMediator->setClean ();
@@ -1596,17 +1699,8 @@ void MainWindow::setCurrentPathFromFile (const QString &fileName)
   }
 }
 
-void MainWindow::setNonFillZoomFactor (ZoomFactor newZoomFactor)
-{
-  ENGAUGE_ASSERT (newZoomFactor != ZOOM_FILL);
-
-  // Update controls and apply zoom factor
-  m_zoomMapToAction [newZoomFactor]->setChecked (true);
-  slotViewZoomFactor (newZoomFactor);
-}
-
-void MainWindow::setPixmap (const QString &curveSelected,
-                            const QPixmap &pixmap)
+void MainWindow::setImage (const QString &curveSelected,
+                           const QImage &image)
 {
 
   m_digitizeStateContext->setImageIsLoaded (m_cmdMediator,
@@ -1614,16 +1708,25 @@ void MainWindow::setPixmap (const QString &curveSelected,
 
   // We cannot reliably use m_cmbCurve->currentText below for the selected curve since that control
   // can be pointing to a curve that no longer exists so this method requires curveSelected as an argument
-  m_backgroundStateContext->setPixmap (m_isGnuplot,
-                                       m_transformation,
-                                       m_cmdMediator->document().modelGridRemoval(),
-                                       m_cmdMediator->document().modelColorFilter(),
-                                       pixmap,
-                                       curveSelected);
+  m_backgroundStateContext->setImage (m_isGnuplot,
+                                      m_transformation,
+                                      m_cmdMediator->document().modelGridRemoval(),
+                                      m_cmdMediator->document().modelColorFilter(),
+                                      image,
+                                      curveSelected);
 
   m_guidelines.initialize (*m_scene);
 }
 
+void MainWindow::setNonFillZoomFactor (ZoomFactor newZoomFactor)
+{
+  ENGAUGE_ASSERT (newZoomFactor != ZOOM_FILL);
+
+  // Update controls and apply zoom factor
+  m_zoomMapToAction [newZoomFactor]->setChecked (true);
+  slotViewZoomFactor (newZoomFactor);
+}
+
 void MainWindow::settingsRead (bool isReset)
 {
   QSettings settings (SETTINGS_ENGAUGE, SETTINGS_DIGITIZER);
@@ -1771,6 +1874,8 @@ void MainWindow::settingsReadMainWindow (QSettings &settings)
                                                                     QVariant (DEFAULT_IMAGE_REPLACE_RENAMES_DOCUMENT)).toBool ());
   m_modelMainWindow.setMaximumExportedPointsPerCurve (settings.value (SETTINGS_MAXIMUM_EXPORTED_POINTS_PER_CURVE,
                                                                       QVariant (DEFAULT_MAXIMUM_EXPORTED_POINTS_PER_CURVE)).toInt ());
+  m_modelMainWindow.setTileCacheMegabytes (settings.value (SETTINGS_TILE_CACHE_MEGABYTES,
+                                                           QVariant (DEFAULT_TILE_CACHE_MEGABYTES)).toInt ());
 
   // MainDirectoryPersist starts with directories from last execution
   MainDirectoryPersist directoryPersist;
@@ -1848,6 +1953,7 @@ void MainWindow::settingsWrite ()
   settings.setValue (SETTINGS_MAXIMUM_EXPORTED_POINTS_PER_CURVE, m_modelMainWindow.maximumExportedPointsPerCurve());
   settings.setValue (SETTINGS_MAXIMUM_GRID_LINES, m_modelMainWindow.maximumGridLines());
   settings.setValue (SETTINGS_SMALL_DIALOGS, m_modelMainWindow.smallDialogs());
+  settings.setValue (SETTINGS_TILE_CACHE_MEGABYTES, m_modelMainWindow.tileCacheMegabytes());
   settings.setValue (SETTINGS_VIEW_BACKGROUND_TOOLBAR, m_actionViewBackgroundToolBar->isChecked());
   settings.setValue (SETTINGS_VIEW_DIGITIZE_TOOLBAR, m_actionViewDigitizeToolBar->isChecked ());
   settings.setValue (SETTINGS_VIEW_STATUS_BAR, m_statusBar->statusBarMode ());
@@ -1872,14 +1978,15 @@ bool MainWindow::setupAfterLoadNewDocument (const QString &fileName,
 
   // At this point the code assumes CmdMediator for the NEW Document is already stored in m_cmdMediator
 
-  m_digitizeStateContext->resetOnLoad (m_cmdMediator); // Before setPixmap
+  m_digitizeStateContext->resetOnLoad (m_cmdMediator); // Before setImage
   m_backgroundStateContext->setCurveSelected (m_isGnuplot,
                                               m_transformation,
                                               m_cmdMediator->document().modelGridRemoval(),
                                               m_cmdMediator->document().modelColorFilter(),
-                                              EMPTY_CURVE_NAME_TO_SKIP_BACKGROUND_PROCESSING); // Before setPixmap
-  setPixmap (m_cmdMediator->document().curvesGraphsNames().first(),
-             m_cmdMediator->pixmap ()); // Set background immediately so it is visible as a preview when any dialogs are displayed
+                                              EMPTY_CURVE_NAME_TO_SKIP_BACKGROUND_PROCESSING); // Before setImage
+  // Export-only runs never show the background, so an empty image lets Document skip decoding its image entirely
+  setImage (m_cmdMediator->document().curvesGraphsNames().first(),
+            m_isExportOnly ? QImage () : imageDecodedOffGuiThread ()); // Set background immediately so it is visible as a preview when any dialogs are displayed
 
   // Image is visible now so the user can refer to it when we ask for the number of coordinate systems. Note that the Document
   // may already have multiple CoordSystem if user loaded a file that had multiple CoordSystem entries
@@ -1917,10 +2024,10 @@ bool MainWindow::setupAfterLoadNewDocument (const QString &fileName,
 
   m_isDocumentExported = false;
 
-  // Background must be set (by setPixmap) before slotViewZoomFactor which relies on the background. At this point
+  // Background must be set (by setImage) before slotViewZoomFactor which relies on the background. At this point
   // the transformation is undefined (unless the code is changed) so grid removal will not work
   // but updateTransformationAndItsDependencies will call this again to fix that issue. Note that the selected
-  // curve name was set (by setCurveSelected) earlier before the call to setPixmap
+  // curve name was set (by setCurveSelected) earlier before the call to setImage
   m_backgroundStateContext->setCurveSelected (m_isGnuplot,
                                               m_transformation,
                                               m_cmdMediator->document().modelGridRemoval(),
@@ -1954,8 +2061,8 @@ bool MainWindow::setupAfterLoadReplacingImage (const QString &fileName,
   // After this point there should be no commands in CmdMediator, since we effectively have a new document
   m_cmdMediator->clear();
 
-  setPixmap (m_cmdMediator->document().curvesGraphsNames().first(),
-             m_cmdMediator->pixmap ()); // Set background immediately so it is visible as a preview when any dialogs are displayed
+  setImage (m_cmdMediator->document().curvesGraphsNames().first(),
+            m_cmdMediator->document().image ()); // Set background immediately so it is visible as a preview when any dialogs are displayed
 
   m_isDocumentExported = false;
 
@@ -2404,15 +2511,18 @@ void MainWindow::slotFileExport ()
 
     MainDirectoryPersist directoryPersist;
     ExportToFile exportStrategy;
+    ExportToFileNumpy exportNumpy;
 
     QString fileName;
     if (m_isExportOnly) {
-      fileName = fileNameForExportOnly ();
+      fileName = fileNameForExportOnly (m_currentFileWithPathAndFileExtension);
     } else {
 
-      QString filter = QString ("%1;;%2;;All files (*.*)")
+      QString filter = QString ("%1;;%2;;%3;;%4;;All files (*.*)")
                        .arg (exportStrategy.filterCsv ())
-                       .arg (exportStrategy.filterTsv ());
+                       .arg (exportStrategy.filterTsv ())
+                       .arg (exportNumpy.filterNpy ())
+                       .arg (exportNumpy.filterNpz ());
 
       // OSX sandbox requires, for the default, a non-empty filename
       QString defaultFileName = QString ("%1/%2.%3")
@@ -2989,6 +3099,17 @@ void MainWindow::slotTimeoutRegressionFileCmdScript ()
   }
 }
 
+void MainWindow::slotTimeoutUpdateAfterCommand ()
+{
+  CmdDirty cmdDirty = m_cmdDirtyThrottled;
+  m_cmdDirtyThrottled = CmdDirty (QStringList ());
+
+  // Document may have been closed while the timer was running
+  if (m_cmdMediator != nullptr) {
+    updateAfterCommand (cmdDirty);
+  }
+}
+
 void MainWindow::slotUndoTextChanged (const QString &text)
 {
   QString completeText ("Undo");
@@ -3310,38 +3431,76 @@ bool MainWindow::transformIsDefined() const
   return m_transformation.transformIsDefined();
 }
 
-void MainWindow::updateAfterCommand ()
+void MainWindow::updateAfterCommand (const CmdDirty &cmdDirty)
 {
 
   ENGAUGE_CHECK_PTR (m_cmdMediator);
 
   // Update transformation stuff, including the graph coordinates of every point in the Document, so coordinates in
-  // status bar are up to date. Point coordinates in Document are also updated
-  updateAfterCommandStatusBarCoords ();
+  // status bar are up to date. Point coordinates in Document are also updated. Graph points have no effect on the
+  // transformation, so this is skipped when only graph points changed
+  if (cmdDirty.isAxes ()) {
+    updateAfterCommandStatusBarCoords ();
+  }
 
-  updateHighlightOpacity ();
+  if (cmdDirty.isAnything ()) {
+    updateHighlightOpacity (cmdDirty);
+  }
 
   // Update graphics. Effectively, these steps do very little (just needed for highlight opacity)
   m_digitizeStateContext->updateAfterPointAddition (); // May or may not be needed due to point addition
 
-  updateControls ();
-  updateChecklistGuide ();
-  updateFittingWindow ();
-  updateGeometryWindow();
+  updateControls (); // Undo/redo availability changes even when the Document does not
+
+  if (cmdDirty.isAnything ()) {
+    updateChecklistGuide ();
+  }
 
-  // Final actions at the end of a redo/undo are:
-  // 1) checkpoint the Document and GraphicsScene to log files so proper state can be verified
-  // 2) run sanity check on state
-  writeCheckpointToLogFile ();
-  DocumentScrub docScrub;
-  docScrub.check (*this,
-                  m_cmdMediator->document ());
+  // Fitting and geometry windows only show the selected curve, whose graph coordinates also depend on the axes
+  if (cmdDirty.isAxes () ||
+      (m_cmbCurve != nullptr && cmdDirty.isCurve (selectedGraphCurve ()))) {
+    updateFittingWindow ();
+    updateGeometryWindow();
+  }
+
+  // Final action at the end of a redo/undo is a sanity check on state
+  if (cmdDirty.isAnything ()) {
+    DocumentScrub docScrub;
+    docScrub.check (*this,
+                    m_cmdMediator->document (),
+                    cmdDirty);
+  }
 
   // Since focus may have drifted over to Geometry Window or some other control we se focus on the GraphicsView
   // so the cursor is appropriate for the current state (otherwise it often ends up as default arrow)
   m_view->setFocus ();
 }
 
+void MainWindow::updateAfterCommandThrottled (const CmdDirty &cmdDirty)
+{
+  const int DISPLAY_FRAME_MS = 16;
+
+  if (m_isErrorReportRegressionTest || m_fileCmdScript != nullptr) {
+
+    updateAfterCommand (cmdDirty);
+
+  } else {
+
+    m_cmdDirtyThrottled.merge (cmdDirty);
+
+    if (m_timerUpdateAfterCommand == nullptr) {
+      m_timerUpdateAfterCommand = new QTimer (this);
+      m_timerUpdateAfterCommand->setSingleShot (true);
+      connect (m_timerUpdateAfterCommand, SIGNAL (timeout ()), this, SLOT (slotTimeoutUpdateAfterCommand ()));
+    }
+
+    // Calls that arrive while the timer is running just add to the accumulated changes
+    if (!m_timerUpdateAfterCommand->isActive ()) {
+      m_timerUpdateAfterCommand->start (DISPLAY_FRAME_MS);
+    }
+  }
+}
+
 void MainWindow::updateAfterCommandStatusBarCoords ()
 {
 
@@ -3623,7 +3782,7 @@ void MainWindow::updateGuidelines ()
                                     !m_digitizeStateContext->guidelinesAreSelectable());
 }
 
-void MainWindow::updateHighlightOpacity ()
+void MainWindow::updateHighlightOpacity (const CmdDirty &cmdDirty)
 {
   if (m_cmdMediator != nullptr) {
 
@@ -3632,7 +3791,8 @@ void MainWindow::updateHighlightOpacity ()
     m_scene->updateAfterCommand (*m_cmdMediator,
                                  m_modelMainWindow.highlightOpacity(),
                                  m_dockGeometryWindow,
-                                 m_transformation);
+                                 m_transformation,
+                                 cmdDirty);
   }
 }
 
@@ -3780,6 +3940,10 @@ void MainWindow::updateSettingsMainWindow()
     m_scene->updateCurveStyles(m_cmdMediator->document().modelCurveStyles());
   }
 
+  if (m_backgroundStateContext != nullptr) {
+    m_backgroundStateContext->setTileCacheMegabytes (m_modelMainWindow.tileCacheMegabytes());
+  }
+
   updateHighlightOpacity();
   updateWindowTitle();
   updateFittingWindow(); // Forward the drag and drop choice
@@ -3829,7 +3993,7 @@ void MainWindow::updateSmallDialogs ()
 void MainWindow::updateTransformationAndItsDependencies()
 {
   m_transformation.update (!m_currentFile.isEmpty (),
-                           *m_cmdMediator,
+                           m_cmdMediator->document(),
                            m_modelMainWindow);
 
   // Grid removal is affected by new transformation above
@@ -3889,7 +4053,7 @@ void MainWindow::updateViewsOfSettings (const QString &activeCurve)
 
     ColorFilterSettings colorFilterSettings = m_cmdMediator->document().modelColorFilter().colorFilterSettings(activeCurve);
     m_viewSegmentFilter->setColorFilterSettings (colorFilterSettings,
-                                                 m_cmdMediator->pixmap ());
+                                                 m_cmdMediator->document().image ());
 
   }
 }
@@ -3943,19 +4107,3 @@ const GraphicsView &MainWindow::view () const
   ENGAUGE_CHECK_PTR (m_view);
   return *m_view;
 }
-
-void MainWindow::writeCheckpointToLogFile ()
-{
-  // Document
-  QString checkpointDoc;
-  QTextStream strDoc (&checkpointDoc);
-  m_cmdMediator->document().printStream(INDENTATION_PAST_TIMESTAMP,
-                                        strDoc);
-
-  // Scene
-  QString checkpointScene;
-  QTextStream strScene (&checkpointScene);
-  m_scene->printStream (INDENTATION_PAST_TIMESTAMP,
-                        strScene);
-
-}
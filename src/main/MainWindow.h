@@ -8,6 +8,7 @@
 #define MAIN_WINDOW_H
 
 #include "BackgroundImage.h"
+#include "CmdDirty.h"
 #include "CoordSystemIndex.h"
 #include "DigitizeStateAbstractBase.h"
 #include "DocumentAxesPointsRequired.h"
@@ -126,11 +127,14 @@ public:
   /// \param isRegressionTest True if errorReportFile or fileCmdScript is for regression testing, in which case it is executed and the program exits
   /// \param isGnuplot True if diagnostic gnuplot files are generated for math-intense sections of the code. Used for development and debugging
   /// \param isReset True to reset all settings that would otherwise be restored from the previous execution of Engauge
-  /// \param isExportOnly True to export the loaded startup file and then exit
+  /// \param isExportOnly True to export the loaded startup files and then exit
   /// \param isExtractImageOnly True to extract the image from the loaded startup file and then exit
   /// \param extractImageOnlyExtension File extension for extracted image for isExtractImageOnly
-  /// \param loadStartupFiles Zero or more Engauge document files to load at startup. A separate instance of Engauge is created for each file
+  /// \param loadStartupFiles Zero or more Engauge document files to load at startup. A separate instance of Engauge is created for each file,
+  ///        except with isExportOnly where all files are exported by this instance
   /// \param commandLineWithoutLoadStartupFiles Command line arguments without load startup files. Used for spawning additional processes
+  /// \param exportOnlyExtension File extension of the exported files for isExportOnly, which selects the format. Empty for csv
+  /// \param exportThreadCount Number of files exported concurrently for isExportOnly. Zero for one per core
   /// \param parent Optional parent widget for this widget
   MainWindow(const QString &errorReportFile,
              const QString &fileCmdScriptFile,
@@ -143,6 +147,8 @@ public:
              const QString &extractImageOnlyExtension,
              const QStringList &loadStartupFiles,
              const QStringList &commandLineWithoutLoadStartupFiles,
+             const QString &exportOnlyExtension = QString (),
+             int exportThreadCount = 0,
              QWidget *parent = nullptr);
   ~MainWindow();
 
@@ -238,8 +244,13 @@ public:
   /// Return true if all three axis points have been defined.
   bool transformIsDefined() const;
 
-  /// See GraphicsScene::updateAfterCommand
-  void updateAfterCommand();
+  /// See GraphicsScene::updateAfterCommand. Refresh steps that do not depend on anything in cmdDirty are skipped. The
+  /// default CmdDirty refreshes everything
+  void updateAfterCommand(const CmdDirty &cmdDirty = CmdDirty ());
+
+  /// Same as updateAfterCommand, except rapid repeated calls (like from holding down an arrow key) are coalesced into
+  /// one refresh per display frame. Regression tests refresh immediately so their results do not depend on timing
+  void updateAfterCommandThrottled (const CmdDirty &cmdDirty);
 
   /// Call MainWindow::updateControls (which is private) after the very specific case - a mouse press/release.
   void updateAfterMouseRelease();
@@ -378,6 +389,7 @@ private slots:
   void slotTimeoutChecklistGuideWizard ();
   void slotTimeoutRegressionErrorReport ();
   void slotTimeoutRegressionFileCmdScript ();
+  void slotTimeoutUpdateAfterCommand ();
   void slotUndoTextChanged (const QString &);
   void slotViewGridLines ();
   void slotViewGroupBackground(QAction*);
@@ -438,7 +450,7 @@ private:
   void fileImport (const QString &fileName,
                    ImportType ImportType); /// Same steps as filePaste but with import from file
   void fileImportWithPrompts (ImportType ImportType); /// Wrapper around fileImport that adds user prompt(s)
-  QString fileNameForExportOnly () const; /// File name for export-only batch mode
+  QString fileNameForExportOnly (const QString &inputFileName) const; /// File name for export-only batch mode
   QString fileNameForExtractImageOnly () const; /// File name for extract-image-only batch mode
   void filePaste (ImportType importType); /// Same steps as fileImport but with import from clipboard
   void ghostsCreate (); /// Create the ghosts for seeing all coordinate systems at once
@@ -454,6 +466,7 @@ private:
   Guidelines &guidelines (); /// Return guidelines for unit testing
   void handleGuidelineMode();  
   void handlerFileExtractImage (); /// Analog to slotFileExport but for image extract. Maybe converted to slot in future
+  QImage imageDecodedOffGuiThread () const; /// Document image, decoded by the thread pool while the gui processes events
   void loadCoordSystemListFromCmdMediator(); /// Update the combobox that has the CoordSystem list
   void loadCurveListFromCmdMediator(); /// Update the combobox that has the curve names.
   void loadDocumentFile (const QString &fileName);
@@ -484,9 +497,9 @@ private:
   void saveStartingDocumentSnapshot();
   void setCurrentFile(const QString &fileName);
   void setCurrentPathFromFile (const QString &fileName);
+  void setImage (const QString &curveSelected,
+                 const QImage &image);
   void setNonFillZoomFactor (ZoomFactor newZoomFactor);
-  void setPixmap (const QString &curveSelected,
-                  const QPixmap &pixmap);
   void settingsRead (bool isReset);
   void settingsReadEnvironment (QSettings &settings);
   void settingsReadMainWindow (QSettings &settings);
@@ -507,7 +520,7 @@ private:
   void updateGeometryWindow ();
   void updateGridLines();
   void updateGuidelines();
-  void updateHighlightOpacity();
+  void updateHighlightOpacity(const CmdDirty &cmdDirty = CmdDirty ()); // Also updates the scene for the curves in cmdDirty
   void updateRecentFileList();
   void updateSettingsMainWindow();
   void updateSmallDialogs();
@@ -515,7 +528,6 @@ private:
   void updateViewedCurves ();
   void updateViewsOfSettings (); // Private version gets active curve name from DigitizeContext
   void updateWindowTitle ();
-  void writeCheckpointToLogFile();
 
   QString m_originalFile; // Original filename for error report
   bool m_originalFileWasImported; // True/false for imported/opened
@@ -746,6 +758,7 @@ private:
 
   // Export the single dig file that was loaded in the command line, as enforced by parseCmdLine
   bool m_isExportOnly;
+  QString m_exportOnlyExtension; // Empty for csv
 
   // Extract the image from the single dig file that was loaded in the command line, as enforced by parseCmdLine
   bool m_isExtractImageOnly;
@@ -753,6 +766,10 @@ private:
 
   // Timer for delayed execution of ChecklistGuideWizard after call to import handler
   QTimer *m_timerChecklistGuideWizard;
+
+  // Timer and accumulated changes for updateAfterCommandThrottled
+  QTimer *m_timerUpdateAfterCommand;
+  CmdDirty m_cmdDirtyThrottled;
 };
 
 #endif // MAIN_WINDOW_H
@@ -4,9 +4,7 @@
  * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
  ******************************************************************************************************/
 
-#include "CmdMediator.h"
 #include "DocumentSerialize.h"
-#include "GraphicsPoint.h"
 #include "GridLineLimiter.h"
 #include "ImportCroppingUtilBase.h"
 #include "Logger.h"
@@ -23,12 +21,14 @@
 // Prevent comma ambiguity with group separator commas and field delimiting commas
 const QLocale::NumberOption HIDE_GROUP_SEPARATOR = QLocale::OmitGroupSeparator;
 
+const double DEFAULT_HIGHLIGHT_OPACITY = 0.35; // 0=transparent to 1=opaque. Values above 0.5 are very hard to notice
 const bool DEFAULT_DRAG_DROP_EXPORT = false; // False value allows intuitive copy-and-drag to select a rectangular set of table cells
 const int DEFAULT_SIGNIFICANT_DIGITS = 7;
 const bool DEFAULT_SMALL_DIALOGS = false;
 const bool DEFAULT_IMAGE_REPLACE_RENAMES_DOCUMENT = true; // Pre-version 11.3 behavior
 const int DEFAULT_MAXIMUM_EXPORTED_POINTS_PER_CURVE = 5000; // Moved 1/2020 from Export classes
 const LoadViews DEFAULT_LOAD_VIEWS = LOAD_VIEWS_KEEP_CURRENT; // Pre-version 13 behavior
+const int DEFAULT_TILE_CACHE_MEGABYTES = 256; // Enough for a full screen of tiles at several zoom levels
   
 MainWindowModel::MainWindowModel() :
   m_zoomControl (ZOOM_CONTROL_MENU_WHEEL_PLUSMINUS),
@@ -43,7 +43,8 @@ MainWindowModel::MainWindowModel() :
   m_dragDropExport (DEFAULT_DRAG_DROP_EXPORT),
   m_significantDigits (DEFAULT_SIGNIFICANT_DIGITS),
   m_imageReplaceRenamesDocument (DEFAULT_IMAGE_REPLACE_RENAMES_DOCUMENT),
-  m_maximumExportedPointsPerCurve (DEFAULT_MAXIMUM_EXPORTED_POINTS_PER_CURVE)
+  m_maximumExportedPointsPerCurve (DEFAULT_MAXIMUM_EXPORTED_POINTS_PER_CURVE),
+  m_tileCacheMegabytes (DEFAULT_TILE_CACHE_MEGABYTES)
 {
   // Locale member variable m_locale is initialized to default locale when default constructor is called
 }
@@ -62,7 +63,8 @@ MainWindowModel::MainWindowModel(const MainWindowModel &other) :
   m_dragDropExport (other.dragDropExport()),
   m_significantDigits (other.significantDigits()),
   m_imageReplaceRenamesDocument (other.imageReplaceRenamesDocument()),
-  m_maximumExportedPointsPerCurve (other.maximumExportedPointsPerCurve ())
+  m_maximumExportedPointsPerCurve (other.maximumExportedPointsPerCurve ()),
+  m_tileCacheMegabytes (other.tileCacheMegabytes ())
 {
 }
 
@@ -82,6 +84,7 @@ MainWindowModel &MainWindowModel::operator=(const MainWindowModel &other)
   m_significantDigits = other.significantDigits();
   m_imageReplaceRenamesDocument = other.imageReplaceRenamesDocument();
   m_maximumExportedPointsPerCurve = other.maximumExportedPointsPerCurve();
+  m_tileCacheMegabytes = other.tileCacheMegabytes();
   
   return *this;
 }
@@ -167,6 +170,7 @@ void MainWindowModel::printStream(QString indentation,
   str << indentation << "significantDigits=" << m_significantDigits << "\n";
   str << indentation << "imageReplaceRenamesDocument=" << (m_imageReplaceRenamesDocument ? "yes" : "no") << "\n";
   str << indentation << "maximumExportedPointsPerCurve=" << m_maximumExportedPointsPerCurve << "\n";
+  str << indentation << "tileCacheMegabytes=" << m_tileCacheMegabytes << "\n";
 }
 
 void MainWindowModel::saveXml(QXmlStreamWriter & /* writer */) const
@@ -245,6 +249,11 @@ void MainWindowModel::setSmallDialogs(bool smallDialogs)
   m_smallDialogs = smallDialogs;
 }
 
+void MainWindowModel::setTileCacheMegabytes(int tileCacheMegabytes)
+{
+  m_tileCacheMegabytes = tileCacheMegabytes;
+}
+
 void MainWindowModel::setZoomControl (ZoomControl zoomControl)
 {
   m_zoomControl = zoomControl;
@@ -265,6 +274,11 @@ bool MainWindowModel::smallDialogs () const
   return m_smallDialogs;
 }
 
+int MainWindowModel::tileCacheMegabytes () const
+{
+  return m_tileCacheMegabytes;
+}
+
 ZoomControl MainWindowModel::zoomControl () const
 {
   return m_zoomControl;
@@ -19,11 +19,13 @@
 class QTextStream;
 
 extern const bool DEFAULT_DRAG_DROP_EXPORT;
+extern const double DEFAULT_HIGHLIGHT_OPACITY;
 extern const int DEFAULT_SIGNIFICANT_DIGITS;
 extern const bool DEFAULT_SMALL_DIALOGS;
 extern const bool DEFAULT_IMAGE_REPLACE_RENAMES_DOCUMENT;
 extern const int DEFAULT_MAXIMUM_EXPORTED_POINTS_PER_CURVE;
 extern const LoadViews DEFAULT_LOAD_VIEWS;
+extern const int DEFAULT_TILE_CACHE_MEGABYTES;
 
 /// Model for DlgSettingsMainWindow. Unlike the other models (DocumentModel*) this data is not saved and 
 /// loaded within the document, so no xml or working with the Document class is involved. Also, there is
@@ -119,6 +121,9 @@ public:
   /// Set method for small dialogs flag
   void setSmallDialogs (bool smallDialogs);
 
+  /// Set method for maximum size of the background image tile cache, in megabytes
+  void setTileCacheMegabytes (int tileCacheMegabytes);
+
   /// Set method for zoom control
   void setZoomControl (ZoomControl zoomControl);
 
@@ -131,6 +136,9 @@ public:
   /// Get method for small dialogs flag
   bool smallDialogs () const;
 
+  /// Get method for maximum size of the background image tile cache, in megabytes
+  int tileCacheMegabytes () const;
+
   /// Get method for zoom control
   ZoomControl zoomControl () const;
 
@@ -152,7 +160,8 @@ private:
   bool m_dragDropExport;
   int m_significantDigits;
   bool m_imageReplaceRenamesDocument;
-  int m_maximumExportedPointsPerCurve; // Too many points causes unacceptable delays so this is the limit
+  int m_maximumExportedPointsPerCurve; // Too many points causes unacceptable delays so this limits the export interval
+  int m_tileCacheMegabytes;
 };
 
 #endif // MAIN_WINDOW_MODEL_H
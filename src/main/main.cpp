@@ -6,6 +6,9 @@
 
 #include "ColorFilterMode.h"
 #include "Compatibility.h"
+#include "DocumentContainer.h"
+#include "ExportToFile.h"
+#include "ExportToFileNumpy.h"
 #include "FittingCurveCoefficients.h"
 #include "ImportImageExtensions.h"
 #include "Logger.h"
@@ -21,6 +24,7 @@
 #include <QProcessEnvironment>
 #include <QStyleFactory>
 #include "TranslatorContainer.h"
+#include "Xml.h"
 #include "ZoomFactor.h"
 
 using namespace std;
@@ -28,7 +32,9 @@ using namespace std;
 const QString CMD_DEBUG ("debug");
 const QString CMD_DROP_REGRESSION ("dropregression");
 const QString CMD_ERROR_REPORT ("errorreport");
+const QString CMD_EXPORT_EXTENSION ("exportextension");
 const QString CMD_EXPORT_ONLY ("exportonly");
+const QString CMD_EXPORT_THREADS ("exportthreads");
 const QString CMD_EXTRACT_IMAGE_ONLY ("extractimageonly");
 const QString CMD_FILE_CMD_SCRIPT ("filecmdscript");
 const QString CMD_GNUPLOT ("gnuplot");
@@ -43,7 +49,9 @@ const QString DASH_DEBUG ("-" + CMD_DEBUG);
 const QString DASH_DROP_REGRESSION ("-" + CMD_DROP_REGRESSION);
 const QString DASH_ERROR_REPORT ("-" + CMD_ERROR_REPORT);
 const QString DASH_EXTRACT_IMAGE_ONLY ("-" + CMD_EXTRACT_IMAGE_ONLY);
+const QString DASH_EXPORT_EXTENSION ("-" + CMD_EXPORT_EXTENSION);
 const QString DASH_EXPORT_ONLY ("-" + CMD_EXPORT_ONLY);
+const QString DASH_EXPORT_THREADS ("-" + CMD_EXPORT_THREADS);
 const QString DASH_FILE_CMD_SCRIPT ("-" + CMD_FILE_CMD_SCRIPT);
 const QString DASH_GNUPLOT ("-" + CMD_GNUPLOT);
 const QString DASH_HELP ("-" + CMD_HELP);
@@ -69,6 +77,8 @@ void parseCmdLine (int argc,
                    bool &isErrorReportRegressionTest,
                    bool &isGnuplot,
                    bool &isExportOnly,
+                   int &exportThreadCount,
+                   QString &exportOnlyExtension,
                    bool &isExtractImageOnly,
                    QString &extractImageOnlyExtension,
                    bool &isUpgrade,
@@ -143,12 +153,21 @@ int main(int argc, char *argv[])
 
   QApplication app(argc, argv);
 
+  // Xml errors get a message box, since the library code that reads xml has no gui of its own
+  xmlBindToErrorDisplay ([] (const QString &title,
+                             const QString &message) {
+    QMessageBox::critical (nullptr,
+                           title,
+                           message);
+  });
+
   // Translations
   TranslatorContainer translatorContainer (app); // Must exist until execution terminates
 
   // Command line
   bool isDebug, isDropRegression, isReset, isGnuplot, isErrorReportRegressionTest, isExportOnly, isExtractImageOnly, isUpgrade;
-  QString errorReportFile, extractImageOnlyExtension, fileCmdScriptFile;
+  int exportThreadCount;
+  QString errorReportFile, exportOnlyExtension, extractImageOnlyExtension, fileCmdScriptFile;
   QStringList loadStartupFiles, commandLineWithoutLoadStartupFiles;
   parseCmdLine (argc,
                 argv,
@@ -160,6 +179,8 @@ int main(int argc, char *argv[])
                 isErrorReportRegressionTest,
                 isGnuplot,
                 isExportOnly,
+                exportThreadCount,
+                exportOnlyExtension,
                 isExtractImageOnly,
                 extractImageOnlyExtension,
                 isUpgrade,
@@ -182,7 +203,9 @@ int main(int argc, char *argv[])
                   isExtractImageOnly,
                   extractImageOnlyExtension,
                   loadStartupFiles,
-                  commandLineWithoutLoadStartupFiles);
+                  commandLineWithoutLoadStartupFiles,
+                  exportOnlyExtension,
+                  exportThreadCount);
     w.show();
 
     // Event loop
@@ -202,6 +225,8 @@ void parseCmdLine (int argc,
                    bool &isErrorReportRegressionTest,
                    bool &isGnuplot,
                    bool &isExportOnly,
+                   int &exportThreadCount,
+                   QString &exportOnlyExtension,
                    bool &isExtractImageOnly,
                    QString &extractImageOnlyExtension,
                    bool &isUpgrade,
@@ -214,6 +239,8 @@ void parseCmdLine (int argc,
 
   // State
   bool nextIsErrorReportFile = false;
+  bool nextIsExportExtension = false;
+  bool nextIsExportThreads = false;
   bool nextIsExtractImageOnly = false;
   bool nextIsFileCmdScript = false;
 
@@ -226,6 +253,8 @@ void parseCmdLine (int argc,
   isErrorReportRegressionTest = false;
   isGnuplot = false;
   isExportOnly = false;
+  exportThreadCount = 0; // One thread per core
+  exportOnlyExtension = ""; // Csv
   isExtractImageOnly = false;
   extractImageOnlyExtension = "";
   isUpgrade = false;
@@ -240,6 +269,26 @@ void parseCmdLine (int argc,
                         QObject::tr ("is not a valid file name"));
       errorReportFile = argv [i];
       nextIsErrorReportFile = false;
+    } else if (nextIsExportExtension) {
+      ExportToFile exportStrategy;
+      ExportToFileNumpy exportNumpy;
+      QStringList exportExtensions;
+      exportExtensions << exportStrategy.fileExtensionCsv ()
+                       << exportStrategy.fileExtensionTsv ()
+                       << exportNumpy.fileExtensionNpy ()
+                       << exportNumpy.fileExtensionNpz ();
+      sanityCheckValue (exportExtensions.contains (argv [i], Qt::CaseInsensitive),
+                        argv [i],
+                        QObject::tr ("is not a valid export file extension"));
+      exportOnlyExtension = argv [i];
+      nextIsExportExtension = false;
+    } else if (nextIsExportThreads) {
+      bool isInteger;
+      exportThreadCount = QString (argv [i]).toInt (&isInteger);
+      sanityCheckValue (isInteger && (exportThreadCount > 0),
+                        argv [i],
+                        QObject::tr ("is not a positive number of threads"));
+      nextIsExportThreads = false;
     } else if (nextIsExtractImageOnly) {
       sanityCheckValue (importImageExtensions.offers (argv [i]),
                         argv [i],
@@ -258,8 +307,12 @@ void parseCmdLine (int argc,
       isDropRegression = true;
     } else if (strcmp (argv [i], DASH_ERROR_REPORT.toLatin1().data()) == 0) {
       nextIsErrorReportFile = true;
+    } else if (strcmp (argv [i], DASH_EXPORT_EXTENSION.toLatin1().data()) == 0) {
+      nextIsExportExtension = true;
     } else if (strcmp (argv [i], DASH_EXPORT_ONLY.toLatin1().data()) == 0) {
       isExportOnly = true;
+    } else if (strcmp (argv [i], DASH_EXPORT_THREADS.toLatin1().data()) == 0) {
+      nextIsExportThreads = true;
     } else if (strcmp (argv [i], DASH_EXTRACT_IMAGE_ONLY.toLatin1().data()) == 0) {
       isExtractImageOnly = true;
       nextIsExtractImageOnly = true;
@@ -314,7 +367,7 @@ void parseCmdLine (int argc,
                                loadStartupFiles);
 
   // Usage
-  if (showUsage || nextIsErrorReportFile || nextIsExtractImageOnly || nextIsFileCmdScript) {
+  if (showUsage || nextIsErrorReportFile || nextIsExportThreads || nextIsExtractImageOnly || nextIsFileCmdScript) {
 
     showUsageAndQuit ();
 
@@ -380,7 +433,9 @@ void showUsageAndQuit ()
       << "[" << DASH_DEBUG.toLatin1().data() << "] "
       << "[" << DASH_DROP_REGRESSION.toLatin1().data() << "] "
       << "[" << DASH_ERROR_REPORT.toLatin1().data() << " &lt;file&gt;] "
+      << "[" << DASH_EXPORT_EXTENSION.toLatin1().data() << " &lt;extension&gt;] "
       << "[" << DASH_EXPORT_ONLY.toLatin1().data() << "] "
+      << "[" << DASH_EXPORT_THREADS.toLatin1().data() << " &lt;count&gt;] "
       << "[" << DASH_EXTRACT_IMAGE_ONLY.toLatin1().data() << " &lt;extension&gt;] "
       << "[" << DASH_FILE_CMD_SCRIPT.toLatin1().data() << " &lt;file&gt; "
       << "[" << DASH_GNUPLOT.toLatin1().data() << "] "
@@ -414,12 +469,24 @@ void showUsageAndQuit ()
       << "</td>"
       << "</tr>"
       << "<tr>"
+      << "<td>" << DASH_EXPORT_EXTENSION.toLatin1().data() << "</td>"
+      << "<td>"
+      << QObject::tr ("File extension of the files exported with the export-only option, which selects the format: csv, tsv, npy or npz. Default is csv").toLatin1().data()
+      << "</td>"
+      << "</tr>"
+      << "<tr>"
       << "<td>" << DASH_EXPORT_ONLY.toLatin1().data() << "</td>"
       << "<td>"
       << QObject::tr ("Export each loaded startup file, which must have all axis points defined, then stop").toLatin1().data()
       << "</td>"
       << "</tr>"
       << "<tr>"
+      << "<td>" << DASH_EXPORT_THREADS.toLatin1().data() << "</td>"
+      << "<td>"
+      << QObject::tr ("Number of files exported at the same time with the export-only option. Default is one per core").toLatin1().data()
+      << "</td>"
+      << "</tr>"
+      << "<tr>"
       << "<td>" << DASH_EXTRACT_IMAGE_ONLY.toLatin1().data() << "</td>"
       << "<td>"
       << QObject::tr ("Extract image in each loaded startup file to a file with the specified extension, then stop").toLatin1().data()
@@ -540,14 +607,14 @@ void upgradeFiles (const QStringList &loadStartupFiles)
         .arg (QObject::tr ("Could not write to"))
         .arg (filenameNew);
 
-    } else {
+    } else if (!DocumentContainer ().write (file,
+                                            document)) {
+
+      msg += QString ("%1 %2")
+        .arg (QObject::tr ("Could not write to"))
+        .arg (filenameNew);
 
-      QXmlStreamWriter writer (&file);
-      writer.setAutoFormatting (true);
-      writer.writeStartDocument();
-      writer.writeDTD ("<!DOCTYPE engauge>");
-      document.saveXml (writer);
-      writer.writeEndDocument ();
+    } else {
 
       msg += QString ("%1 %2 %3 %4")
         .arg (QObject::tr ("Upgraded"))
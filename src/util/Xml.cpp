@@ -4,13 +4,20 @@
  * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
  ******************************************************************************************************/
 
+#include <iostream>
 #include "Logger.h"
 #include <QFileDevice>
-#include <QMessageBox>
 #include <QObject>
 #include "QtToString.h"
 #include "Xml.h"
 
+static XmlErrorDisplay xmlErrorDisplay;
+
+void xmlBindToErrorDisplay (const XmlErrorDisplay &errorDisplay)
+{
+  xmlErrorDisplay = errorDisplay;
+}
+
 QXmlStreamReader::TokenType loadNextFromReader (QXmlStreamReader &reader)
 {
   QXmlStreamReader::TokenType tokenType = reader.readNext();
@@ -46,9 +53,13 @@ void xmlExitWithError (QXmlStreamReader &reader,
                        .arg (message)
                        .arg (QObject::tr ("Quitting"));
 
-  QMessageBox::critical (nullptr,
-                         QObject::tr ("Error reading xml"),
-                         adornedMsg);
+  if (xmlErrorDisplay) {
+    xmlErrorDisplay (QObject::tr ("Error reading xml"),
+                     adornedMsg);
+  } else {
+    std::cerr << QObject::tr ("Error reading xml").toLocal8Bit().data() << ": "
+              << adornedMsg.toLocal8Bit().data() << std::endl;
+  }
 
   exit (-1);
 }
@@ -7,14 +7,22 @@
 #ifndef XML_H
 #define XML_H
 
+#include <functional>
 #include <QString>
 #include <QXmlStreamReader>
 
+/// Handler that shows the title and message of an error while reading xml
+typedef std::function<void (const QString &, const QString &)> XmlErrorDisplay;
+
+/// Bind to the gui handler that shows xml errors in a message box. Without a binding, as in batch export, errors are
+/// only written to stderr
+extern void xmlBindToErrorDisplay (const XmlErrorDisplay &errorDisplay);
+
 /// Load next token from xml reader
 extern QXmlStreamReader::TokenType loadNextFromReader (QXmlStreamReader &reader);
 
 /// Show specified message for an error while reading xml, then quit. The reader will provide filename
-/// (if available) and line number
+/// (if available) and line number. See xmlBindToErrorDisplay
 extern void xmlExitWithError (QXmlStreamReader &reader,
                               const QString &message);
 